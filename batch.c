@@ -0,0 +1,515 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>    /* printf(), puts() */
+#include <stdlib.h>   /* malloc(), free() */
+#include <string.h>   /* strlen() */
+
+#include "compat-sdl.h" /* SDL_GetPerformanceCounter() */
+#include "draw.h"
+#include "gra.h"
+#include "movelist.h"
+#include "pool.h"
+#include "save.h"
+#include "skin.h"
+#include "sok_core.h"
+#include "sok_solver.h"
+
+#include "batch.h" /* include self for control */
+
+
+enum verifystatus {
+  VERIFY_NOSOLUTION = 0,
+  VERIFY_PASS = 1,
+  VERIFY_UNSOLVED = 2,
+  VERIFY_ILLEGAL = 3,
+  VERIFY_NOMEM = 4,
+  VERIFY_BADPUSH = 5
+};
+
+struct verifyres {
+  enum verifystatus status;
+  size_t moves;
+  size_t pushes;
+  size_t failpos;
+};
+
+struct verifyctx {
+  struct sokgame **gameslist;
+  struct verifyres *res;
+};
+
+
+/* replays the solution of a single level on a private copy of the game */
+static void verify_job(void *arg, int jobid) {
+  struct verifyctx *ctx = arg;
+  struct verifyres *res = &(ctx->res[jobid]);
+  struct sokgame *game;
+  struct sokgamestates *states;
+  const struct sokmovelist *solution = ctx->gameslist[jobid]->solution;
+  int r;
+
+  if (solution == NULL) {
+    res->status = VERIFY_NOSOLUTION;
+    return;
+  }
+  res->moves = ml_count(solution);
+  res->pushes = ml_pushcount(solution);
+
+  /* replay on a copy, the original game is shared by all threads */
+  game = sok_copygame(ctx->gameslist[jobid]);
+  states = sok_newstates();
+  if ((game == NULL) || (states == NULL)) {
+    res->status = VERIFY_NOMEM;
+    free(game);
+    sok_freestates(states);
+    return;
+  }
+  game->solution = NULL; /* owned by the original game */
+
+  r = sok_replay(game, states, solution, &(res->failpos));
+  if (r == -2) {
+    res->status = VERIFY_BADPUSH;
+  } else if (r < 0) {
+    res->status = VERIFY_ILLEGAL;
+  } else if (r == 0) {
+    res->status = VERIFY_UNSOLVED;
+  } else {
+    res->status = VERIFY_PASS;
+  }
+
+  sok_freestates(states);
+  free(game);
+}
+
+
+/* loads a level set for batch processing. returns the number of levels, or
+ * a non-positive value on error */
+static int batch_loadset(char *levelfile, struct sokgame ***gameslist) {
+  int levelscount;
+  char comment[64];
+
+  if (levelfile == NULL) {
+    puts("batch processing requires a level file");
+    return(0);
+  }
+
+  *gameslist = malloc(sizeof(struct sokgame *) * MAXLEVELS);
+  if (*gameslist == NULL) {
+    puts("Memory allocation failed!");
+    return(0);
+  }
+
+  levelscount = sok_loadfile(*gameslist, MAXLEVELS, levelfile, NULL, 0, comment, sizeof(comment));
+  if (levelscount < 1) {
+    printf("Failed to load the level file '%s': %s\n", levelfile, sok_strerr(levelscount));
+    free(*gameslist);
+    *gameslist = NULL;
+    return(levelscount);
+  }
+  sok_loadsolutions(*gameslist, levelscount);
+  return(levelscount);
+}
+
+
+int batch_verify(char *levelfile, int threads) {
+  struct sokgame **gameslist;
+  struct verifyctx ctx;
+  int levelscount, i, usedthreads;
+  unsigned long passed = 0, failed = 0, nosol = 0;
+  double totmoves = 0, elapsed;
+  Uint64 t0, t1;
+
+  levelscount = batch_loadset(levelfile, &gameslist);
+  if (levelscount < 1) return(1);
+
+  ctx.gameslist = gameslist;
+  ctx.res = calloc((size_t)levelscount, sizeof(struct verifyres));
+  if (ctx.res == NULL) {
+    puts("Memory allocation failed!");
+    sok_freefile(gameslist, levelscount);
+    free(gameslist);
+    return(1);
+  }
+
+  t0 = SDL_GetPerformanceCounter();
+  usedthreads = pool_run(threads, levelscount, verify_job, &ctx);
+  t1 = SDL_GetPerformanceCounter();
+  elapsed = (double)(t1 - t0) / (double)SDL_GetPerformanceFrequency();
+
+  /* print results in level order, regardless of the order jobs completed */
+  for (i = 0; i < levelscount; i++) {
+    struct verifyres *res = &(ctx.res[i]);
+    switch (res->status) {
+      case VERIFY_NOSOLUTION:
+        printf("level %4d: no solution\n", i + 1);
+        nosol++;
+        continue;
+      case VERIFY_PASS:
+        printf("level %4d: pass (%lu moves, %lu pushes)\n", i + 1, (unsigned long)res->moves, (unsigned long)res->pushes);
+        passed++;
+        break;
+      case VERIFY_UNSOLVED:
+        printf("level %4d: FAIL, level not solved (%lu moves, %lu pushes)\n", i + 1, (unsigned long)res->moves, (unsigned long)res->pushes);
+        failed++;
+        break;
+      case VERIFY_ILLEGAL:
+        printf("level %4d: FAIL, illegal move #%lu (%lu moves, %lu pushes)\n", i + 1, (unsigned long)res->failpos + 1, (unsigned long)res->moves, (unsigned long)res->pushes);
+        failed++;
+        break;
+      case VERIFY_BADPUSH:
+        printf("level %4d: FAIL, move #%lu is not recorded as the push or walk it is (%lu moves, %lu pushes)\n", i + 1, (unsigned long)res->failpos + 1, (unsigned long)res->moves, (unsigned long)res->pushes);
+        failed++;
+        break;
+      case VERIFY_NOMEM:
+        printf("level %4d: FAIL, out of memory\n", i + 1);
+        failed++;
+        break;
+    }
+    totmoves += (double)res->moves;
+  }
+
+  printf("\n%d levels: %lu passed, %lu failed, %lu without solution\n", levelscount, passed, failed, nosol);
+  printf("replayed %.0f moves in %.3f s on %d thread%s", totmoves, elapsed, usedthreads, (usedthreads > 1) ? "s" : "");
+  if (elapsed > 0) printf(" (%.0f moves/s)", totmoves / elapsed);
+  puts("");
+
+  free(ctx.res);
+  sok_freefile(gameslist, levelscount);
+  free(gameslist);
+
+  if (failed != 0) return(1);
+  return(0);
+}
+
+
+struct solveres {
+  int status;     /* SOKSOLVER result, or SOLVE_xxx */
+  struct sokmovelist *solution;
+  double elapsed;
+  unsigned long nodes;
+};
+
+#define SOLVE_SKIPPED 1
+#define SOLVE_BADREPLAY 2
+
+struct solvectx {
+  struct sokgame **gameslist;
+  struct solveres *res;
+  struct soksolver_params params;
+};
+
+
+/* solves a single level and double-checks the solution by replaying it */
+static void solve_job(void *arg, int jobid) {
+  struct solvectx *ctx = arg;
+  struct solveres *res = &(ctx->res[jobid]);
+  struct soksolver_stats stats;
+  struct sokgame *game;
+  struct sokgamestates *states;
+  char *solution;
+  Uint64 t0;
+
+  if (ctx->gameslist[jobid]->solution != NULL) {
+    res->status = SOLVE_SKIPPED;
+    return;
+  }
+  t0 = SDL_GetPerformanceCounter();
+  res->status = sok_solve(ctx->gameslist[jobid], &(ctx->params), &solution, &stats);
+  res->elapsed = (double)(SDL_GetPerformanceCounter() - t0) / (double)SDL_GetPerformanceFrequency();
+  res->nodes = stats.nodes;
+  if (res->status != soksolver_solved) return;
+  res->solution = ml_fromstring(solution);
+  free(solution);
+  if (res->solution == NULL) res->status = SOLVE_BADREPLAY;
+  if (res->status != soksolver_solved) return;
+
+  /* never trust the solver blindly: the solution must replay fine */
+  game = sok_copygame(ctx->gameslist[jobid]);
+  states = sok_newstates();
+  if ((game == NULL) || (states == NULL)) {
+    res->status = soksolver_outofmem;
+  } else {
+    game->solution = NULL;
+    if (sok_replay(game, states, res->solution, NULL) != 1) res->status = SOLVE_BADREPLAY;
+  }
+  if (res->status != soksolver_solved) {
+    ml_free(res->solution);
+    res->solution = NULL;
+  }
+  free(game);
+  sok_freestates(states);
+}
+
+
+int batch_solve(char *levelfile, const struct soksolver_params *params) {
+  struct sokgame **gameslist;
+  struct solvectx ctx;
+  int levelscount, i, threads, pending = 0, perlevel;
+  unsigned long solved = 0, failed = 0, skipped = 0, totnodes = 0;
+  double elapsed, cputime = 0;
+  Uint64 t0;
+
+  levelscount = batch_loadset(levelfile, &gameslist);
+  if (levelscount < 1) return(1);
+
+  ctx.gameslist = gameslist;
+  ctx.params = *params;
+  ctx.res = calloc((size_t)levelscount, sizeof(struct solveres));
+  if (ctx.res == NULL) {
+    puts("Memory allocation failed!");
+    sok_freefile(gameslist, levelscount);
+    free(gameslist);
+    return(1);
+  }
+
+  threads = params->threads;
+  if (threads < 1) threads = CSDL_GetCPUCount();
+  if (threads < 1) threads = 1;
+  for (i = 0; i < levelscount; i++) {
+    if (gameslist[i]->solution == NULL) pending++;
+  }
+
+  /* with enough levels to keep all cores busy, levels are spread over
+   * threads and each is solved by a single-threaded search, sharing the
+   * memory budget. otherwise levels are solved one after another, each by a
+   * search running on all threads. */
+  perlevel = (pending >= threads) && (threads > 1);
+  if (perlevel) {
+    ctx.params.threads = 1;
+    ctx.params.maxmemory = params->maxmemory / (size_t)threads;
+    printf("solving %d levels on %d threads, one level per thread\n", pending, threads);
+  } else {
+    ctx.params.threads = threads;
+    printf("solving %d levels one by one, on %d thread%s\n", pending, threads, (threads > 1) ? "s" : "");
+  }
+
+  t0 = SDL_GetPerformanceCounter();
+  pool_run(perlevel ? threads : 1, levelscount, solve_job, &ctx);
+  elapsed = (double)(SDL_GetPerformanceCounter() - t0) / (double)SDL_GetPerformanceFrequency();
+
+  /* report and save results in level order */
+  for (i = 0; i < levelscount; i++) {
+    struct solveres *res = &(ctx.res[i]);
+    if (res->status == SOLVE_SKIPPED) {
+      printf("level %4d: already solved\n", i + 1);
+      skipped++;
+      continue;
+    }
+    cputime += res->elapsed;
+    totnodes += res->nodes;
+    if (res->status == soksolver_solved) {
+      solution_save(gameslist[i]->crc64, res->solution, "sol");
+      printf("level %4d: solved (%lu moves, %lu pushes) in %.2f s, %lu nodes\n", i + 1, (unsigned long)ml_count(res->solution), (unsigned long)ml_pushcount(res->solution), res->elapsed, res->nodes);
+      ml_free(res->solution);
+      solved++;
+    } else if (res->status == SOLVE_BADREPLAY) {
+      printf("level %4d: FAIL, computed solution does not replay\n", i + 1);
+      failed++;
+    } else {
+      printf("level %4d: FAIL, %s after %.2f s, %lu nodes\n", i + 1, sok_solver_strerr(res->status), res->elapsed, res->nodes);
+      failed++;
+    }
+  }
+
+  printf("\n%d levels: %lu solved, %lu failed, %lu already solved\n", levelscount, solved, failed, skipped);
+  printf("explored %lu nodes in %.3f s", totnodes, elapsed);
+  if (elapsed > 0) printf(" (%.0f nodes/s, %.0f nodes/s per thread)", (double)totnodes / elapsed, (double)totnodes / elapsed / threads);
+  puts("");
+  /* levels solved in parallel ran the single-threaded solver, so the sum of
+   * their solving times is what a single thread would have needed (as long
+   * as there are not more threads than CPU cores) */
+  if (perlevel && (elapsed > 0)) printf("speed-up over a single thread: %.2fx (%.3f s of solving in %.3f s)\n", cputime / elapsed, cputime, elapsed);
+
+  /* levels solved one by one ran a search spread over all threads: solved
+   * levels are solved again by a single-threaded search to compare with.
+   * levels the single thread fails to solve in time are left out. */
+  if (!perlevel && (threads > 1) && (solved > 0)) {
+    struct solvectx base = ctx;
+    double basetime = 0, partime = 0;
+    int compared = 0;
+    base.params.threads = 1;
+    base.res = calloc((size_t)levelscount, sizeof(struct solveres));
+    if (base.res == NULL) {
+      puts("speed-up over a single thread: not available, out of memory");
+    } else {
+      puts("solving the same levels on a single thread, for comparison...");
+      for (i = 0; i < levelscount; i++) {
+        if (ctx.res[i].status != soksolver_solved) continue;
+        solve_job(&base, i);
+        if (base.res[i].status == soksolver_solved) {
+          basetime += base.res[i].elapsed;
+          partime += ctx.res[i].elapsed;
+          compared++;
+        }
+        ml_free(base.res[i].solution);
+      }
+      free(base.res);
+      if (partime > 0) {
+        printf("speed-up over a single thread: %.2fx (%d level%s solved in %.3f s on %d threads, in %.3f s on one thread)\n", basetime / partime, compared, (compared > 1) ? "s" : "", partime, threads, basetime);
+      } else {
+        puts("speed-up over a single thread: not available, no level got solved by a single thread");
+      }
+    }
+  }
+
+  free(ctx.res);
+  sok_freefile(gameslist, levelscount);
+  free(gameslist);
+
+  if (failed != 0) return(1);
+  return(0);
+}
+
+
+/* previews larger than this (in pixels, either way) get smaller tiles */
+#define THUMB_MAXPIXELS 4096
+
+struct thumbctx {
+  struct sokgame **gameslist;
+  int levelscount;
+  const char *outdir;
+  const char *skinname;
+  CSDL_AtomicInt next; /* next level to render */
+  int *res;            /* levelscount entries, 0 once the preview is written */
+};
+
+
+/* draws the preview of a level on a texture and writes it to file fname.
+ * returns 0 on success, non-zero otherwise. */
+static int thumb_render(const struct sokgame *game, struct spritesstruct *sprites, SDL_Renderer *renderer, const char *fname) {
+  int w, h, res = -1, longest = (game->field_width > game->field_height) ? game->field_width : game->field_height;
+  unsigned short tilesize = sprites->tilesize;
+  SDL_Texture *tex;
+  SDL_Surface *img;
+
+  if (tilesize * longest > THUMB_MAXPIXELS) tilesize = (unsigned short)((THUMB_MAXPIXELS / longest) & ~1);
+  if (tilesize < 2) tilesize = 2;
+  w = game->field_width * tilesize;
+  h = game->field_height * tilesize;
+
+  tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+  if (tex == NULL) return(-1);
+  img = CSDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGBA8888);
+  if (img != NULL) {
+    SDL_SetRenderTarget(renderer, tex);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); /* whatever is out of the level stays transparent */
+    SDL_RenderClear(renderer);
+    draw_levelmap(game, sprites, w / 2, h / 2, renderer, tilesize, 255, 0);
+    if (CSDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_RGBA8888, img->pixels, img->pitch) == 0) {
+      res = CIMG_SavePNG(img, fname);
+    }
+    SDL_SetRenderTarget(renderer, NULL);
+    CSDL_DestroySurface(img);
+  }
+  SDL_DestroyTexture(tex);
+  return(res);
+}
+
+
+/* a worker: sets up its own offscreen renderer (textures of a renderer may
+ * not be shared with another one, hence its own copy of the skin too) and
+ * renders levels until none is left */
+static void thumb_job(void *arg, int jobid) {
+  struct thumbctx *ctx = arg;
+  SDL_Surface *screen;
+  SDL_Renderer *renderer = NULL;
+  struct spritesstruct *sprites = NULL;
+  char *fname;
+  int i;
+
+  (void)jobid;
+  screen = CSDL_CreateSurface(1, 1, SDL_PIXELFORMAT_RGBA8888);
+  if (screen != NULL) renderer = SDL_CreateSoftwareRenderer(screen);
+  if (renderer != NULL) sprites = skin_load(ctx->skinname, renderer);
+  fname = malloc(strlen(ctx->outdir) + 16);
+
+  while ((i = CSDL_AtomicAdd(&(ctx->next), 1)) < ctx->levelscount) {
+    if ((sprites == NULL) || (fname == NULL)) continue; /* res stays set to failure */
+    sprintf(fname, "%s/%04d.png", ctx->outdir, i + 1);
+    ctx->res[i] = thumb_render(ctx->gameslist[i], sprites, renderer, fname);
+  }
+
+  free(fname);
+  if (sprites != NULL) skin_free(sprites);
+  if (renderer != NULL) SDL_DestroyRenderer(renderer);
+  if (screen != NULL) CSDL_DestroySurface(screen);
+}
+
+
+int batch_renderthumbs(char *levelfile, const char *outdir, const char *skinname, int threads) {
+  struct sokgame **gameslist;
+  struct thumbctx ctx;
+  int levelscount, i, usedthreads;
+  unsigned long failed = 0;
+  double elapsed;
+  Uint64 t0;
+
+  levelscount = batch_loadset(levelfile, &gameslist);
+  if (levelscount < 1) return(1);
+
+  ctx.gameslist = gameslist;
+  ctx.levelscount = levelscount;
+  ctx.outdir = outdir;
+  ctx.skinname = skinname;
+  CSDL_AtomicSet(&(ctx.next), 0);
+  ctx.res = malloc(sizeof(int) * (size_t)levelscount);
+  if (ctx.res == NULL) {
+    puts("Memory allocation failed!");
+    sok_freefile(gameslist, levelscount);
+    free(gameslist);
+    return(1);
+  }
+  for (i = 0; i < levelscount; i++) ctx.res[i] = -1;
+
+  /* one job per worker thread, each of them taking levels one by one */
+  if (threads < 1) threads = CSDL_GetCPUCount();
+  if (threads > levelscount) threads = levelscount;
+  if (threads < 1) threads = 1;
+
+  t0 = SDL_GetPerformanceCounter();
+  usedthreads = pool_run(threads, threads, thumb_job, &ctx);
+  elapsed = (double)(SDL_GetPerformanceCounter() - t0) / (double)SDL_GetPerformanceFrequency();
+
+  for (i = 0; i < levelscount; i++) {
+    if (ctx.res[i] == 0) {
+      printf("level %4d: %s/%04d.png\n", i + 1, outdir, i + 1);
+    } else {
+      printf("level %4d: FAIL, preview not written\n", i + 1);
+      failed++;
+    }
+  }
+
+  printf("\n%d levels: %lu previews written, %lu failed\n", levelscount, (unsigned long)levelscount - failed, failed);
+  printf("rendered in %.3f s on %d thread%s\n", elapsed, usedthreads, (usedthreads > 1) ? "s" : "");
+
+  free(ctx.res);
+  sok_freefile(gameslist, levelscount);
+  free(gameslist);
+
+  if (failed != 0) return(1);
+  return(0);
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef batch_h_sentinel
+#define batch_h_sentinel
+
+  #include "sok_solver.h"
+
+  /* loads the level set levelfile, replays the saved solution of every level
+   * on a pool of worker threads and prints the outcome for each level.
+   * threads < 1 means "one thread per CPU core". returns 0 if all available
+   * solutions are valid, non-zero otherwise. */
+  int batch_verify(char *levelfile, int threads);
+
+  /* loads the level set levelfile, computes a solution for every level that
+   * has none yet and saves it. returns 0 if all levels end up solved,
+   * non-zero otherwise. */
+  int batch_solve(char *levelfile, const struct soksolver_params *params);
+
+  /* loads the level set levelfile and writes a preview of every level to
+   * directory outdir as a PNG image (0001.png, 0002.png...), drawn with skin
+   * skinname. levels are spread over a pool of worker threads, each drawing
+   * on its own offscreen software renderer, so no display is needed.
+   * threads < 1 means "one thread per CPU core". returns 0 if all previews
+   * are written, non-zero otherwise. */
+  int batch_renderthumbs(char *levelfile, const char *outdir, const char *skinname, int threads);
+
+#endif
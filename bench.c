@@ -0,0 +1,448 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * simplesok-bench: microbenchmarks of Simple Sokoban's hot paths (level
+ * loading, moves, decompression, checksums, solution storage and screen
+ * drawing). Every result is printed as a line of JSON, so figures can be
+ * collected and compared from one release to another.
+ *
+ * usage: simplesok-bench [--time=ms] [--dir=path] [--skin=name] [filter]...
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>   /* malloc(), free(), atoi() */
+#include <string.h>   /* strstr(), strncmp() */
+
+#include "compat-sdl.h" /* SDL_GetPerformanceCounter() */
+#include "crc64.h"
+#include "data.h"       /* embedded level sets */
+#include "draw.h"
+#include "gz.h"
+#include "movelist.h"
+#include "save.h"
+#include "skin.h"
+#include "sok_core.h"
+#include "sok_solver.h"
+
+
+#define BENCH_DEFAULTMS 1000           /* minimum time spent on each benchmark */
+#define BENCH_DEFAULTDIR "simplesok-bench.tmp"
+#define BENCH_CRCBUFLEN (16 * 1024 * 1024)
+#define BENCH_REPLAYLEVELS 10          /* microban levels replayed by move_undo */
+#define BENCH_SOLVETIME 10             /* solver's time limit for these, in seconds */
+#define BENCH_SOLVEMEM 256             /* solver's memory limit, in MiB */
+#define BENCH_ROUNDTRIPS 64            /* solutions saved and loaded per iteration */
+#define BENCH_ROUNDTRIPKEY 0xbe7c000000000000ull /* keys no real level uses */
+#define BENCH_WINW 1280
+#define BENCH_WINH 800
+
+struct levelset {
+  const char *name;
+  unsigned char *data;
+  size_t len;
+};
+
+static struct levelset levelsets[] = {
+  {"microban", assets_levels_microban_xsb_gz, 0},
+  {"sasquatch", assets_levels_sasquatch_xsb_gz, 0},
+  {"sasquatch3", assets_levels_sasquatch3_xsb_gz, 0},
+  {"boxworld", assets_levels_boxworld_xsb_gz, 0},
+  {NULL, NULL, 0}
+};
+
+static unsigned long mintime = BENCH_DEFAULTMS;
+static char **filters;
+static int filterscount;
+
+
+static double now(void) {
+  return((double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency());
+}
+
+
+/* a benchmark runs only if its name contains any of the filters (or if
+ * there are no filters at all) */
+static int bench_selected(const char *name) {
+  int i;
+  if (filterscount == 0) return(1);
+  for (i = 0; i < filterscount; i++) {
+    if (strstr(name, filters[i]) != NULL) return(1);
+  }
+  return(0);
+}
+
+
+/* calls fn(ctx) over and over for at least mintime ms (after a warm up
+ * call) and prints the result. fn returns the amount of work it performed,
+ * in unit, so the value reported is that work per second. */
+static void bench_run(const char *name, const char *unit, double (*fn)(void *ctx), void *ctx) {
+  unsigned long iterations = 0;
+  double work = 0, start, elapsed;
+
+  fn(ctx);
+  start = now();
+  do {
+    work += fn(ctx);
+    iterations++;
+    elapsed = now() - start;
+  } while (elapsed * 1000.0 < (double)mintime);
+
+  printf("{\"bench\":\"%s\",\"iterations\":%lu,\"seconds\":%.6f,\"value\":%.3f,\"unit\":\"%s/s\"}\n", name, iterations, elapsed, work / elapsed, unit);
+  fflush(stdout);
+}
+
+
+static void bench_skip(const char *name, const char *reason) {
+  printf("{\"bench\":\"%s\",\"skipped\":\"%s\"}\n", name, reason);
+  fflush(stdout);
+}
+
+
+/*** sok_loadfile() ***/
+
+struct loadctx {
+  const struct levelset *set;
+  struct sokgame **games;
+};
+
+static double run_loadfile(void *ctx) {
+  struct loadctx *c = ctx;
+  char comment[256];
+  int count;
+  count = sok_loadfile(c->games, MAXLEVELS, NULL, c->set->data, c->set->len, comment, sizeof(comment));
+  if (count < 1) return(0);
+  sok_freefile(c->games, count);
+  return(count);
+}
+
+
+/*** ungz() ***/
+
+static double run_ungz(void *ctx) {
+  const struct levelset *set = ctx;
+  size_t len;
+  void *res = ungz(set->data, set->len, &len);
+  if (res == NULL) return(0);
+  free(res);
+  return((double)len);
+}
+
+
+/*** crc64() ***/
+
+static volatile uint64_t crcsink; /* so the computation is not optimized away */
+
+static double run_crc64(void *ctx) {
+  crcsink = crc64(0, ctx, BENCH_CRCBUFLEN);
+  return(BENCH_CRCBUFLEN);
+}
+
+
+/*** sok_move() / sok_undo() ***/
+
+struct replayctx {
+  struct sokgame *games[MAXLEVELS];
+  int count;
+  struct sokgamestates *states;
+};
+
+/* plays the solution of every level, then undoes all of it */
+static double run_moveundo(void *ctx) {
+  struct replayctx *c = ctx;
+  size_t i, moves, total = 0;
+  int l;
+  for (l = 0; l < c->count; l++) {
+    struct sokgame *game = c->games[l];
+    moves = ml_count(game->solution);
+    for (i = 0; i < moves; i++) {
+      sok_move(game, sok_ml2move(ml_get(game->solution, i)), 0, c->states);
+    }
+    for (i = 0; i < moves; i++) sok_undo(game, c->states);
+    total += moves * 2;
+  }
+  return((double)total);
+}
+
+/* loads microban levels and makes sure the first BENCH_REPLAYLEVELS of them
+ * have a solution to replay. missing solutions are computed and saved, so
+ * next runs use the very same ones. returns 0 on success. */
+static int replay_prepare(struct replayctx *c) {
+  char comment[256];
+  struct soksolver_params params;
+  char *solution;
+  int l, res, count;
+
+  count = sok_loadfile(c->games, MAXLEVELS, NULL, levelsets[0].data, levelsets[0].len, comment, sizeof(comment));
+  if (count < BENCH_REPLAYLEVELS) {
+    if (count > 0) sok_freefile(c->games, count);
+    return(-1);
+  }
+  /* only keep the levels to be replayed */
+  sok_freefile(c->games + BENCH_REPLAYLEVELS, count - BENCH_REPLAYLEVELS);
+  c->count = BENCH_REPLAYLEVELS;
+
+  params.maxtime = BENCH_SOLVETIME;
+  params.maxmemory = (size_t)BENCH_SOLVEMEM * 1024 * 1024;
+  params.threads = 0;
+  params.cancel = NULL;
+  params.cancelctx = NULL;
+  for (l = 0; l < c->count; l++) {
+    if (c->games[l]->solution != NULL) continue;
+    fprintf(stderr, "solving microban level %d...\n", l + 1);
+    res = sok_solve(c->games[l], &params, &solution, NULL);
+    if (res != soksolver_solved) {
+      fprintf(stderr, "microban level %d: %s\n", l + 1, sok_solver_strerr(res));
+      sok_freefile(c->games, c->count);
+      return(-1);
+    }
+    c->games[l]->solution = ml_fromstring(solution);
+    free(solution);
+    if (c->games[l]->solution == NULL) {
+      sok_freefile(c->games, c->count);
+      return(-1);
+    }
+    solution_save(c->games[l]->crc64, c->games[l]->solution, "sol");
+  }
+
+  c->states = sok_newstates();
+  if (c->states == NULL) {
+    sok_freefile(c->games, c->count);
+    return(-1);
+  }
+  return(0);
+}
+
+
+/*** solution_save() / solution_load() ***/
+
+static double run_solroundtrip(void *ctx) {
+  struct sokmovelist *sol;
+  int i;
+  for (i = 0; i < BENCH_ROUNDTRIPS; i++) {
+    solution_save(BENCH_ROUNDTRIPKEY + i, ctx, "sol");
+    sol = solution_load(BENCH_ROUNDTRIPKEY + i, "sol");
+    ml_free(sol);
+  }
+  return(BENCH_ROUNDTRIPS);
+}
+
+
+/*** draw_screen() ***/
+
+struct drawctx {
+  const struct sokgame *game;
+  struct sokgamestates *states;
+  struct spritesstruct *sprites;
+  SDL_Renderer *renderer;
+  SDL_Window *window;
+  struct videosettings settings;
+  int frame;
+};
+
+/* the player is drawn at a different place on every frame, as if moving */
+static double run_drawscreen(void *ctx) {
+  struct drawctx *c = ctx;
+  SDL_PumpEvents();
+  draw_screen(c->game, c->states, c->sprites, c->renderer, c->window, &(c->settings), c->frame % c->settings.tilesize, 0, 0, DRAWSCREEN_REFRESH, "benchmark");
+  c->frame++;
+  return(1);
+}
+
+static void bench_drawscreen(const char *skinname) {
+  static const unsigned short tilesizes[] = {16, 32, 48, 64, 0};
+  struct drawctx c;
+  struct sokgame *games[MAXLEVELS];
+  char comment[256], name[64];
+  int i, count, biggest = 0;
+
+  /* don't bother setting up the video if not needed */
+  for (i = 0; tilesizes[i] != 0; i++) {
+    sprintf(name, "draw_screen/%u", tilesizes[i]);
+    if (bench_selected(name)) break;
+  }
+  if (tilesizes[i] == 0) return;
+
+  if (CSDL_Init(SDL_INIT_VIDEO) != 0) {
+    bench_skip("draw_screen", "no video available");
+    return;
+  }
+  CSDL_LinearScalingHint();
+  memset(&c, 0, sizeof(c));
+  c.window = CSDL_CreateWindow("simplesok-bench", BENCH_WINW, BENCH_WINH, SDL_WINDOW_HIDDEN);
+  if (c.window != NULL) c.renderer = CSDL_CreateRenderer(c.window, WITH_SOFTWARE_RENDERER);
+  if (c.renderer != NULL) {
+    CSDL_SetRenderVSync(c.renderer, 0); /* measure drawing, not the display */
+    c.sprites = skin_load(skinname, c.renderer);
+  }
+  c.states = sok_newstates();
+  count = sok_loadfile(games, MAXLEVELS, NULL, levelsets[1].data, levelsets[1].len, comment, sizeof(comment));
+
+  if ((c.sprites == NULL) || (c.states == NULL) || (count < 1)) {
+    bench_skip("draw_screen", SDL_GetError());
+  } else {
+    /* the biggest level of sasquatch makes the most drawing */
+    for (i = 1; i < count; i++) {
+      if (games[i]->field_width * games[i]->field_height > games[biggest]->field_width * games[biggest]->field_height) biggest = i;
+    }
+    c.game = games[biggest];
+    for (i = 0; tilesizes[i] != 0; i++) {
+      sprintf(name, "draw_screen/%u", tilesizes[i]);
+      if (!bench_selected(name)) continue;
+      c.settings.tilesize = tilesizes[i];
+      c.frame = 0;
+      bench_run(name, "frames", run_drawscreen, &c);
+    }
+    draw_free();
+  }
+
+  if (count > 0) sok_freefile(games, count);
+  if (c.states != NULL) sok_freestates(c.states);
+  if (c.sprites != NULL) skin_free(c.sprites);
+  if (c.renderer != NULL) SDL_DestroyRenderer(c.renderer);
+  if (c.window != NULL) SDL_DestroyWindow(c.window);
+  SDL_Quit();
+}
+
+
+int main(int argc, char **argv) {
+  const char *dir = BENCH_DEFAULTDIR;
+  const char *skinname = NULL; /* the embedded skin, same everywhere */
+  char name[64];
+  int i;
+
+  filters = malloc(sizeof(char *) * (argc + 1));
+  if (filters == NULL) return(1);
+  for (i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--time=", 7) == 0) {
+      mintime = strtoul(argv[i] + 7, NULL, 10);
+    } else if (strncmp(argv[i], "--dir=", 6) == 0) {
+      dir = argv[i] + 6;
+    } else if (strncmp(argv[i], "--skin=", 7) == 0) {
+      skinname = argv[i] + 7;
+    } else if (argv[i][0] == '-') {
+      puts("usage: simplesok-bench [--time=ms] [--dir=path] [--skin=name] [filter]...");
+      puts("");
+      puts("runs the benchmarks whose name contains any filter (all by default),");
+      puts("each for at least ms milliseconds, and prints results as JSON lines.");
+      puts("solutions and caches are kept in path (default: " BENCH_DEFAULTDIR ").");
+      free(filters);
+      return(1);
+    } else {
+      filters[filterscount++] = argv[i];
+    }
+  }
+
+  /* keep the user's own solutions and caches out of this */
+  save_setroot(dir);
+
+  levelsets[0].len = assets_levels_microban_xsb_gz_len;
+  levelsets[1].len = assets_levels_sasquatch_xsb_gz_len;
+  levelsets[2].len = assets_levels_sasquatch3_xsb_gz_len;
+  levelsets[3].len = assets_levels_boxworld_xsb_gz_len;
+
+  printf("{\"suite\":\"simplesok-bench\",\"version\":\"%s\",\"mintime\":%lu}\n", PACKAGE_VERSION, mintime);
+
+  /* level sets loading */
+  for (i = 0; levelsets[i].name != NULL; i++) {
+    struct loadctx c;
+    sprintf(name, "loadfile/%s", levelsets[i].name);
+    if (!bench_selected(name)) continue;
+    c.set = &(levelsets[i]);
+    c.games = malloc(sizeof(struct sokgame *) * MAXLEVELS);
+    if (c.games == NULL) {
+      bench_skip(name, "out of memory");
+      continue;
+    }
+    bench_run(name, "levels", run_loadfile, &c);
+    free(c.games);
+  }
+
+  /* decompression */
+  for (i = 0; levelsets[i].name != NULL; i++) {
+    sprintf(name, "ungz/%s", levelsets[i].name);
+    if (!bench_selected(name)) continue;
+    if (!isGz(levelsets[i].data, levelsets[i].len)) {
+      bench_skip(name, "not gzipped");
+      continue;
+    }
+    bench_run(name, "bytes", run_ungz, &(levelsets[i]));
+  }
+
+  /* checksums, computed over pseudo-random but always identical data */
+  if (bench_selected("crc64")) {
+    unsigned char *buf = malloc(BENCH_CRCBUFLEN);
+    unsigned long seed = 1;
+    long l;
+    if (buf == NULL) {
+      bench_skip("crc64", "out of memory");
+    } else {
+      for (l = 0; l < BENCH_CRCBUFLEN; l++) {
+        seed = (seed * 1103515245ul + 12345ul) & 0xfffffffful;
+        buf[l] = (unsigned char)(seed >> 16);
+      }
+      bench_run("crc64", "bytes", run_crc64, buf);
+      free(buf);
+    }
+  }
+
+  /* moves and undos, replaying solutions */
+  if (bench_selected("move_undo")) {
+    struct replayctx *c = calloc(1, sizeof(struct replayctx));
+    if ((c == NULL) || (replay_prepare(c) != 0)) {
+      bench_skip("move_undo", "no solutions to replay");
+    } else {
+      bench_run("move_undo", "moves", run_moveundo, c);
+      sok_freestates(c->states);
+      sok_freefile(c->games, c->count);
+    }
+    free(c);
+  }
+
+  /* solutions storage */
+  if (bench_selected("solution_roundtrip")) {
+    struct sokmovelist *sol;
+    char moves[401];
+    for (i = 0; i < 400; i++) moves[i] = "uRdLUrDl"[i % 8];
+    moves[400] = 0;
+    sol = ml_fromstring(moves);
+    if (sol == NULL) {
+      bench_skip("solution_roundtrip", "out of memory");
+    } else {
+      bench_run("solution_roundtrip", "roundtrips", run_solroundtrip, sol);
+      ml_free(sol);
+    }
+  }
+
+  /* screen drawing */
+  bench_drawscreen(skinname);
+
+  save_flush();
+  free(filters);
+  return(0);
+}
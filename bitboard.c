@@ -0,0 +1,239 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>   /* malloc(), free() */
+#include <string.h>   /* memset() */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "sok_core.h"
+
+#include "bitboard.h" /* include self for control */
+
+
+struct sokbitboard *bb_new(const struct sokgame *game) {
+  struct sokbitboard *bb;
+  int x, y, rows;
+
+  if ((game->field_width > BB_MAXSIZE) || (game->field_height > BB_MAXSIZE)) return(NULL);
+  rows = BB_ROWS(game->field_height);
+  bb = malloc(sizeof(struct sokbitboard) + sizeof(uint64_t) * 3 * (size_t)rows);
+  if (bb == NULL) return(NULL);
+  bb->width = game->field_width;
+  bb->height = game->field_height;
+  bb->rows = rows;
+  bb->wall = (uint64_t *)(bb + 1);
+  bb->goal = bb->wall + rows;
+  bb->box = bb->goal + rows;
+
+  /* everything is a wall, until proven otherwise */
+  memset(bb->wall, 0xff, sizeof(uint64_t) * (size_t)rows);
+  memset(bb->goal, 0, sizeof(uint64_t) * (size_t)rows);
+  memset(bb->box, 0, sizeof(uint64_t) * (size_t)rows);
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      if ((SOK_FIELD(game, x, y) & field_floor) && ((SOK_FIELD(game, x, y) & field_wall) == 0)) BB_CLR(bb->wall, x, y);
+      if (SOK_FIELD(game, x, y) & field_goal) BB_SET(bb->goal, x, y);
+      if (SOK_FIELD(game, x, y) & field_atom) BB_SET(bb->box, x, y);
+    }
+  }
+  return(bb);
+}
+
+
+void bb_free(struct sokbitboard *bb) {
+  free(bb);
+}
+
+
+int bb_firstbit(uint64_t v) {
+#ifdef __GNUC__
+  return(__builtin_ctzll(v));
+#else
+  int res = 0;
+  while ((v & 1) == 0) {
+    v >>= 1;
+    res++;
+  }
+  return(res);
+#endif
+}
+
+
+/* spreads the seeds of a row both ways, as long as cells are free. this is
+ * a Kogge-Stone fill: 6 shift steps per direction cover any run length. */
+static uint64_t bb_fillrow(uint64_t seed, uint64_t free) {
+  uint64_t left = seed, right = seed, pl = free, pr = free;
+  left |= pl & (left << 1);
+  pl &= pl << 1;
+  right |= pr & (right >> 1);
+  pr &= pr >> 1;
+  left |= pl & (left << 2);
+  pl &= pl << 2;
+  right |= pr & (right >> 2);
+  pr &= pr >> 2;
+  left |= pl & (left << 4);
+  pl &= pl << 4;
+  right |= pr & (right >> 4);
+  pr &= pr >> 4;
+  left |= pl & (left << 8);
+  pl &= pl << 8;
+  right |= pr & (right >> 8);
+  pr &= pr >> 8;
+  left |= pl & (left << 16);
+  pl &= pl << 16;
+  right |= pr & (right >> 16);
+  pr &= pr >> 16;
+  left |= pl & (left << 32);
+  right |= pr & (right >> 32);
+  return(left | right);
+}
+
+
+/* lets row r take in what its neighbour rows reach. returns non-zero if the
+ * row changed */
+static int bb_growrow(uint64_t *reach, const uint64_t *free, int r) {
+  uint64_t n;
+  n = reach[r] | ((reach[r - 1] | reach[r + 1]) & free[r]);
+  if (n == reach[r]) return(0);
+  reach[r] = bb_fillrow(n, free[r]);
+  return(1);
+}
+
+
+void bb_reach(const struct sokbitboard *bb, const uint64_t *box, int x, int y, uint64_t *reach, int *normx, int *normy) {
+  uint64_t free[BB_MAXROWS];
+  int r, changed;
+
+  for (r = 0; r < bb->rows; r++) {
+    free[r] = ~(bb->wall[r] | box[r]);
+    reach[r] = 0;
+  }
+  reach[y + 1] = bb_fillrow(BB_BIT(x), free[y + 1]);
+
+  /* sweep down then up until nothing grows anymore, rows are updated in
+   * place so an open area is usually covered in a single round trip */
+  do {
+    changed = 0;
+    for (r = 1; r <= bb->height; r++) changed |= bb_growrow(reach, free, r);
+    for (r = bb->height; r >= 1; r--) changed |= bb_growrow(reach, free, r);
+  } while (changed);
+
+  for (r = 1; reach[r] == 0; r++);
+  *normx = bb_firstbit(reach[r]);
+  *normy = r - 1;
+}
+
+
+void bb_pushable(const struct sokbitboard *bb, const uint64_t *box, const uint64_t *reach, const uint64_t *dest, enum SOKMOVE dir, uint64_t *res) {
+  uint64_t target[BB_MAXROWS];
+  int r;
+
+  /* cells a box may be pushed to */
+  for (r = 0; r < bb->rows; r++) {
+    target[r] = ~(bb->wall[r] | box[r]);
+    if (dest != NULL) target[r] &= dest[r];
+  }
+  res[0] = 0;
+  res[bb->rows - 1] = 0;
+
+#ifdef __SSE2__
+  /* two rows at a time, the last pair may spill into the guard rows */
+  for (r = 1; r <= bb->height; r += 2) {
+    __m128i b, p, t;
+    b = _mm_loadu_si128((const __m128i *)(box + r));
+    switch (dir) {
+      case sokmoveRIGHT: /* player on x-1, box lands on x+1 */
+        p = _mm_slli_epi64(_mm_loadu_si128((const __m128i *)(reach + r)), 1);
+        t = _mm_srli_epi64(_mm_loadu_si128((const __m128i *)(target + r)), 1);
+        break;
+      case sokmoveLEFT:
+        p = _mm_srli_epi64(_mm_loadu_si128((const __m128i *)(reach + r)), 1);
+        t = _mm_slli_epi64(_mm_loadu_si128((const __m128i *)(target + r)), 1);
+        break;
+      case sokmoveUP: /* player on the row below, box lands on the row above */
+        p = _mm_loadu_si128((const __m128i *)(reach + r + 1));
+        t = _mm_loadu_si128((const __m128i *)(target + r - 1));
+        break;
+      case sokmoveDOWN:
+        p = _mm_loadu_si128((const __m128i *)(reach + r - 1));
+        t = _mm_loadu_si128((const __m128i *)(target + r + 1));
+        break;
+      default:
+        p = _mm_setzero_si128();
+        t = p;
+        break;
+    }
+    _mm_storeu_si128((__m128i *)(res + r), _mm_and_si128(b, _mm_and_si128(p, t)));
+  }
+  /* an odd height made the last pair write over the bottom guard row */
+  res[bb->height + 1] = 0;
+#else
+  for (r = 1; r <= bb->height; r++) {
+    switch (dir) {
+      case sokmoveRIGHT: /* player on x-1, box lands on x+1 */
+        res[r] = box[r] & (reach[r] << 1) & (target[r] >> 1);
+        break;
+      case sokmoveLEFT:
+        res[r] = box[r] & (reach[r] >> 1) & (target[r] << 1);
+        break;
+      case sokmoveUP: /* player on the row below, box lands on the row above */
+        res[r] = box[r] & reach[r + 1] & target[r - 1];
+        break;
+      case sokmoveDOWN:
+        res[r] = box[r] & reach[r - 1] & target[r + 1];
+        break;
+      default:
+        res[r] = 0;
+        break;
+    }
+  }
+#endif
+}
+
+
+int bb_issolved(const struct sokbitboard *bb, const uint64_t *box) {
+  int r;
+#ifdef __SSE2__
+  __m128i left = _mm_setzero_si128();
+  uint64_t tmp[2];
+  /* guard rows hold no goals, so pairs may overlap them */
+  for (r = 1; r <= bb->height; r += 2) {
+    __m128i g = _mm_loadu_si128((const __m128i *)(bb->goal + r));
+    __m128i b = _mm_loadu_si128((const __m128i *)(box + r));
+    left = _mm_or_si128(left, _mm_andnot_si128(b, g));
+  }
+  _mm_storeu_si128((__m128i *)tmp, left);
+  return((tmp[0] | tmp[1]) == 0);
+#else
+  uint64_t left = 0;
+  for (r = 1; r <= bb->height; r++) left |= bb->goal[r] & ~box[r];
+  return(left == 0);
+#endif
+}
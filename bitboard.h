@@ -0,0 +1,79 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef bitboard_h_sentinel
+#define bitboard_h_sentinel
+
+  #include <stdint.h>
+
+  #include "sok_core.h"
+
+  /* bitsets are row-major, with one 64-bit word per row (so only levels of
+   * up to BB_MAXSIZE x BB_MAXSIZE cells get a bitboard): cell (x,y) is bit x
+   * of word y+1. word 0 and words past the last row are guard rows, so
+   * neighbours of any cell of the level can be looked at without bound
+   * checks. */
+  #define BB_MAXSIZE 62
+  #define BB_ROWS(height) ((height) + 3)
+  #define BB_MAXROWS BB_ROWS(BB_MAXSIZE)
+  #define BB_BIT(x) (((uint64_t)1) << (x))
+  #define BB_TEST(set, x, y) (((set)[(y) + 1] >> (x)) & 1)
+  #define BB_SET(set, x, y) ((set)[(y) + 1] |= BB_BIT(x))
+  #define BB_CLR(set, x, y) ((set)[(y) + 1] &= ~BB_BIT(x))
+
+  struct sokbitboard {
+    unsigned short width;
+    unsigned short height;
+    int rows;        /* number of words in each bitset, guard rows included */
+    uint64_t *wall;  /* walls, cells outside of the level and guard rows */
+    uint64_t *goal;
+    uint64_t *box;   /* boxes, as in the level's initial position */
+  };
+
+  /* builds the bitboard of game. returns NULL on out of memory, or if game is
+   * wider or higher than BB_MAXSIZE */
+  struct sokbitboard *bb_new(const struct sokgame *game);
+
+  void bb_free(struct sokbitboard *bb);
+
+  /* computes in reach (bb->rows words) all cells the player can walk to
+   * from (x,y) when boxes are at box. the top-left-most reachable cell, that
+   * identifies the area regardless of where the player stands in it, is
+   * returned in (*normx, *normy). */
+  void bb_reach(const struct sokbitboard *bb, const uint64_t *box, int x, int y, uint64_t *reach, int *normx, int *normy);
+
+  /* computes in res (bb->rows words) the boxes that can be pushed in
+   * direction dir, given the area reach of the player. with dest set, only
+   * pushes that end on a cell of dest are kept. */
+  void bb_pushable(const struct sokbitboard *bb, const uint64_t *box, const uint64_t *reach, const uint64_t *dest, enum SOKMOVE dir, uint64_t *res);
+
+  /* returns non-zero if every goal has a box on it */
+  int bb_issolved(const struct sokbitboard *bb, const uint64_t *box);
+
+  /* returns the index of the lowest set bit of v (v must not be 0) */
+  int bb_firstbit(uint64_t v);
+
+#endif
@@ -52,6 +52,8 @@
 
 #define CSDL_CreateRenderer(window, soft)				\
 	SDL_CreateRenderer((window), -1, (soft)? SDL_RENDERER_SOFTWARE: 0)
+#define CSDL_SetRenderVSync(renderer, v)				\
+	SDL_RenderSetVSync((renderer), (v))
 #define CSDL_RenderFillRect(renderer, rect)				\
 	SDL_RenderFillRect((renderer), (rect))
 #define CSDL_RenderRect(renderer, rect)					\
@@ -64,8 +66,15 @@ typedef SDL_RWops	CSDL_IOStream;
 #define CIMG_LoadTexture_IO(renderer, stream, closeio)			\
 	IMG_LoadTexture_RW((renderer), (stream), (closeio))
 #define CSDL_LoadBMP_IO(src, closeio)	SDL_LoadBMP_RW((src), (closeio))
+#define CIMG_Load_IO(stream, closeio)	IMG_Load_RW((stream), (closeio))
+#define CIMG_SavePNG(s, file)	IMG_SavePNG((s), (file))
 #define CSDL_CloseIO(stream)	SDL_FreeRW(stream)
 
+#define CSDL_CreateSurface(w, h, format)				\
+	SDL_CreateRGBSurfaceWithFormat(0, (w), (h), 32, (format))
+#define CSDL_ConvertSurface(s, format)					\
+	SDL_ConvertSurfaceFormat((s), (format), 0)
+
 #define CSDL_QueryTexture(t, f, a, w, h)				\
 	SDL_QueryTexture((t), (f), (a), (w), (h))
 
@@ -103,6 +112,7 @@ typedef SDL_RWops	CSDL_IOStream;
 
 #define CSDL_KMOD_CTRL		KMOD_CTRL
 #define CSDL_KMOD_ALT		KMOD_ALT
+#define CSDL_KMOD_SHIFT		KMOD_SHIFT
 #define CSDL_K_C		SDLK_c
 #define CSDL_K_R		SDLK_r
 #define CSDL_K_S		SDLK_s
@@ -112,7 +122,26 @@ typedef SDL_RWops	CSDL_IOStream;
 #define CSDL_EVENT_KEY_UP	SDL_KEYUP
 #define CSDL_EVENT_KEY_DOWN	SDL_KEYDOWN
 #define CSDL_EVENT_DROP_FILE	SDL_DROPFILE
+#define CSDL_EVENT_RENDER_TARGETS_RESET	SDL_RENDER_TARGETS_RESET
 #define CSDL_EVENT_MOUSE_MOTION	SDL_MOUSEMOTION
+#define CSDL_EVENT_MOUSE_BUTTON_DOWN	SDL_MOUSEBUTTONDOWN
+#define CSDL_EVENT_MOUSE_BUTTON_UP	SDL_MOUSEBUTTONUP
+
+#define CSDL_BUTTON_X(b)	((b).x)
+#define CSDL_BUTTON_Y(b)	((b).y)
+
+typedef SDL_mutex	CSDL_Mutex;
+typedef SDL_cond	CSDL_Cond;
+#define CSDL_CreateCond()	SDL_CreateCond()
+#define CSDL_DestroyCond(c)	SDL_DestroyCond(c)
+#define CSDL_CondSignal(c)	SDL_CondSignal(c)
+#define CSDL_CondWait(c, m)	SDL_CondWait((c), (m))
+typedef SDL_atomic_t	CSDL_AtomicInt;
+#define CSDL_AtomicAdd(a, v)	SDL_AtomicAdd((a), (v))
+#define CSDL_AtomicGet(a)	SDL_AtomicGet(a)
+#define CSDL_AtomicSet(a, v)	SDL_AtomicSet((a), (v))
+#define CSDL_GetCPUCount()	SDL_GetCPUCount()
+#define CSDL_ThreadID()		SDL_ThreadID()
 
 #else
 
@@ -127,6 +156,8 @@ typedef SDL_RWops	CSDL_IOStream;
 
 #define CSDL_CreateRenderer(window, soft)				\
 	SDL_CreateRenderer((window), (soft)? SDL_SOFTWARE_RENDERER: NULL)
+#define CSDL_SetRenderVSync(renderer, v)				\
+	(SDL_SetRenderVSync((renderer), (v))? 0: -1)
 extern int CSDL_RenderFillRect(SDL_Renderer *renderer, const SDL_Rect *rect);
 extern int CSDL_RenderRect(SDL_Renderer *renderer, const SDL_Rect *rect);
 #define CSDL_RenderLine(renderer, x1, y1, x2, y2)			\
@@ -137,8 +168,13 @@ typedef SDL_IOStream	CSDL_IOStream;
 #define CSDL_LoadBMP_IO(src, closeio)	SDL_LoadBMP_IO((src), (closeio))
 #define CIMG_LoadTexture_IO(renderer, stream, closeio)			\
 	IMG_LoadTexture_IO((renderer), (stream), (closeio))
+#define CIMG_Load_IO(stream, closeio)	IMG_Load_IO((stream), (closeio))
+#define CIMG_SavePNG(s, file)	(IMG_SavePNG((s), (file))? 0: -1)
 #define CSDL_CloseIO(stream)	SDL_CloseIO(stream)
 
+#define CSDL_CreateSurface(w, h, format)	SDL_CreateSurface((w), (h), (format))
+#define CSDL_ConvertSurface(s, format)	SDL_ConvertSurface((s), (format))
+
 extern int CSDL_QueryTexture(SDL_Texture *texture, Uint32 *format, int *access,
 			     int *w, int *h);
 extern int CSDL_RenderTexture(SDL_Renderer *renderer, SDL_Texture *texture, \
@@ -173,6 +209,7 @@ extern int CSDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
 
 #define CSDL_KMOD_CTRL		SDL_KMOD_CTRL
 #define CSDL_KMOD_ALT		SDL_KMOD_ALT
+#define CSDL_KMOD_SHIFT		SDL_KMOD_SHIFT
 #define CSDL_K_C		SDLK_C
 #define CSDL_K_R		SDLK_R
 #define CSDL_K_S		SDLK_S
@@ -182,7 +219,27 @@ extern int CSDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
 #define CSDL_EVENT_KEY_UP	SDL_EVENT_KEY_UP
 #define CSDL_EVENT_KEY_DOWN	SDL_EVENT_KEY_DOWN
 #define CSDL_EVENT_DROP_FILE	SDL_EVENT_DROP_FILE
+#define CSDL_EVENT_RENDER_TARGETS_RESET	SDL_EVENT_RENDER_TARGETS_RESET
 #define CSDL_EVENT_MOUSE_MOTION	SDL_EVENT_MOUSE_MOTION
+#define CSDL_EVENT_MOUSE_BUTTON_DOWN	SDL_EVENT_MOUSE_BUTTON_DOWN
+#define CSDL_EVENT_MOUSE_BUTTON_UP	SDL_EVENT_MOUSE_BUTTON_UP
+
+/* SDL3 reports mouse positions as floats. */
+#define CSDL_BUTTON_X(b)	((int) (b).x)
+#define CSDL_BUTTON_Y(b)	((int) (b).y)
+
+typedef SDL_Mutex	CSDL_Mutex;
+typedef SDL_Condition	CSDL_Cond;
+#define CSDL_CreateCond()	SDL_CreateCondition()
+#define CSDL_DestroyCond(c)	SDL_DestroyCondition(c)
+#define CSDL_CondSignal(c)	SDL_SignalCondition(c)
+#define CSDL_CondWait(c, m)	SDL_WaitCondition((c), (m))
+typedef SDL_AtomicInt	CSDL_AtomicInt;
+#define CSDL_AtomicAdd(a, v)	SDL_AddAtomicInt((a), (v))
+#define CSDL_AtomicGet(a)	SDL_GetAtomicInt(a)
+#define CSDL_AtomicSet(a, v)	SDL_SetAtomicInt((a), (v))
+#define CSDL_GetCPUCount()	SDL_GetNumLogicalCPUCores()
+#define CSDL_ThreadID()		SDL_GetCurrentThreadID()
 
 #endif
 
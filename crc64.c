@@ -1,145 +1,1066 @@
 #include <stdint.h>
 
-static const uint64_t crc64_tab[256] = {
-  UINT64_C(0x0000000000000000), UINT64_C(0x7ad870c830358979),
-  UINT64_C(0xf5b0e190606b12f2), UINT64_C(0x8f689158505e9b8b),
-  UINT64_C(0xc038e5739841b68f), UINT64_C(0xbae095bba8743ff6),
-  UINT64_C(0x358804e3f82aa47d), UINT64_C(0x4f50742bc81f2d04),
-  UINT64_C(0xab28ecb46814fe75), UINT64_C(0xd1f09c7c5821770c),
-  UINT64_C(0x5e980d24087fec87), UINT64_C(0x24407dec384a65fe),
-  UINT64_C(0x6b1009c7f05548fa), UINT64_C(0x11c8790fc060c183),
-  UINT64_C(0x9ea0e857903e5a08), UINT64_C(0xe478989fa00bd371),
-  UINT64_C(0x7d08ff3b88be6f81), UINT64_C(0x07d08ff3b88be6f8),
-  UINT64_C(0x88b81eabe8d57d73), UINT64_C(0xf2606e63d8e0f40a),
-  UINT64_C(0xbd301a4810ffd90e), UINT64_C(0xc7e86a8020ca5077),
-  UINT64_C(0x4880fbd87094cbfc), UINT64_C(0x32588b1040a14285),
-  UINT64_C(0xd620138fe0aa91f4), UINT64_C(0xacf86347d09f188d),
-  UINT64_C(0x2390f21f80c18306), UINT64_C(0x594882d7b0f40a7f),
-  UINT64_C(0x1618f6fc78eb277b), UINT64_C(0x6cc0863448deae02),
-  UINT64_C(0xe3a8176c18803589), UINT64_C(0x997067a428b5bcf0),
-  UINT64_C(0xfa11fe77117cdf02), UINT64_C(0x80c98ebf2149567b),
-  UINT64_C(0x0fa11fe77117cdf0), UINT64_C(0x75796f2f41224489),
-  UINT64_C(0x3a291b04893d698d), UINT64_C(0x40f16bccb908e0f4),
-  UINT64_C(0xcf99fa94e9567b7f), UINT64_C(0xb5418a5cd963f206),
-  UINT64_C(0x513912c379682177), UINT64_C(0x2be1620b495da80e),
-  UINT64_C(0xa489f35319033385), UINT64_C(0xde51839b2936bafc),
-  UINT64_C(0x9101f7b0e12997f8), UINT64_C(0xebd98778d11c1e81),
-  UINT64_C(0x64b116208142850a), UINT64_C(0x1e6966e8b1770c73),
-  UINT64_C(0x8719014c99c2b083), UINT64_C(0xfdc17184a9f739fa),
-  UINT64_C(0x72a9e0dcf9a9a271), UINT64_C(0x08719014c99c2b08),
-  UINT64_C(0x4721e43f0183060c), UINT64_C(0x3df994f731b68f75),
-  UINT64_C(0xb29105af61e814fe), UINT64_C(0xc849756751dd9d87),
-  UINT64_C(0x2c31edf8f1d64ef6), UINT64_C(0x56e99d30c1e3c78f),
-  UINT64_C(0xd9810c6891bd5c04), UINT64_C(0xa3597ca0a188d57d),
-  UINT64_C(0xec09088b6997f879), UINT64_C(0x96d1784359a27100),
-  UINT64_C(0x19b9e91b09fcea8b), UINT64_C(0x636199d339c963f2),
-  UINT64_C(0xdf7adabd7a6e2d6f), UINT64_C(0xa5a2aa754a5ba416),
-  UINT64_C(0x2aca3b2d1a053f9d), UINT64_C(0x50124be52a30b6e4),
-  UINT64_C(0x1f423fcee22f9be0), UINT64_C(0x659a4f06d21a1299),
-  UINT64_C(0xeaf2de5e82448912), UINT64_C(0x902aae96b271006b),
-  UINT64_C(0x74523609127ad31a), UINT64_C(0x0e8a46c1224f5a63),
-  UINT64_C(0x81e2d7997211c1e8), UINT64_C(0xfb3aa75142244891),
-  UINT64_C(0xb46ad37a8a3b6595), UINT64_C(0xceb2a3b2ba0eecec),
-  UINT64_C(0x41da32eaea507767), UINT64_C(0x3b024222da65fe1e),
-  UINT64_C(0xa2722586f2d042ee), UINT64_C(0xd8aa554ec2e5cb97),
-  UINT64_C(0x57c2c41692bb501c), UINT64_C(0x2d1ab4dea28ed965),
-  UINT64_C(0x624ac0f56a91f461), UINT64_C(0x1892b03d5aa47d18),
-  UINT64_C(0x97fa21650afae693), UINT64_C(0xed2251ad3acf6fea),
-  UINT64_C(0x095ac9329ac4bc9b), UINT64_C(0x7382b9faaaf135e2),
-  UINT64_C(0xfcea28a2faafae69), UINT64_C(0x8632586aca9a2710),
-  UINT64_C(0xc9622c4102850a14), UINT64_C(0xb3ba5c8932b0836d),
-  UINT64_C(0x3cd2cdd162ee18e6), UINT64_C(0x460abd1952db919f),
-  UINT64_C(0x256b24ca6b12f26d), UINT64_C(0x5fb354025b277b14),
-  UINT64_C(0xd0dbc55a0b79e09f), UINT64_C(0xaa03b5923b4c69e6),
-  UINT64_C(0xe553c1b9f35344e2), UINT64_C(0x9f8bb171c366cd9b),
-  UINT64_C(0x10e3202993385610), UINT64_C(0x6a3b50e1a30ddf69),
-  UINT64_C(0x8e43c87e03060c18), UINT64_C(0xf49bb8b633338561),
-  UINT64_C(0x7bf329ee636d1eea), UINT64_C(0x012b592653589793),
-  UINT64_C(0x4e7b2d0d9b47ba97), UINT64_C(0x34a35dc5ab7233ee),
-  UINT64_C(0xbbcbcc9dfb2ca865), UINT64_C(0xc113bc55cb19211c),
-  UINT64_C(0x5863dbf1e3ac9dec), UINT64_C(0x22bbab39d3991495),
-  UINT64_C(0xadd33a6183c78f1e), UINT64_C(0xd70b4aa9b3f20667),
-  UINT64_C(0x985b3e827bed2b63), UINT64_C(0xe2834e4a4bd8a21a),
-  UINT64_C(0x6debdf121b863991), UINT64_C(0x1733afda2bb3b0e8),
-  UINT64_C(0xf34b37458bb86399), UINT64_C(0x8993478dbb8deae0),
-  UINT64_C(0x06fbd6d5ebd3716b), UINT64_C(0x7c23a61ddbe6f812),
-  UINT64_C(0x3373d23613f9d516), UINT64_C(0x49aba2fe23cc5c6f),
-  UINT64_C(0xc6c333a67392c7e4), UINT64_C(0xbc1b436e43a74e9d),
-  UINT64_C(0x95ac9329ac4bc9b5), UINT64_C(0xef74e3e19c7e40cc),
-  UINT64_C(0x601c72b9cc20db47), UINT64_C(0x1ac40271fc15523e),
-  UINT64_C(0x5594765a340a7f3a), UINT64_C(0x2f4c0692043ff643),
-  UINT64_C(0xa02497ca54616dc8), UINT64_C(0xdafce7026454e4b1),
-  UINT64_C(0x3e847f9dc45f37c0), UINT64_C(0x445c0f55f46abeb9),
-  UINT64_C(0xcb349e0da4342532), UINT64_C(0xb1eceec59401ac4b),
-  UINT64_C(0xfebc9aee5c1e814f), UINT64_C(0x8464ea266c2b0836),
-  UINT64_C(0x0b0c7b7e3c7593bd), UINT64_C(0x71d40bb60c401ac4),
-  UINT64_C(0xe8a46c1224f5a634), UINT64_C(0x927c1cda14c02f4d),
-  UINT64_C(0x1d148d82449eb4c6), UINT64_C(0x67ccfd4a74ab3dbf),
-  UINT64_C(0x289c8961bcb410bb), UINT64_C(0x5244f9a98c8199c2),
-  UINT64_C(0xdd2c68f1dcdf0249), UINT64_C(0xa7f41839ecea8b30),
-  UINT64_C(0x438c80a64ce15841), UINT64_C(0x3954f06e7cd4d138),
-  UINT64_C(0xb63c61362c8a4ab3), UINT64_C(0xcce411fe1cbfc3ca),
-  UINT64_C(0x83b465d5d4a0eece), UINT64_C(0xf96c151de49567b7),
-  UINT64_C(0x76048445b4cbfc3c), UINT64_C(0x0cdcf48d84fe7545),
-  UINT64_C(0x6fbd6d5ebd3716b7), UINT64_C(0x15651d968d029fce),
-  UINT64_C(0x9a0d8ccedd5c0445), UINT64_C(0xe0d5fc06ed698d3c),
-  UINT64_C(0xaf85882d2576a038), UINT64_C(0xd55df8e515432941),
-  UINT64_C(0x5a3569bd451db2ca), UINT64_C(0x20ed197575283bb3),
-  UINT64_C(0xc49581ead523e8c2), UINT64_C(0xbe4df122e51661bb),
-  UINT64_C(0x3125607ab548fa30), UINT64_C(0x4bfd10b2857d7349),
-  UINT64_C(0x04ad64994d625e4d), UINT64_C(0x7e7514517d57d734),
-  UINT64_C(0xf11d85092d094cbf), UINT64_C(0x8bc5f5c11d3cc5c6),
-  UINT64_C(0x12b5926535897936), UINT64_C(0x686de2ad05bcf04f),
-  UINT64_C(0xe70573f555e26bc4), UINT64_C(0x9ddd033d65d7e2bd),
-  UINT64_C(0xd28d7716adc8cfb9), UINT64_C(0xa85507de9dfd46c0),
-  UINT64_C(0x273d9686cda3dd4b), UINT64_C(0x5de5e64efd965432),
-  UINT64_C(0xb99d7ed15d9d8743), UINT64_C(0xc3450e196da80e3a),
-  UINT64_C(0x4c2d9f413df695b1), UINT64_C(0x36f5ef890dc31cc8),
-  UINT64_C(0x79a59ba2c5dc31cc), UINT64_C(0x037deb6af5e9b8b5),
-  UINT64_C(0x8c157a32a5b7233e), UINT64_C(0xf6cd0afa9582aa47),
-  UINT64_C(0x4ad64994d625e4da), UINT64_C(0x300e395ce6106da3),
-  UINT64_C(0xbf66a804b64ef628), UINT64_C(0xc5bed8cc867b7f51),
-  UINT64_C(0x8aeeace74e645255), UINT64_C(0xf036dc2f7e51db2c),
-  UINT64_C(0x7f5e4d772e0f40a7), UINT64_C(0x05863dbf1e3ac9de),
-  UINT64_C(0xe1fea520be311aaf), UINT64_C(0x9b26d5e88e0493d6),
-  UINT64_C(0x144e44b0de5a085d), UINT64_C(0x6e963478ee6f8124),
-  UINT64_C(0x21c640532670ac20), UINT64_C(0x5b1e309b16452559),
-  UINT64_C(0xd476a1c3461bbed2), UINT64_C(0xaeaed10b762e37ab),
-  UINT64_C(0x37deb6af5e9b8b5b), UINT64_C(0x4d06c6676eae0222),
-  UINT64_C(0xc26e573f3ef099a9), UINT64_C(0xb8b627f70ec510d0),
-  UINT64_C(0xf7e653dcc6da3dd4), UINT64_C(0x8d3e2314f6efb4ad),
-  UINT64_C(0x0256b24ca6b12f26), UINT64_C(0x788ec2849684a65f),
-  UINT64_C(0x9cf65a1b368f752e), UINT64_C(0xe62e2ad306bafc57),
-  UINT64_C(0x6946bb8b56e467dc), UINT64_C(0x139ecb4366d1eea5),
-  UINT64_C(0x5ccebf68aecec3a1), UINT64_C(0x2616cfa09efb4ad8),
-  UINT64_C(0xa97e5ef8cea5d153), UINT64_C(0xd3a62e30fe90582a),
-  UINT64_C(0xb0c7b7e3c7593bd8), UINT64_C(0xca1fc72bf76cb2a1),
-  UINT64_C(0x45775673a732292a), UINT64_C(0x3faf26bb9707a053),
-  UINT64_C(0x70ff52905f188d57), UINT64_C(0x0a2722586f2d042e),
-  UINT64_C(0x854fb3003f739fa5), UINT64_C(0xff97c3c80f4616dc),
-  UINT64_C(0x1bef5b57af4dc5ad), UINT64_C(0x61372b9f9f784cd4),
-  UINT64_C(0xee5fbac7cf26d75f), UINT64_C(0x9487ca0fff135e26),
-  UINT64_C(0xdbd7be24370c7322), UINT64_C(0xa10fceec0739fa5b),
-  UINT64_C(0x2e675fb4576761d0), UINT64_C(0x54bf2f7c6752e8a9),
-  UINT64_C(0xcdcf48d84fe75459), UINT64_C(0xb71738107fd2dd20),
-  UINT64_C(0x387fa9482f8c46ab), UINT64_C(0x42a7d9801fb9cfd2),
-  UINT64_C(0x0df7adabd7a6e2d6), UINT64_C(0x772fdd63e7936baf),
-  UINT64_C(0xf8474c3bb7cdf024), UINT64_C(0x829f3cf387f8795d),
-  UINT64_C(0x66e7a46c27f3aa2c), UINT64_C(0x1c3fd4a417c62355),
-  UINT64_C(0x935745fc4798b8de), UINT64_C(0xe98f353477ad31a7),
-  UINT64_C(0xa6df411fbfb21ca3), UINT64_C(0xdc0731d78f8795da),
-  UINT64_C(0x536fa08fdfd90e51), UINT64_C(0x29b7d047efec8728),
+/* slicing-by-8 tables: crc64_tab[0] is the classic byte-at-a-time table,
+ * and crc64_tab[k][b] is the CRC of byte b followed by k zero bytes. */
+static const uint64_t crc64_tab[8][256] = {
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0x7ad870c830358979),
+    UINT64_C(0xf5b0e190606b12f2), UINT64_C(0x8f689158505e9b8b),
+    UINT64_C(0xc038e5739841b68f), UINT64_C(0xbae095bba8743ff6),
+    UINT64_C(0x358804e3f82aa47d), UINT64_C(0x4f50742bc81f2d04),
+    UINT64_C(0xab28ecb46814fe75), UINT64_C(0xd1f09c7c5821770c),
+    UINT64_C(0x5e980d24087fec87), UINT64_C(0x24407dec384a65fe),
+    UINT64_C(0x6b1009c7f05548fa), UINT64_C(0x11c8790fc060c183),
+    UINT64_C(0x9ea0e857903e5a08), UINT64_C(0xe478989fa00bd371),
+    UINT64_C(0x7d08ff3b88be6f81), UINT64_C(0x07d08ff3b88be6f8),
+    UINT64_C(0x88b81eabe8d57d73), UINT64_C(0xf2606e63d8e0f40a),
+    UINT64_C(0xbd301a4810ffd90e), UINT64_C(0xc7e86a8020ca5077),
+    UINT64_C(0x4880fbd87094cbfc), UINT64_C(0x32588b1040a14285),
+    UINT64_C(0xd620138fe0aa91f4), UINT64_C(0xacf86347d09f188d),
+    UINT64_C(0x2390f21f80c18306), UINT64_C(0x594882d7b0f40a7f),
+    UINT64_C(0x1618f6fc78eb277b), UINT64_C(0x6cc0863448deae02),
+    UINT64_C(0xe3a8176c18803589), UINT64_C(0x997067a428b5bcf0),
+    UINT64_C(0xfa11fe77117cdf02), UINT64_C(0x80c98ebf2149567b),
+    UINT64_C(0x0fa11fe77117cdf0), UINT64_C(0x75796f2f41224489),
+    UINT64_C(0x3a291b04893d698d), UINT64_C(0x40f16bccb908e0f4),
+    UINT64_C(0xcf99fa94e9567b7f), UINT64_C(0xb5418a5cd963f206),
+    UINT64_C(0x513912c379682177), UINT64_C(0x2be1620b495da80e),
+    UINT64_C(0xa489f35319033385), UINT64_C(0xde51839b2936bafc),
+    UINT64_C(0x9101f7b0e12997f8), UINT64_C(0xebd98778d11c1e81),
+    UINT64_C(0x64b116208142850a), UINT64_C(0x1e6966e8b1770c73),
+    UINT64_C(0x8719014c99c2b083), UINT64_C(0xfdc17184a9f739fa),
+    UINT64_C(0x72a9e0dcf9a9a271), UINT64_C(0x08719014c99c2b08),
+    UINT64_C(0x4721e43f0183060c), UINT64_C(0x3df994f731b68f75),
+    UINT64_C(0xb29105af61e814fe), UINT64_C(0xc849756751dd9d87),
+    UINT64_C(0x2c31edf8f1d64ef6), UINT64_C(0x56e99d30c1e3c78f),
+    UINT64_C(0xd9810c6891bd5c04), UINT64_C(0xa3597ca0a188d57d),
+    UINT64_C(0xec09088b6997f879), UINT64_C(0x96d1784359a27100),
+    UINT64_C(0x19b9e91b09fcea8b), UINT64_C(0x636199d339c963f2),
+    UINT64_C(0xdf7adabd7a6e2d6f), UINT64_C(0xa5a2aa754a5ba416),
+    UINT64_C(0x2aca3b2d1a053f9d), UINT64_C(0x50124be52a30b6e4),
+    UINT64_C(0x1f423fcee22f9be0), UINT64_C(0x659a4f06d21a1299),
+    UINT64_C(0xeaf2de5e82448912), UINT64_C(0x902aae96b271006b),
+    UINT64_C(0x74523609127ad31a), UINT64_C(0x0e8a46c1224f5a63),
+    UINT64_C(0x81e2d7997211c1e8), UINT64_C(0xfb3aa75142244891),
+    UINT64_C(0xb46ad37a8a3b6595), UINT64_C(0xceb2a3b2ba0eecec),
+    UINT64_C(0x41da32eaea507767), UINT64_C(0x3b024222da65fe1e),
+    UINT64_C(0xa2722586f2d042ee), UINT64_C(0xd8aa554ec2e5cb97),
+    UINT64_C(0x57c2c41692bb501c), UINT64_C(0x2d1ab4dea28ed965),
+    UINT64_C(0x624ac0f56a91f461), UINT64_C(0x1892b03d5aa47d18),
+    UINT64_C(0x97fa21650afae693), UINT64_C(0xed2251ad3acf6fea),
+    UINT64_C(0x095ac9329ac4bc9b), UINT64_C(0x7382b9faaaf135e2),
+    UINT64_C(0xfcea28a2faafae69), UINT64_C(0x8632586aca9a2710),
+    UINT64_C(0xc9622c4102850a14), UINT64_C(0xb3ba5c8932b0836d),
+    UINT64_C(0x3cd2cdd162ee18e6), UINT64_C(0x460abd1952db919f),
+    UINT64_C(0x256b24ca6b12f26d), UINT64_C(0x5fb354025b277b14),
+    UINT64_C(0xd0dbc55a0b79e09f), UINT64_C(0xaa03b5923b4c69e6),
+    UINT64_C(0xe553c1b9f35344e2), UINT64_C(0x9f8bb171c366cd9b),
+    UINT64_C(0x10e3202993385610), UINT64_C(0x6a3b50e1a30ddf69),
+    UINT64_C(0x8e43c87e03060c18), UINT64_C(0xf49bb8b633338561),
+    UINT64_C(0x7bf329ee636d1eea), UINT64_C(0x012b592653589793),
+    UINT64_C(0x4e7b2d0d9b47ba97), UINT64_C(0x34a35dc5ab7233ee),
+    UINT64_C(0xbbcbcc9dfb2ca865), UINT64_C(0xc113bc55cb19211c),
+    UINT64_C(0x5863dbf1e3ac9dec), UINT64_C(0x22bbab39d3991495),
+    UINT64_C(0xadd33a6183c78f1e), UINT64_C(0xd70b4aa9b3f20667),
+    UINT64_C(0x985b3e827bed2b63), UINT64_C(0xe2834e4a4bd8a21a),
+    UINT64_C(0x6debdf121b863991), UINT64_C(0x1733afda2bb3b0e8),
+    UINT64_C(0xf34b37458bb86399), UINT64_C(0x8993478dbb8deae0),
+    UINT64_C(0x06fbd6d5ebd3716b), UINT64_C(0x7c23a61ddbe6f812),
+    UINT64_C(0x3373d23613f9d516), UINT64_C(0x49aba2fe23cc5c6f),
+    UINT64_C(0xc6c333a67392c7e4), UINT64_C(0xbc1b436e43a74e9d),
+    UINT64_C(0x95ac9329ac4bc9b5), UINT64_C(0xef74e3e19c7e40cc),
+    UINT64_C(0x601c72b9cc20db47), UINT64_C(0x1ac40271fc15523e),
+    UINT64_C(0x5594765a340a7f3a), UINT64_C(0x2f4c0692043ff643),
+    UINT64_C(0xa02497ca54616dc8), UINT64_C(0xdafce7026454e4b1),
+    UINT64_C(0x3e847f9dc45f37c0), UINT64_C(0x445c0f55f46abeb9),
+    UINT64_C(0xcb349e0da4342532), UINT64_C(0xb1eceec59401ac4b),
+    UINT64_C(0xfebc9aee5c1e814f), UINT64_C(0x8464ea266c2b0836),
+    UINT64_C(0x0b0c7b7e3c7593bd), UINT64_C(0x71d40bb60c401ac4),
+    UINT64_C(0xe8a46c1224f5a634), UINT64_C(0x927c1cda14c02f4d),
+    UINT64_C(0x1d148d82449eb4c6), UINT64_C(0x67ccfd4a74ab3dbf),
+    UINT64_C(0x289c8961bcb410bb), UINT64_C(0x5244f9a98c8199c2),
+    UINT64_C(0xdd2c68f1dcdf0249), UINT64_C(0xa7f41839ecea8b30),
+    UINT64_C(0x438c80a64ce15841), UINT64_C(0x3954f06e7cd4d138),
+    UINT64_C(0xb63c61362c8a4ab3), UINT64_C(0xcce411fe1cbfc3ca),
+    UINT64_C(0x83b465d5d4a0eece), UINT64_C(0xf96c151de49567b7),
+    UINT64_C(0x76048445b4cbfc3c), UINT64_C(0x0cdcf48d84fe7545),
+    UINT64_C(0x6fbd6d5ebd3716b7), UINT64_C(0x15651d968d029fce),
+    UINT64_C(0x9a0d8ccedd5c0445), UINT64_C(0xe0d5fc06ed698d3c),
+    UINT64_C(0xaf85882d2576a038), UINT64_C(0xd55df8e515432941),
+    UINT64_C(0x5a3569bd451db2ca), UINT64_C(0x20ed197575283bb3),
+    UINT64_C(0xc49581ead523e8c2), UINT64_C(0xbe4df122e51661bb),
+    UINT64_C(0x3125607ab548fa30), UINT64_C(0x4bfd10b2857d7349),
+    UINT64_C(0x04ad64994d625e4d), UINT64_C(0x7e7514517d57d734),
+    UINT64_C(0xf11d85092d094cbf), UINT64_C(0x8bc5f5c11d3cc5c6),
+    UINT64_C(0x12b5926535897936), UINT64_C(0x686de2ad05bcf04f),
+    UINT64_C(0xe70573f555e26bc4), UINT64_C(0x9ddd033d65d7e2bd),
+    UINT64_C(0xd28d7716adc8cfb9), UINT64_C(0xa85507de9dfd46c0),
+    UINT64_C(0x273d9686cda3dd4b), UINT64_C(0x5de5e64efd965432),
+    UINT64_C(0xb99d7ed15d9d8743), UINT64_C(0xc3450e196da80e3a),
+    UINT64_C(0x4c2d9f413df695b1), UINT64_C(0x36f5ef890dc31cc8),
+    UINT64_C(0x79a59ba2c5dc31cc), UINT64_C(0x037deb6af5e9b8b5),
+    UINT64_C(0x8c157a32a5b7233e), UINT64_C(0xf6cd0afa9582aa47),
+    UINT64_C(0x4ad64994d625e4da), UINT64_C(0x300e395ce6106da3),
+    UINT64_C(0xbf66a804b64ef628), UINT64_C(0xc5bed8cc867b7f51),
+    UINT64_C(0x8aeeace74e645255), UINT64_C(0xf036dc2f7e51db2c),
+    UINT64_C(0x7f5e4d772e0f40a7), UINT64_C(0x05863dbf1e3ac9de),
+    UINT64_C(0xe1fea520be311aaf), UINT64_C(0x9b26d5e88e0493d6),
+    UINT64_C(0x144e44b0de5a085d), UINT64_C(0x6e963478ee6f8124),
+    UINT64_C(0x21c640532670ac20), UINT64_C(0x5b1e309b16452559),
+    UINT64_C(0xd476a1c3461bbed2), UINT64_C(0xaeaed10b762e37ab),
+    UINT64_C(0x37deb6af5e9b8b5b), UINT64_C(0x4d06c6676eae0222),
+    UINT64_C(0xc26e573f3ef099a9), UINT64_C(0xb8b627f70ec510d0),
+    UINT64_C(0xf7e653dcc6da3dd4), UINT64_C(0x8d3e2314f6efb4ad),
+    UINT64_C(0x0256b24ca6b12f26), UINT64_C(0x788ec2849684a65f),
+    UINT64_C(0x9cf65a1b368f752e), UINT64_C(0xe62e2ad306bafc57),
+    UINT64_C(0x6946bb8b56e467dc), UINT64_C(0x139ecb4366d1eea5),
+    UINT64_C(0x5ccebf68aecec3a1), UINT64_C(0x2616cfa09efb4ad8),
+    UINT64_C(0xa97e5ef8cea5d153), UINT64_C(0xd3a62e30fe90582a),
+    UINT64_C(0xb0c7b7e3c7593bd8), UINT64_C(0xca1fc72bf76cb2a1),
+    UINT64_C(0x45775673a732292a), UINT64_C(0x3faf26bb9707a053),
+    UINT64_C(0x70ff52905f188d57), UINT64_C(0x0a2722586f2d042e),
+    UINT64_C(0x854fb3003f739fa5), UINT64_C(0xff97c3c80f4616dc),
+    UINT64_C(0x1bef5b57af4dc5ad), UINT64_C(0x61372b9f9f784cd4),
+    UINT64_C(0xee5fbac7cf26d75f), UINT64_C(0x9487ca0fff135e26),
+    UINT64_C(0xdbd7be24370c7322), UINT64_C(0xa10fceec0739fa5b),
+    UINT64_C(0x2e675fb4576761d0), UINT64_C(0x54bf2f7c6752e8a9),
+    UINT64_C(0xcdcf48d84fe75459), UINT64_C(0xb71738107fd2dd20),
+    UINT64_C(0x387fa9482f8c46ab), UINT64_C(0x42a7d9801fb9cfd2),
+    UINT64_C(0x0df7adabd7a6e2d6), UINT64_C(0x772fdd63e7936baf),
+    UINT64_C(0xf8474c3bb7cdf024), UINT64_C(0x829f3cf387f8795d),
+    UINT64_C(0x66e7a46c27f3aa2c), UINT64_C(0x1c3fd4a417c62355),
+    UINT64_C(0x935745fc4798b8de), UINT64_C(0xe98f353477ad31a7),
+    UINT64_C(0xa6df411fbfb21ca3), UINT64_C(0xdc0731d78f8795da),
+    UINT64_C(0x536fa08fdfd90e51), UINT64_C(0x29b7d047efec8728),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0x89e99ffd73bddf69),
+    UINT64_C(0x388a19a9bfec2db9), UINT64_C(0xb1638654cc51f2d0),
+    UINT64_C(0x711433537fd85b72), UINT64_C(0xf8fdacae0c65841b),
+    UINT64_C(0x499e2afac03476cb), UINT64_C(0xc077b507b389a9a2),
+    UINT64_C(0xe22866a6ffb0b6e4), UINT64_C(0x6bc1f95b8c0d698d),
+    UINT64_C(0xdaa27f0f405c9b5d), UINT64_C(0x534be0f233e14434),
+    UINT64_C(0x933c55f58068ed96), UINT64_C(0x1ad5ca08f3d532ff),
+    UINT64_C(0xabb64c5c3f84c02f), UINT64_C(0x225fd3a14c391f46),
+    UINT64_C(0xef09eb1ea7f6fea3), UINT64_C(0x66e074e3d44b21ca),
+    UINT64_C(0xd783f2b7181ad31a), UINT64_C(0x5e6a6d4a6ba70c73),
+    UINT64_C(0x9e1dd84dd82ea5d1), UINT64_C(0x17f447b0ab937ab8),
+    UINT64_C(0xa697c1e467c28868), UINT64_C(0x2f7e5e19147f5701),
+    UINT64_C(0x0d218db858464847), UINT64_C(0x84c812452bfb972e),
+    UINT64_C(0x35ab9411e7aa65fe), UINT64_C(0xbc420bec9417ba97),
+    UINT64_C(0x7c35beeb279e1335), UINT64_C(0xf5dc21165423cc5c),
+    UINT64_C(0x44bfa74298723e8c), UINT64_C(0xcd5638bfebcfe1e5),
+    UINT64_C(0xf54af06e177a6e2d), UINT64_C(0x7ca36f9364c7b144),
+    UINT64_C(0xcdc0e9c7a8964394), UINT64_C(0x4429763adb2b9cfd),
+    UINT64_C(0x845ec33d68a2355f), UINT64_C(0x0db75cc01b1fea36),
+    UINT64_C(0xbcd4da94d74e18e6), UINT64_C(0x353d4569a4f3c78f),
+    UINT64_C(0x176296c8e8cad8c9), UINT64_C(0x9e8b09359b7707a0),
+    UINT64_C(0x2fe88f615726f570), UINT64_C(0xa601109c249b2a19),
+    UINT64_C(0x6676a59b971283bb), UINT64_C(0xef9f3a66e4af5cd2),
+    UINT64_C(0x5efcbc3228feae02), UINT64_C(0xd71523cf5b43716b),
+    UINT64_C(0x1a431b70b08c908e), UINT64_C(0x93aa848dc3314fe7),
+    UINT64_C(0x22c902d90f60bd37), UINT64_C(0xab209d247cdd625e),
+    UINT64_C(0x6b572823cf54cbfc), UINT64_C(0xe2beb7debce91495),
+    UINT64_C(0x53dd318a70b8e645), UINT64_C(0xda34ae770305392c),
+    UINT64_C(0xf86b7dd64f3c266a), UINT64_C(0x7182e22b3c81f903),
+    UINT64_C(0xc0e1647ff0d00bd3), UINT64_C(0x4908fb82836dd4ba),
+    UINT64_C(0x897f4e8530e47d18), UINT64_C(0x0096d1784359a271),
+    UINT64_C(0xb1f5572c8f0850a1), UINT64_C(0x381cc8d1fcb58fc8),
+    UINT64_C(0xc1ccc68f76634f31), UINT64_C(0x4825597205de9058),
+    UINT64_C(0xf946df26c98f6288), UINT64_C(0x70af40dbba32bde1),
+    UINT64_C(0xb0d8f5dc09bb1443), UINT64_C(0x39316a217a06cb2a),
+    UINT64_C(0x8852ec75b65739fa), UINT64_C(0x01bb7388c5eae693),
+    UINT64_C(0x23e4a02989d3f9d5), UINT64_C(0xaa0d3fd4fa6e26bc),
+    UINT64_C(0x1b6eb980363fd46c), UINT64_C(0x9287267d45820b05),
+    UINT64_C(0x52f0937af60ba2a7), UINT64_C(0xdb190c8785b67dce),
+    UINT64_C(0x6a7a8ad349e78f1e), UINT64_C(0xe393152e3a5a5077),
+    UINT64_C(0x2ec52d91d195b192), UINT64_C(0xa72cb26ca2286efb),
+    UINT64_C(0x164f34386e799c2b), UINT64_C(0x9fa6abc51dc44342),
+    UINT64_C(0x5fd11ec2ae4deae0), UINT64_C(0xd638813fddf03589),
+    UINT64_C(0x675b076b11a1c759), UINT64_C(0xeeb29896621c1830),
+    UINT64_C(0xcced4b372e250776), UINT64_C(0x4504d4ca5d98d81f),
+    UINT64_C(0xf467529e91c92acf), UINT64_C(0x7d8ecd63e274f5a6),
+    UINT64_C(0xbdf9786451fd5c04), UINT64_C(0x3410e7992240836d),
+    UINT64_C(0x857361cdee1171bd), UINT64_C(0x0c9afe309dacaed4),
+    UINT64_C(0x348636e16119211c), UINT64_C(0xbd6fa91c12a4fe75),
+    UINT64_C(0x0c0c2f48def50ca5), UINT64_C(0x85e5b0b5ad48d3cc),
+    UINT64_C(0x459205b21ec17a6e), UINT64_C(0xcc7b9a4f6d7ca507),
+    UINT64_C(0x7d181c1ba12d57d7), UINT64_C(0xf4f183e6d29088be),
+    UINT64_C(0xd6ae50479ea997f8), UINT64_C(0x5f47cfbaed144891),
+    UINT64_C(0xee2449ee2145ba41), UINT64_C(0x67cdd61352f86528),
+    UINT64_C(0xa7ba6314e171cc8a), UINT64_C(0x2e53fce992cc13e3),
+    UINT64_C(0x9f307abd5e9de133), UINT64_C(0x16d9e5402d203e5a),
+    UINT64_C(0xdb8fddffc6efdfbf), UINT64_C(0x52664202b55200d6),
+    UINT64_C(0xe305c4567903f206), UINT64_C(0x6aec5bab0abe2d6f),
+    UINT64_C(0xaa9beeacb93784cd), UINT64_C(0x23727151ca8a5ba4),
+    UINT64_C(0x9211f70506dba974), UINT64_C(0x1bf868f87566761d),
+    UINT64_C(0x39a7bb59395f695b), UINT64_C(0xb04e24a44ae2b632),
+    UINT64_C(0x012da2f086b344e2), UINT64_C(0x88c43d0df50e9b8b),
+    UINT64_C(0x48b3880a46873229), UINT64_C(0xc15a17f7353aed40),
+    UINT64_C(0x703991a3f96b1f90), UINT64_C(0xf9d00e5e8ad6c0f9),
+    UINT64_C(0xa8c0ab4db4510d09), UINT64_C(0x212934b0c7ecd260),
+    UINT64_C(0x904ab2e40bbd20b0), UINT64_C(0x19a32d197800ffd9),
+    UINT64_C(0xd9d4981ecb89567b), UINT64_C(0x503d07e3b8348912),
+    UINT64_C(0xe15e81b774657bc2), UINT64_C(0x68b71e4a07d8a4ab),
+    UINT64_C(0x4ae8cdeb4be1bbed), UINT64_C(0xc3015216385c6484),
+    UINT64_C(0x7262d442f40d9654), UINT64_C(0xfb8b4bbf87b0493d),
+    UINT64_C(0x3bfcfeb83439e09f), UINT64_C(0xb215614547843ff6),
+    UINT64_C(0x0376e7118bd5cd26), UINT64_C(0x8a9f78ecf868124f),
+    UINT64_C(0x47c9405313a7f3aa), UINT64_C(0xce20dfae601a2cc3),
+    UINT64_C(0x7f4359faac4bde13), UINT64_C(0xf6aac607dff6017a),
+    UINT64_C(0x36dd73006c7fa8d8), UINT64_C(0xbf34ecfd1fc277b1),
+    UINT64_C(0x0e576aa9d3938561), UINT64_C(0x87bef554a02e5a08),
+    UINT64_C(0xa5e126f5ec17454e), UINT64_C(0x2c08b9089faa9a27),
+    UINT64_C(0x9d6b3f5c53fb68f7), UINT64_C(0x1482a0a12046b79e),
+    UINT64_C(0xd4f515a693cf1e3c), UINT64_C(0x5d1c8a5be072c155),
+    UINT64_C(0xec7f0c0f2c233385), UINT64_C(0x659693f25f9eecec),
+    UINT64_C(0x5d8a5b23a32b6324), UINT64_C(0xd463c4ded096bc4d),
+    UINT64_C(0x6500428a1cc74e9d), UINT64_C(0xece9dd776f7a91f4),
+    UINT64_C(0x2c9e6870dcf33856), UINT64_C(0xa577f78daf4ee73f),
+    UINT64_C(0x141471d9631f15ef), UINT64_C(0x9dfdee2410a2ca86),
+    UINT64_C(0xbfa23d855c9bd5c0), UINT64_C(0x364ba2782f260aa9),
+    UINT64_C(0x8728242ce377f879), UINT64_C(0x0ec1bbd190ca2710),
+    UINT64_C(0xceb60ed623438eb2), UINT64_C(0x475f912b50fe51db),
+    UINT64_C(0xf63c177f9cafa30b), UINT64_C(0x7fd58882ef127c62),
+    UINT64_C(0xb283b03d04dd9d87), UINT64_C(0x3b6a2fc0776042ee),
+    UINT64_C(0x8a09a994bb31b03e), UINT64_C(0x03e03669c88c6f57),
+    UINT64_C(0xc397836e7b05c6f5), UINT64_C(0x4a7e1c9308b8199c),
+    UINT64_C(0xfb1d9ac7c4e9eb4c), UINT64_C(0x72f4053ab7543425),
+    UINT64_C(0x50abd69bfb6d2b63), UINT64_C(0xd942496688d0f40a),
+    UINT64_C(0x6821cf32448106da), UINT64_C(0xe1c850cf373cd9b3),
+    UINT64_C(0x21bfe5c884b57011), UINT64_C(0xa8567a35f708af78),
+    UINT64_C(0x1935fc613b595da8), UINT64_C(0x90dc639c48e482c1),
+    UINT64_C(0x690c6dc2c2324238), UINT64_C(0xe0e5f23fb18f9d51),
+    UINT64_C(0x5186746b7dde6f81), UINT64_C(0xd86feb960e63b0e8),
+    UINT64_C(0x18185e91bdea194a), UINT64_C(0x91f1c16cce57c623),
+    UINT64_C(0x20924738020634f3), UINT64_C(0xa97bd8c571bbeb9a),
+    UINT64_C(0x8b240b643d82f4dc), UINT64_C(0x02cd94994e3f2bb5),
+    UINT64_C(0xb3ae12cd826ed965), UINT64_C(0x3a478d30f1d3060c),
+    UINT64_C(0xfa303837425aafae), UINT64_C(0x73d9a7ca31e770c7),
+    UINT64_C(0xc2ba219efdb68217), UINT64_C(0x4b53be638e0b5d7e),
+    UINT64_C(0x860586dc65c4bc9b), UINT64_C(0x0fec1921167963f2),
+    UINT64_C(0xbe8f9f75da289122), UINT64_C(0x37660088a9954e4b),
+    UINT64_C(0xf711b58f1a1ce7e9), UINT64_C(0x7ef82a7269a13880),
+    UINT64_C(0xcf9bac26a5f0ca50), UINT64_C(0x467233dbd64d1539),
+    UINT64_C(0x642de07a9a740a7f), UINT64_C(0xedc47f87e9c9d516),
+    UINT64_C(0x5ca7f9d3259827c6), UINT64_C(0xd54e662e5625f8af),
+    UINT64_C(0x1539d329e5ac510d), UINT64_C(0x9cd04cd496118e64),
+    UINT64_C(0x2db3ca805a407cb4), UINT64_C(0xa45a557d29fda3dd),
+    UINT64_C(0x9c469dacd5482c15), UINT64_C(0x15af0251a6f5f37c),
+    UINT64_C(0xa4cc84056aa401ac), UINT64_C(0x2d251bf81919dec5),
+    UINT64_C(0xed52aeffaa907767), UINT64_C(0x64bb3102d92da80e),
+    UINT64_C(0xd5d8b756157c5ade), UINT64_C(0x5c3128ab66c185b7),
+    UINT64_C(0x7e6efb0a2af89af1), UINT64_C(0xf78764f759454598),
+    UINT64_C(0x46e4e2a39514b748), UINT64_C(0xcf0d7d5ee6a96821),
+    UINT64_C(0x0f7ac8595520c183), UINT64_C(0x869357a4269d1eea),
+    UINT64_C(0x37f0d1f0eaccec3a), UINT64_C(0xbe194e0d99713353),
+    UINT64_C(0x734f76b272bed2b6), UINT64_C(0xfaa6e94f01030ddf),
+    UINT64_C(0x4bc56f1bcd52ff0f), UINT64_C(0xc22cf0e6beef2066),
+    UINT64_C(0x025b45e10d6689c4), UINT64_C(0x8bb2da1c7edb56ad),
+    UINT64_C(0x3ad15c48b28aa47d), UINT64_C(0xb338c3b5c1377b14),
+    UINT64_C(0x916710148d0e6452), UINT64_C(0x188e8fe9feb3bb3b),
+    UINT64_C(0xa9ed09bd32e249eb), UINT64_C(0x20049640415f9682),
+    UINT64_C(0xe0732347f2d63f20), UINT64_C(0x699abcba816be049),
+    UINT64_C(0xd8f93aee4d3a1299), UINT64_C(0x5110a5133e87cdf0),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0xf4125129ce4038be),
+    UINT64_C(0xc37d8400c417e217), UINT64_C(0x376fd5290a57daa9),
+    UINT64_C(0xada22e52d0b85745), UINT64_C(0x59b07f7b1ef86ffb),
+    UINT64_C(0x6edfaa5214afb552), UINT64_C(0x9acdfb7bdaef8dec),
+    UINT64_C(0x701d7af6f9e73de1), UINT64_C(0x840f2bdf37a7055f),
+    UINT64_C(0xb360fef63df0dff6), UINT64_C(0x4772afdff3b0e748),
+    UINT64_C(0xddbf54a4295f6aa4), UINT64_C(0x29ad058de71f521a),
+    UINT64_C(0x1ec2d0a4ed4888b3), UINT64_C(0xead0818d2308b00d),
+    UINT64_C(0xe03af5edf3ce7bc2), UINT64_C(0x1428a4c43d8e437c),
+    UINT64_C(0x234771ed37d999d5), UINT64_C(0xd75520c4f999a16b),
+    UINT64_C(0x4d98dbbf23762c87), UINT64_C(0xb98a8a96ed361439),
+    UINT64_C(0x8ee55fbfe761ce90), UINT64_C(0x7af70e962921f62e),
+    UINT64_C(0x90278f1b0a294623), UINT64_C(0x6435de32c4697e9d),
+    UINT64_C(0x535a0b1bce3ea434), UINT64_C(0xa7485a32007e9c8a),
+    UINT64_C(0x3d85a149da911166), UINT64_C(0xc997f06014d129d8),
+    UINT64_C(0xfef825491e86f371), UINT64_C(0x0aea7460d0c6cbcf),
+    UINT64_C(0xeb2ccd88bf0b64ef), UINT64_C(0x1f3e9ca1714b5c51),
+    UINT64_C(0x285149887b1c86f8), UINT64_C(0xdc4318a1b55cbe46),
+    UINT64_C(0x468ee3da6fb333aa), UINT64_C(0xb29cb2f3a1f30b14),
+    UINT64_C(0x85f367daaba4d1bd), UINT64_C(0x71e136f365e4e903),
+    UINT64_C(0x9b31b77e46ec590e), UINT64_C(0x6f23e65788ac61b0),
+    UINT64_C(0x584c337e82fbbb19), UINT64_C(0xac5e62574cbb83a7),
+    UINT64_C(0x3693992c96540e4b), UINT64_C(0xc281c805581436f5),
+    UINT64_C(0xf5ee1d2c5243ec5c), UINT64_C(0x01fc4c059c03d4e2),
+    UINT64_C(0x0b1638654cc51f2d), UINT64_C(0xff04694c82852793),
+    UINT64_C(0xc86bbc6588d2fd3a), UINT64_C(0x3c79ed4c4692c584),
+    UINT64_C(0xa6b416379c7d4868), UINT64_C(0x52a6471e523d70d6),
+    UINT64_C(0x65c99237586aaa7f), UINT64_C(0x91dbc31e962a92c1),
+    UINT64_C(0x7b0b4293b52222cc), UINT64_C(0x8f1913ba7b621a72),
+    UINT64_C(0xb876c6937135c0db), UINT64_C(0x4c6497babf75f865),
+    UINT64_C(0xd6a96cc1659a7589), UINT64_C(0x22bb3de8abda4d37),
+    UINT64_C(0x15d4e8c1a18d979e), UINT64_C(0xe1c6b9e86fcdaf20),
+    UINT64_C(0xfd00bd4226815ab5), UINT64_C(0x0912ec6be8c1620b),
+    UINT64_C(0x3e7d3942e296b8a2), UINT64_C(0xca6f686b2cd6801c),
+    UINT64_C(0x50a29310f6390df0), UINT64_C(0xa4b0c2393879354e),
+    UINT64_C(0x93df1710322eefe7), UINT64_C(0x67cd4639fc6ed759),
+    UINT64_C(0x8d1dc7b4df666754), UINT64_C(0x790f969d11265fea),
+    UINT64_C(0x4e6043b41b718543), UINT64_C(0xba72129dd531bdfd),
+    UINT64_C(0x20bfe9e60fde3011), UINT64_C(0xd4adb8cfc19e08af),
+    UINT64_C(0xe3c26de6cbc9d206), UINT64_C(0x17d03ccf0589eab8),
+    UINT64_C(0x1d3a48afd54f2177), UINT64_C(0xe92819861b0f19c9),
+    UINT64_C(0xde47ccaf1158c360), UINT64_C(0x2a559d86df18fbde),
+    UINT64_C(0xb09866fd05f77632), UINT64_C(0x448a37d4cbb74e8c),
+    UINT64_C(0x73e5e2fdc1e09425), UINT64_C(0x87f7b3d40fa0ac9b),
+    UINT64_C(0x6d2732592ca81c96), UINT64_C(0x99356370e2e82428),
+    UINT64_C(0xae5ab659e8bffe81), UINT64_C(0x5a48e77026ffc63f),
+    UINT64_C(0xc0851c0bfc104bd3), UINT64_C(0x34974d223250736d),
+    UINT64_C(0x03f8980b3807a9c4), UINT64_C(0xf7eac922f647917a),
+    UINT64_C(0x162c70ca998a3e5a), UINT64_C(0xe23e21e357ca06e4),
+    UINT64_C(0xd551f4ca5d9ddc4d), UINT64_C(0x2143a5e393dde4f3),
+    UINT64_C(0xbb8e5e984932691f), UINT64_C(0x4f9c0fb1877251a1),
+    UINT64_C(0x78f3da988d258b08), UINT64_C(0x8ce18bb14365b3b6),
+    UINT64_C(0x66310a3c606d03bb), UINT64_C(0x92235b15ae2d3b05),
+    UINT64_C(0xa54c8e3ca47ae1ac), UINT64_C(0x515edf156a3ad912),
+    UINT64_C(0xcb93246eb0d554fe), UINT64_C(0x3f8175477e956c40),
+    UINT64_C(0x08eea06e74c2b6e9), UINT64_C(0xfcfcf147ba828e57),
+    UINT64_C(0xf61685276a444598), UINT64_C(0x0204d40ea4047d26),
+    UINT64_C(0x356b0127ae53a78f), UINT64_C(0xc179500e60139f31),
+    UINT64_C(0x5bb4ab75bafc12dd), UINT64_C(0xafa6fa5c74bc2a63),
+    UINT64_C(0x98c92f757eebf0ca), UINT64_C(0x6cdb7e5cb0abc874),
+    UINT64_C(0x860bffd193a37879), UINT64_C(0x7219aef85de340c7),
+    UINT64_C(0x45767bd157b49a6e), UINT64_C(0xb1642af899f4a2d0),
+    UINT64_C(0x2ba9d183431b2f3c), UINT64_C(0xdfbb80aa8d5b1782),
+    UINT64_C(0xe8d45583870ccd2b), UINT64_C(0x1cc604aa494cf595),
+    UINT64_C(0xd1585cd715952601), UINT64_C(0x254a0dfedbd51ebf),
+    UINT64_C(0x1225d8d7d182c416), UINT64_C(0xe63789fe1fc2fca8),
+    UINT64_C(0x7cfa7285c52d7144), UINT64_C(0x88e823ac0b6d49fa),
+    UINT64_C(0xbf87f685013a9353), UINT64_C(0x4b95a7accf7aabed),
+    UINT64_C(0xa1452621ec721be0), UINT64_C(0x555777082232235e),
+    UINT64_C(0x6238a2212865f9f7), UINT64_C(0x962af308e625c149),
+    UINT64_C(0x0ce708733cca4ca5), UINT64_C(0xf8f5595af28a741b),
+    UINT64_C(0xcf9a8c73f8ddaeb2), UINT64_C(0x3b88dd5a369d960c),
+    UINT64_C(0x3162a93ae65b5dc3), UINT64_C(0xc570f813281b657d),
+    UINT64_C(0xf21f2d3a224cbfd4), UINT64_C(0x060d7c13ec0c876a),
+    UINT64_C(0x9cc0876836e30a86), UINT64_C(0x68d2d641f8a33238),
+    UINT64_C(0x5fbd0368f2f4e891), UINT64_C(0xabaf52413cb4d02f),
+    UINT64_C(0x417fd3cc1fbc6022), UINT64_C(0xb56d82e5d1fc589c),
+    UINT64_C(0x820257ccdbab8235), UINT64_C(0x761006e515ebba8b),
+    UINT64_C(0xecddfd9ecf043767), UINT64_C(0x18cfacb701440fd9),
+    UINT64_C(0x2fa0799e0b13d570), UINT64_C(0xdbb228b7c553edce),
+    UINT64_C(0x3a74915faa9e42ee), UINT64_C(0xce66c07664de7a50),
+    UINT64_C(0xf909155f6e89a0f9), UINT64_C(0x0d1b4476a0c99847),
+    UINT64_C(0x97d6bf0d7a2615ab), UINT64_C(0x63c4ee24b4662d15),
+    UINT64_C(0x54ab3b0dbe31f7bc), UINT64_C(0xa0b96a247071cf02),
+    UINT64_C(0x4a69eba953797f0f), UINT64_C(0xbe7bba809d3947b1),
+    UINT64_C(0x89146fa9976e9d18), UINT64_C(0x7d063e80592ea5a6),
+    UINT64_C(0xe7cbc5fb83c1284a), UINT64_C(0x13d994d24d8110f4),
+    UINT64_C(0x24b641fb47d6ca5d), UINT64_C(0xd0a410d28996f2e3),
+    UINT64_C(0xda4e64b25950392c), UINT64_C(0x2e5c359b97100192),
+    UINT64_C(0x1933e0b29d47db3b), UINT64_C(0xed21b19b5307e385),
+    UINT64_C(0x77ec4ae089e86e69), UINT64_C(0x83fe1bc947a856d7),
+    UINT64_C(0xb491cee04dff8c7e), UINT64_C(0x40839fc983bfb4c0),
+    UINT64_C(0xaa531e44a0b704cd), UINT64_C(0x5e414f6d6ef73c73),
+    UINT64_C(0x692e9a4464a0e6da), UINT64_C(0x9d3ccb6daae0de64),
+    UINT64_C(0x07f13016700f5388), UINT64_C(0xf3e3613fbe4f6b36),
+    UINT64_C(0xc48cb416b418b19f), UINT64_C(0x309ee53f7a588921),
+    UINT64_C(0x2c58e19533147cb4), UINT64_C(0xd84ab0bcfd54440a),
+    UINT64_C(0xef256595f7039ea3), UINT64_C(0x1b3734bc3943a61d),
+    UINT64_C(0x81facfc7e3ac2bf1), UINT64_C(0x75e89eee2dec134f),
+    UINT64_C(0x42874bc727bbc9e6), UINT64_C(0xb6951aeee9fbf158),
+    UINT64_C(0x5c459b63caf34155), UINT64_C(0xa857ca4a04b379eb),
+    UINT64_C(0x9f381f630ee4a342), UINT64_C(0x6b2a4e4ac0a49bfc),
+    UINT64_C(0xf1e7b5311a4b1610), UINT64_C(0x05f5e418d40b2eae),
+    UINT64_C(0x329a3131de5cf407), UINT64_C(0xc6886018101cccb9),
+    UINT64_C(0xcc621478c0da0776), UINT64_C(0x387045510e9a3fc8),
+    UINT64_C(0x0f1f907804cde561), UINT64_C(0xfb0dc151ca8ddddf),
+    UINT64_C(0x61c03a2a10625033), UINT64_C(0x95d26b03de22688d),
+    UINT64_C(0xa2bdbe2ad475b224), UINT64_C(0x56afef031a358a9a),
+    UINT64_C(0xbc7f6e8e393d3a97), UINT64_C(0x486d3fa7f77d0229),
+    UINT64_C(0x7f02ea8efd2ad880), UINT64_C(0x8b10bba7336ae03e),
+    UINT64_C(0x11dd40dce9856dd2), UINT64_C(0xe5cf11f527c5556c),
+    UINT64_C(0xd2a0c4dc2d928fc5), UINT64_C(0x26b295f5e3d2b77b),
+    UINT64_C(0xc7742c1d8c1f185b), UINT64_C(0x33667d34425f20e5),
+    UINT64_C(0x0409a81d4808fa4c), UINT64_C(0xf01bf9348648c2f2),
+    UINT64_C(0x6ad6024f5ca74f1e), UINT64_C(0x9ec4536692e777a0),
+    UINT64_C(0xa9ab864f98b0ad09), UINT64_C(0x5db9d76656f095b7),
+    UINT64_C(0xb76956eb75f825ba), UINT64_C(0x437b07c2bbb81d04),
+    UINT64_C(0x7414d2ebb1efc7ad), UINT64_C(0x800683c27fafff13),
+    UINT64_C(0x1acb78b9a54072ff), UINT64_C(0xeed929906b004a41),
+    UINT64_C(0xd9b6fcb9615790e8), UINT64_C(0x2da4ad90af17a856),
+    UINT64_C(0x274ed9f07fd16399), UINT64_C(0xd35c88d9b1915b27),
+    UINT64_C(0xe4335df0bbc6818e), UINT64_C(0x10210cd97586b930),
+    UINT64_C(0x8aecf7a2af6934dc), UINT64_C(0x7efea68b61290c62),
+    UINT64_C(0x499173a26b7ed6cb), UINT64_C(0xbd83228ba53eee75),
+    UINT64_C(0x5753a30686365e78), UINT64_C(0xa341f22f487666c6),
+    UINT64_C(0x942e27064221bc6f), UINT64_C(0x603c762f8c6184d1),
+    UINT64_C(0xfaf18d54568e093d), UINT64_C(0x0ee3dc7d98ce3183),
+    UINT64_C(0x398c09549299eb2a), UINT64_C(0xcd9e587d5cd9d394),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0x8ce168638c796306),
+    UINT64_C(0x329bf69440655567), UINT64_C(0xbe7a9ef7cc1c3661),
+    UINT64_C(0x6537ed2880caaace), UINT64_C(0xe9d6854b0cb3c9c8),
+    UINT64_C(0x57ac1bbcc0afffa9), UINT64_C(0xdb4d73df4cd69caf),
+    UINT64_C(0xca6fda510195559c), UINT64_C(0x468eb2328dec369a),
+    UINT64_C(0xf8f42cc541f000fb), UINT64_C(0x741544a6cd8963fd),
+    UINT64_C(0xaf583779815fff52), UINT64_C(0x23b95f1a0d269c54),
+    UINT64_C(0x9dc3c1edc13aaa35), UINT64_C(0x1122a98e4d43c933),
+    UINT64_C(0xbf8692f15bbd3853), UINT64_C(0x3367fa92d7c45b55),
+    UINT64_C(0x8d1d64651bd86d34), UINT64_C(0x01fc0c0697a10e32),
+    UINT64_C(0xdab17fd9db77929d), UINT64_C(0x565017ba570ef19b),
+    UINT64_C(0xe82a894d9b12c7fa), UINT64_C(0x64cbe12e176ba4fc),
+    UINT64_C(0x75e948a05a286dcf), UINT64_C(0xf90820c3d6510ec9),
+    UINT64_C(0x4772be341a4d38a8), UINT64_C(0xcb93d65796345bae),
+    UINT64_C(0x10dea588dae2c701), UINT64_C(0x9c3fcdeb569ba407),
+    UINT64_C(0x2245531c9a879266), UINT64_C(0xaea43b7f16fef160),
+    UINT64_C(0x545403b1efede3cd), UINT64_C(0xd8b56bd2639480cb),
+    UINT64_C(0x66cff525af88b6aa), UINT64_C(0xea2e9d4623f1d5ac),
+    UINT64_C(0x3163ee996f274903), UINT64_C(0xbd8286fae35e2a05),
+    UINT64_C(0x03f8180d2f421c64), UINT64_C(0x8f19706ea33b7f62),
+    UINT64_C(0x9e3bd9e0ee78b651), UINT64_C(0x12dab1836201d557),
+    UINT64_C(0xaca02f74ae1de336), UINT64_C(0x2041471722648030),
+    UINT64_C(0xfb0c34c86eb21c9f), UINT64_C(0x77ed5cabe2cb7f99),
+    UINT64_C(0xc997c25c2ed749f8), UINT64_C(0x4576aa3fa2ae2afe),
+    UINT64_C(0xebd29140b450db9e), UINT64_C(0x6733f9233829b898),
+    UINT64_C(0xd94967d4f4358ef9), UINT64_C(0x55a80fb7784cedff),
+    UINT64_C(0x8ee57c68349a7150), UINT64_C(0x0204140bb8e31256),
+    UINT64_C(0xbc7e8afc74ff2437), UINT64_C(0x309fe29ff8864731),
+    UINT64_C(0x21bd4b11b5c58e02), UINT64_C(0xad5c237239bced04),
+    UINT64_C(0x1326bd85f5a0db65), UINT64_C(0x9fc7d5e679d9b863),
+    UINT64_C(0x448aa639350f24cc), UINT64_C(0xc86bce5ab97647ca),
+    UINT64_C(0x761150ad756a71ab), UINT64_C(0xfaf038cef91312ad),
+    UINT64_C(0xa8a80763dfdbc79a), UINT64_C(0x24496f0053a2a49c),
+    UINT64_C(0x9a33f1f79fbe92fd), UINT64_C(0x16d2999413c7f1fb),
+    UINT64_C(0xcd9fea4b5f116d54), UINT64_C(0x417e8228d3680e52),
+    UINT64_C(0xff041cdf1f743833), UINT64_C(0x73e574bc930d5b35),
+    UINT64_C(0x62c7dd32de4e9206), UINT64_C(0xee26b5515237f100),
+    UINT64_C(0x505c2ba69e2bc761), UINT64_C(0xdcbd43c51252a467),
+    UINT64_C(0x07f0301a5e8438c8), UINT64_C(0x8b115879d2fd5bce),
+    UINT64_C(0x356bc68e1ee16daf), UINT64_C(0xb98aaeed92980ea9),
+    UINT64_C(0x172e95928466ffc9), UINT64_C(0x9bcffdf1081f9ccf),
+    UINT64_C(0x25b56306c403aaae), UINT64_C(0xa9540b65487ac9a8),
+    UINT64_C(0x721978ba04ac5507), UINT64_C(0xfef810d988d53601),
+    UINT64_C(0x40828e2e44c90060), UINT64_C(0xcc63e64dc8b06366),
+    UINT64_C(0xdd414fc385f3aa55), UINT64_C(0x51a027a0098ac953),
+    UINT64_C(0xefdab957c596ff32), UINT64_C(0x633bd13449ef9c34),
+    UINT64_C(0xb876a2eb0539009b), UINT64_C(0x3497ca888940639d),
+    UINT64_C(0x8aed547f455c55fc), UINT64_C(0x060c3c1cc92536fa),
+    UINT64_C(0xfcfc04d230362457), UINT64_C(0x701d6cb1bc4f4751),
+    UINT64_C(0xce67f24670537130), UINT64_C(0x42869a25fc2a1236),
+    UINT64_C(0x99cbe9fab0fc8e99), UINT64_C(0x152a81993c85ed9f),
+    UINT64_C(0xab501f6ef099dbfe), UINT64_C(0x27b1770d7ce0b8f8),
+    UINT64_C(0x3693de8331a371cb), UINT64_C(0xba72b6e0bdda12cd),
+    UINT64_C(0x0408281771c624ac), UINT64_C(0x88e94074fdbf47aa),
+    UINT64_C(0x53a433abb169db05), UINT64_C(0xdf455bc83d10b803),
+    UINT64_C(0x613fc53ff10c8e62), UINT64_C(0xeddead5c7d75ed64),
+    UINT64_C(0x437a96236b8b1c04), UINT64_C(0xcf9bfe40e7f27f02),
+    UINT64_C(0x71e160b72bee4963), UINT64_C(0xfd0008d4a7972a65),
+    UINT64_C(0x264d7b0beb41b6ca), UINT64_C(0xaaac13686738d5cc),
+    UINT64_C(0x14d68d9fab24e3ad), UINT64_C(0x9837e5fc275d80ab),
+    UINT64_C(0x89154c726a1e4998), UINT64_C(0x05f42411e6672a9e),
+    UINT64_C(0xbb8ebae62a7b1cff), UINT64_C(0x376fd285a6027ff9),
+    UINT64_C(0xec22a15aead4e356), UINT64_C(0x60c3c93966ad8050),
+    UINT64_C(0xdeb957ceaab1b631), UINT64_C(0x52583fad26c8d537),
+    UINT64_C(0x7a092894e7201c5f), UINT64_C(0xf6e840f76b597f59),
+    UINT64_C(0x4892de00a7454938), UINT64_C(0xc473b6632b3c2a3e),
+    UINT64_C(0x1f3ec5bc67eab691), UINT64_C(0x93dfaddfeb93d597),
+    UINT64_C(0x2da53328278fe3f6), UINT64_C(0xa1445b4babf680f0),
+    UINT64_C(0xb066f2c5e6b549c3), UINT64_C(0x3c879aa66acc2ac5),
+    UINT64_C(0x82fd0451a6d01ca4), UINT64_C(0x0e1c6c322aa97fa2),
+    UINT64_C(0xd5511fed667fe30d), UINT64_C(0x59b0778eea06800b),
+    UINT64_C(0xe7cae979261ab66a), UINT64_C(0x6b2b811aaa63d56c),
+    UINT64_C(0xc58fba65bc9d240c), UINT64_C(0x496ed20630e4470a),
+    UINT64_C(0xf7144cf1fcf8716b), UINT64_C(0x7bf524927081126d),
+    UINT64_C(0xa0b8574d3c578ec2), UINT64_C(0x2c593f2eb02eedc4),
+    UINT64_C(0x9223a1d97c32dba5), UINT64_C(0x1ec2c9baf04bb8a3),
+    UINT64_C(0x0fe06034bd087190), UINT64_C(0x8301085731711296),
+    UINT64_C(0x3d7b96a0fd6d24f7), UINT64_C(0xb19afec3711447f1),
+    UINT64_C(0x6ad78d1c3dc2db5e), UINT64_C(0xe636e57fb1bbb858),
+    UINT64_C(0x584c7b887da78e39), UINT64_C(0xd4ad13ebf1deed3f),
+    UINT64_C(0x2e5d2b2508cdff92), UINT64_C(0xa2bc434684b49c94),
+    UINT64_C(0x1cc6ddb148a8aaf5), UINT64_C(0x9027b5d2c4d1c9f3),
+    UINT64_C(0x4b6ac60d8807555c), UINT64_C(0xc78bae6e047e365a),
+    UINT64_C(0x79f13099c862003b), UINT64_C(0xf51058fa441b633d),
+    UINT64_C(0xe432f1740958aa0e), UINT64_C(0x68d399178521c908),
+    UINT64_C(0xd6a907e0493dff69), UINT64_C(0x5a486f83c5449c6f),
+    UINT64_C(0x81051c5c899200c0), UINT64_C(0x0de4743f05eb63c6),
+    UINT64_C(0xb39eeac8c9f755a7), UINT64_C(0x3f7f82ab458e36a1),
+    UINT64_C(0x91dbb9d45370c7c1), UINT64_C(0x1d3ad1b7df09a4c7),
+    UINT64_C(0xa3404f40131592a6), UINT64_C(0x2fa127239f6cf1a0),
+    UINT64_C(0xf4ec54fcd3ba6d0f), UINT64_C(0x780d3c9f5fc30e09),
+    UINT64_C(0xc677a26893df3868), UINT64_C(0x4a96ca0b1fa65b6e),
+    UINT64_C(0x5bb4638552e5925d), UINT64_C(0xd7550be6de9cf15b),
+    UINT64_C(0x692f95111280c73a), UINT64_C(0xe5cefd729ef9a43c),
+    UINT64_C(0x3e838eadd22f3893), UINT64_C(0xb262e6ce5e565b95),
+    UINT64_C(0x0c187839924a6df4), UINT64_C(0x80f9105a1e330ef2),
+    UINT64_C(0xd2a12ff738fbdbc5), UINT64_C(0x5e404794b482b8c3),
+    UINT64_C(0xe03ad963789e8ea2), UINT64_C(0x6cdbb100f4e7eda4),
+    UINT64_C(0xb796c2dfb831710b), UINT64_C(0x3b77aabc3448120d),
+    UINT64_C(0x850d344bf854246c), UINT64_C(0x09ec5c28742d476a),
+    UINT64_C(0x18cef5a6396e8e59), UINT64_C(0x942f9dc5b517ed5f),
+    UINT64_C(0x2a550332790bdb3e), UINT64_C(0xa6b46b51f572b838),
+    UINT64_C(0x7df9188eb9a42497), UINT64_C(0xf11870ed35dd4791),
+    UINT64_C(0x4f62ee1af9c171f0), UINT64_C(0xc383867975b812f6),
+    UINT64_C(0x6d27bd066346e396), UINT64_C(0xe1c6d565ef3f8090),
+    UINT64_C(0x5fbc4b922323b6f1), UINT64_C(0xd35d23f1af5ad5f7),
+    UINT64_C(0x0810502ee38c4958), UINT64_C(0x84f1384d6ff52a5e),
+    UINT64_C(0x3a8ba6baa3e91c3f), UINT64_C(0xb66aced92f907f39),
+    UINT64_C(0xa748675762d3b60a), UINT64_C(0x2ba90f34eeaad50c),
+    UINT64_C(0x95d391c322b6e36d), UINT64_C(0x1932f9a0aecf806b),
+    UINT64_C(0xc27f8a7fe2191cc4), UINT64_C(0x4e9ee21c6e607fc2),
+    UINT64_C(0xf0e47ceba27c49a3), UINT64_C(0x7c0514882e052aa5),
+    UINT64_C(0x86f52c46d7163808), UINT64_C(0x0a1444255b6f5b0e),
+    UINT64_C(0xb46edad297736d6f), UINT64_C(0x388fb2b11b0a0e69),
+    UINT64_C(0xe3c2c16e57dc92c6), UINT64_C(0x6f23a90ddba5f1c0),
+    UINT64_C(0xd15937fa17b9c7a1), UINT64_C(0x5db85f999bc0a4a7),
+    UINT64_C(0x4c9af617d6836d94), UINT64_C(0xc07b9e745afa0e92),
+    UINT64_C(0x7e01008396e638f3), UINT64_C(0xf2e068e01a9f5bf5),
+    UINT64_C(0x29ad1b3f5649c75a), UINT64_C(0xa54c735cda30a45c),
+    UINT64_C(0x1b36edab162c923d), UINT64_C(0x97d785c89a55f13b),
+    UINT64_C(0x3973beb78cab005b), UINT64_C(0xb592d6d400d2635d),
+    UINT64_C(0x0be84823ccce553c), UINT64_C(0x8709204040b7363a),
+    UINT64_C(0x5c44539f0c61aa95), UINT64_C(0xd0a53bfc8018c993),
+    UINT64_C(0x6edfa50b4c04fff2), UINT64_C(0xe23ecd68c07d9cf4),
+    UINT64_C(0xf31c64e68d3e55c7), UINT64_C(0x7ffd0c85014736c1),
+    UINT64_C(0xc1879272cd5b00a0), UINT64_C(0x4d66fa11412263a6),
+    UINT64_C(0x962b89ce0df4ff09), UINT64_C(0x1acae1ad818d9c0f),
+    UINT64_C(0xa4b07f5a4d91aa6e), UINT64_C(0x28511739c1e8c968),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0x3504e58b9ba6dd1e),
+    UINT64_C(0x6a09cb17374dba3c), UINT64_C(0x5f0d2e9caceb6722),
+    UINT64_C(0xd413962e6e9b7478), UINT64_C(0xe11773a5f53da966),
+    UINT64_C(0xbe1a5d3959d6ce44), UINT64_C(0x8b1eb8b2c270135a),
+    UINT64_C(0x837e0a0f85a17b9b), UINT64_C(0xb67aef841e07a685),
+    UINT64_C(0xe977c118b2ecc1a7), UINT64_C(0xdc732493294a1cb9),
+    UINT64_C(0x576d9c21eb3a0fe3), UINT64_C(0x626979aa709cd2fd),
+    UINT64_C(0x3d645736dc77b5df), UINT64_C(0x0860b2bd47d168c1),
+    UINT64_C(0x2da5324c53d5645d), UINT64_C(0x18a1d7c7c873b943),
+    UINT64_C(0x47acf95b6498de61), UINT64_C(0x72a81cd0ff3e037f),
+    UINT64_C(0xf9b6a4623d4e1025), UINT64_C(0xccb241e9a6e8cd3b),
+    UINT64_C(0x93bf6f750a03aa19), UINT64_C(0xa6bb8afe91a57707),
+    UINT64_C(0xaedb3843d6741fc6), UINT64_C(0x9bdfddc84dd2c2d8),
+    UINT64_C(0xc4d2f354e139a5fa), UINT64_C(0xf1d616df7a9f78e4),
+    UINT64_C(0x7ac8ae6db8ef6bbe), UINT64_C(0x4fcc4be62349b6a0),
+    UINT64_C(0x10c1657a8fa2d182), UINT64_C(0x25c580f114040c9c),
+    UINT64_C(0x5b4a6498a7aac8ba), UINT64_C(0x6e4e81133c0c15a4),
+    UINT64_C(0x3143af8f90e77286), UINT64_C(0x04474a040b41af98),
+    UINT64_C(0x8f59f2b6c931bcc2), UINT64_C(0xba5d173d529761dc),
+    UINT64_C(0xe55039a1fe7c06fe), UINT64_C(0xd054dc2a65dadbe0),
+    UINT64_C(0xd8346e97220bb321), UINT64_C(0xed308b1cb9ad6e3f),
+    UINT64_C(0xb23da5801546091d), UINT64_C(0x8739400b8ee0d403),
+    UINT64_C(0x0c27f8b94c90c759), UINT64_C(0x39231d32d7361a47),
+    UINT64_C(0x662e33ae7bdd7d65), UINT64_C(0x532ad625e07ba07b),
+    UINT64_C(0x76ef56d4f47face7), UINT64_C(0x43ebb35f6fd971f9),
+    UINT64_C(0x1ce69dc3c33216db), UINT64_C(0x29e278485894cbc5),
+    UINT64_C(0xa2fcc0fa9ae4d89f), UINT64_C(0x97f8257101420581),
+    UINT64_C(0xc8f50bedada962a3), UINT64_C(0xfdf1ee66360fbfbd),
+    UINT64_C(0xf5915cdb71ded77c), UINT64_C(0xc095b950ea780a62),
+    UINT64_C(0x9f9897cc46936d40), UINT64_C(0xaa9c7247dd35b05e),
+    UINT64_C(0x2182caf51f45a304), UINT64_C(0x14862f7e84e37e1a),
+    UINT64_C(0x4b8b01e228081938), UINT64_C(0x7e8fe469b3aec426),
+    UINT64_C(0xb694c9314f559174), UINT64_C(0x83902cbad4f34c6a),
+    UINT64_C(0xdc9d022678182b48), UINT64_C(0xe999e7ade3bef656),
+    UINT64_C(0x62875f1f21cee50c), UINT64_C(0x5783ba94ba683812),
+    UINT64_C(0x088e940816835f30), UINT64_C(0x3d8a71838d25822e),
+    UINT64_C(0x35eac33ecaf4eaef), UINT64_C(0x00ee26b5515237f1),
+    UINT64_C(0x5fe30829fdb950d3), UINT64_C(0x6ae7eda2661f8dcd),
+    UINT64_C(0xe1f95510a46f9e97), UINT64_C(0xd4fdb09b3fc94389),
+    UINT64_C(0x8bf09e07932224ab), UINT64_C(0xbef47b8c0884f9b5),
+    UINT64_C(0x9b31fb7d1c80f529), UINT64_C(0xae351ef687262837),
+    UINT64_C(0xf138306a2bcd4f15), UINT64_C(0xc43cd5e1b06b920b),
+    UINT64_C(0x4f226d53721b8151), UINT64_C(0x7a2688d8e9bd5c4f),
+    UINT64_C(0x252ba64445563b6d), UINT64_C(0x102f43cfdef0e673),
+    UINT64_C(0x184ff17299218eb2), UINT64_C(0x2d4b14f9028753ac),
+    UINT64_C(0x72463a65ae6c348e), UINT64_C(0x4742dfee35cae990),
+    UINT64_C(0xcc5c675cf7bafaca), UINT64_C(0xf95882d76c1c27d4),
+    UINT64_C(0xa655ac4bc0f740f6), UINT64_C(0x935149c05b519de8),
+    UINT64_C(0xeddeada9e8ff59ce), UINT64_C(0xd8da4822735984d0),
+    UINT64_C(0x87d766bedfb2e3f2), UINT64_C(0xb2d3833544143eec),
+    UINT64_C(0x39cd3b8786642db6), UINT64_C(0x0cc9de0c1dc2f0a8),
+    UINT64_C(0x53c4f090b129978a), UINT64_C(0x66c0151b2a8f4a94),
+    UINT64_C(0x6ea0a7a66d5e2255), UINT64_C(0x5ba4422df6f8ff4b),
+    UINT64_C(0x04a96cb15a139869), UINT64_C(0x31ad893ac1b54577),
+    UINT64_C(0xbab3318803c5562d), UINT64_C(0x8fb7d40398638b33),
+    UINT64_C(0xd0bafa9f3488ec11), UINT64_C(0xe5be1f14af2e310f),
+    UINT64_C(0xc07b9fe5bb2a3d93), UINT64_C(0xf57f7a6e208ce08d),
+    UINT64_C(0xaa7254f28c6787af), UINT64_C(0x9f76b17917c15ab1),
+    UINT64_C(0x146809cbd5b149eb), UINT64_C(0x216cec404e1794f5),
+    UINT64_C(0x7e61c2dce2fcf3d7), UINT64_C(0x4b652757795a2ec9),
+    UINT64_C(0x430595ea3e8b4608), UINT64_C(0x76017061a52d9b16),
+    UINT64_C(0x290c5efd09c6fc34), UINT64_C(0x1c08bb769260212a),
+    UINT64_C(0x971603c450103270), UINT64_C(0xa212e64fcbb6ef6e),
+    UINT64_C(0xfd1fc8d3675d884c), UINT64_C(0xc81b2d58fcfb5552),
+    UINT64_C(0x4670b431c63cb183), UINT64_C(0x737451ba5d9a6c9d),
+    UINT64_C(0x2c797f26f1710bbf), UINT64_C(0x197d9aad6ad7d6a1),
+    UINT64_C(0x9263221fa8a7c5fb), UINT64_C(0xa767c794330118e5),
+    UINT64_C(0xf86ae9089fea7fc7), UINT64_C(0xcd6e0c83044ca2d9),
+    UINT64_C(0xc50ebe3e439dca18), UINT64_C(0xf00a5bb5d83b1706),
+    UINT64_C(0xaf07752974d07024), UINT64_C(0x9a0390a2ef76ad3a),
+    UINT64_C(0x111d28102d06be60), UINT64_C(0x2419cd9bb6a0637e),
+    UINT64_C(0x7b14e3071a4b045c), UINT64_C(0x4e10068c81edd942),
+    UINT64_C(0x6bd5867d95e9d5de), UINT64_C(0x5ed163f60e4f08c0),
+    UINT64_C(0x01dc4d6aa2a46fe2), UINT64_C(0x34d8a8e13902b2fc),
+    UINT64_C(0xbfc61053fb72a1a6), UINT64_C(0x8ac2f5d860d47cb8),
+    UINT64_C(0xd5cfdb44cc3f1b9a), UINT64_C(0xe0cb3ecf5799c684),
+    UINT64_C(0xe8ab8c721048ae45), UINT64_C(0xddaf69f98bee735b),
+    UINT64_C(0x82a2476527051479), UINT64_C(0xb7a6a2eebca3c967),
+    UINT64_C(0x3cb81a5c7ed3da3d), UINT64_C(0x09bcffd7e5750723),
+    UINT64_C(0x56b1d14b499e6001), UINT64_C(0x63b534c0d238bd1f),
+    UINT64_C(0x1d3ad0a961967939), UINT64_C(0x283e3522fa30a427),
+    UINT64_C(0x77331bbe56dbc305), UINT64_C(0x4237fe35cd7d1e1b),
+    UINT64_C(0xc92946870f0d0d41), UINT64_C(0xfc2da30c94abd05f),
+    UINT64_C(0xa3208d903840b77d), UINT64_C(0x9624681ba3e66a63),
+    UINT64_C(0x9e44daa6e43702a2), UINT64_C(0xab403f2d7f91dfbc),
+    UINT64_C(0xf44d11b1d37ab89e), UINT64_C(0xc149f43a48dc6580),
+    UINT64_C(0x4a574c888aac76da), UINT64_C(0x7f53a903110aabc4),
+    UINT64_C(0x205e879fbde1cce6), UINT64_C(0x155a6214264711f8),
+    UINT64_C(0x309fe2e532431d64), UINT64_C(0x059b076ea9e5c07a),
+    UINT64_C(0x5a9629f2050ea758), UINT64_C(0x6f92cc799ea87a46),
+    UINT64_C(0xe48c74cb5cd8691c), UINT64_C(0xd1889140c77eb402),
+    UINT64_C(0x8e85bfdc6b95d320), UINT64_C(0xbb815a57f0330e3e),
+    UINT64_C(0xb3e1e8eab7e266ff), UINT64_C(0x86e50d612c44bbe1),
+    UINT64_C(0xd9e823fd80afdcc3), UINT64_C(0xececc6761b0901dd),
+    UINT64_C(0x67f27ec4d9791287), UINT64_C(0x52f69b4f42dfcf99),
+    UINT64_C(0x0dfbb5d3ee34a8bb), UINT64_C(0x38ff5058759275a5),
+    UINT64_C(0xf0e47d00896920f7), UINT64_C(0xc5e0988b12cffde9),
+    UINT64_C(0x9aedb617be249acb), UINT64_C(0xafe9539c258247d5),
+    UINT64_C(0x24f7eb2ee7f2548f), UINT64_C(0x11f30ea57c548991),
+    UINT64_C(0x4efe2039d0bfeeb3), UINT64_C(0x7bfac5b24b1933ad),
+    UINT64_C(0x739a770f0cc85b6c), UINT64_C(0x469e9284976e8672),
+    UINT64_C(0x1993bc183b85e150), UINT64_C(0x2c975993a0233c4e),
+    UINT64_C(0xa789e12162532f14), UINT64_C(0x928d04aaf9f5f20a),
+    UINT64_C(0xcd802a36551e9528), UINT64_C(0xf884cfbdceb84836),
+    UINT64_C(0xdd414f4cdabc44aa), UINT64_C(0xe845aac7411a99b4),
+    UINT64_C(0xb748845bedf1fe96), UINT64_C(0x824c61d076572388),
+    UINT64_C(0x0952d962b42730d2), UINT64_C(0x3c563ce92f81edcc),
+    UINT64_C(0x635b1275836a8aee), UINT64_C(0x565ff7fe18cc57f0),
+    UINT64_C(0x5e3f45435f1d3f31), UINT64_C(0x6b3ba0c8c4bbe22f),
+    UINT64_C(0x34368e546850850d), UINT64_C(0x01326bdff3f65813),
+    UINT64_C(0x8a2cd36d31864b49), UINT64_C(0xbf2836e6aa209657),
+    UINT64_C(0xe025187a06cbf175), UINT64_C(0xd521fdf19d6d2c6b),
+    UINT64_C(0xabae19982ec3e84d), UINT64_C(0x9eaafc13b5653553),
+    UINT64_C(0xc1a7d28f198e5271), UINT64_C(0xf4a3370482288f6f),
+    UINT64_C(0x7fbd8fb640589c35), UINT64_C(0x4ab96a3ddbfe412b),
+    UINT64_C(0x15b444a177152609), UINT64_C(0x20b0a12aecb3fb17),
+    UINT64_C(0x28d01397ab6293d6), UINT64_C(0x1dd4f61c30c44ec8),
+    UINT64_C(0x42d9d8809c2f29ea), UINT64_C(0x77dd3d0b0789f4f4),
+    UINT64_C(0xfcc385b9c5f9e7ae), UINT64_C(0xc9c760325e5f3ab0),
+    UINT64_C(0x96ca4eaef2b45d92), UINT64_C(0xa3ceab256912808c),
+    UINT64_C(0x860b2bd47d168c10), UINT64_C(0xb30fce5fe6b0510e),
+    UINT64_C(0xec02e0c34a5b362c), UINT64_C(0xd9060548d1fdeb32),
+    UINT64_C(0x5218bdfa138df868), UINT64_C(0x671c5871882b2576),
+    UINT64_C(0x381176ed24c04254), UINT64_C(0x0d159366bf669f4a),
+    UINT64_C(0x057521dbf8b7f78b), UINT64_C(0x3071c45063112a95),
+    UINT64_C(0x6f7ceacccffa4db7), UINT64_C(0x5a780f47545c90a9),
+    UINT64_C(0xd166b7f5962c83f3), UINT64_C(0xe462527e0d8a5eed),
+    UINT64_C(0xbb6f7ce2a16139cf), UINT64_C(0x8e6b99693ac7e4d1),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0xe39d1389931b9354),
+    UINT64_C(0xec6301407ea0b5c3), UINT64_C(0x0ffe12c9edbb2697),
+    UINT64_C(0xf39f24d3a5d6f8ed), UINT64_C(0x1002375a36cd6bb9),
+    UINT64_C(0x1ffc2593db764d2e), UINT64_C(0xfc61361a486dde7a),
+    UINT64_C(0xcc676ff4133a62b1), UINT64_C(0x2ffa7c7d8021f1e5),
+    UINT64_C(0x20046eb46d9ad772), UINT64_C(0xc3997d3dfe814426),
+    UINT64_C(0x3ff84b27b6ec9a5c), UINT64_C(0xdc6558ae25f70908),
+    UINT64_C(0xd39b4a67c84c2f9f), UINT64_C(0x300659ee5b57bccb),
+    UINT64_C(0xb397f9bb7ee35609), UINT64_C(0x500aea32edf8c55d),
+    UINT64_C(0x5ff4f8fb0043e3ca), UINT64_C(0xbc69eb729358709e),
+    UINT64_C(0x4008dd68db35aee4), UINT64_C(0xa395cee1482e3db0),
+    UINT64_C(0xac6bdc28a5951b27), UINT64_C(0x4ff6cfa1368e8873),
+    UINT64_C(0x7ff0964f6dd934b8), UINT64_C(0x9c6d85c6fec2a7ec),
+    UINT64_C(0x9393970f1379817b), UINT64_C(0x700e84868062122f),
+    UINT64_C(0x8c6fb29cc80fcc55), UINT64_C(0x6ff2a1155b145f01),
+    UINT64_C(0x600cb3dcb6af7996), UINT64_C(0x8391a05525b4eac2),
+    UINT64_C(0x4c76d525a5513f79), UINT64_C(0xafebc6ac364aac2d),
+    UINT64_C(0xa015d465dbf18aba), UINT64_C(0x4388c7ec48ea19ee),
+    UINT64_C(0xbfe9f1f60087c794), UINT64_C(0x5c74e27f939c54c0),
+    UINT64_C(0x538af0b67e277257), UINT64_C(0xb017e33fed3ce103),
+    UINT64_C(0x8011bad1b66b5dc8), UINT64_C(0x638ca9582570ce9c),
+    UINT64_C(0x6c72bb91c8cbe80b), UINT64_C(0x8fefa8185bd07b5f),
+    UINT64_C(0x738e9e0213bda525), UINT64_C(0x90138d8b80a63671),
+    UINT64_C(0x9fed9f426d1d10e6), UINT64_C(0x7c708ccbfe0683b2),
+    UINT64_C(0xffe12c9edbb26970), UINT64_C(0x1c7c3f1748a9fa24),
+    UINT64_C(0x13822ddea512dcb3), UINT64_C(0xf01f3e5736094fe7),
+    UINT64_C(0x0c7e084d7e64919d), UINT64_C(0xefe31bc4ed7f02c9),
+    UINT64_C(0xe01d090d00c4245e), UINT64_C(0x03801a8493dfb70a),
+    UINT64_C(0x3386436ac8880bc1), UINT64_C(0xd01b50e35b939895),
+    UINT64_C(0xdfe5422ab628be02), UINT64_C(0x3c7851a325332d56),
+    UINT64_C(0xc01967b96d5ef32c), UINT64_C(0x23847430fe456078),
+    UINT64_C(0x2c7a66f913fe46ef), UINT64_C(0xcfe7757080e5d5bb),
+    UINT64_C(0x98edaa4b4aa27ef2), UINT64_C(0x7b70b9c2d9b9eda6),
+    UINT64_C(0x748eab0b3402cb31), UINT64_C(0x9713b882a7195865),
+    UINT64_C(0x6b728e98ef74861f), UINT64_C(0x88ef9d117c6f154b),
+    UINT64_C(0x87118fd891d433dc), UINT64_C(0x648c9c5102cfa088),
+    UINT64_C(0x548ac5bf59981c43), UINT64_C(0xb717d636ca838f17),
+    UINT64_C(0xb8e9c4ff2738a980), UINT64_C(0x5b74d776b4233ad4),
+    UINT64_C(0xa715e16cfc4ee4ae), UINT64_C(0x4488f2e56f5577fa),
+    UINT64_C(0x4b76e02c82ee516d), UINT64_C(0xa8ebf3a511f5c239),
+    UINT64_C(0x2b7a53f0344128fb), UINT64_C(0xc8e74079a75abbaf),
+    UINT64_C(0xc71952b04ae19d38), UINT64_C(0x24844139d9fa0e6c),
+    UINT64_C(0xd8e577239197d016), UINT64_C(0x3b7864aa028c4342),
+    UINT64_C(0x34867663ef3765d5), UINT64_C(0xd71b65ea7c2cf681),
+    UINT64_C(0xe71d3c04277b4a4a), UINT64_C(0x04802f8db460d91e),
+    UINT64_C(0x0b7e3d4459dbff89), UINT64_C(0xe8e32ecdcac06cdd),
+    UINT64_C(0x148218d782adb2a7), UINT64_C(0xf71f0b5e11b621f3),
+    UINT64_C(0xf8e11997fc0d0764), UINT64_C(0x1b7c0a1e6f169430),
+    UINT64_C(0xd49b7f6eeff3418b), UINT64_C(0x37066ce77ce8d2df),
+    UINT64_C(0x38f87e2e9153f448), UINT64_C(0xdb656da70248671c),
+    UINT64_C(0x27045bbd4a25b966), UINT64_C(0xc4994834d93e2a32),
+    UINT64_C(0xcb675afd34850ca5), UINT64_C(0x28fa4974a79e9ff1),
+    UINT64_C(0x18fc109afcc9233a), UINT64_C(0xfb6103136fd2b06e),
+    UINT64_C(0xf49f11da826996f9), UINT64_C(0x17020253117205ad),
+    UINT64_C(0xeb633449591fdbd7), UINT64_C(0x08fe27c0ca044883),
+    UINT64_C(0x0700350927bf6e14), UINT64_C(0xe49d2680b4a4fd40),
+    UINT64_C(0x670c86d591101782), UINT64_C(0x8491955c020b84d6),
+    UINT64_C(0x8b6f8795efb0a241), UINT64_C(0x68f2941c7cab3115),
+    UINT64_C(0x9493a20634c6ef6f), UINT64_C(0x770eb18fa7dd7c3b),
+    UINT64_C(0x78f0a3464a665aac), UINT64_C(0x9b6db0cfd97dc9f8),
+    UINT64_C(0xab6be921822a7533), UINT64_C(0x48f6faa81131e667),
+    UINT64_C(0x4708e861fc8ac0f0), UINT64_C(0xa495fbe86f9153a4),
+    UINT64_C(0x58f4cdf227fc8dde), UINT64_C(0xbb69de7bb4e71e8a),
+    UINT64_C(0xb497ccb2595c381d), UINT64_C(0x570adf3bca47ab49),
+    UINT64_C(0x1a8272c5cdd36e8f), UINT64_C(0xf91f614c5ec8fddb),
+    UINT64_C(0xf6e17385b373db4c), UINT64_C(0x157c600c20684818),
+    UINT64_C(0xe91d561668059662), UINT64_C(0x0a80459ffb1e0536),
+    UINT64_C(0x057e575616a523a1), UINT64_C(0xe6e344df85beb0f5),
+    UINT64_C(0xd6e51d31dee90c3e), UINT64_C(0x35780eb84df29f6a),
+    UINT64_C(0x3a861c71a049b9fd), UINT64_C(0xd91b0ff833522aa9),
+    UINT64_C(0x257a39e27b3ff4d3), UINT64_C(0xc6e72a6be8246787),
+    UINT64_C(0xc91938a2059f4110), UINT64_C(0x2a842b2b9684d244),
+    UINT64_C(0xa9158b7eb3303886), UINT64_C(0x4a8898f7202babd2),
+    UINT64_C(0x45768a3ecd908d45), UINT64_C(0xa6eb99b75e8b1e11),
+    UINT64_C(0x5a8aafad16e6c06b), UINT64_C(0xb917bc2485fd533f),
+    UINT64_C(0xb6e9aeed684675a8), UINT64_C(0x5574bd64fb5de6fc),
+    UINT64_C(0x6572e48aa00a5a37), UINT64_C(0x86eff7033311c963),
+    UINT64_C(0x8911e5cadeaaeff4), UINT64_C(0x6a8cf6434db17ca0),
+    UINT64_C(0x96edc05905dca2da), UINT64_C(0x7570d3d096c7318e),
+    UINT64_C(0x7a8ec1197b7c1719), UINT64_C(0x9913d290e867844d),
+    UINT64_C(0x56f4a7e0688251f6), UINT64_C(0xb569b469fb99c2a2),
+    UINT64_C(0xba97a6a01622e435), UINT64_C(0x590ab52985397761),
+    UINT64_C(0xa56b8333cd54a91b), UINT64_C(0x46f690ba5e4f3a4f),
+    UINT64_C(0x49088273b3f41cd8), UINT64_C(0xaa9591fa20ef8f8c),
+    UINT64_C(0x9a93c8147bb83347), UINT64_C(0x790edb9de8a3a013),
+    UINT64_C(0x76f0c95405188684), UINT64_C(0x956ddadd960315d0),
+    UINT64_C(0x690cecc7de6ecbaa), UINT64_C(0x8a91ff4e4d7558fe),
+    UINT64_C(0x856fed87a0ce7e69), UINT64_C(0x66f2fe0e33d5ed3d),
+    UINT64_C(0xe5635e5b166107ff), UINT64_C(0x06fe4dd2857a94ab),
+    UINT64_C(0x09005f1b68c1b23c), UINT64_C(0xea9d4c92fbda2168),
+    UINT64_C(0x16fc7a88b3b7ff12), UINT64_C(0xf561690120ac6c46),
+    UINT64_C(0xfa9f7bc8cd174ad1), UINT64_C(0x190268415e0cd985),
+    UINT64_C(0x290431af055b654e), UINT64_C(0xca9922269640f61a),
+    UINT64_C(0xc56730ef7bfbd08d), UINT64_C(0x26fa2366e8e043d9),
+    UINT64_C(0xda9b157ca08d9da3), UINT64_C(0x390606f533960ef7),
+    UINT64_C(0x36f8143cde2d2860), UINT64_C(0xd56507b54d36bb34),
+    UINT64_C(0x826fd88e8771107d), UINT64_C(0x61f2cb07146a8329),
+    UINT64_C(0x6e0cd9cef9d1a5be), UINT64_C(0x8d91ca476aca36ea),
+    UINT64_C(0x71f0fc5d22a7e890), UINT64_C(0x926defd4b1bc7bc4),
+    UINT64_C(0x9d93fd1d5c075d53), UINT64_C(0x7e0eee94cf1cce07),
+    UINT64_C(0x4e08b77a944b72cc), UINT64_C(0xad95a4f30750e198),
+    UINT64_C(0xa26bb63aeaebc70f), UINT64_C(0x41f6a5b379f0545b),
+    UINT64_C(0xbd9793a9319d8a21), UINT64_C(0x5e0a8020a2861975),
+    UINT64_C(0x51f492e94f3d3fe2), UINT64_C(0xb2698160dc26acb6),
+    UINT64_C(0x31f82135f9924674), UINT64_C(0xd26532bc6a89d520),
+    UINT64_C(0xdd9b20758732f3b7), UINT64_C(0x3e0633fc142960e3),
+    UINT64_C(0xc26705e65c44be99), UINT64_C(0x21fa166fcf5f2dcd),
+    UINT64_C(0x2e0404a622e40b5a), UINT64_C(0xcd99172fb1ff980e),
+    UINT64_C(0xfd9f4ec1eaa824c5), UINT64_C(0x1e025d4879b3b791),
+    UINT64_C(0x11fc4f8194089106), UINT64_C(0xf2615c0807130252),
+    UINT64_C(0x0e006a124f7edc28), UINT64_C(0xed9d799bdc654f7c),
+    UINT64_C(0xe2636b5231de69eb), UINT64_C(0x01fe78dba2c5fabf),
+    UINT64_C(0xce190dab22202f04), UINT64_C(0x2d841e22b13bbc50),
+    UINT64_C(0x227a0ceb5c809ac7), UINT64_C(0xc1e71f62cf9b0993),
+    UINT64_C(0x3d86297887f6d7e9), UINT64_C(0xde1b3af114ed44bd),
+    UINT64_C(0xd1e52838f956622a), UINT64_C(0x32783bb16a4df17e),
+    UINT64_C(0x027e625f311a4db5), UINT64_C(0xe1e371d6a201dee1),
+    UINT64_C(0xee1d631f4fbaf876), UINT64_C(0x0d807096dca16b22),
+    UINT64_C(0xf1e1468c94ccb558), UINT64_C(0x127c550507d7260c),
+    UINT64_C(0x1d8247ccea6c009b), UINT64_C(0xfe1f5445797793cf),
+    UINT64_C(0x7d8ef4105cc3790d), UINT64_C(0x9e13e799cfd8ea59),
+    UINT64_C(0x91edf5502263ccce), UINT64_C(0x7270e6d9b1785f9a),
+    UINT64_C(0x8e11d0c3f91581e0), UINT64_C(0x6d8cc34a6a0e12b4),
+    UINT64_C(0x6272d18387b53423), UINT64_C(0x81efc20a14aea777),
+    UINT64_C(0xb1e99be44ff91bbc), UINT64_C(0x5274886ddce288e8),
+    UINT64_C(0x5d8a9aa43159ae7f), UINT64_C(0xbe17892da2423d2b),
+    UINT64_C(0x4276bf37ea2fe351), UINT64_C(0xa1ebacbe79347005),
+    UINT64_C(0xae15be77948f5692), UINT64_C(0x4d88adfe0794c5c6),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0x62a95de6e302eff2),
+    UINT64_C(0xc552bbcdc605dfe4), UINT64_C(0xa7fbe62b25073016),
+    UINT64_C(0xa1fc51c8d49c2ca3), UINT64_C(0xc3550c2e379ec351),
+    UINT64_C(0x64aeea051299f347), UINT64_C(0x0607b7e3f19b1cb5),
+    UINT64_C(0x68a185c2f1afca2d), UINT64_C(0x0a08d82412ad25df),
+    UINT64_C(0xadf33e0f37aa15c9), UINT64_C(0xcf5a63e9d4a8fa3b),
+    UINT64_C(0xc95dd40a2533e68e), UINT64_C(0xabf489ecc631097c),
+    UINT64_C(0x0c0f6fc7e336396a), UINT64_C(0x6ea632210034d698),
+    UINT64_C(0xd1430b85e35f945a), UINT64_C(0xb3ea5663005d7ba8),
+    UINT64_C(0x1411b048255a4bbe), UINT64_C(0x76b8edaec658a44c),
+    UINT64_C(0x70bf5a4d37c3b8f9), UINT64_C(0x121607abd4c1570b),
+    UINT64_C(0xb5ede180f1c6671d), UINT64_C(0xd744bc6612c488ef),
+    UINT64_C(0xb9e28e4712f05e77), UINT64_C(0xdb4bd3a1f1f2b185),
+    UINT64_C(0x7cb0358ad4f58193), UINT64_C(0x1e19686c37f76e61),
+    UINT64_C(0x181edf8fc66c72d4), UINT64_C(0x7ab78269256e9d26),
+    UINT64_C(0xdd4c64420069ad30), UINT64_C(0xbfe539a4e36b42c2),
+    UINT64_C(0x89df31589e28bbdf), UINT64_C(0xeb766cbe7d2a542d),
+    UINT64_C(0x4c8d8a95582d643b), UINT64_C(0x2e24d773bb2f8bc9),
+    UINT64_C(0x282360904ab4977c), UINT64_C(0x4a8a3d76a9b6788e),
+    UINT64_C(0xed71db5d8cb14898), UINT64_C(0x8fd886bb6fb3a76a),
+    UINT64_C(0xe17eb49a6f8771f2), UINT64_C(0x83d7e97c8c859e00),
+    UINT64_C(0x242c0f57a982ae16), UINT64_C(0x468552b14a8041e4),
+    UINT64_C(0x4082e552bb1b5d51), UINT64_C(0x222bb8b45819b2a3),
+    UINT64_C(0x85d05e9f7d1e82b5), UINT64_C(0xe77903799e1c6d47),
+    UINT64_C(0x589c3add7d772f85), UINT64_C(0x3a35673b9e75c077),
+    UINT64_C(0x9dce8110bb72f061), UINT64_C(0xff67dcf658701f93),
+    UINT64_C(0xf9606b15a9eb0326), UINT64_C(0x9bc936f34ae9ecd4),
+    UINT64_C(0x3c32d0d86feedcc2), UINT64_C(0x5e9b8d3e8cec3330),
+    UINT64_C(0x303dbf1f8cd8e5a8), UINT64_C(0x5294e2f96fda0a5a),
+    UINT64_C(0xf56f04d24add3a4c), UINT64_C(0x97c65934a9dfd5be),
+    UINT64_C(0x91c1eed75844c90b), UINT64_C(0xf368b331bb4626f9),
+    UINT64_C(0x5493551a9e4116ef), UINT64_C(0x363a08fc7d43f91d),
+    UINT64_C(0x38e744e264c6e4d5), UINT64_C(0x5a4e190487c40b27),
+    UINT64_C(0xfdb5ff2fa2c33b31), UINT64_C(0x9f1ca2c941c1d4c3),
+    UINT64_C(0x991b152ab05ac876), UINT64_C(0xfbb248cc53582784),
+    UINT64_C(0x5c49aee7765f1792), UINT64_C(0x3ee0f301955df860),
+    UINT64_C(0x5046c12095692ef8), UINT64_C(0x32ef9cc6766bc10a),
+    UINT64_C(0x95147aed536cf11c), UINT64_C(0xf7bd270bb06e1eee),
+    UINT64_C(0xf1ba90e841f5025b), UINT64_C(0x9313cd0ea2f7eda9),
+    UINT64_C(0x34e82b2587f0ddbf), UINT64_C(0x564176c364f2324d),
+    UINT64_C(0xe9a44f678799708f), UINT64_C(0x8b0d1281649b9f7d),
+    UINT64_C(0x2cf6f4aa419caf6b), UINT64_C(0x4e5fa94ca29e4099),
+    UINT64_C(0x48581eaf53055c2c), UINT64_C(0x2af14349b007b3de),
+    UINT64_C(0x8d0aa562950083c8), UINT64_C(0xefa3f88476026c3a),
+    UINT64_C(0x8105caa57636baa2), UINT64_C(0xe3ac974395345550),
+    UINT64_C(0x44577168b0336546), UINT64_C(0x26fe2c8e53318ab4),
+    UINT64_C(0x20f99b6da2aa9601), UINT64_C(0x4250c68b41a879f3),
+    UINT64_C(0xe5ab20a064af49e5), UINT64_C(0x87027d4687ada617),
+    UINT64_C(0xb13875bafaee5f0a), UINT64_C(0xd391285c19ecb0f8),
+    UINT64_C(0x746ace773ceb80ee), UINT64_C(0x16c39391dfe96f1c),
+    UINT64_C(0x10c424722e7273a9), UINT64_C(0x726d7994cd709c5b),
+    UINT64_C(0xd5969fbfe877ac4d), UINT64_C(0xb73fc2590b7543bf),
+    UINT64_C(0xd999f0780b419527), UINT64_C(0xbb30ad9ee8437ad5),
+    UINT64_C(0x1ccb4bb5cd444ac3), UINT64_C(0x7e6216532e46a531),
+    UINT64_C(0x7865a1b0dfddb984), UINT64_C(0x1accfc563cdf5676),
+    UINT64_C(0xbd371a7d19d86660), UINT64_C(0xdf9e479bfada8992),
+    UINT64_C(0x607b7e3f19b1cb50), UINT64_C(0x02d223d9fab324a2),
+    UINT64_C(0xa529c5f2dfb414b4), UINT64_C(0xc78098143cb6fb46),
+    UINT64_C(0xc1872ff7cd2de7f3), UINT64_C(0xa32e72112e2f0801),
+    UINT64_C(0x04d5943a0b283817), UINT64_C(0x667cc9dce82ad7e5),
+    UINT64_C(0x08dafbfde81e017d), UINT64_C(0x6a73a61b0b1cee8f),
+    UINT64_C(0xcd8840302e1bde99), UINT64_C(0xaf211dd6cd19316b),
+    UINT64_C(0xa926aa353c822dde), UINT64_C(0xcb8ff7d3df80c22c),
+    UINT64_C(0x6c7411f8fa87f23a), UINT64_C(0x0edd4c1e19851dc8),
+    UINT64_C(0x71ce89c4c98dc9aa), UINT64_C(0x1367d4222a8f2658),
+    UINT64_C(0xb49c32090f88164e), UINT64_C(0xd6356fefec8af9bc),
+    UINT64_C(0xd032d80c1d11e509), UINT64_C(0xb29b85eafe130afb),
+    UINT64_C(0x156063c1db143aed), UINT64_C(0x77c93e273816d51f),
+    UINT64_C(0x196f0c0638220387), UINT64_C(0x7bc651e0db20ec75),
+    UINT64_C(0xdc3db7cbfe27dc63), UINT64_C(0xbe94ea2d1d253391),
+    UINT64_C(0xb8935dceecbe2f24), UINT64_C(0xda3a00280fbcc0d6),
+    UINT64_C(0x7dc1e6032abbf0c0), UINT64_C(0x1f68bbe5c9b91f32),
+    UINT64_C(0xa08d82412ad25df0), UINT64_C(0xc224dfa7c9d0b202),
+    UINT64_C(0x65df398cecd78214), UINT64_C(0x0776646a0fd56de6),
+    UINT64_C(0x0171d389fe4e7153), UINT64_C(0x63d88e6f1d4c9ea1),
+    UINT64_C(0xc4236844384baeb7), UINT64_C(0xa68a35a2db494145),
+    UINT64_C(0xc82c0783db7d97dd), UINT64_C(0xaa855a65387f782f),
+    UINT64_C(0x0d7ebc4e1d784839), UINT64_C(0x6fd7e1a8fe7aa7cb),
+    UINT64_C(0x69d0564b0fe1bb7e), UINT64_C(0x0b790badece3548c),
+    UINT64_C(0xac82ed86c9e4649a), UINT64_C(0xce2bb0602ae68b68),
+    UINT64_C(0xf811b89c57a57275), UINT64_C(0x9ab8e57ab4a79d87),
+    UINT64_C(0x3d43035191a0ad91), UINT64_C(0x5fea5eb772a24263),
+    UINT64_C(0x59ede95483395ed6), UINT64_C(0x3b44b4b2603bb124),
+    UINT64_C(0x9cbf5299453c8132), UINT64_C(0xfe160f7fa63e6ec0),
+    UINT64_C(0x90b03d5ea60ab858), UINT64_C(0xf21960b8450857aa),
+    UINT64_C(0x55e28693600f67bc), UINT64_C(0x374bdb75830d884e),
+    UINT64_C(0x314c6c96729694fb), UINT64_C(0x53e5317091947b09),
+    UINT64_C(0xf41ed75bb4934b1f), UINT64_C(0x96b78abd5791a4ed),
+    UINT64_C(0x2952b319b4fae62f), UINT64_C(0x4bfbeeff57f809dd),
+    UINT64_C(0xec0008d472ff39cb), UINT64_C(0x8ea9553291fdd639),
+    UINT64_C(0x88aee2d16066ca8c), UINT64_C(0xea07bf378364257e),
+    UINT64_C(0x4dfc591ca6631568), UINT64_C(0x2f5504fa4561fa9a),
+    UINT64_C(0x41f336db45552c02), UINT64_C(0x235a6b3da657c3f0),
+    UINT64_C(0x84a18d168350f3e6), UINT64_C(0xe608d0f060521c14),
+    UINT64_C(0xe00f671391c900a1), UINT64_C(0x82a63af572cbef53),
+    UINT64_C(0x255ddcde57ccdf45), UINT64_C(0x47f48138b4ce30b7),
+    UINT64_C(0x4929cd26ad4b2d7f), UINT64_C(0x2b8090c04e49c28d),
+    UINT64_C(0x8c7b76eb6b4ef29b), UINT64_C(0xeed22b0d884c1d69),
+    UINT64_C(0xe8d59cee79d701dc), UINT64_C(0x8a7cc1089ad5ee2e),
+    UINT64_C(0x2d872723bfd2de38), UINT64_C(0x4f2e7ac55cd031ca),
+    UINT64_C(0x218848e45ce4e752), UINT64_C(0x43211502bfe608a0),
+    UINT64_C(0xe4daf3299ae138b6), UINT64_C(0x8673aecf79e3d744),
+    UINT64_C(0x8074192c8878cbf1), UINT64_C(0xe2dd44ca6b7a2403),
+    UINT64_C(0x4526a2e14e7d1415), UINT64_C(0x278fff07ad7ffbe7),
+    UINT64_C(0x986ac6a34e14b925), UINT64_C(0xfac39b45ad1656d7),
+    UINT64_C(0x5d387d6e881166c1), UINT64_C(0x3f9120886b138933),
+    UINT64_C(0x3996976b9a889586), UINT64_C(0x5b3fca8d798a7a74),
+    UINT64_C(0xfcc42ca65c8d4a62), UINT64_C(0x9e6d7140bf8fa590),
+    UINT64_C(0xf0cb4361bfbb7308), UINT64_C(0x92621e875cb99cfa),
+    UINT64_C(0x3599f8ac79beacec), UINT64_C(0x5730a54a9abc431e),
+    UINT64_C(0x513712a96b275fab), UINT64_C(0x339e4f4f8825b059),
+    UINT64_C(0x9465a964ad22804f), UINT64_C(0xf6ccf4824e206fbd),
+    UINT64_C(0xc0f6fc7e336396a0), UINT64_C(0xa25fa198d0617952),
+    UINT64_C(0x05a447b3f5664944), UINT64_C(0x670d1a551664a6b6),
+    UINT64_C(0x610aadb6e7ffba03), UINT64_C(0x03a3f05004fd55f1),
+    UINT64_C(0xa458167b21fa65e7), UINT64_C(0xc6f14b9dc2f88a15),
+    UINT64_C(0xa85779bcc2cc5c8d), UINT64_C(0xcafe245a21ceb37f),
+    UINT64_C(0x6d05c27104c98369), UINT64_C(0x0fac9f97e7cb6c9b),
+    UINT64_C(0x09ab28741650702e), UINT64_C(0x6b027592f5529fdc),
+    UINT64_C(0xccf993b9d055afca), UINT64_C(0xae50ce5f33574038),
+    UINT64_C(0x11b5f7fbd03c02fa), UINT64_C(0x731caa1d333eed08),
+    UINT64_C(0xd4e74c361639dd1e), UINT64_C(0xb64e11d0f53b32ec),
+    UINT64_C(0xb049a63304a02e59), UINT64_C(0xd2e0fbd5e7a2c1ab),
+    UINT64_C(0x751b1dfec2a5f1bd), UINT64_C(0x17b2401821a71e4f),
+    UINT64_C(0x791472392193c8d7), UINT64_C(0x1bbd2fdfc2912725),
+    UINT64_C(0xbc46c9f4e7961733), UINT64_C(0xdeef94120494f8c1),
+    UINT64_C(0xd8e823f1f50fe474), UINT64_C(0xba417e17160d0b86),
+    UINT64_C(0x1dba983c330a3b90), UINT64_C(0x7f13c5dad008d462),
+  },
+  {
+    UINT64_C(0x0000000000000000), UINT64_C(0x381d0015c96f4444),
+    UINT64_C(0x703a002b92de8888), UINT64_C(0x4827003e5bb1cccc),
+    UINT64_C(0xe074005725bd1110), UINT64_C(0xd8690042ecd25554),
+    UINT64_C(0x904e007cb7639998), UINT64_C(0xa85300697e0cdddc),
+    UINT64_C(0xebb126fd13edb14b), UINT64_C(0xd3ac26e8da82f50f),
+    UINT64_C(0x9b8b26d6813339c3), UINT64_C(0xa39626c3485c7d87),
+    UINT64_C(0x0bc526aa3650a05b), UINT64_C(0x33d826bfff3fe41f),
+    UINT64_C(0x7bff2681a48e28d3), UINT64_C(0x43e226946de16c97),
+    UINT64_C(0xfc3b6ba97f4cf1fd), UINT64_C(0xc4266bbcb623b5b9),
+    UINT64_C(0x8c016b82ed927975), UINT64_C(0xb41c6b9724fd3d31),
+    UINT64_C(0x1c4f6bfe5af1e0ed), UINT64_C(0x24526beb939ea4a9),
+    UINT64_C(0x6c756bd5c82f6865), UINT64_C(0x54686bc001402c21),
+    UINT64_C(0x178a4d546ca140b6), UINT64_C(0x2f974d41a5ce04f2),
+    UINT64_C(0x67b04d7ffe7fc83e), UINT64_C(0x5fad4d6a37108c7a),
+    UINT64_C(0xf7fe4d03491c51a6), UINT64_C(0xcfe34d16807315e2),
+    UINT64_C(0x87c44d28dbc2d92e), UINT64_C(0xbfd94d3d12ad9d6a),
+    UINT64_C(0xd32ff101a60e7091), UINT64_C(0xeb32f1146f6134d5),
+    UINT64_C(0xa315f12a34d0f819), UINT64_C(0x9b08f13ffdbfbc5d),
+    UINT64_C(0x335bf15683b36181), UINT64_C(0x0b46f1434adc25c5),
+    UINT64_C(0x4361f17d116de909), UINT64_C(0x7b7cf168d802ad4d),
+    UINT64_C(0x389ed7fcb5e3c1da), UINT64_C(0x0083d7e97c8c859e),
+    UINT64_C(0x48a4d7d7273d4952), UINT64_C(0x70b9d7c2ee520d16),
+    UINT64_C(0xd8ead7ab905ed0ca), UINT64_C(0xe0f7d7be5931948e),
+    UINT64_C(0xa8d0d78002805842), UINT64_C(0x90cdd795cbef1c06),
+    UINT64_C(0x2f149aa8d942816c), UINT64_C(0x17099abd102dc528),
+    UINT64_C(0x5f2e9a834b9c09e4), UINT64_C(0x67339a9682f34da0),
+    UINT64_C(0xcf609afffcff907c), UINT64_C(0xf77d9aea3590d438),
+    UINT64_C(0xbf5a9ad46e2118f4), UINT64_C(0x87479ac1a74e5cb0),
+    UINT64_C(0xc4a5bc55caaf3027), UINT64_C(0xfcb8bc4003c07463),
+    UINT64_C(0xb49fbc7e5871b8af), UINT64_C(0x8c82bc6b911efceb),
+    UINT64_C(0x24d1bc02ef122137), UINT64_C(0x1cccbc17267d6573),
+    UINT64_C(0x54ebbc297dcca9bf), UINT64_C(0x6cf6bc3cb4a3edfb),
+    UINT64_C(0x8d06c450148b7249), UINT64_C(0xb51bc445dde4360d),
+    UINT64_C(0xfd3cc47b8655fac1), UINT64_C(0xc521c46e4f3abe85),
+    UINT64_C(0x6d72c40731366359), UINT64_C(0x556fc412f859271d),
+    UINT64_C(0x1d48c42ca3e8ebd1), UINT64_C(0x2555c4396a87af95),
+    UINT64_C(0x66b7e2ad0766c302), UINT64_C(0x5eaae2b8ce098746),
+    UINT64_C(0x168de28695b84b8a), UINT64_C(0x2e90e2935cd70fce),
+    UINT64_C(0x86c3e2fa22dbd212), UINT64_C(0xbedee2efebb49656),
+    UINT64_C(0xf6f9e2d1b0055a9a), UINT64_C(0xcee4e2c4796a1ede),
+    UINT64_C(0x713daff96bc783b4), UINT64_C(0x4920afeca2a8c7f0),
+    UINT64_C(0x0107afd2f9190b3c), UINT64_C(0x391aafc730764f78),
+    UINT64_C(0x9149afae4e7a92a4), UINT64_C(0xa954afbb8715d6e0),
+    UINT64_C(0xe173af85dca41a2c), UINT64_C(0xd96eaf9015cb5e68),
+    UINT64_C(0x9a8c8904782a32ff), UINT64_C(0xa2918911b14576bb),
+    UINT64_C(0xeab6892feaf4ba77), UINT64_C(0xd2ab893a239bfe33),
+    UINT64_C(0x7af889535d9723ef), UINT64_C(0x42e5894694f867ab),
+    UINT64_C(0x0ac28978cf49ab67), UINT64_C(0x32df896d0626ef23),
+    UINT64_C(0x5e293551b28502d8), UINT64_C(0x663435447bea469c),
+    UINT64_C(0x2e13357a205b8a50), UINT64_C(0x160e356fe934ce14),
+    UINT64_C(0xbe5d3506973813c8), UINT64_C(0x864035135e57578c),
+    UINT64_C(0xce67352d05e69b40), UINT64_C(0xf67a3538cc89df04),
+    UINT64_C(0xb59813aca168b393), UINT64_C(0x8d8513b96807f7d7),
+    UINT64_C(0xc5a2138733b63b1b), UINT64_C(0xfdbf1392fad97f5f),
+    UINT64_C(0x55ec13fb84d5a283), UINT64_C(0x6df113ee4dbae6c7),
+    UINT64_C(0x25d613d0160b2a0b), UINT64_C(0x1dcb13c5df646e4f),
+    UINT64_C(0xa2125ef8cdc9f325), UINT64_C(0x9a0f5eed04a6b761),
+    UINT64_C(0xd2285ed35f177bad), UINT64_C(0xea355ec696783fe9),
+    UINT64_C(0x42665eafe874e235), UINT64_C(0x7a7b5eba211ba671),
+    UINT64_C(0x325c5e847aaa6abd), UINT64_C(0x0a415e91b3c52ef9),
+    UINT64_C(0x49a37805de24426e), UINT64_C(0x71be7810174b062a),
+    UINT64_C(0x3999782e4cfacae6), UINT64_C(0x0184783b85958ea2),
+    UINT64_C(0xa9d77852fb99537e), UINT64_C(0x91ca784732f6173a),
+    UINT64_C(0xd9ed78796947dbf6), UINT64_C(0xe1f0786ca0289fb2),
+    UINT64_C(0x3154aef3718177f9), UINT64_C(0x0949aee6b8ee33bd),
+    UINT64_C(0x416eaed8e35fff71), UINT64_C(0x7973aecd2a30bb35),
+    UINT64_C(0xd120aea4543c66e9), UINT64_C(0xe93daeb19d5322ad),
+    UINT64_C(0xa11aae8fc6e2ee61), UINT64_C(0x9907ae9a0f8daa25),
+    UINT64_C(0xdae5880e626cc6b2), UINT64_C(0xe2f8881bab0382f6),
+    UINT64_C(0xaadf8825f0b24e3a), UINT64_C(0x92c2883039dd0a7e),
+    UINT64_C(0x3a91885947d1d7a2), UINT64_C(0x028c884c8ebe93e6),
+    UINT64_C(0x4aab8872d50f5f2a), UINT64_C(0x72b688671c601b6e),
+    UINT64_C(0xcd6fc55a0ecd8604), UINT64_C(0xf572c54fc7a2c240),
+    UINT64_C(0xbd55c5719c130e8c), UINT64_C(0x8548c564557c4ac8),
+    UINT64_C(0x2d1bc50d2b709714), UINT64_C(0x1506c518e21fd350),
+    UINT64_C(0x5d21c526b9ae1f9c), UINT64_C(0x653cc53370c15bd8),
+    UINT64_C(0x26dee3a71d20374f), UINT64_C(0x1ec3e3b2d44f730b),
+    UINT64_C(0x56e4e38c8ffebfc7), UINT64_C(0x6ef9e3994691fb83),
+    UINT64_C(0xc6aae3f0389d265f), UINT64_C(0xfeb7e3e5f1f2621b),
+    UINT64_C(0xb690e3dbaa43aed7), UINT64_C(0x8e8de3ce632cea93),
+    UINT64_C(0xe27b5ff2d78f0768), UINT64_C(0xda665fe71ee0432c),
+    UINT64_C(0x92415fd945518fe0), UINT64_C(0xaa5c5fcc8c3ecba4),
+    UINT64_C(0x020f5fa5f2321678), UINT64_C(0x3a125fb03b5d523c),
+    UINT64_C(0x72355f8e60ec9ef0), UINT64_C(0x4a285f9ba983dab4),
+    UINT64_C(0x09ca790fc462b623), UINT64_C(0x31d7791a0d0df267),
+    UINT64_C(0x79f0792456bc3eab), UINT64_C(0x41ed79319fd37aef),
+    UINT64_C(0xe9be7958e1dfa733), UINT64_C(0xd1a3794d28b0e377),
+    UINT64_C(0x9984797373012fbb), UINT64_C(0xa1997966ba6e6bff),
+    UINT64_C(0x1e40345ba8c3f695), UINT64_C(0x265d344e61acb2d1),
+    UINT64_C(0x6e7a34703a1d7e1d), UINT64_C(0x56673465f3723a59),
+    UINT64_C(0xfe34340c8d7ee785), UINT64_C(0xc62934194411a3c1),
+    UINT64_C(0x8e0e34271fa06f0d), UINT64_C(0xb6133432d6cf2b49),
+    UINT64_C(0xf5f112a6bb2e47de), UINT64_C(0xcdec12b37241039a),
+    UINT64_C(0x85cb128d29f0cf56), UINT64_C(0xbdd61298e09f8b12),
+    UINT64_C(0x158512f19e9356ce), UINT64_C(0x2d9812e457fc128a),
+    UINT64_C(0x65bf12da0c4dde46), UINT64_C(0x5da212cfc5229a02),
+    UINT64_C(0xbc526aa3650a05b0), UINT64_C(0x844f6ab6ac6541f4),
+    UINT64_C(0xcc686a88f7d48d38), UINT64_C(0xf4756a9d3ebbc97c),
+    UINT64_C(0x5c266af440b714a0), UINT64_C(0x643b6ae189d850e4),
+    UINT64_C(0x2c1c6adfd2699c28), UINT64_C(0x14016aca1b06d86c),
+    UINT64_C(0x57e34c5e76e7b4fb), UINT64_C(0x6ffe4c4bbf88f0bf),
+    UINT64_C(0x27d94c75e4393c73), UINT64_C(0x1fc44c602d567837),
+    UINT64_C(0xb7974c09535aa5eb), UINT64_C(0x8f8a4c1c9a35e1af),
+    UINT64_C(0xc7ad4c22c1842d63), UINT64_C(0xffb04c3708eb6927),
+    UINT64_C(0x4069010a1a46f44d), UINT64_C(0x7874011fd329b009),
+    UINT64_C(0x3053012188987cc5), UINT64_C(0x084e013441f73881),
+    UINT64_C(0xa01d015d3ffbe55d), UINT64_C(0x98000148f694a119),
+    UINT64_C(0xd0270176ad256dd5), UINT64_C(0xe83a0163644a2991),
+    UINT64_C(0xabd827f709ab4506), UINT64_C(0x93c527e2c0c40142),
+    UINT64_C(0xdbe227dc9b75cd8e), UINT64_C(0xe3ff27c9521a89ca),
+    UINT64_C(0x4bac27a02c165416), UINT64_C(0x73b127b5e5791052),
+    UINT64_C(0x3b96278bbec8dc9e), UINT64_C(0x038b279e77a798da),
+    UINT64_C(0x6f7d9ba2c3047521), UINT64_C(0x57609bb70a6b3165),
+    UINT64_C(0x1f479b8951dafda9), UINT64_C(0x275a9b9c98b5b9ed),
+    UINT64_C(0x8f099bf5e6b96431), UINT64_C(0xb7149be02fd62075),
+    UINT64_C(0xff339bde7467ecb9), UINT64_C(0xc72e9bcbbd08a8fd),
+    UINT64_C(0x84ccbd5fd0e9c46a), UINT64_C(0xbcd1bd4a1986802e),
+    UINT64_C(0xf4f6bd7442374ce2), UINT64_C(0xccebbd618b5808a6),
+    UINT64_C(0x64b8bd08f554d57a), UINT64_C(0x5ca5bd1d3c3b913e),
+    UINT64_C(0x1482bd23678a5df2), UINT64_C(0x2c9fbd36aee519b6),
+    UINT64_C(0x9346f00bbc4884dc), UINT64_C(0xab5bf01e7527c098),
+    UINT64_C(0xe37cf0202e960c54), UINT64_C(0xdb61f035e7f94810),
+    UINT64_C(0x7332f05c99f595cc), UINT64_C(0x4b2ff049509ad188),
+    UINT64_C(0x0308f0770b2b1d44), UINT64_C(0x3b15f062c2445900),
+    UINT64_C(0x78f7d6f6afa53597), UINT64_C(0x40ead6e366ca71d3),
+    UINT64_C(0x08cdd6dd3d7bbd1f), UINT64_C(0x30d0d6c8f414f95b),
+    UINT64_C(0x9883d6a18a182487), UINT64_C(0xa09ed6b4437760c3),
+    UINT64_C(0xe8b9d68a18c6ac0f), UINT64_C(0xd0a4d69fd1a9e84b),
+  }
 };
 
 
 /* CRC needs to be inited (eg to 0). There is no XOR-out operation so this
  * function may be called multiple times to generate a CRC on large data */
 uint64_t crc64(uint64_t crc, const unsigned char *s, unsigned int len) {
-  unsigned int i;
+  /* eight bytes at a time */
+  while (len >= 8) {
+    crc ^= (uint64_t)s[0] | ((uint64_t)s[1] << 8) | ((uint64_t)s[2] << 16) | ((uint64_t)s[3] << 24) | ((uint64_t)s[4] << 32) | ((uint64_t)s[5] << 40) | ((uint64_t)s[6] << 48) | ((uint64_t)s[7] << 56);
+    crc = crc64_tab[7][crc & 0xff] ^ crc64_tab[6][(crc >> 8) & 0xff] ^ crc64_tab[5][(crc >> 16) & 0xff] ^ crc64_tab[4][(crc >> 24) & 0xff] ^ crc64_tab[3][(crc >> 32) & 0xff] ^ crc64_tab[2][(crc >> 40) & 0xff] ^ crc64_tab[1][(crc >> 48) & 0xff] ^ crc64_tab[0][crc >> 56];
+    s += 8;
+    len -= 8;
+  }
 
-  for (i = 0; i < len; i++) {
-    uint8_t byte = s[i];
-    crc = crc64_tab[(uint8_t)crc ^ byte] ^ (crc >> 8);
+  /* then the remaining bytes one by one */
+  while (len-- > 0) {
+    crc = crc64_tab[0][(uint8_t)crc ^ *s] ^ (crc >> 8);
+    s += 1;
   }
   return(crc);
 }
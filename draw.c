@@ -0,0 +1,645 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>    /* sprintf(), snprintf() */
+#include <stdlib.h>   /* malloc(), free() */
+#include <string.h>   /* strdup(), strcmp() */
+#include <time.h>     /* time() */
+
+#include "compat-sdl.h"
+#include "gra.h"
+#include "movelist.h"
+#include "perf.h"
+#include "skin.h"
+#include "sok_core.h"
+
+#include "draw.h" /* include self for control */
+
+#include "dbg.h"
+
+
+#define DRAWPLAYFIELDTILE_DRAWATOM 1
+#define DRAWPLAYFIELDTILE_PUSH 2
+
+#define FONT_SPACE_WIDTH 12
+#define FONT_KERNING -3
+
+
+/* provides width and height of a string (in pixels) */
+void draw_stringsize(const char *string, int fontsize, const struct spritesstruct *sprites, int *w, int *h) {
+  int glyphw, glyphh;
+  *w = 0;
+  *h = 0;
+  while (*string != 0) {
+    if (*string == ' ') {
+      *w += FONT_SPACE_WIDTH * fontsize / 100;
+    } else {
+      glyphw = sprites->glyph[(unsigned char)(*string)].w;
+      glyphh = sprites->glyph[(unsigned char)(*string)].h;
+      *w += glyphw * fontsize / 100 + FONT_KERNING * fontsize / 100;
+      if (glyphh * fontsize / 100 > *h) *h = glyphh * fontsize / 100;
+    }
+    string += 1;
+  }
+}
+
+/* explode a string into wordwrapped substrings */
+static void wordwrap(const char *string, char **multiline, int maxlines, int maxwidth, int fontsize, const struct spritesstruct *sprites) {
+  int lastspace, multilineid;
+  int x, stringw, stringh;
+  char *tmpstring;
+  /* set all multiline entries to NULL */
+  for (x = 0; x < maxlines; x++) multiline[x] = NULL;
+
+  /* find the next word boundary */
+  lastspace = -1;
+  multilineid = 0;
+  for (;;) { /* loop on every word, and check if we reached the end */
+    for (x = lastspace + 1; ; x++) {
+      if ((string[x] == ' ') || (string[x] == '\t') || (string[x] == '\n') || (string[x] == 0)) {
+        lastspace = x;
+        break;
+      }
+    }
+    /* is this word boundary fitting on screen? */
+    tmpstring = strdup(string);
+    tmpstring[lastspace] = 0;
+    draw_stringsize(tmpstring, fontsize, sprites, &stringw, &stringh);
+    if (stringw < maxwidth) {
+      if (multiline[multilineid] != NULL) free(multiline[multilineid]);
+      multiline[multilineid] = tmpstring;
+    } else {
+      free(tmpstring);
+      if (multiline[multilineid] == NULL) break;
+      lastspace = -1;
+      string += strlen(multiline[multilineid]) + 1;
+      multilineid += 1;
+      if (multilineid >= maxlines) {
+        size_t lastlinelen = strlen(multiline[multilineid - 1]);
+        /* if text have been truncated, print '...' at the end of the last line */
+        if (lastlinelen >= 3) {
+          multiline[multilineid - 1][lastlinelen - 3] = '.';
+          multiline[multilineid - 1][lastlinelen - 2] = '.';
+          multiline[multilineid - 1][lastlinelen - 1] = '.';
+        }
+        break;
+      }
+    }
+    if ((lastspace >= 0) && (string[lastspace] == 0)) break;
+  }
+}
+
+/* strings are laid out (word wrapped, measured, and turned into a list of
+ * glyph rectangles) once, and the resulting text runs are kept in a cache.
+ * drawing a string that was drawn before costs then only the blits of its
+ * glyphs. the least recently used run is evicted when the cache is full. */
+#define TEXTRUN_CACHESIZE 64
+#define TEXTRUN_MAXLINES 16
+
+static struct textrun {
+  char *text;               /* NULL for an empty slot */
+  unsigned long hash;
+  const struct spritesstruct *sprites;
+  int fontsize;
+  int maxwidth;
+  int maxlines;
+  int linecount;
+  struct {
+    int w, h;               /* size of the line, in pixels */
+    int first, count;       /* glyphs of the line */
+  } line[TEXTRUN_MAXLINES];
+  SDL_Rect *src;            /* glyphs in the font atlas */
+  SDL_Rect *dst;            /* glyphs on screen, relative to their line's position */
+  unsigned long lastuse;
+} textruns[TEXTRUN_CACHESIZE];
+
+static unsigned long textrunclock;
+
+/* drops all text runs */
+static void textrun_free(void) {
+  int i;
+  for (i = 0; i < TEXTRUN_CACHESIZE; i++) {
+    free(textruns[i].text);
+    free(textruns[i].src);
+    free(textruns[i].dst);
+    textruns[i].text = NULL;
+    textruns[i].src = NULL;
+    textruns[i].dst = NULL;
+  }
+}
+
+/* returns the text run of string, laying it out first if needed. returns
+ * NULL on out of memory. */
+static struct textrun *textrun_get(const char *string, int fontsize, const struct spritesstruct *sprites, int maxwidth, int maxlines) {
+  struct textrun *t = &(textruns[0]);
+  unsigned long hash = 2166136261lu; /* FNV-1a */
+  char *multiline[TEXTRUN_MAXLINES];
+  const char *s;
+  int i, l, glyphs;
+
+  for (s = string; *s != 0; s++) hash = ((hash ^ (unsigned char)*s) * 16777619lu) & 0xfffffffflu;
+
+  for (i = 0; i < TEXTRUN_CACHESIZE; i++) {
+    struct textrun *c = &(textruns[i]);
+    if ((c->text != NULL) && (c->hash == hash) && (c->sprites == sprites) && (c->fontsize == fontsize) && (c->maxwidth == maxwidth) && (c->maxlines == maxlines) && (strcmp(c->text, string) == 0)) {
+      c->lastuse = ++textrunclock;
+      return(c);
+    }
+    /* remember the empty or least recently used slot */
+    if ((t->text != NULL) && ((c->text == NULL) || (c->lastuse < t->lastuse))) t = c;
+  }
+
+  /* lay the string out */
+  free(t->text);
+  free(t->src);
+  free(t->dst);
+  t->text = strdup(string);
+  t->src = NULL;
+  t->dst = NULL;
+  if (t->text == NULL) return(NULL);
+  wordwrap(string, multiline, maxlines, maxwidth, fontsize, sprites);
+  for (glyphs = 0, l = 0; (l < maxlines) && (multiline[l] != NULL); l++) {
+    for (s = multiline[l]; *s != 0; s++) if (*s != ' ') glyphs++;
+  }
+  t->src = malloc(sizeof(SDL_Rect) * (glyphs + 1));
+  t->dst = malloc(sizeof(SDL_Rect) * (glyphs + 1));
+  if ((t->src == NULL) || (t->dst == NULL)) {
+    for (l = 0; (l < maxlines) && (multiline[l] != NULL); l++) free(multiline[l]);
+    free(t->text);
+    t->text = NULL;
+    return(NULL);
+  }
+  t->hash = hash;
+  t->sprites = sprites;
+  t->fontsize = fontsize;
+  t->maxwidth = maxwidth;
+  t->maxlines = maxlines;
+  t->lastuse = ++textrunclock;
+  for (glyphs = 0, l = 0; (l < maxlines) && (multiline[l] != NULL); l++) {
+    int x = 0;
+    draw_stringsize(multiline[l], fontsize, sprites, &(t->line[l].w), &(t->line[l].h));
+    t->line[l].first = glyphs;
+    for (s = multiline[l]; *s != 0; s++) {
+      if (*s == ' ') {
+        x += FONT_SPACE_WIDTH * fontsize / 100;
+        continue;
+      }
+      t->src[glyphs] = sprites->glyph[(unsigned char)*s];
+      t->dst[glyphs].x = x;
+      t->dst[glyphs].y = 0;
+      t->dst[glyphs].w = t->src[glyphs].w * fontsize / 100;
+      t->dst[glyphs].h = t->src[glyphs].h * fontsize / 100;
+      x += t->dst[glyphs].w + (FONT_KERNING * fontsize / 100);
+      glyphs++;
+    }
+    t->line[l].count = glyphs - t->line[l].first;
+    /* free the multiline memory */
+    free(multiline[l]);
+  }
+  t->linecount = l;
+  return(t);
+}
+
+/* blits a string onscreen, scaling the font at fontsize percents. The string is placed at starting position x/y */
+void draw_string(const char *orgstring, int fontsize, unsigned char alpha, struct spritesstruct *sprites, SDL_Renderer *renderer, int x, int y, SDL_Window *window, int maxlines, int pheight) {
+  int i, l, winw, winh;
+  SDL_Rect rectdst;
+  struct textrun *run;
+  if (maxlines > TEXTRUN_MAXLINES) maxlines = TEXTRUN_MAXLINES;
+  /* get size of the window */
+  SDL_GetWindowSize(window, &winw, &winh);
+  run = textrun_get(orgstring, fontsize, sprites, winw - x, maxlines);
+  if (run == NULL) return;
+  SDL_SetTextureAlphaMod(sprites->fontatlas, alpha);
+  /* loop on every line */
+  for (l = 0; l < run->linecount; l++) {
+    if (l > 0) y += pheight;
+    /* if centering is requested, use the size of the string */
+    if ((x < 0) || (y < 0)) {
+      if (x == DRAWSTRING_CENTER) x = (winw - run->line[l].w) >> 1;
+      if (x == DRAWSTRING_RIGHT) x = winw - run->line[l].w - 10;
+      if (y == DRAWSTRING_BOTTOM) y = winh - run->line[l].h;
+      if (y == DRAWSTRING_CENTER) y = (winh - run->line[l].h) / 2;
+    }
+    for (i = run->line[l].first; i < run->line[l].first + run->line[l].count; i++) {
+      rectdst = run->dst[i];
+      rectdst.x += x;
+      rectdst.y += y;
+      perf_count(perf_drawcall);
+      CSDL_RenderTexture(renderer, sprites->fontatlas, &(run->src[i]), &rectdst);
+    }
+  }
+}
+
+
+int draw_offseth(const struct sokgame *game, int winw, unsigned short tilesize) {
+  /* if playfield is smaller than the screen */
+  if (game->field_width * tilesize <= winw) return((winw / 2) - (game->field_width * tilesize / 2));
+  /* if playfield is larger than the screen */
+  if (game->positionx * tilesize + (tilesize / 2) > (winw / 2)) {
+    int res = (winw / 2) - (game->positionx * tilesize + (tilesize / 2));
+    if ((game->field_width * tilesize) + res < winw) res = winw - (game->field_width * tilesize);
+    return(res);
+  }
+  return(0);
+}
+
+int draw_offsetv(const struct sokgame *game, int winh, int tilesize) {
+  /* if playfield is smaller than the screen */
+  if (game->field_height * tilesize <= winh) return((winh / 2) - (game->field_height * tilesize / 2));
+  /* if playfield is larger than the screen */
+  if (game->positiony * tilesize + (tilesize / 2) > winh / 2) {
+    int res = (winh / 2) - (game->positiony * tilesize + (tilesize / 2));
+    if ((game->field_height * tilesize) + res < winh) res = winh - (game->field_height * tilesize);
+    return(res);
+  }
+  return(0);
+}
+
+
+static void draw_playfield_tile(const struct sokgame *game, int x, int y, struct spritesstruct *sprites, SDL_Renderer *renderer, int winw, int winh, const struct videosettings *settings, int flags, int moveoffsetx, int moveoffsety) {
+  int xpix, ypix;
+  /* compute the pixel coordinates of the destination field */
+  xpix = draw_offseth(game, winw, settings->tilesize) + (x * settings->tilesize) + moveoffsetx;
+  ypix = draw_offsetv(game, winh, settings->tilesize) + (y * settings->tilesize) + moveoffsety;
+
+  if ((flags & DRAWPLAYFIELDTILE_DRAWATOM) == 0) {
+    if (SOK_FIELD(game, x, y) & field_floor) gra_rendertile(renderer, sprites, SPRITE_FLOOR, xpix, ypix, settings->tilesize, 0);
+    if (SOK_FIELD(game, x, y) & field_goal) gra_rendertile(renderer, sprites, SPRITE_GOAL, xpix, ypix, settings->tilesize, 0);
+    if (SOK_FIELD(game, x, y) & field_wall) gra_renderwall(renderer, sprites, SOK_WALLMASK(game, x, y), xpix, ypix, settings->tilesize);
+  } else if (SOK_FIELD(game, x, y) & field_atom) {
+    unsigned short boxsprite = SPRITE_BOX;
+    if (SOK_FIELD(game, x, y) & field_goal) {
+      boxsprite = SPRITE_BOXOK;
+      if (flags & DRAWPLAYFIELDTILE_PUSH) {
+        if ((game->positionx == x - 1) && (game->positiony == y) && (moveoffsetx > 0) && ((SOK_FIELD(game, x + 1, y) & field_goal) == 0)) boxsprite = SPRITE_BOX;
+        if ((game->positionx == x + 1) && (game->positiony == y) && (moveoffsetx < 0) && ((SOK_FIELD(game, x - 1, y) & field_goal) == 0)) boxsprite = SPRITE_BOX;
+        if ((game->positionx == x) && (game->positiony == y - 1) && (moveoffsety > 0) && ((SOK_FIELD(game, x, y + 1) & field_goal) == 0)) boxsprite = SPRITE_BOX;
+        if ((game->positionx == x) && (game->positiony == y + 1) && (moveoffsety < 0) && ((SOK_FIELD(game, x, y - 1) & field_goal) == 0)) boxsprite = SPRITE_BOX;
+      }
+    }
+    gra_rendertile(renderer, sprites, boxsprite, xpix, ypix, settings->tilesize, 0);
+  }
+}
+
+static void draw_player(const struct sokgame *game, const struct sokgamestates *states, struct spritesstruct *sprites, SDL_Renderer *renderer, int winw, int winh, const struct videosettings *settings, int offsetx, int offsety) {
+  SDL_Rect rect;
+  unsigned short playersprite = SPRITE_PLAYERUP;
+  int angle = states->angle;
+
+  /* compute the dst rect */
+  rect.x = draw_offseth(game, winw, settings->tilesize) + (game->positionx * settings->tilesize) + offsetx;
+  rect.y = draw_offsetv(game, winh, settings->tilesize) + (game->positiony * settings->tilesize) + offsety;
+  rect.w = settings->tilesize;
+  rect.h = settings->tilesize;
+
+  if ((sprites->flags & SPRITES_FLAG_PLAYERROTATE) == 0) {
+    switch (states->angle) {
+      case 0:
+        playersprite = SPRITE_PLAYERUP;
+        break;
+      case 90:
+        playersprite = SPRITE_PLAYERRIGHT;
+        break;
+      case 180:
+        playersprite = SPRITE_PLAYERDOWN;
+        break;
+      case 270:
+        playersprite = SPRITE_PLAYERLEFT;
+        break;
+    }
+    angle = 0;
+  }
+
+  /* if player happens to be on a goal, then use the special "player on goal" version of the sprite */
+  if (SOK_FIELD(game, game->positionx, game->positiony) & field_goal) playersprite += 4;
+
+  gra_rendertile(renderer, sprites, playersprite, rect.x, rect.y, settings->tilesize, angle);
+}
+
+
+/* the static layer of the playfield (floors, goals and walls) is rendered once
+ * into a texture, then draw_screen() blits it in a single call for as long as
+ * the level, the tile size and the skin stay the same */
+static struct {
+  int valid;
+  SDL_Texture *tex; /* NULL if no texture could be created for this layer */
+  const struct spritesstruct *sprites;
+  uint64_t crc64;
+  unsigned short width;
+  unsigned short height;
+  unsigned short tilesize;
+} staticlayer;
+
+/* drops the static layer, forcing it to be rendered again on next use */
+static void staticlayer_free(void) {
+  if (staticlayer.tex != NULL) SDL_DestroyTexture(staticlayer.tex);
+  staticlayer.tex = NULL;
+  staticlayer.valid = 0;
+}
+
+/* returns the static layer texture of game, rendering it first if needed.
+ * returns NULL if the renderer cannot provide such texture (too large, no
+ * render target support...), tiles must then be drawn one by one. */
+static SDL_Texture *staticlayer_get(const struct sokgame *game, struct spritesstruct *sprites, SDL_Renderer *renderer, const struct videosettings *settings) {
+  int x, y, w, h;
+
+  if ((staticlayer.valid != 0) && (staticlayer.sprites == sprites) && (staticlayer.crc64 == game->crc64) && (staticlayer.width == game->field_width) && (staticlayer.height == game->field_height) && (staticlayer.tilesize == settings->tilesize)) {
+    return(staticlayer.tex);
+  }
+
+  staticlayer_free();
+  staticlayer.valid = 1;
+  staticlayer.sprites = sprites;
+  staticlayer.crc64 = game->crc64;
+  staticlayer.width = game->field_width;
+  staticlayer.height = game->field_height;
+  staticlayer.tilesize = settings->tilesize;
+
+  w = game->field_width * settings->tilesize;
+  h = game->field_height * settings->tilesize;
+  if ((w == 0) || (h == 0)) return(NULL);
+  staticlayer.tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+  if (staticlayer.tex == NULL) {
+    if (debugmode) printf("static layer (%dx%d) not available: %s\n", w, h, SDL_GetError());
+    return(NULL);
+  }
+  SDL_SetTextureBlendMode(staticlayer.tex, SDL_BLENDMODE_BLEND); /* areas outside of the level must let the background through */
+
+  SDL_SetRenderTarget(renderer, staticlayer.tex);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); /* fill texture with transparency */
+  SDL_RenderClear(renderer);
+  /* the texture is exactly the size of the field, so tiles land at their own offset */
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      draw_playfield_tile(game, x, y, sprites, renderer, w, h, settings, 0, 0, 0);
+    }
+  }
+  SDL_SetRenderTarget(renderer, NULL); /* reset the renderer (detach any texture) so I can draw to screen again */
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+
+  return(staticlayer.tex);
+}
+
+
+/* strings of the HUD, along with the values they show */
+static struct {
+  char levelname[256];
+  int level;
+  char levelstr[300];
+  long bestmoves;
+  long bestpushes;
+  char beststr[64];
+  size_t moves;
+  size_t pushes;
+  size_t redo;
+  char movesstr[80];
+} hud;
+
+/* draws the --perf overlay below the HUD. figures are formatted again only
+ * twice per second, so they stay readable */
+static void draw_perfoverlay(struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, int y) {
+  static char lines[4][160];
+  static Uint32 nextupdate;
+  int i;
+
+  if ((lines[0][0] == 0) || ((Sint32)((Uint32)SDL_GetTicks() - nextupdate) >= 0)) {
+    struct perfstats st[perf_phasecount];
+    for (i = 0; i < perf_phasecount; i++) {
+      perf_getstats((enum perfphase)i, &st[i]);
+      if (st[i].count == 0) st[i].count = 1; /* avoid divisions by zero below, averages are 0 anyway */
+    }
+    nextupdate = (Uint32)SDL_GetTicks() + 500;
+    sprintf(lines[0], "frame: avg %.2f ms, max %.2f ms, %lu draw calls", st[perf_frame].totalms / st[perf_frame].count, st[perf_frame].maxms, perf_framedrawcalls());
+    sprintf(lines[1], "sok_move: avg %.4f ms / checksolution: avg %.4f ms", st[perf_move].totalms / st[perf_move].count, st[perf_checksolution].totalms / st[perf_checksolution].count);
+    sprintf(lines[2], "solution load: avg %.3f ms / save: avg %.3f ms, max %.3f ms", st[perf_solload].totalms / st[perf_solload].count, st[perf_solsave].totalms / st[perf_solsave].count, st[perf_solsave].maxms);
+    sprintf(lines[3], "http: avg %.0f ms, max %.0f ms", st[perf_http].totalms / st[perf_http].count, st[perf_http].maxms);
+  }
+
+  for (i = 0; i < 4; i++) {
+    draw_string(lines[i], 60, 200, sprites, renderer, 10, y + i * (sprites->em * 70 / 100), window, 1, 0);
+  }
+}
+
+void draw_screen(const struct sokgame *game, const struct sokgamestates *states, struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, const struct videosettings *settings, int moveoffsetx, int moveoffsety, int scrolling, int flags, const char *levelname) {
+  int x, y, winw, winh, offx, offy;
+  /* int partialoffsetx = 0, partialoffsety = 0; */
+  int scrollingadjx = 0, scrollingadjy = 0; /* this is used when scrolling + movement of player is needed */
+  int drawtile_flags = 0;
+  SDL_Texture *layer;
+  uint64_t perfstart = perf_begin();
+
+  SDL_GetWindowSize(window, &winw, &winh);
+  SDL_RenderClear(renderer);
+
+  if ((flags & DRAWSCREEN_NOBG) == 0) {
+    gra_renderbg(renderer, sprites, SPRITE_BG, winw, winh);
+  }
+
+  if (flags & DRAWSCREEN_PUSH) drawtile_flags = DRAWPLAYFIELDTILE_PUSH;
+
+  if (scrolling > 0) {
+    if (moveoffsetx > scrolling) {
+      scrollingadjx = moveoffsetx - scrolling;
+      moveoffsetx = scrolling;
+    }
+    if (moveoffsetx < -scrolling) {
+      scrollingadjx = moveoffsetx + scrolling;
+      moveoffsetx = -scrolling;
+    }
+    if (moveoffsety > scrolling) {
+      scrollingadjy = moveoffsety - scrolling;
+      moveoffsety = scrolling;
+    }
+    if (moveoffsety < -scrolling) {
+      scrollingadjy = moveoffsety + scrolling;
+      moveoffsety = -scrolling;
+    }
+  }
+  /* draw non-moveable tiles (floors, walls, goals), at once if possible */
+  layer = staticlayer_get(game, sprites, renderer, settings);
+  if (layer != NULL) {
+    SDL_Rect rect;
+    rect.x = draw_offseth(game, winw, settings->tilesize);
+    rect.y = draw_offsetv(game, winh, settings->tilesize);
+    if (scrolling != 0) {
+      rect.x -= moveoffsetx;
+      rect.y -= moveoffsety;
+    }
+    rect.w = game->field_width * settings->tilesize;
+    rect.h = game->field_height * settings->tilesize;
+    perf_count(perf_drawcall);
+    CSDL_RenderTexture(renderer, layer, NULL, &rect);
+  } else {
+    for (y = 0; y < game->field_height; y++) {
+      for (x = 0; x < game->field_width; x++) {
+        if (scrolling != 0) {
+          draw_playfield_tile(game, x, y, sprites, renderer, winw, winh, settings, drawtile_flags, -moveoffsetx, -moveoffsety);
+        } else {
+          draw_playfield_tile(game, x, y, sprites, renderer, winw, winh, settings, drawtile_flags, 0, 0);
+        }
+      }
+    }
+  }
+  /* draw moveable elements (atoms) */
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      offx = 0;
+      offy = 0;
+      if (scrolling == 0) {
+        if ((moveoffsetx > 0) && (x == game->positionx + 1) && (y == game->positiony)) offx = moveoffsetx;
+        if ((moveoffsetx < 0) && (x == game->positionx - 1) && (y == game->positiony)) offx = moveoffsetx;
+        if ((moveoffsety > 0) && (y == game->positiony + 1) && (x == game->positionx)) offy = moveoffsety;
+        if ((moveoffsety < 0) && (y == game->positiony - 1) && (x == game->positionx)) offy = moveoffsety;
+      } else {
+        offx = -moveoffsetx;
+        offy = -moveoffsety;
+        if ((moveoffsetx > 0) && (x == game->positionx + 1) && (y == game->positiony)) offx = scrollingadjx;
+        if ((moveoffsetx < 0) && (x == game->positionx - 1) && (y == game->positiony)) offx = scrollingadjx;
+        if ((moveoffsety > 0) && (y == game->positiony + 1) && (x == game->positionx)) offy = scrollingadjy;
+        if ((moveoffsety < 0) && (y == game->positiony - 1) && (x == game->positionx)) offy = scrollingadjy;
+      }
+      draw_playfield_tile(game, x, y, sprites, renderer, winw, winh, settings, DRAWPLAYFIELDTILE_DRAWATOM, offx, offy);
+    }
+  }
+  /* draw where the player is */
+  if (scrolling != 0) {
+    draw_player(game, states, sprites, renderer, winw, winh, settings, scrollingadjx, scrollingadjy);
+  } else {
+    draw_player(game, states, sprites, renderer, winw, winh, settings, moveoffsetx, moveoffsety);
+  }
+  /* draw text */
+  if ((flags & DRAWSCREEN_NOTXT) == 0) {
+    /* HUD strings are formatted again only when what they tell changes */
+    size_t moves = sok_states_getmoves(states), pushes = sok_states_getpushes(states), redo = sok_states_getredo(states);
+    long bestmoves = -1, bestpushes = -1;
+    if ((hud.level != game->level) || (strcmp(hud.levelname, levelname) != 0)) {
+      hud.level = game->level;
+      snprintf(hud.levelname, sizeof(hud.levelname), "%s", levelname);
+      snprintf(hud.levelstr, sizeof(hud.levelstr), "%s, level %d", levelname, game->level);
+    }
+    draw_string(hud.levelstr, 100, 255, sprites, renderer, 10, DRAWSTRING_BOTTOM, window, 1, 0);
+    if (game->solution != NULL) {
+      bestmoves = (long)ml_count(game->solution);
+      bestpushes = (long)ml_pushcount(game->solution);
+    }
+    if ((hud.beststr[0] == 0) || (hud.bestmoves != bestmoves) || (hud.bestpushes != bestpushes)) {
+      hud.bestmoves = bestmoves;
+      hud.bestpushes = bestpushes;
+      if (bestmoves >= 0) {
+        sprintf(hud.beststr, "best score: %lu/%lu", (unsigned long)bestmoves, (unsigned long)bestpushes);
+      } else {
+        sprintf(hud.beststr, "best score: -");
+      }
+    }
+    draw_string(hud.beststr, 100, 255, sprites, renderer, DRAWSTRING_RIGHT, 0, window, 1, 0);
+    if ((hud.movesstr[0] == 0) || (hud.moves != moves) || (hud.pushes != pushes) || (hud.redo != redo)) {
+      hud.moves = moves;
+      hud.pushes = pushes;
+      hud.redo = redo;
+      if (redo > 0) { /* tell how many moves can be redone */
+        sprintf(hud.movesstr, "moves: %lu (+%lu) / pushes: %lu", (unsigned long)moves, (unsigned long)redo, (unsigned long)pushes);
+      } else {
+        sprintf(hud.movesstr, "moves: %lu / pushes: %lu", (unsigned long)moves, (unsigned long)pushes);
+      }
+    }
+    draw_string(hud.movesstr, 100, 255, sprites, renderer, 10, 0, window, 1, 0);
+  }
+  if ((flags & DRAWSCREEN_PLAYBACK) && (time(NULL) % 2 == 0)) {
+    static const char *playbackstr[] = {"*** PLAYBACK ***", "*** PLAYBACK 4x ***", "*** PLAYBACK 16x ***", "*** INSTANT PLAYBACK ***"};
+    draw_string(playbackstr[settings->playspeed], 100, 255, sprites, renderer, DRAWSTRING_CENTER, 32, window, 1, 0);
+  }
+  if (perf_enabled) draw_perfoverlay(sprites, renderer, window, sprites->em * 12 / 10);
+  perf_end(perf_frame, perfstart);
+  /* Update the screen */
+  if (flags & DRAWSCREEN_REFRESH) SDL_RenderPresent(renderer);
+}
+
+
+void draw_levelmap(const struct sokgame *game, struct spritesstruct *sprites, int xpos, int ypos, SDL_Renderer *renderer, unsigned short tilesize, unsigned char alpha, int flags) {
+  int x, y, bgpadding = tilesize * 3;
+  SDL_Rect rect, bgrect;
+
+  bgrect.x = xpos - (game->field_width * tilesize + bgpadding) / 2;
+  bgrect.y = ypos - (game->field_height * tilesize + bgpadding) / 2;
+  bgrect.w = game->field_width * tilesize + bgpadding;
+  bgrect.h = game->field_height * tilesize + bgpadding;
+  /* if background enabled, compute coordinates of the background and draw it */
+  if (flags & DRAWLEVELMAP_BACKGROUND) {
+    SDL_SetRenderDrawColor(renderer, 0x12, 0x12, 0x12, 255);
+    CSDL_RenderFillRect(renderer, &bgrect);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+  }
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      /* compute coordinates of the tile on screen */
+      rect.x = xpos + (tilesize * x) - (game->field_width * tilesize) / 2;
+      rect.y = ypos + (tilesize * y) - (game->field_height * tilesize) / 2;
+      /* draw the tile */
+      if (SOK_FIELD(game, x, y) & field_floor) gra_rendertile(renderer, sprites, SPRITE_FLOOR, rect.x, rect.y, tilesize, 0);
+      if (SOK_FIELD(game, x, y) & field_wall) gra_renderwall(renderer, sprites, SOK_WALLMASK(game, x, y), rect.x, rect.y, tilesize);
+      if ((SOK_FIELD(game, x, y) & field_goal) && (SOK_FIELD(game, x, y) & field_atom)) { /* atom on goal */
+        gra_rendertile(renderer, sprites, SPRITE_BOXOK, rect.x, rect.y, tilesize, 0);
+      } else if (SOK_FIELD(game, x, y) & field_goal) { /* goal */
+        gra_rendertile(renderer, sprites, SPRITE_GOAL, rect.x, rect.y, tilesize, 0);
+      } else if (SOK_FIELD(game, x, y) & field_atom) { /* atom */
+        gra_rendertile(renderer, sprites, SPRITE_BOX, rect.x, rect.y, tilesize, 0);
+      }
+    }
+  }
+  /* apply alpha filter */
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255 - alpha);
+  CSDL_RenderFillRect(renderer, &bgrect);
+  /* if background enabled, then draw the border */
+  if (flags & DRAWLEVELMAP_BACKGROUND) {
+    unsigned char fadealpha;
+    SDL_SetRenderDrawColor(renderer, 0x28, 0x28, 0x28, 255);
+    CSDL_RenderRect(renderer, &bgrect);
+    /* draw a nice fade-out effect around the selected level */
+    for (fadealpha = 1; fadealpha < DRAWLEVELMAP_FADEWIDTH + 1; fadealpha++) {
+      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255 - fadealpha * (255 / 20));
+      bgrect.x -= 1;
+      bgrect.y -= 1;
+      bgrect.w += 2;
+      bgrect.h += 2;
+      CSDL_RenderRect(renderer, &bgrect);
+    }
+  }
+  /* set the drawing color to its default, plain black color */
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+}
+
+
+void draw_droptextures(void) {
+  staticlayer_free();
+}
+
+
+void draw_free(void) {
+  staticlayer_free();
+  textrun_free();
+}
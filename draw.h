@@ -0,0 +1,103 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef draw_h_sentinel
+#define draw_h_sentinel
+
+  #include "compat-sdl.h"
+  #include "gra.h"
+  #include "sok_core.h"
+
+  struct videosettings {
+    unsigned short tilesize;
+    int rotspeed; /* player's rotation speed (1..100) */
+    int movspeed; /* player's moving [horizontal/vertical] speed (1..100) */
+    const char *customskinfile;
+    int batchmode; /* headless operation instead of the GUI (BATCH_xxx) */
+    const char *thumbsdir;   /* where --render-thumbs writes level previews */
+    unsigned long solvetime; /* solver's time limit in seconds (0 = default) */
+    unsigned long solvemem;  /* solver's memory limit in MiB (0 = default) */
+    int threads;             /* worker threads for solving and verifying (0 = one per CPU core) */
+    int playspeed;           /* pace of solution playback (PLAYSPEED_xxx) */
+  };
+
+  /* solution playback speeds, 1x being animated and others not */
+  #define PLAYSPEED_1X 0
+  #define PLAYSPEED_4X 1
+  #define PLAYSPEED_16X 2
+  #define PLAYSPEED_INSTANT 3 /* all the remaining moves at once */
+
+  /* flags of draw_screen() */
+  #define DRAWSCREEN_REFRESH 1  /* present the frame once drawn */
+  #define DRAWSCREEN_PLAYBACK 2 /* tell that a solution is being played back */
+  #define DRAWSCREEN_PUSH 4     /* the player is pushing an atom */
+  #define DRAWSCREEN_NOBG 8     /* no background image */
+  #define DRAWSCREEN_NOTXT 16   /* no HUD text */
+
+  /* special positions of draw_string() */
+  #define DRAWSTRING_CENTER -1
+  #define DRAWSTRING_RIGHT -2
+  #define DRAWSTRING_BOTTOM -3
+
+  /* provides width and height of a string (in pixels) */
+  void draw_stringsize(const char *string, int fontsize, const struct spritesstruct *sprites, int *w, int *h);
+
+  /* blits a string onscreen, scaling the font at fontsize percents. The
+   * string is placed at starting position x/y (or a DRAWSTRING_xxx special
+   * position), wordwrapped over up to maxlines lines, pheight pixels apart */
+  void draw_string(const char *orgstring, int fontsize, unsigned char alpha, struct spritesstruct *sprites, SDL_Renderer *renderer, int x, int y, SDL_Window *window, int maxlines, int pheight);
+
+  /* horizontal and vertical offsets of the playfield on a winw x winh window,
+   * it scrolls to follow the player if it does not fit */
+  int draw_offseth(const struct sokgame *game, int winw, unsigned short tilesize);
+  int draw_offsetv(const struct sokgame *game, int winh, int tilesize);
+
+  /* draws the playfield, the player and the HUD. moveoffsetx/moveoffsety is
+   * how far the player (or the playfield if scrolling is set) moved toward
+   * its next position while being animated. flags is a DRAWSCREEN_xxx
+   * bitfield. */
+  void draw_screen(const struct sokgame *game, const struct sokgamestates *states, struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, const struct videosettings *settings, int moveoffsetx, int moveoffsety, int scrolling, int flags, const char *levelname);
+
+  /* flags of draw_levelmap() */
+  #define DRAWLEVELMAP_BACKGROUND 1 /* dark background, faded out around */
+
+  /* width of the fade-out border around previews with a background */
+  #define DRAWLEVELMAP_FADEWIDTH 19
+
+  /* draws a preview of a level (in its initial position) centered on
+   * xpos/ypos, tilesize being preferably even so no glitches appear between
+   * tiles. alpha dims the preview over what lies below it. flags is a
+   * DRAWLEVELMAP_xxx bitfield. */
+  void draw_levelmap(const struct sokgame *game, struct spritesstruct *sprites, int xpos, int ypos, SDL_Renderer *renderer, unsigned short tilesize, unsigned char alpha, int flags);
+
+  /* drops render target textures, to be called when their content got lost */
+  void draw_droptextures(void);
+
+  /* frees everything kept around by draw_xxx() functions, to be called
+   * before their skin gets freed */
+  void draw_free(void);
+
+#endif
@@ -30,6 +30,7 @@
 
 #include "gra.h"
 #include "gz.h"
+#include "perf.h"
 #include "skin.h"
 
 
@@ -52,6 +53,30 @@ SDL_Texture *loadgzbmp(const unsigned char *memgz, size_t memgzlen, SDL_Renderer
 }
 
 
+SDL_Surface *loadgzsurface(const unsigned char *memgz, size_t memgzlen) {
+  unsigned char *rawimage = (void *)memgz;
+  size_t rawimagelen = memgzlen;
+  CSDL_IOStream *stream;
+  SDL_Surface *surface, *rgba = NULL;
+
+  /* if it's a gzip file then uncompress it first */
+  if (isGz(memgz, memgzlen)) rawimage = ungz(memgz, memgzlen, &rawimagelen);
+
+  stream = CSDL_IOFromMem(rawimage, (int)rawimagelen);
+  surface = CIMG_Load_IO(stream, 0);
+  CSDL_CloseIO(stream);
+  if (rawimage != memgz) free(rawimage);
+
+  /* a single well-known pixel format makes pixels easy to look at */
+  if (surface != NULL) {
+    rgba = CSDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA8888);
+    CSDL_DestroySurface(surface);
+  }
+
+  return(rgba);
+}
+
+
 
 /* render a tiled background over the entire screen */
 void gra_renderbg(SDL_Renderer *renderer, const struct spritesstruct *spr, unsigned short id, int winw, int winh) {
@@ -63,7 +88,8 @@ void gra_renderbg(SDL_Renderer *renderer, const struct spritesstruct *spr, unsig
   /* fill screen with tiles */
   for (dst.y = 0; dst.y < winh; dst.y += dst.h) {
     for (dst.x = 0; dst.x < winw; dst.x += dst.w) {
-      CSDL_RenderTexture(renderer, spr->map[id], NULL, &dst);
+      perf_count(perf_drawcall);
+      CSDL_RenderTexture(renderer, spr->atlas, &(spr->tile[id]), &dst);
     }
   }
 }
@@ -79,7 +105,8 @@ void gra_rendertile(SDL_Renderer *renderer, const struct spritesstruct *spr, uns
   dst.h = tilesize;
 
   /* copy the texture to screen (possibly scaled) */
-  CSDL_RenderTextureRotated(renderer, spr->map[id], NULL, &dst,
+  perf_count(perf_drawcall);
+  CSDL_RenderTextureRotated(renderer, spr->atlas, &(spr->tile[id]), &dst,
 			    angle, NULL, SDL_FLIP_NONE);
 
 }
@@ -93,23 +120,136 @@ void gra_rendertilequarter(SDL_Renderer *renderer, const struct spritesstruct *s
   dst.w = tilesize;
   dst.h = tilesize;
 
-  if (qid == 0) { /* top left */
-    src.x = 0;
-    src.y = 0;
-  } else if (qid == 1) { /* top right */
-    src.x = spr->tilesize / 2;
-    src.y = 0;
-  } else if (qid == 2) { /* bottom left */
-    src.x = 0;
-    src.y = spr->tilesize / 2;
-  } else { /* bottom right */
-    src.x = spr->tilesize / 2;
-    src.y = spr->tilesize / 2;
-  }
+  src.x = spr->tile[id].x;
+  src.y = spr->tile[id].y;
+  if ((qid == 1) || (qid == 3)) src.x += spr->tilesize / 2; /* right */
+  if ((qid == 2) || (qid == 3)) src.y += spr->tilesize / 2; /* bottom */
 
   src.w = spr->tilesize / 2;
   src.h = spr->tilesize / 2;
 
   /* copy the texture to screen (possibly scaled) */
-  CSDL_RenderTexture(renderer, spr->map[id], &src, &dst);
+  perf_count(perf_drawcall);
+  CSDL_RenderTexture(renderer, spr->atlas, &src, &dst);
+}
+
+
+void gra_wallquarters(unsigned char neighbors, unsigned short wallid[4]) {
+  unsigned short id;
+
+  /* top-left quarter */
+  switch (neighbors & 0xD0) { /* 11010000 */
+    case 0xC0: /* 11000000 */
+    case 0x40: /* 01000000 */
+      id = SPRITE_WALL_VERTIC;
+      break;
+    case 0x90: /* 10010000 */
+    case 0x10: /* 00010000 */
+      id = SPRITE_WALL_HORIZ;
+      break;
+    case 0x50: /* 01010000 (inner corner) */
+      id = SPRITE_WALL_CORNER;
+      break;
+    case 0xD0: /* 11010000 (full block) */
+      id = SPRITE_WALL_PLAIN;
+      break;
+    default:
+      id = SPRITE_WALL_ISLAND;
+      break;
+  }
+  wallid[0] = id;
+
+  /* top-right quarter */
+  switch (neighbors & 0x68) { /* 011 01 000 */
+    case 0x60: /* 011 00 000 */
+    case 0x40: /* 010 00 000 */
+      id = SPRITE_WALL_VERTIC;
+      break;
+    case 0x28: /* 001 01 000 */
+    case 0x08: /* 000 01 000 */
+      id = SPRITE_WALL_HORIZ;
+      break;
+    case 0x48: /* 010 01 000 (inner corner) */
+      id = SPRITE_WALL_CORNER;
+      break;
+    case 0x68: /* 011 01 000 (full block) */
+      id = SPRITE_WALL_PLAIN;
+      break;
+    default:
+      id = SPRITE_WALL_ISLAND;
+      break;
+  }
+  wallid[1] = id;
+
+  /* bottom-left quarter */
+  switch (neighbors & 0x16) { /* 000 10 110 */
+    case 0x06: /* 000 00 110 */
+    case 0x02: /* 000 00 010 */
+      id = SPRITE_WALL_VERTIC;
+      break;
+    case 0x14: /* 000 10 100 */
+    case 0x10: /* 000 10 000 */
+      id = SPRITE_WALL_HORIZ;
+      break;
+    case 0x12: /* 000 10 010 (inner corner) */
+      id = SPRITE_WALL_CORNER;
+      break;
+    case 0x16: /* 000 10 110 (full block) */
+      id = SPRITE_WALL_PLAIN;
+      break;
+    default:
+      id = SPRITE_WALL_ISLAND;
+      break;
+  }
+  wallid[2] = id;
+
+  /* bottom-right quarter */
+  switch (neighbors & 0x0B) { /* 000 01 011 */
+    case 0x03: /* 000 00 011 */
+    case 0x02: /* 000 00 010 */
+      id = SPRITE_WALL_VERTIC;
+      break;
+    case 0x09: /* 000 01 001 */
+    case 0x08: /* 000 01 000 */
+      id = SPRITE_WALL_HORIZ;
+      break;
+    case 0x0A: /* 000 01 010 (inner corner) */
+      id = SPRITE_WALL_CORNER;
+      break;
+    case 0x0B: /* 000 01 011 (full block) */
+      id = SPRITE_WALL_PLAIN;
+      break;
+    default:
+      id = SPRITE_WALL_ISLAND;
+      break;
+  }
+  wallid[3] = id;
+}
+
+
+void gra_renderwall(SDL_Renderer *renderer, const struct spritesstruct *spr, unsigned char wallmask, int x, int y, unsigned short tilesize) {
+  SDL_Rect src, dst;
+  unsigned short wallid[4];
+
+  /* a single copy from the pre-composed atlas, if available */
+  if (spr->wallatlas != NULL) {
+    src.x = (wallmask % 16) * WALLATLAS_CELL(spr->tilesize) + 1;
+    src.y = (wallmask / 16) * WALLATLAS_CELL(spr->tilesize) + 1;
+    src.w = spr->tilesize;
+    src.h = spr->tilesize;
+    dst.x = x;
+    dst.y = y;
+    dst.w = tilesize;
+    dst.h = tilesize;
+    perf_count(perf_drawcall);
+    CSDL_RenderTexture(renderer, spr->wallatlas, &src, &dst);
+    return;
+  }
+
+  /* otherwise the wall is assembled from 4 quarters */
+  gra_wallquarters(wallmask, wallid);
+  gra_rendertilequarter(renderer, spr, wallid[0], x, y, tilesize / 2, 0);
+  gra_rendertilequarter(renderer, spr, wallid[1], x + (tilesize / 2), y, tilesize / 2, 1);
+  gra_rendertilequarter(renderer, spr, wallid[2], x, y + (tilesize / 2), tilesize / 2, 2);
+  gra_rendertilequarter(renderer, spr, wallid[3], x + (tilesize / 2), y + (tilesize / 2), tilesize / 2, 3);
 }
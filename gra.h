@@ -43,12 +43,15 @@ struct spritesstruct {
   SDL_Texture *playfromclipboard;
   SDL_Texture *snapshottoclipboard;
   SDL_Texture *help;
-  SDL_Texture *map[4*8]; /* 4 tiles per row, 8 rows */
   SDL_Texture *saved;
   SDL_Texture *loaded;
   SDL_Texture *nosave;
   SDL_Texture *solved;
-  SDL_Texture *font[256];
+  SDL_Texture *atlas;      /* all tiles of the sprite map */
+  SDL_Rect tile[4*8];      /* where each tile is in atlas (4 tiles per row, 8 rows) */
+  SDL_Texture *fontatlas;  /* all glyphs of the font */
+  SDL_Rect glyph[256];     /* where each glyph is in fontatlas */
+  SDL_Texture *wallatlas;  /* all 256 wall variants, NULL if not available */
   unsigned short tilesize; /* width (and height) of tiles present in the sprite map */
   unsigned short em;       /* a font-related unit used to scale tiles and possibly other elements */
   unsigned short flags;
@@ -58,6 +61,13 @@ struct spritesstruct {
 /* loads a gziped bmp image from memory and returns a texture */
 SDL_Texture *loadgzbmp(const unsigned char *memgz, size_t memgzlen, SDL_Renderer *renderer);
 
+/* same as loadgzbmp(), but returns a RGBA8888 surface for the CPU to work on */
+SDL_Surface *loadgzsurface(const unsigned char *memgz, size_t memgzlen);
+
+/* atlas textures surround each of their cells with a 1-pixel gutter that
+ * repeats its edges, so scaled copies never bleed neighbour cells in */
+#define ATLAS_CELL(size) ((size) + 2)
+
 /* render a tiled background over the entire screen */
 void gra_renderbg(SDL_Renderer *renderer, const struct spritesstruct *spr, unsigned short id, int winw, int winh);
 
@@ -66,4 +76,16 @@ void gra_rendertile(SDL_Renderer *renderer, const struct spritesstruct *spr, uns
 /* same as gra_rendertile() but for one quarter of the tile (qid 0 = topleft) */
 void gra_rendertilequarter(SDL_Renderer *renderer, const struct spritesstruct *spr, unsigned short id, int x, int y, unsigned short tilesize, int qid);
 
+/* the wall atlas is a 16x16 grid of cells, the cell of a wall variant being
+ * given by its wallmask (see sok_core.h) */
+#define WALLATLAS_CELL(tilesize) ATLAS_CELL(tilesize)
+
+/* tells which wall sprite each quarter of a wall tile (qid 0 = topleft,
+ * 1 = topright, 2 = bottomleft, 3 = bottomright) is made of, depending on
+ * the walls around it */
+void gra_wallquarters(unsigned char wallmask, unsigned short wallid[4]);
+
+/* render a wall tile, given the walls around it */
+void gra_renderwall(SDL_Renderer *renderer, const struct spritesstruct *spr, unsigned char wallmask, int x, int y, unsigned short tilesize);
+
 #endif
@@ -25,7 +25,7 @@
  */
 
 #include <stdlib.h>   /* calloc(), free() */
-#include <string.h>   /* memset() */
+#include <string.h>   /* memcpy(), memmove() */
 #include <zlib.h>
 
 #include "gz.h" /* include self for control */
@@ -44,13 +44,143 @@ int isGz(const void *memgz, size_t memgzlen) {
 }
 
 
-/* decompress a gz file in memory. returns a pointer to a newly allocated memory chunk (holding uncompressed data), or NULL on error. */
+/* size of the input window of a gzreader over a file */
+#define GZR_INBUF 16384
+
+struct gzreader {
+  z_stream zlibstream;
+  int inflating;  /* 1 if data is gzip, 0 if passed through */
+  int zlibdone;   /* end of the last gzip member reached */
+  FILE *fd;
+  const unsigned char *mem;
+  size_t memlen;
+  size_t inbuflen; /* amount of bytes in inbuf, for files only */
+  unsigned char inbuf[GZR_INBUF];
+};
+
+
+/* hands the next chunk of input to zlib if it consumed the previous one.
+ * returns the amount of input available, 0 if none is left. */
+static size_t gzr_feed(struct gzreader *r) {
+  if (r->zlibstream.avail_in > 0) return(r->zlibstream.avail_in);
+  if (r->fd != NULL) {
+    r->inbuflen = fread(r->inbuf, 1, sizeof(r->inbuf), r->fd);
+    r->zlibstream.next_in = r->inbuf;
+    r->zlibstream.avail_in = (uInt)r->inbuflen;
+  } else if (r->memlen > 0) {
+    /* memory is fed by chunks of at most 1 GiB so it always fits in uInt */
+    size_t chunk = r->memlen;
+    if (chunk > 1024*1024*1024) chunk = 1024*1024*1024;
+    r->zlibstream.next_in = (Bytef *)r->mem; /* ugly cast because the zlib API sadly does not declare input as CONST... it is a known issue caused by retro-compatibility concerns, but still it is safe to assume zlib is NOT changing input buffer in any way:
+      "zlib does not touch the input data. It is treated as if it were const. next_in is not const by default since many applications use next_in outside of zlib to read in their data. Making it const would break those applications. - Mark Adler, Jul 7 '17 at 6:52"
+      src: https://stackoverflow.com/questions/44958875/c-using-zlib-with-const-data */
+    r->zlibstream.avail_in = (uInt)chunk;
+    r->mem += chunk;
+    r->memlen -= chunk;
+  }
+  return(r->zlibstream.avail_in);
+}
+
+
+struct gzreader *gzr_open(const void *mem, size_t memlen, FILE *fd) {
+  struct gzreader *r;
+  const unsigned char *head;
+  size_t headlen;
+
+  r = calloc(1, sizeof(struct gzreader));
+  if (r == NULL) return(NULL);
+  r->fd = fd;
+  r->mem = mem;
+  r->memlen = memlen;
+
+  /* look at the first bytes of data to decide whether it is gzip or not */
+  if (mem != NULL) {
+    head = mem;
+    headlen = memlen;
+  } else {
+    r->inbuflen = fread(r->inbuf, 1, sizeof(r->inbuf), fd);
+    head = r->inbuf;
+    headlen = r->inbuflen;
+  }
+  r->inflating = isGz(head, headlen);
+  if (r->inflating == 0) return(r);
+
+  if (inflateInit2(&(r->zlibstream), 31) != Z_OK) { /* 31 means "this is gzip data" (as opposed to a zlib stream or raw deflate) */
+    free(r);
+    return(NULL);
+  }
+  if (mem == NULL) {
+    r->zlibstream.next_in = r->inbuf;
+    r->zlibstream.avail_in = (uInt)r->inbuflen;
+  }
+  return(r);
+}
+
+
+long gzr_read(struct gzreader *r, void *buf, size_t len) {
+  int zres;
+
+  if (len > 1024*1024*1024) len = 1024*1024*1024;
+
+  /* plain data: copy whatever is left of the first window, then the rest */
+  if (r->inflating == 0) {
+    size_t res = 0;
+    if (r->mem != NULL) {
+      res = (len < r->memlen) ? len : r->memlen;
+      memcpy(buf, r->mem, res);
+      r->mem += res;
+      r->memlen -= res;
+    } else {
+      if (r->inbuflen > 0) {
+        res = (len < r->inbuflen) ? len : r->inbuflen;
+        memcpy(buf, r->inbuf, res);
+        r->inbuflen -= res;
+        memmove(r->inbuf, r->inbuf + res, r->inbuflen);
+      }
+      if (res < len) res += fread((unsigned char *)buf + res, 1, len - res, r->fd);
+    }
+    return((long)res);
+  }
+
+  r->zlibstream.next_out = buf;
+  r->zlibstream.avail_out = (uInt)len;
+  while ((r->zlibstream.avail_out > 0) && (r->zlibdone == 0)) {
+    if (gzr_feed(r) == 0) {
+      /* input exhausted in the middle of a member: truncated data */
+      if (r->zlibstream.avail_out == len) return(-1);
+      break;
+    }
+    zres = inflate(&(r->zlibstream), Z_NO_FLUSH);
+    if (zres == Z_STREAM_END) {
+      /* another gzip member may follow (multi-member file), anything else
+       * is trailing garbage and ends the data */
+      if ((gzr_feed(r) > 0) && (r->zlibstream.next_in[0] == 0x1F) && (inflateReset(&(r->zlibstream)) == Z_OK)) continue;
+      r->zlibdone = 1;
+    } else if (zres != Z_OK) {
+      return(-1);
+    }
+  }
+  return((long)(len - r->zlibstream.avail_out));
+}
+
+
+void gzr_close(struct gzreader *r) {
+  if (r == NULL) return;
+  if (r->inflating) inflateEnd(&(r->zlibstream));
+  free(r);
+}
+
+
+/* decompress a gz file in memory. returns a pointer to a newly allocated memory chunk (holding uncompressed data), or NULL on error.
+ * the ISIZE field of the gzip trailer is only used as a hint of the
+ * uncompressed size, since it is wrong for multi-member files (and for files
+ * of 4 GiB or more). */
 void *ungz(const void *memgzsrc, size_t memgzlen, size_t *resultlen) {
   const unsigned char *memgz = memgzsrc;
-  int extract_res;
-  void *result;
-  size_t filelen;
-  z_stream zlibstream;
+  struct gzreader *r;
+  unsigned char *result, *newresult, extrabyte;
+  size_t filelen, alloc;
+  long len;
 
   /* validate arguments */
   if ((resultlen == NULL) || (memgzsrc == NULL) || (memgzlen < 16)) return(NULL);
@@ -70,39 +200,44 @@ void *ungz(const void *memgzsrc, size_t memgzlen, size_t *resultlen) {
   filelen <<= 8;
   filelen |= memgz[memgzlen - 4];
 
-  /* abort if file appears to be over 1 GB - this is certainly an anomaly */
-  if (filelen > 1024*1024*1024) return(NULL);
+  /* do not trust an ISIZE that is over 1 GB - this is certainly an anomaly -
+   * nor one that is smaller than the compressed data */
+  if ((filelen > 1024*1024*1024) || (filelen < memgzlen)) filelen = memgzlen;
 
-  /* allocate memory for uncompressed content */
-  result = calloc(1, filelen + 1); /* +1 so it is guaranteed to end with a zero byte */
-  if (result == NULL) return(NULL);  /* failed to alloc memory for the result */
-
-  memset(&zlibstream, 0, sizeof(zlibstream));
-  zlibstream.zalloc = Z_NULL;
-  zlibstream.zfree = Z_NULL;
-  zlibstream.opaque = Z_NULL;
-  zlibstream.avail_in = 0;
-  zlibstream.next_in = Z_NULL;
-  if (inflateInit2(&zlibstream, 31) != Z_OK) { /* 31 means "this is gzip data" (as opposed to a zlib stream or raw deflate) */
-    free(result);
-    return(NULL);
-  }
-
-  zlibstream.next_in = (Bytef *)memgzsrc; /* ugly cast because the zlib API sadly does not declare input as CONST... it is a known issue caused by retro-compatibility concerns, but still it is safe to assume zlib is NOT changing input buffer in any way:
-    "zlib does not touch the input data. It is treated as if it were const. next_in is not const by default since many applications use next_in outside of zlib to read in their data. Making it const would break those applications. - Mark Adler, Jul 7 '17 at 6:52"
-    src: https://stackoverflow.com/questions/44958875/c-using-zlib-with-const-data */
-  zlibstream.avail_in = (uInt)memgzlen;
-  zlibstream.next_out = result;
-  zlibstream.avail_out = (uInt)filelen;
+  r = gzr_open(memgzsrc, memgzlen, NULL);
+  if (r == NULL) return(NULL);
 
-  extract_res = inflate(&zlibstream, Z_FINISH); /* Z_FINISH informs zlib that it may use shortcuts because everything is expected to be done within this one single call */
-  inflateEnd(&zlibstream);
-
-  if (extract_res != Z_STREAM_END) {
-    free(result);
-    return(NULL);
+  /* allocate memory for uncompressed content */
+  alloc = filelen + 1; /* +1 so it is guaranteed to end with a zero byte */
+  result = malloc(alloc);
+  if (result == NULL) goto ERR; /* failed to alloc memory for the result */
+
+  filelen = 0;
+  for (;;) {
+    len = gzr_read(r, result + filelen, alloc - filelen - 1);
+    if (len < 0) goto ERR;
+    if (len == 0) break;
+    filelen += (size_t)len;
+    if (filelen + 1 < alloc) continue;
+    /* buffer full: either all data is in, or ISIZE was wrong */
+    len = gzr_read(r, &extrabyte, 1);
+    if (len < 0) goto ERR;
+    if (len == 0) break;
+    if (alloc > 1024*1024*1024) goto ERR;
+    newresult = realloc(result, alloc * 2);
+    if (newresult == NULL) goto ERR;
+    result = newresult;
+    alloc *= 2;
+    result[filelen++] = extrabyte;
   }
+  gzr_close(r);
 
+  result[filelen] = 0;
   *resultlen = filelen;
   return(result);
+
+  ERR:
+  gzr_close(r);
+  free(result);
+  return(NULL);
 }
@@ -26,6 +26,23 @@
 
 #ifndef gz_h_sentinel
 #define gz_h_sentinel
+  #include <stdio.h> /* FILE */
+
   int isGz(const void *memgz, size_t memgzlen);
   void *ungz(const void *memgz, size_t memgzlen, size_t *resultlen);
+
+  struct gzreader; /* opaque streaming reader, see below */
+
+  /* opens a streaming reader over the memory chunk mem (or over the open
+   * file fd if mem is NULL). gzip data (possibly made of several members) is
+   * inflated on the fly through a fixed-size window, anything else is passed
+   * through as-is. the file, if any, stays owned by the caller. returns NULL
+   * on error. */
+  struct gzreader *gzr_open(const void *mem, size_t memlen, FILE *fd);
+
+  /* reads up to len bytes of (uncompressed) data into buf. returns the amount
+   * of bytes read, 0 at the end of data, or -1 on error. */
+  long gzr_read(struct gzreader *r, void *buf, size_t len);
+
+  void gzr_close(struct gzreader *r);
 #endif
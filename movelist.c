@@ -0,0 +1,231 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "movelist.h"
+
+
+/* makes room in ml for a total of n moves. returns 0 on success. */
+static int ml_reserve(struct sokmovelist *ml, size_t n) {
+  unsigned char *newdata;
+  n = (n + 7) & ~(size_t)7;
+  if (n <= ml->alloc) return(0);
+  newdata = realloc(ml->data, n / 8 * 3);
+  if (newdata == NULL) return(-1);
+  ml->data = newdata;
+  ml->alloc = n;
+  return(0);
+}
+
+
+struct sokmovelist *ml_new(void) {
+  struct sokmovelist *ml;
+  ml = calloc(1, sizeof(struct sokmovelist));
+  return(ml);
+}
+
+
+void ml_free(struct sokmovelist *ml) {
+  if (ml == NULL) return;
+  free(ml->data);
+  free(ml);
+}
+
+
+void ml_clear(struct sokmovelist *ml) {
+  ml->count = 0;
+  ml->pushcount = 0;
+}
+
+
+struct sokmovelist *ml_dup(const struct sokmovelist *ml) {
+  struct sokmovelist *res;
+  res = ml_new();
+  if (res == NULL) return(NULL);
+  if (ml_reserve(res, ml->count) != 0) {
+    ml_free(res);
+    return(NULL);
+  }
+  if (ml->count > 0) memcpy(res->data, ml->data, (ml->count + 7) / 8 * 3);
+  res->count = ml->count;
+  res->pushcount = ml->pushcount;
+  return(res);
+}
+
+
+int ml_append(struct sokmovelist *ml, int move) {
+  unsigned char *group;
+  size_t i = ml->count;
+  int shift;
+  if (i == ml->alloc) {
+    if (ml_reserve(ml, (i < 128) ? 256 : i * 2) != 0) return(-1);
+  }
+  group = ml->data + (i >> 3) * 3;
+  shift = (int)(i & 3) * 2;
+  /* the slot may hold an undone move, or whatever realloc() left there */
+  group[(i & 7) >> 2] = (unsigned char)((group[(i & 7) >> 2] & ~(3 << shift)) | ((move & 3) << shift));
+  if (move & mlmove_push) {
+    group[2] |= (unsigned char)(1 << (i & 7));
+    ml->pushcount += 1;
+  } else {
+    group[2] &= (unsigned char)~(1 << (i & 7));
+  }
+  ml->count += 1;
+  return(0);
+}
+
+
+void ml_undo(struct sokmovelist *ml) {
+  if (ml->count == 0) return;
+  if (ml_get(ml, ml->count - 1) & mlmove_push) ml->pushcount -= 1;
+  ml->count -= 1;
+}
+
+
+size_t ml_count(const struct sokmovelist *ml) {
+  if (ml == NULL) return(0);
+  return(ml->count);
+}
+
+
+size_t ml_pushcount(const struct sokmovelist *ml) {
+  if (ml == NULL) return(0);
+  return(ml->pushcount);
+}
+
+
+int ml_get(const struct sokmovelist *ml, size_t i) {
+  const unsigned char *group = ml->data + (i >> 3) * 3;
+  int move;
+  move = (group[(i & 7) >> 2] >> ((i & 3) * 2)) & 3;
+  if (group[2] & (1 << (i & 7))) move |= mlmove_push;
+  return(move);
+}
+
+
+char ml_move2char(int move) {
+  return("uldrULDR"[move & 7]);
+}
+
+
+int ml_char2move(char c) {
+  switch (c) {
+    case 'u':
+      return(mlmove_up);
+    case 'l':
+      return(mlmove_left);
+    case 'd':
+      return(mlmove_down);
+    case 'r':
+      return(mlmove_right);
+    case 'U':
+      return(mlmove_up | mlmove_push);
+    case 'L':
+      return(mlmove_left | mlmove_push);
+    case 'D':
+      return(mlmove_down | mlmove_push);
+    case 'R':
+      return(mlmove_right | mlmove_push);
+    default:
+      return(-1);
+  }
+}
+
+
+struct sokmovelist *ml_fromstring(const char *moves) {
+  struct sokmovelist *ml;
+  int move;
+  ml = ml_new();
+  if (ml == NULL) return(NULL);
+  if (ml_reserve(ml, strlen(moves)) != 0) {
+    ml_free(ml);
+    return(NULL);
+  }
+  for (; *moves != 0; moves++) {
+    move = ml_char2move(*moves);
+    if ((move < 0) || (ml_append(ml, move) != 0)) {
+      ml_free(ml);
+      return(NULL);
+    }
+  }
+  return(ml);
+}
+
+
+char *ml_tostring(const struct sokmovelist *ml) {
+  char *res;
+  size_t i;
+  res = malloc(ml->count + 1);
+  if (res == NULL) return(NULL);
+  for (i = 0; i < ml->count; i++) res[i] = ml_move2char(ml_get(ml, i));
+  res[ml->count] = 0;
+  return(res);
+}
+
+
+unsigned char *ml_pack(const struct sokmovelist *ml, size_t *len) {
+  unsigned char *res;
+  size_t i;
+  int move, lastmove = -1, runlen = 0;
+  *len = 0;
+  res = malloc(ml->count + 1);
+  if (res == NULL) return(NULL);
+  for (i = 0; i < ml->count; i++) {
+    move = ml_get(ml, i);
+    if ((move == lastmove) && (runlen < 15)) {
+      runlen += 1;
+      continue;
+    }
+    if (runlen > 0) res[(*len)++] = (unsigned char)((runlen << 4) | lastmove);
+    lastmove = move;
+    runlen = 1;
+  }
+  if (runlen > 0) res[(*len)++] = (unsigned char)((runlen << 4) | lastmove);
+  return(res);
+}
+
+
+struct sokmovelist *ml_unpack(const unsigned char *buf, size_t len) {
+  struct sokmovelist *ml;
+  size_t i, total = 0;
+  int runlen;
+  for (i = 0; i < len; i++) {
+    if (buf[i] & 8) return(NULL); /* not a move */
+    total += (size_t)(buf[i] >> 4);
+  }
+  ml = ml_new();
+  if (ml == NULL) return(NULL);
+  if (ml_reserve(ml, total) != 0) {
+    ml_free(ml);
+    return(NULL);
+  }
+  for (i = 0; i < len; i++) {
+    for (runlen = buf[i] >> 4; runlen > 0; runlen--) ml_append(ml, buf[i] & 7);
+  }
+  return(ml);
+}
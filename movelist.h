@@ -0,0 +1,100 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef movelist_h_sentinel
+#define movelist_h_sentinel
+
+  #include <stddef.h> /* size_t */
+
+  /* a move is a direction code, possibly flagged with mlmove_push. direction
+   * codes are those of enum SOKMOVE minus 1 (and of the solution files). */
+  #define mlmove_up 0
+  #define mlmove_left 1
+  #define mlmove_down 2
+  #define mlmove_right 3
+  #define mlmove_push 4
+
+  /* a list of moves, packed as 3 bits per move: moves are stored in groups
+   * of 8, each group being 2 bytes of directions (2 bits per direction)
+   * followed by 1 byte of push flags. */
+  struct sokmovelist {
+    unsigned char *data;
+    size_t count;      /* number of moves */
+    size_t pushcount;  /* number of pushes */
+    size_t alloc;      /* number of moves data has room for, a multiple of 8 */
+  };
+
+  /* returns a new, empty move list, or NULL on out of memory */
+  struct sokmovelist *ml_new(void);
+
+  void ml_free(struct sokmovelist *ml);
+
+  /* empties ml (without releasing its memory) */
+  void ml_clear(struct sokmovelist *ml);
+
+  /* returns a copy of ml, or NULL on out of memory */
+  struct sokmovelist *ml_dup(const struct sokmovelist *ml);
+
+  /* appends a move to ml. returns 0 on success, -1 on out of memory */
+  int ml_append(struct sokmovelist *ml, int move);
+
+  /* drops the last move of ml */
+  void ml_undo(struct sokmovelist *ml);
+
+  /* returns the number of moves of ml (0 if ml is NULL) */
+  size_t ml_count(const struct sokmovelist *ml);
+
+  /* returns the number of pushes of ml (0 if ml is NULL) */
+  size_t ml_pushcount(const struct sokmovelist *ml);
+
+  /* returns move i (0-based, must be lower than ml_count()) of ml */
+  int ml_get(const struct sokmovelist *ml, size_t i);
+
+  /* returns the history character of a move (u, l, d, r, uppercase if it
+   * is a push) */
+  char ml_move2char(int move);
+
+  /* returns the move of a history character, or -1 if c is not a move */
+  int ml_char2move(char c);
+
+  /* returns a move list out of a string of moves, or NULL if the string
+   * contains anything else than moves or on out of memory */
+  struct sokmovelist *ml_fromstring(const char *moves);
+
+  /* returns ml as a malloc()'ed, null-terminated string of moves, or NULL on
+   * out of memory */
+  char *ml_tostring(const struct sokmovelist *ml);
+
+  /* packs ml into its on-disk form: one byte per run of up to 15 identical
+   * moves, the run length being stored in the high nibble and the move in the
+   * low one. returns a malloc()'ed buffer of *len bytes, or NULL on error. */
+  unsigned char *ml_pack(const struct sokmovelist *ml, size_t *len);
+
+  /* unpacks a move list from its on-disk form. returns NULL if buf is
+   * corrupted or on out of memory. */
+  struct sokmovelist *ml_unpack(const unsigned char *buf, size_t len);
+
+#endif
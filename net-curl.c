@@ -42,6 +42,9 @@ struct netload {
   unsigned char *buffer;        /* Loaded data buffer. */
   size_t bufalloc;              /* Buffer size. */
   size_t datalen;               /* Data byte count in buffer. */
+  struct http_headers hdr;      /* Headers of the last response. */
+  http_progressfunc progress;   /* Progress callback, may be NULL. */
+  void *ctx;                    /* Progress callback context. */
 };
 
 
@@ -55,6 +58,12 @@ void cleanup_net(void) {
 }
 
 
+/* Nothing to do: libcurl calls the progress callback at least once per
+   second, so a transfer whose caller asks for it to stop ends soon enough. */
+void http_abort(void) {
+}
+
+
 /* Accumulate incoming data. */
 static size_t loaddata(void *ptr, size_t size, size_t nmemb, void *userdata) {
   struct netload *p = userdata;
@@ -81,18 +90,70 @@ static size_t loaddata(void *ptr, size_t size, size_t nmemb, void *userdata) {
   return nmemb;
 }
 
-/* fetch a resource from host/path on defined port using http and return a pointer to the allocated chunk of memory
- * Note: do not forget to free the memory afterwards! */
-size_t http_get(const char *host, unsigned short port, const char *path, unsigned char **resptr) {
+/* Collect validators from response headers. */
+static size_t loadheader(char *ptr, size_t size, size_t nmemb, void *userdata) {
+  struct netload *p = userdata;
+  char line[256];
+
+  (void) size;
+
+  /* A status line starts a new response (redirects). */
+  if (nmemb >= 5 && !memcmp(ptr, "HTTP/", 5)) {
+    memset(&p->hdr, 0, sizeof(p->hdr));
+    return nmemb;
+  }
+
+  /* Lines too long to hold anything of interest are skipped. */
+  if (nmemb < sizeof(line)) {
+    memcpy(line, ptr, nmemb);
+    line[nmemb] = '\0';
+    http_parseheader(line, &p->hdr);
+  }
+  return nmemb;
+}
+
+
+/* Forward transfer progress. */
+static int loadprogress(void *userdata, curl_off_t dltotal, curl_off_t dlnow,
+                        curl_off_t ultotal, curl_off_t ulnow) {
+  struct netload *p = userdata;
+
+  (void) dltotal;
+  (void) ultotal;
+  (void) ulnow;
+
+  return p->progress(p->ctx, (size_t) dlnow, p->hdr.contentlen);
+}
+
+
+size_t http_fetch(const char *host, unsigned short port, const char *path,
+                  struct http_validators *val, http_progressfunc progress,
+                  void *ctx, unsigned char **resptr, int *status) {
   CURLU *url = curl_url();
   CURL *easy = NULL;
+  struct curl_slist *headers = NULL;
   struct netload ctrl;
   char portstring[6];
+  char hdrline[256];
   char *urlstring = NULL;
+  long code = 0;
 
-  ctrl.datalen = 0;
+  memset(&ctrl, 0, sizeof(ctrl));
   ctrl.bufalloc = 1024;
-  ctrl.buffer = NULL;
+  ctrl.progress = progress;
+  ctrl.ctx = ctx;
+  *status = 0;
+
+  /* Conditional request headers. */
+  if (val && val->etag[0]) {
+    snprintf(hdrline, sizeof(hdrline), "If-None-Match: %s", val->etag);
+    headers = curl_slist_append(headers, hdrline);
+  }
+  if (val && val->lastmodified[0]) {
+    snprintf(hdrline, sizeof(hdrline), "If-Modified-Since: %s",
+             val->lastmodified);
+    headers = curl_slist_append(headers, hdrline);
+  }
   if(url) {
     /* Build URL. */
     snprintf(portstring, sizeof(portstring), "%hu", port);
@@ -108,6 +169,15 @@ size_t http_get(const char *host, unsigned short port, const char *path, unsigne
         curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
         curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, loaddata);
         curl_easy_setopt(easy, CURLOPT_WRITEDATA, &ctrl);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, loadheader);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &ctrl);
+        if (headers)
+          curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headers);
+        if (progress) {
+          curl_easy_setopt(easy, CURLOPT_XFERINFOFUNCTION, loadprogress);
+          curl_easy_setopt(easy, CURLOPT_XFERINFODATA, &ctrl);
+          curl_easy_setopt(easy, CURLOPT_NOPROGRESS, 0L);
+        }
 #if defined(_WIN32) || defined(WIN32)
         /* The request may be redirected to https and Windows libcurl packages
            come without trusted CA bundle: if possible, use Windows trusted CA
@@ -125,12 +195,17 @@ size_t http_get(const char *host, unsigned short port, const char *path, unsigne
         /* Allocate initial buffer and transfer data. */
         if ((ctrl.buffer = malloc(ctrl.bufalloc))) {
           ctrl.buffer[0] = '\0';
-          if (curl_easy_perform(easy)) {
-            /* An error occurred. */
+          if (!curl_easy_perform(easy))
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &code);
+          *status = (int) code;
+          if (code != 200) {
+            /* An error occurred, or there is nothing new to load. */
             free(ctrl.buffer);
             ctrl.buffer = NULL;
             ctrl.datalen = 0;
           }
+          else if (val)
+            *val = ctrl.hdr.val;
         }
       }
     }
@@ -138,6 +213,7 @@ size_t http_get(const char *host, unsigned short port, const char *path, unsigne
 
   /* Clean up and return. */
   curl_easy_cleanup(easy);
+  curl_slist_free_all(headers);
   curl_free(urlstring);
   curl_url_cleanup(url);
   *resptr = ctrl.buffer;
@@ -26,143 +26,427 @@
  */
 
 #if defined(_WIN32) || defined(WIN32)
-  #include <winsock2.h>  /* gethostbyname() on nonstandard, exotic platforms */
+  #include <winsock2.h>  /* socket API on nonstandard, exotic platforms */
+  #include <ws2tcpip.h>  /* getaddrinfo() */
 #else
-  #include <netdb.h>     /* gethostbyname() on posix */
+  #include <sys/types.h>
+  #include <sys/socket.h>
+  #include <netdb.h>     /* getaddrinfo() on posix */
 #endif
 
 #include <errno.h>
 #include <unistd.h> /* NULL */
 #include <string.h> /* memcpy() */
-#include <stdlib.h> /* realloc(), malloc() */
+#include <stdlib.h> /* realloc(), malloc(), atoi(), strtoul() */
 #include <stdio.h>  /* sprintf() */
 
+#include "compat-sdl.h" /* SDL mutexes */
+
+#include "gz.h"
 #include "net.h"
 
+/* a socket must be closed with closesocket() on Windows */
+#ifdef _WIN32
+#define CLOSESOCK(x) closesocket(x)
+#define SHUTSOCK(x) shutdown(x, SD_BOTH)
+#else
+#define CLOSESOCK(x) close(x)
+#define SHUTSOCK(x) shutdown(x, SHUT_RDWR)
+#endif
+
+#define BUFLEN 16384
+
+/* a connection to a HTTP server, along with its read buffer: headers and
+ * bodies are read through it by large chunks rather than byte by byte */
+struct httpconn {
+  int sock;
+  char host[256];
+  unsigned short port;
+  size_t bufpos;  /* offset of the next unread byte in buf */
+  size_t buflen;  /* amount of bytes in buf */
+  int failed;     /* a receive failed, the end of data is not a regular one */
+  struct httpconn *next; /* next open connection */
+  unsigned char buf[BUFLEN];
+};
+
+/* a body being received */
+struct httpbody {
+  unsigned char *data;
+  size_t len;
+  size_t alloc;
+  size_t total;   /* expected length, 0 if unknown */
+  http_progressfunc progress;
+  void *ctx;
+};
+
+/* readbody() length meaning "up to the end of the connection" */
+#define UNTILEOF ((size_t)-1)
+
+/* the connection left open by the last keep-alive answer, to be reused by
+ * the next request to the same server (typically the level set fetched right
+ * after the list of sets) */
+static struct httpconn *idleconn;
+static CSDL_Mutex *idlelock;
+
+/* all open connections, so http_abort() can shut them down. protected by
+ * idlelock, as is the aborted flag. */
+static struct httpconn *openconns;
+static int aborted;
+
+
+static void closeconn(struct httpconn *c) {
+  struct httpconn **p;
+  if (c == NULL) return;
+  if (idlelock != NULL) SDL_LockMutex(idlelock);
+  for (p = &openconns; *p != NULL; p = &((*p)->next)) {
+    if (*p != c) continue;
+    *p = c->next;
+    break;
+  }
+  if (idlelock != NULL) SDL_UnlockMutex(idlelock);
+  CLOSESOCK(c->sock);
+  free(c);
+}
+
+
+static int isaborted(void) {
+  int res;
+  if (idlelock == NULL) return(0);
+  SDL_LockMutex(idlelock);
+  res = aborted;
+  SDL_UnlockMutex(idlelock);
+  return(res);
+}
+
+
+void http_abort(void) {
+  struct httpconn *c;
+  if (idlelock == NULL) return;
+  SDL_LockMutex(idlelock);
+  aborted = 1;
+  /* a shut down socket wakes up whoever is blocked receiving from it */
+  for (c = openconns; c != NULL; c = c->next) SHUTSOCK(c->sock);
+  SDL_UnlockMutex(idlelock);
+}
+
+
 void init_net(void) {
   #if defined(_WIN32) || defined(WIN32)
   WSADATA wsaData;
   WSAStartup(MAKEWORD(2,2), &wsaData);
   #endif
+  idlelock = SDL_CreateMutex();
 }
 
 void cleanup_net(void) {
+  if (idlelock != NULL) {
+    closeconn(idleconn);
+    idleconn = NULL;
+    SDL_DestroyMutex(idlelock);
+    idlelock = NULL;
+    aborted = 0;
+  }
 #if defined(_WIN32) || defined(WIN32)
   WSACleanup();
 #endif
 }
 
-/* a socket must be closed with closesocket() on Windows */
-#ifdef _WIN32
-#define CLOSESOCK(x) closesocket(x)
-#else
-#define CLOSESOCK(x) close(x)
-#endif
+
+/* takes over the idle connection if it leads to host:port */
+static struct httpconn *takeidle(const char *host, unsigned short port) {
+  struct httpconn *c = NULL;
+  if (idlelock == NULL) return(NULL);
+  SDL_LockMutex(idlelock);
+  if ((idleconn != NULL) && (idleconn->port == port) && (strcmp(idleconn->host, host) == 0)) {
+    c = idleconn;
+    idleconn = NULL;
+  }
+  SDL_UnlockMutex(idlelock);
+  return(c);
+}
 
 
-/* open socket to remote host/port and return its socket descriptor */
-static int makeSocket(const char *host, unsigned short portnum) {
-  int sock;
-  struct sockaddr_in sa; /* Socket address */
-  struct hostent *hp;    /* Host entity */
+/* keeps c open for the next request, in place of any former idle connection */
+static void putidle(struct httpconn *c) {
+  struct httpconn *old;
+  if (idlelock == NULL) {
+    closeconn(c);
+    return;
+  }
+  SDL_LockMutex(idlelock);
+  old = idleconn;
+  idleconn = c;
+  SDL_UnlockMutex(idlelock);
+  closeconn(old);
+}
+
 
-  hp = gethostbyname(host);
-  if (hp == NULL) return(-1);
+/* open a connection to remote host/port (IPv4 or IPv6) */
+static struct httpconn *openconn(const char *host, unsigned short portnum) {
+  struct httpconn *c;
+  struct addrinfo hints, *ai, *res;
+  char portstr[8];
+  int sock = -1;
 
-  /* Copy host address from hostent to (server) socket address */
-  memcpy((char *)&sa.sin_addr, (char *)hp->h_addr, hp->h_length);
-  sa.sin_family = hp->h_addrtype;  /* Set service sin_family to PF_INET */
-  sa.sin_port = htons(portnum);       /* Put portnum into sockaddr */
+  if (strlen(host) >= sizeof(c->host)) return(NULL);
+  if (isaborted()) return(NULL);
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  sprintf(portstr, "%u", portnum);
+  if (getaddrinfo(host, portstr, &hints, &res) != 0) return(NULL);
+
+  /* try all addresses of host until one accepts the connection */
+  for (ai = res; ai != NULL; ai = ai->ai_next) {
+    sock = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (sock == -1) continue;
+    if (connect(sock, ai->ai_addr, ai->ai_addrlen) == 0) break;
+    CLOSESOCK(sock);
+    sock = -1;
+  }
+  freeaddrinfo(res);
+  if (sock == -1) return(NULL);
 
-  /* open socket */
-  sock = socket(hp->h_addrtype, SOCK_STREAM, 0);
-  if (sock == -1) return(-1);
+  c = malloc(sizeof(struct httpconn));
+  if (c == NULL) {
+    CLOSESOCK(sock);
+    return(NULL);
+  }
+  c->sock = sock;
+  strcpy(c->host, host);
+  c->port = portnum;
+  c->bufpos = 0;
+  c->buflen = 0;
+  c->failed = 0;
+  c->next = NULL;
+  if (idlelock == NULL) return(c);
 
-  /* connect to remote host */
-  if (connect(sock, (struct sockaddr *)&sa, sizeof(sa)) == -1) {
+  /* no new connection once transfers are aborted */
+  SDL_LockMutex(idlelock);
+  if (aborted) {
+    SDL_UnlockMutex(idlelock);
     CLOSESOCK(sock);
-    return(-1);
+    free(c);
+    return(NULL);
   }
+  c->next = openconns;
+  openconns = c;
+  SDL_UnlockMutex(idlelock);
+  return(c);
+}
+
 
-  return(sock);
+/* refills the read buffer if it is empty. returns the amount of buffered
+ * bytes, 0 on end of connection or error. */
+static size_t fillbuf(struct httpconn *c) {
+  long len;
+  if (c->bufpos < c->buflen) return(c->buflen - c->bufpos);
+  c->bufpos = 0;
+  c->buflen = 0;
+  len = recv(c->sock, (char *)c->buf, sizeof(c->buf), 0);
+  if (len < 0) c->failed = 1;
+  if (len <= 0) return(0);
+  c->buflen = (size_t)len;
+  return(c->buflen);
 }
 
-static long readline(int sock, char *buf, long maxlen) {
-  long res, bufpos = 0;
-  char bytebuff;
+
+/* reads a line, dropping its CRLF terminator (and anything that does not fit
+ * in buf). returns its length, or -1 if the connection ended first. */
+static long readline(struct httpconn *c, char *buf, long maxlen) {
+  long bufpos = 0;
+  unsigned char b;
   for (;;) {
-    res = recv(sock, &bytebuff, 1, 0);
-    if (res < 1) break;
-    if (bytebuff == '\r') continue;
-    if (bytebuff == '\n') break;
-    buf[bufpos++] = bytebuff;
-    if (bufpos >= maxlen - 1) break;
+    if (fillbuf(c) == 0) return(-1);
+    b = c->buf[c->bufpos++];
+    if (b == '\r') continue;
+    if (b == '\n') break;
+    if (bufpos < maxlen - 1) buf[bufpos++] = (char)b;
   }
   buf[bufpos] = 0;
   return(bufpos);
 }
 
-/* fetch a resource from host/path on defined port using http and return a pointer to the allocated chunk of memory
- * Note: do not forget to free the memory afterwards! */
-size_t http_get(const char *host, unsigned short port, const char *path, unsigned char **resptr) {
-  #define BUFLEN 2048
-  size_t resalloc = 1024;
-  size_t reslen = 0;
-  char linebuf[BUFLEN];
-  long len;
-  int sock;
-  unsigned char *res;
-  *resptr = NULL;
-  res = NULL;
-  sock = makeSocket(host, port);
-  if (sock < 0) {
-    printf("makeSocket() err: %s\n", strerror(errno));
-    return(0);
+
+/* appends len bytes read from c to body (or everything up to the end of the
+ * connection if len is UNTILEOF). returns 0 on success. */
+static int readbody(struct httpconn *c, struct httpbody *body, size_t len) {
+  size_t n;
+  while (len > 0) {
+    if ((body->progress != NULL) && (body->progress(body->ctx, body->len, body->total) != 0)) return(-1);
+    n = fillbuf(c);
+    /* a body delimited by the end of the connection is complete only if
+     * the server closed it, not if it broke or got aborted */
+    if (n == 0) return(((len == UNTILEOF) && (c->failed == 0) && !isaborted()) ? 0 : -1);
+    if (n > len) n = len;
+    if (body->len + n > DATA_SIZE_LIMIT) return(-1);
+    while (body->len + n + 1 > body->alloc) {
+      unsigned char *newdata = realloc(body->data, body->alloc *= 2);
+      if (newdata == NULL) return(-1);
+      body->data = newdata;
+    }
+    memcpy(body->data + body->len, c->buf + c->bufpos, n);
+    c->bufpos += n;
+    body->len += n;
+    if (len != UNTILEOF) len -= n;
   }
-  snprintf(linebuf, BUFLEN - 1, "GET %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n", path, host);
-  send(sock, linebuf, strlen(linebuf), 0);
-  /* trash out all headers */
+  return(0);
+}
+
+
+/* reads a body made of chunks (Transfer-Encoding: chunked). returns 0 on
+ * success. */
+static int readchunks(struct httpconn *c, struct httpbody *body) {
+  char line[128];
+  size_t chunklen;
   for (;;) {
-    len = readline(sock, linebuf, BUFLEN);
+    if (readline(c, line, sizeof(line)) < 0) return(-1);
+    chunklen = strtoul(line, NULL, 16);
+    if (chunklen == 0) break;
+    if (chunklen > DATA_SIZE_LIMIT) return(-1);
+    if (readbody(c, body, chunklen) != 0) return(-1);
+    if (readline(c, line, sizeof(line)) != 0) return(-1); /* CRLF after chunk */
+  }
+  /* skip trailer headers, up to the final empty line */
+  for (;;) {
+    long len = readline(c, line, sizeof(line));
+    if (len < 0) return(-1);
     if (len == 0) break;
   }
-  /* preallocate initial buffer */
-  res = malloc(resalloc);
-  if (res == NULL) {
-    CLOSESOCK(sock);
-    return(0);
+  return(0);
+}
+
+
+/* sends the request req over c and reads the status line and headers of the
+ * answer. returns 0 on success. */
+static int request(struct httpconn *c, const char *req, int *status, int *http11, struct http_headers *hdr) {
+  char linebuf[1024];
+  long len;
+  size_t sent, reqlen = strlen(req);
+  for (sent = 0; sent < reqlen; sent += (size_t)len) {
+    len = send(c->sock, req + sent, reqlen - sent, 0);
+    if (len <= 0) return(-1);
   }
-  /* fetch data */
+  /* read the status line ("HTTP/1.1 200 OK") */
+  if ((readline(c, linebuf, sizeof(linebuf)) < 12) || (strncmp(linebuf, "HTTP/", 5) != 0) || (strchr(linebuf, ' ') == NULL)) return(-1);
+  *status = atoi(strchr(linebuf, ' ') + 1);
+  *http11 = (strncmp(linebuf, "HTTP/1.0", 8) != 0);
+  /* parse headers, up to the empty line that ends them */
+  memset(hdr, 0, sizeof(*hdr));
   for (;;) {
-    len = recv(sock, linebuf, BUFLEN, 0);
+    len = readline(c, linebuf, sizeof(linebuf));
+    if (len < 0) return(-1);
     if (len == 0) break;
-    if (len < 0) {
-      printf("Err: %s\n", strerror(errno));
-      free(res);
-      CLOSESOCK(sock);
+    http_parseheader(linebuf, hdr);
+  }
+  return(0);
+}
+
+
+size_t http_fetch(const char *host, unsigned short port, const char *path, struct http_validators *val, http_progressfunc progress, void *ctx, unsigned char **resptr, int *status) {
+  char req[2048];
+  struct httpconn *c;
+  struct http_headers hdr;
+  struct httpbody body;
+  int attempt, reused, http11, fail;
+
+  *resptr = NULL;
+  *status = 0;
+
+  snprintf(req, sizeof(req) - 1, "GET %s HTTP/1.1\r\nHost: %s\r\nAccept-Encoding: gzip\r\n", path, host);
+  if ((val != NULL) && (val->etag[0] != 0)) {
+    snprintf(req + strlen(req), sizeof(req) - 1 - strlen(req), "If-None-Match: %s\r\n", val->etag);
+  }
+  if ((val != NULL) && (val->lastmodified[0] != 0)) {
+    snprintf(req + strlen(req), sizeof(req) - 1 - strlen(req), "If-Modified-Since: %s\r\n", val->lastmodified);
+  }
+  snprintf(req + strlen(req), sizeof(req) - 1 - strlen(req), "\r\n");
+
+  /* a reused connection may have been closed by the server in the meantime,
+   * in which case the request is tried again over a fresh one */
+  for (attempt = 0;; attempt++) {
+    c = takeidle(host, port);
+    reused = (c != NULL);
+    if (c == NULL) c = openconn(host, port);
+    if (c == NULL) {
+      printf("openconn() err: %s\n", strerror(errno));
       return(0);
     }
-    if (reslen + (size_t) len > DATA_SIZE_LIMIT) {
-      free(res);
-      CLOSESOCK(sock);
-      return 0;
+    if (request(c, req, status, &http11, &hdr) == 0) break;
+    closeconn(c);
+    *status = 0;
+    if ((reused == 0) || (attempt > 0)) return(0);
+  }
+
+  /* anything else than a 200 answer is not worth reading. a 304 answer has
+   * no body, so its connection is still good for another request */
+  if (*status != 200) {
+    if ((*status == 304) && http11 && !hdr.close) {
+      putidle(c);
+    } else {
+      closeconn(c);
+    }
+    return(0);
+  }
+
+  /* preallocate the body, all of it if its length is known */
+  memset(&body, 0, sizeof(body));
+  body.alloc = 1024;
+  if (hdr.haslength) {
+    if (hdr.contentlen > DATA_SIZE_LIMIT) {
+      closeconn(c);
+      return(0);
     }
-    while (reslen + (size_t)len + 1 > resalloc) {
-      unsigned char *newres = realloc(res, resalloc *= 2);
-
-      if (newres == NULL) {
-        free(res);
-        CLOSESOCK(sock);
-        return(0);
-      }
-      res = newres;
+    body.alloc = hdr.contentlen + 1;
+    body.total = hdr.contentlen;
+  }
+  body.progress = progress;
+  body.ctx = ctx;
+  body.data = malloc(body.alloc);
+  if (body.data == NULL) {
+    closeconn(c);
+    return(0);
+  }
+
+  /* fetch data */
+  if (hdr.chunked) {
+    fail = readchunks(c, &body);
+  } else if (hdr.haslength) {
+    fail = readbody(c, &body, hdr.contentlen);
+  } else {
+    fail = readbody(c, &body, UNTILEOF);
+    hdr.close = 1;
+  }
+
+  /* keep the connection for the next request if the answer did not leave
+   * anything unread behind */
+  if ((fail == 0) && http11 && !hdr.close && (c->bufpos == c->buflen)) {
+    putidle(c);
+  } else {
+    closeconn(c);
+  }
+  if (fail != 0) {
+    free(body.data);
+    return(0);
+  }
+  body.data[body.len] = 0; /* terminate data with a NULL, just in case (I don't know what the caller will want to do with the data..) */
+
+  /* gzip-encoded answer: decompress it */
+  if (hdr.gzip) {
+    size_t rawlen;
+    unsigned char *raw = ungz(body.data, body.len, &rawlen);
+    free(body.data);
+    if ((raw == NULL) || (rawlen > DATA_SIZE_LIMIT)) {
+      free(raw);
+      return(0);
     }
-    memcpy(&(res[reslen]), linebuf, (size_t)len);
-    reslen += (size_t)len;
+    body.data = raw;
+    body.len = rawlen;
   }
-  CLOSESOCK(sock);
-  res[reslen] = 0; /* terminate data with a NULL, just in case (I don't know what the caller will want to do with the data..) */
-  *resptr = res;
 
-  return(reslen);
+  if (val != NULL) memcpy(val, &hdr.val, sizeof(hdr.val));
+  *resptr = body.data;
+
+  return(body.len);
 }
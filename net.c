@@ -0,0 +1,103 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* backend-independent parts of the HTTP client, see net-socket.c and
+ * net-curl.c for the actual transport */
+
+#include <ctype.h>  /* tolower() */
+#include <stdlib.h> /* strtoul() */
+#include <string.h> /* strlen() */
+
+#include "net.h"
+#include "perf.h"
+
+
+/* returns a pointer to the value of header line if its name is hdr (case
+ * insensitive), NULL otherwise */
+static const char *headervalue(const char *line, const char *hdr) {
+  for (; *hdr != 0; hdr++, line++) {
+    if (tolower((unsigned char)*line) != *hdr) return(NULL);
+  }
+  if (*line != ':') return(NULL);
+  line++;
+  while ((*line == ' ') || (*line == '\t')) line++;
+  return(line);
+}
+
+
+/* copies value into dst (of dstsz bytes), dropping trailing white spaces.
+ * values that would not fit are dropped completely, since a truncated
+ * validator is worse than none. */
+static void copyvalue(char *dst, size_t dstsz, const char *value) {
+  size_t len = strlen(value);
+  while ((len > 0) && ((value[len - 1] == ' ') || (value[len - 1] == '\t') || (value[len - 1] == '\r') || (value[len - 1] == '\n'))) len--;
+  if (len >= dstsz) len = 0;
+  memcpy(dst, value, len);
+  dst[len] = 0;
+}
+
+
+/* tells whether the (comma-separated) list of tokens holds token, case
+ * insensitive */
+static int hastoken(const char *list, const char *token) {
+  size_t i;
+  for (;;) {
+    while ((*list == ' ') || (*list == '\t') || (*list == ',')) list++;
+    if (*list == 0) return(0);
+    for (i = 0; (token[i] != 0) && (tolower((unsigned char)list[i]) == token[i]); i++);
+    if ((token[i] == 0) && ((list[i] == 0) || (list[i] == ',') || (list[i] == ' ') || (list[i] == '\t') || (list[i] == ';'))) return(1);
+    while ((*list != 0) && (*list != ',')) list++;
+  }
+}
+
+
+void http_parseheader(const char *line, struct http_headers *hdr) {
+  const char *v;
+  if ((v = headervalue(line, "content-length")) != NULL) {
+    hdr->contentlen = strtoul(v, NULL, 10);
+    hdr->haslength = 1;
+  } else if ((v = headervalue(line, "content-encoding")) != NULL) {
+    hdr->gzip = hastoken(v, "gzip") | hastoken(v, "x-gzip");
+  } else if ((v = headervalue(line, "transfer-encoding")) != NULL) {
+    hdr->chunked = hastoken(v, "chunked");
+  } else if ((v = headervalue(line, "connection")) != NULL) {
+    hdr->close = hastoken(v, "close");
+  } else if ((v = headervalue(line, "etag")) != NULL) {
+    copyvalue(hdr->val.etag, sizeof(hdr->val.etag), v);
+  } else if ((v = headervalue(line, "last-modified")) != NULL) {
+    copyvalue(hdr->val.lastmodified, sizeof(hdr->val.lastmodified), v);
+  }
+}
+
+
+size_t http_get(const char *host, unsigned short port, const char *path, unsigned char **resptr) {
+  int status;
+  size_t res;
+  uint64_t perfstart = perf_begin();
+  res = http_fetch(host, port, path, NULL, NULL, NULL, resptr, &status);
+  perf_end(perf_http, perfstart);
+  return(res);
+}
@@ -33,9 +33,47 @@
   void init_net(void);
   void cleanup_net(void);
 
+  /* makes the transfers in progress (in any thread) fail as soon as
+   * possible, and the next ones fail right away. to be called before waiting
+   * for background transfers at exit. */
+  void http_abort(void);
+
+  /* cache validators of a resource, as returned by the server. an empty
+   * string means "not known" */
+  struct http_validators {
+    char etag[128];
+    char lastmodified[64];
+  };
+
+  /* progress callback of http_fetch(): received is the amount of bytes
+   * fetched so far, total the expected amount (0 if unknown). returning a
+   * non-zero value aborts the transfer. */
+  typedef int (*http_progressfunc)(void *ctx, size_t received, size_t total);
+
 /* fetch a resource from host/path on defined port using http and return a
  * pointer to the allocated chunk of memory
  * Note: do not forget to free the memory afterwards! */
   size_t http_get(const char *host, unsigned short port, const char *path, unsigned char **resptr);
 
+/* same as http_get(), but conditional and interruptible. if val is not NULL
+ * then its validators are sent along with the request, and replaced by the
+ * ones received in a 200 answer. progress may be NULL. *status is set to the
+ * HTTP status code of the answer, or 0 if no answer could be obtained. an
+ * answer other than 200 never comes with any data. */
+  size_t http_fetch(const char *host, unsigned short port, const char *path, struct http_validators *val, http_progressfunc progress, void *ctx, unsigned char **resptr, int *status);
+
+  /* the headers of an answer that matter to network backends */
+  struct http_headers {
+    struct http_validators val;
+    size_t contentlen;  /* Content-Length, if haslength is set */
+    int haslength;
+    int gzip;           /* body is gzip-encoded (Content-Encoding) */
+    int chunked;        /* body is sent in chunks (Transfer-Encoding) */
+    int close;          /* server closes the connection (Connection) */
+  };
+
+/* parses a single (CRLF-stripped) HTTP header line into hdr. used by network
+ * backends. */
+  void http_parseheader(const char *line, struct http_headers *hdr);
+
 #endif
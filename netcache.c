@@ -0,0 +1,302 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* background fetching of internet levels, backed by an on-disk cache.
+ *
+ * the cache directory holds two kinds of files:
+ *  - <crc64 of data>.dat files with the raw downloaded resources, named after
+ *    their content so a set served under several urls is stored only once,
+ *  - <crc64 of url>.idx files, one per url, telling which .dat file holds the
+ *    url's last known content along with the validators (ETag and
+ *    Last-Modified) used to ask the server whether it changed since. */
+
+#include <stdio.h>    /* fopen(), snprintf() */
+#include <stdlib.h>   /* malloc(), free() */
+#include <string.h>   /* memset(), strlen() */
+#include <inttypes.h> /* PRIx64, SCNx64 */
+
+#include "compat-sdl.h" /* SDL threads and atomics */
+
+#include "crc64.h"
+#include "net.h"
+#include "perf.h"
+#include "save.h"
+
+#include "netcache.h" /* include self for control */
+
+
+struct netfetch {
+  CSDL_AtomicInt refs;      /* one for the caller, one for the worker */
+  CSDL_AtomicInt state;     /* NETFETCH_xxx */
+  CSDL_AtomicInt received;  /* bytes downloaded so far */
+  CSDL_AtomicInt cancelled; /* set by the caller to abort the download */
+  SDL_Thread *thread;
+  char host[256];
+  unsigned short port;
+  char path[1024];
+  unsigned char *res;       /* result, owned by the handle until finished */
+  size_t reslen;
+  struct netfetch *next;    /* next cancelled fetch */
+};
+
+/* cancelled fetches whose thread may still be running, waited for by
+ * netcache_shutdown(). only ever used by the thread calling netcache_*(). */
+static struct netfetch *cancelled;
+
+
+static void netfetch_release(struct netfetch *f) {
+  if (CSDL_AtomicAdd(&(f->refs), -1) != 1) return;
+  free(f->res);
+  free(f);
+}
+
+
+/* builds the path of a cache file, returns 0 on success */
+static int cachefile(char *fname, size_t fnamesz, uint64_t id, const char *ext) {
+  char dir[1024];
+  getcachedir(dir, sizeof(dir));
+  if (dir[0] == 0) return(-1);
+  if ((size_t)snprintf(fname, fnamesz, "%s%016" PRIx64 ".%s", dir, id, ext) >= fnamesz) return(-1);
+  return(0);
+}
+
+
+/* loads the index of url urlid: the id of its cached content along with its
+ * validators. returns 0 on success. */
+static int loadindex(uint64_t urlid, uint64_t *dataid, struct http_validators *val) {
+  char fname[1100], line[256];
+  int gotdata = 0;
+  FILE *fd;
+  size_t len;
+  memset(val, 0, sizeof(*val));
+  if (cachefile(fname, sizeof(fname), urlid, "idx") != 0) return(-1);
+  fd = fopen(fname, "rb");
+  if (fd == NULL) return(-1);
+  while (fgets(line, sizeof(line), fd) != NULL) {
+    len = strlen(line);
+    while ((len > 0) && ((line[len - 1] == '\n') || (line[len - 1] == '\r'))) line[--len] = 0;
+    if (strncmp(line, "content ", 8) == 0) {
+      if (sscanf(line + 8, "%" SCNx64, dataid) == 1) gotdata = 1;
+    } else if ((strncmp(line, "etag ", 5) == 0) && (len - 5 < sizeof(val->etag))) {
+      strcpy(val->etag, line + 5);
+    } else if ((strncmp(line, "modified ", 9) == 0) && (len - 9 < sizeof(val->lastmodified))) {
+      strcpy(val->lastmodified, line + 9);
+    }
+  }
+  fclose(fd);
+  if (gotdata == 0) return(-1);
+  return(0);
+}
+
+
+static void saveindex(uint64_t urlid, uint64_t dataid, const struct http_validators *val) {
+  char fname[1100];
+  FILE *fd;
+  if (cachefile(fname, sizeof(fname), urlid, "idx") != 0) return;
+  fd = fopen(fname, "wb");
+  if (fd == NULL) return;
+  fprintf(fd, "content %016" PRIx64 "\n", dataid);
+  if (val->etag[0] != 0) fprintf(fd, "etag %s\n", val->etag);
+  if (val->lastmodified[0] != 0) fprintf(fd, "modified %s\n", val->lastmodified);
+  fclose(fd);
+}
+
+
+/* loads the cached content dataid, and makes sure it is intact. returns the
+ * length of loaded data (0 on failure). */
+static size_t loaddata(uint64_t dataid, unsigned char **resptr) {
+  char fname[1100];
+  unsigned char *res;
+  FILE *fd;
+  long len;
+  *resptr = NULL;
+  if (cachefile(fname, sizeof(fname), dataid, "dat") != 0) return(0);
+  fd = fopen(fname, "rb");
+  if (fd == NULL) return(0);
+  if ((fseek(fd, 0, SEEK_END) != 0) || ((len = ftell(fd)) <= 0) || (len > DATA_SIZE_LIMIT) || (fseek(fd, 0, SEEK_SET) != 0)) {
+    fclose(fd);
+    return(0);
+  }
+  res = malloc((size_t)len + 1);
+  if (res == NULL) {
+    fclose(fd);
+    return(0);
+  }
+  if ((fread(res, 1, (size_t)len, fd) != (size_t)len) || (crc64(0, res, (unsigned int)len) != dataid)) {
+    free(res);
+    fclose(fd);
+    return(0);
+  }
+  fclose(fd);
+  res[len] = 0;
+  *resptr = res;
+  return((size_t)len);
+}
+
+
+/* stores data into the cache, returns 0 on success */
+static int savedata(uint64_t dataid, const unsigned char *data, size_t len) {
+  char fname[1100];
+  FILE *fd;
+  int res = 0;
+  if (cachefile(fname, sizeof(fname), dataid, "dat") != 0) return(-1);
+  /* content-addressed: if the file exists then it holds these data already */
+  fd = fopen(fname, "rb");
+  if (fd != NULL) {
+    fclose(fd);
+    return(0);
+  }
+  fd = fopen(fname, "wb");
+  if (fd == NULL) return(-1);
+  if (fwrite(data, 1, len, fd) != len) res = -1;
+  if (fclose(fd) != 0) res = -1;
+  if (res != 0) remove(fname);
+  return(res);
+}
+
+
+static int netcache_progress(void *ctx, size_t received, size_t total) {
+  struct netfetch *f = ctx;
+  (void)total;
+  CSDL_AtomicSet(&(f->received), (int)received);
+  return(CSDL_AtomicGet(&(f->cancelled)));
+}
+
+
+static int netcache_worker(void *arg) {
+  struct netfetch *f = arg;
+  struct http_validators val;
+  unsigned char *cached = NULL, *res = NULL;
+  size_t cachedlen = 0, reslen;
+  uint64_t urlid, dataid, perfstart;
+  char url[1300];
+  int status;
+
+  snprintf(url, sizeof(url), "%s:%u%s", f->host, f->port, f->path);
+  urlid = crc64(0, (unsigned char *)url, (unsigned int)strlen(url));
+
+  /* look for a cached copy first, and revalidate it if found */
+  if (loadindex(urlid, &dataid, &val) == 0) cachedlen = loaddata(dataid, &cached);
+  if (cachedlen == 0) memset(&val, 0, sizeof(val));
+
+  perfstart = perf_begin();
+  reslen = http_fetch(f->host, f->port, f->path, &val, netcache_progress, f, &res, &status);
+  perf_end(perf_http, perfstart);
+
+  if ((status == 200) && (res != NULL)) { /* new content */
+    free(cached);
+    /* a cancelled fetch may have been cut short, it is never cached */
+    dataid = crc64(0, res, (unsigned int)reslen);
+    if ((CSDL_AtomicGet(&(f->cancelled)) == 0) && (savedata(dataid, res, reslen) == 0)) saveindex(urlid, dataid, &val);
+    f->res = res;
+    f->reslen = reslen;
+  } else if ((cachedlen > 0) && ((status == 304) || (status == 200) || (status == 0)) && (CSDL_AtomicGet(&(f->cancelled)) == 0)) {
+    /* not modified, server unreachable or answer cut short: the cached copy
+     * is good enough */
+    free(res);
+    f->res = cached;
+    f->reslen = cachedlen;
+  } else {
+    free(res);
+    free(cached);
+  }
+
+  CSDL_AtomicSet(&(f->state), (f->res != NULL) ? NETFETCH_DONE : NETFETCH_FAILED);
+  netfetch_release(f);
+  return(0);
+}
+
+
+struct netfetch *netcache_fetch(const char *host, unsigned short port, const char *path) {
+  struct netfetch *f;
+  if ((strlen(host) >= sizeof(f->host)) || (strlen(path) >= sizeof(f->path))) return(NULL);
+  f = calloc(1, sizeof(struct netfetch));
+  if (f == NULL) return(NULL);
+  strcpy(f->host, host);
+  strcpy(f->path, path);
+  f->port = port;
+  CSDL_AtomicSet(&(f->refs), 2);
+  CSDL_AtomicSet(&(f->state), NETFETCH_PENDING);
+  f->thread = SDL_CreateThread(netcache_worker, "simplesok fetch", f);
+  /* no thread available: fetch synchronously */
+  if (f->thread == NULL) netcache_worker(f);
+  return(f);
+}
+
+
+int netcache_poll(struct netfetch *f, size_t *received) {
+  if (received != NULL) *received = (size_t)CSDL_AtomicGet(&(f->received));
+  return(CSDL_AtomicGet(&(f->state)));
+}
+
+
+size_t netcache_finish(struct netfetch *f, unsigned char **resptr) {
+  size_t reslen;
+  if (f->thread != NULL) SDL_WaitThread(f->thread, NULL);
+  *resptr = f->res;
+  reslen = f->reslen;
+  f->res = NULL;
+  netfetch_release(f);
+  return(reslen);
+}
+
+
+void netcache_cancel(struct netfetch *f) {
+  struct netfetch **p;
+  CSDL_AtomicSet(&(f->cancelled), 1);
+
+  /* reap cancelled fetches that ended in the meantime */
+  for (p = &cancelled; *p != NULL;) {
+    struct netfetch *c = *p;
+    if (CSDL_AtomicGet(&(c->state)) == NETFETCH_PENDING) {
+      p = &(c->next);
+      continue;
+    }
+    *p = c->next;
+    SDL_WaitThread(c->thread, NULL);
+    netfetch_release(c);
+  }
+
+  if (f->thread == NULL) {
+    netfetch_release(f);
+    return;
+  }
+  f->next = cancelled;
+  cancelled = f;
+}
+
+
+void netcache_shutdown(void) {
+  struct netfetch *f;
+  if (cancelled == NULL) return;
+  http_abort();
+  while (cancelled != NULL) {
+    f = cancelled;
+    cancelled = f->next;
+    SDL_WaitThread(f->thread, NULL);
+    netfetch_release(f);
+  }
+}
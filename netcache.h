@@ -0,0 +1,63 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef netcache_h_sentinel
+#define netcache_h_sentinel
+
+  #include <stddef.h> /* size_t */
+
+  #define NETFETCH_PENDING 0
+  #define NETFETCH_DONE 1
+  #define NETFETCH_FAILED 2
+
+  struct netfetch; /* opaque handle of a background fetch */
+
+  /* starts fetching host:port/path in a background thread and returns a
+   * handle to follow the fetch (NULL on out of memory). the resource is
+   * served from the on-disk cache whenever the server says it did not
+   * change, or cannot be reached at all. every handle must be released
+   * either with netcache_finish() or with netcache_cancel(). */
+  struct netfetch *netcache_fetch(const char *host, unsigned short port, const char *path);
+
+  /* returns the state of a fetch (NETFETCH_xxx), never blocks. if received
+   * is not NULL then it is set to the amount of bytes downloaded so far. */
+  int netcache_poll(struct netfetch *f, size_t *received);
+
+  /* waits for a fetch to complete and releases its handle. returns the
+   * length of the fetched data and stores a pointer to them (NUL-terminated,
+   * to be freed by the caller) into *resptr, or returns 0 with *resptr set to
+   * NULL if the fetch failed. */
+  size_t netcache_finish(struct netfetch *f, unsigned char **resptr);
+
+  /* aborts a fetch and releases its handle without waiting. the fetch may
+   * go on in the background until it notices, see netcache_shutdown(). */
+  void netcache_cancel(struct netfetch *f);
+
+  /* aborts the cancelled fetches that are still going on and waits for
+   * them. to be called before cleanup_net(). */
+  void netcache_shutdown(void);
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>    /* fopen(), fprintf() */
+#include <stdlib.h>   /* malloc(), free() */
+#include <string.h>   /* strdup() */
+
+#include "compat-sdl.h" /* performance counters, mutexes */
+
+#include "perf.h" /* include self for control */
+
+
+/* timed calls are kept as trace events until perf_shutdown() writes them
+ * out. past PERF_MAXEVENTS events only the stats keep being updated. */
+#define PERF_MAXEVENTS 262144
+
+struct perfevent {
+  uint64_t start;
+  uint64_t dur;
+  unsigned long tid;
+  int phase;
+};
+
+int perf_enabled;
+
+static struct {
+  char *tracefile;
+  CSDL_Mutex *lock;         /* protects everything below */
+  uint64_t origin;          /* timestamp of perf_init() */
+  double tickms;            /* milliseconds per performance counter tick */
+  struct perfstats stats[perf_phasecount];
+  unsigned long framedrawcalls;
+  unsigned long lastframedraws; /* drawcall count when the last frame ended */
+  struct perfevent *events;
+  size_t eventcount;
+  unsigned long dropped;
+} perf;
+
+static const char *phasenames[perf_phasecount] = {
+  "draw_screen",
+  "draw call",
+  "sok_move",
+  "sok_checksolution",
+  "solution_load",
+  "solution_save",
+  "http_fetch"
+};
+
+
+void perf_init(const char *tracefile) {
+  if (perf_enabled) return;
+  memset(&perf, 0, sizeof(perf));
+  perf.lock = SDL_CreateMutex();
+  if (perf.lock == NULL) return;
+  perf.tracefile = strdup(tracefile);
+  perf.events = malloc(sizeof(struct perfevent) * PERF_MAXEVENTS);
+  perf.origin = SDL_GetPerformanceCounter();
+  perf.tickms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+  perf_enabled = 1;
+}
+
+
+uint64_t perf_begin(void) {
+  uint64_t t;
+  if (perf_enabled == 0) return(0);
+  t = SDL_GetPerformanceCounter();
+  if (t == 0) t = 1; /* 0 means "not measured" */
+  return(t);
+}
+
+
+void perf_end(enum perfphase phase, uint64_t start) {
+  uint64_t dur;
+  double ms;
+  if ((start == 0) || (perf_enabled == 0)) return;
+  dur = SDL_GetPerformanceCounter() - start;
+  ms = (double)dur * perf.tickms;
+  SDL_LockMutex(perf.lock);
+  perf.stats[phase].count += 1;
+  perf.stats[phase].totalms += ms;
+  if (ms > perf.stats[phase].maxms) perf.stats[phase].maxms = ms;
+  if (phase == perf_frame) {
+    perf.framedrawcalls = perf.stats[perf_drawcall].count - perf.lastframedraws;
+    perf.lastframedraws = perf.stats[perf_drawcall].count;
+  }
+  if ((perf.events != NULL) && (perf.eventcount < PERF_MAXEVENTS)) {
+    struct perfevent *e = &(perf.events[perf.eventcount++]);
+    e->start = start;
+    e->dur = dur;
+    e->tid = (unsigned long)CSDL_ThreadID();
+    e->phase = phase;
+  } else {
+    perf.dropped += 1;
+  }
+  SDL_UnlockMutex(perf.lock);
+}
+
+
+void perf_count(enum perfphase phase) {
+  if (perf_enabled == 0) return;
+  SDL_LockMutex(perf.lock);
+  perf.stats[phase].count += 1;
+  SDL_UnlockMutex(perf.lock);
+}
+
+
+void perf_getstats(enum perfphase phase, struct perfstats *stats) {
+  memset(stats, 0, sizeof(*stats));
+  if (perf_enabled == 0) return;
+  SDL_LockMutex(perf.lock);
+  *stats = perf.stats[phase];
+  SDL_UnlockMutex(perf.lock);
+}
+
+
+unsigned long perf_framedrawcalls(void) {
+  unsigned long res;
+  if (perf_enabled == 0) return(0);
+  SDL_LockMutex(perf.lock);
+  res = perf.framedrawcalls;
+  SDL_UnlockMutex(perf.lock);
+  return(res);
+}
+
+
+const char *perf_name(enum perfphase phase) {
+  return(phasenames[phase]);
+}
+
+
+/* timestamps are written in microseconds since perf_init(), as the trace
+ * event format wants */
+static double perf_us(uint64_t t) {
+  return((double)(t - perf.origin) * perf.tickms * 1000.0);
+}
+
+
+void perf_shutdown(void) {
+  FILE *fd;
+  size_t i;
+  int p;
+
+  if (perf_enabled == 0) return;
+  perf_enabled = 0;
+
+  fd = fopen(perf.tracefile, "wb");
+  if (fd == NULL) {
+    printf("perf: failed to write trace to %s\n", perf.tracefile);
+  } else {
+    fprintf(fd, "{\"traceEvents\":[\n");
+    for (i = 0; i < perf.eventcount; i++) {
+      const struct perfevent *e = &(perf.events[i]);
+      fprintf(fd, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}%s\n", phasenames[e->phase], e->tid, perf_us(e->start), (double)e->dur * perf.tickms * 1000.0, (i + 1 < perf.eventcount) ? "," : "");
+    }
+    fprintf(fd, "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%lu}}\n", perf.dropped);
+    fclose(fd);
+    printf("perf: trace written to %s (%lu events", perf.tracefile, (unsigned long)perf.eventcount);
+    if (perf.dropped != 0) printf(", %lu dropped", perf.dropped);
+    puts(")");
+  }
+
+  for (p = 0; p < perf_phasecount; p++) {
+    const struct perfstats *s = &(perf.stats[p]);
+    if (s->count == 0) continue;
+    if (p == perf_drawcall) {
+      printf("perf: %-18s %10lu calls\n", phasenames[p], s->count);
+    } else {
+      printf("perf: %-18s %10lu calls, avg %9.4f ms, max %9.4f ms, total %10.2f ms\n", phasenames[p], s->count, s->totalms / (double)s->count, s->maxms, s->totalms);
+    }
+  }
+
+  free(perf.events);
+  free(perf.tracefile);
+  SDL_DestroyMutex(perf.lock);
+  memset(&perf, 0, sizeof(perf));
+}
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef perf_h_sentinel
+#define perf_h_sentinel
+
+  #include <stdint.h>
+
+  /* the phases measured in --perf mode */
+  enum perfphase {
+    perf_frame = 0,       /* draw_screen() */
+    perf_drawcall,        /* textures copied to the renderer: tiles, walls, glyphs, layers... (counted only) */
+    perf_move,            /* sok_move() */
+    perf_checksolution,   /* sok_checksolution() */
+    perf_solload,         /* solution_load() */
+    perf_solsave,         /* solution_save() */
+    perf_http,            /* http_fetch(), that http_get() relies on */
+    perf_phasecount
+  };
+
+  struct perfstats {
+    unsigned long count;  /* number of calls */
+    double totalms;       /* time spent in all of them */
+    double maxms;         /* longest call */
+  };
+
+  /* non-zero once perf_init() has been called */
+  extern int perf_enabled;
+
+  /* enables measurements. tracefile is where the Chrome trace (the JSON
+   * "trace event format") is written by perf_shutdown(). */
+  void perf_init(const char *tracefile);
+
+  /* returns the start timestamp of a phase, or 0 if measurements are off */
+  uint64_t perf_begin(void);
+
+  /* records that a phase started at perf_begin() time start is over. does
+   * nothing if start is 0 */
+  void perf_end(enum perfphase phase, uint64_t start);
+
+  /* counts an occurrence of a phase that is not timed */
+  void perf_count(enum perfphase phase);
+
+  /* fills *stats with what has been measured of a phase so far */
+  void perf_getstats(enum perfphase phase, struct perfstats *stats);
+
+  /* returns the number of draw calls issued by the last complete frame */
+  unsigned long perf_framedrawcalls(void);
+
+  /* returns the name of a phase */
+  const char *perf_name(enum perfphase phase);
+
+  /* writes the trace file, prints a summary and disables measurements */
+  void perf_shutdown(void);
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdlib.h>   /* malloc(), free() */
+#include <string.h>   /* memset() */
+
+#include "compat-sdl.h" /* SDL threads and atomics */
+
+#include "pool.h" /* include self for control */
+
+
+struct poolctx {
+  CSDL_AtomicInt nextjob;
+  int jobcount;
+  pool_jobfunc job;
+  void *ctx;
+};
+
+
+/* worker loop: fetch job ids until none are left */
+static int pool_worker(void *arg) {
+  struct poolctx *pool = arg;
+  int jobid;
+  for (;;) {
+    jobid = CSDL_AtomicAdd(&(pool->nextjob), 1);
+    if (jobid >= pool->jobcount) break;
+    pool->job(pool->ctx, jobid);
+  }
+  return(0);
+}
+
+
+int pool_run(int threads, int jobcount, pool_jobfunc job, void *ctx) {
+  struct poolctx pool;
+  SDL_Thread **workers;
+  int i, spawned = 0;
+
+  if (jobcount < 1) return(0);
+  if (threads < 1) threads = CSDL_GetCPUCount();
+  if (threads < 1) threads = 1;
+  if (threads > jobcount) threads = jobcount;
+
+  memset(&pool, 0, sizeof(pool));
+  pool.jobcount = jobcount;
+  pool.job = job;
+  pool.ctx = ctx;
+
+  /* the calling thread is a worker, too, so spawn one thread less */
+  workers = malloc(sizeof(SDL_Thread *) * (size_t)threads);
+  if (workers != NULL) {
+    for (i = 0; i < threads - 1; i++) {
+      workers[spawned] = SDL_CreateThread(pool_worker, "simplesok worker", &pool);
+      if (workers[spawned] == NULL) break;
+      spawned++;
+    }
+  }
+
+  pool_worker(&pool);
+
+  for (i = 0; i < spawned; i++) SDL_WaitThread(workers[i], NULL);
+  free(workers);
+
+  return(spawned + 1);
+}
@@ -26,82 +26,44 @@
 
 #include <errno.h>
 #include <stdio.h>    /* fopen() */
-#include <stdlib.h>   /* malloc(), realloc() */
+#include <stdlib.h>   /* malloc(), realloc(), realpath() */
 #include <string.h>   /* strcpy(), strcat() */
 #include <inttypes.h> /* PRIx64 */
 #include <sys/stat.h> /* mkdir() */
+#include <dirent.h>   /* opendir() */
 
 #include "compat-sdl.h" /* SDL_GetPrefPath(), SDL_free() */
 
+#include "crc64.h"
+#include "movelist.h"
+#include "perf.h"
 #include "save.h"
 
-enum solmoves {
-  solmove_u = 0,
-  solmove_l = 1,
-  solmove_d = 2,
-  solmove_r = 3,
-  solmove_U = 4,
-  solmove_L = 5,
-  solmove_D = 6,
-  solmove_R = 7,
-  solmove_ERR = 8
-};
-
-static int xsb2byte(char c) {
-  switch (c) {
-    case 'u':
-      return(solmove_u);
-    case 'l':
-      return(solmove_l);
-    case 'd':
-      return(solmove_d);
-    case 'r':
-      return(solmove_r);
-    case 'U':
-      return(solmove_U);
-    case 'L':
-      return(solmove_L);
-    case 'D':
-      return(solmove_D);
-    case 'R':
-      return(solmove_R);
-    default:
-      return(solmove_ERR);
-  }
-}
-
-static char byte2xsb(int b) {
-  switch (b) {
-    case solmove_u:
-      return('u');
-    case solmove_l:
-      return('l');
-    case solmove_d:
-      return('d');
-    case solmove_r:
-      return('r');
-    case solmove_U:
-      return('U');
-    case solmove_L:
-      return('L');
-    case solmove_D:
-      return('D');
-    case solmove_R:
-      return('R');
-    default:
-      return('!');
-  }
-}
-
 #ifdef _WIN32
 #define MKDIR(d) mkdir(d)
 #else
 #define MKDIR(d) mkdir(d, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH)
 #endif
 
+/* user directory set by save_setroot(), empty if none */
+static char rootoverride[4096];
+
+void save_setroot(const char *dir) {
+  if (strlen(dir) + 2 > sizeof(rootoverride)) return;
+  strcpy(rootoverride, dir);
+  if ((rootoverride[0] != 0) && (rootoverride[strlen(rootoverride) - 1] != '/')) strcat(rootoverride, "/");
+}
+
 static void getfname(char *result, size_t ressz, const char *fname) {
   char *prefpath;
   if (ressz > 0) result[0] = 0;
+  if (rootoverride[0] != 0) {
+    MKDIR(rootoverride);
+    if (strlen(rootoverride) + strlen(fname) + 1 > ressz) return;
+    strcpy(result, rootoverride);
+    strcat(result, fname);
+    return;
+  }
   prefpath = SDL_GetPrefPath("", "simplesok");
   if (prefpath == NULL) return;
   MKDIR(prefpath);
@@ -119,11 +81,24 @@ static void getsavedir(char *savedir, size_t maxlen) {
 }
 
 
+void getcachedir(char *cachedir, size_t maxlen) {
+  getsavedir(cachedir, maxlen);
+  if (cachedir[0] == 0) return;
+  if (strlen(cachedir) + strlen("netcache/") + 1 > maxlen) {
+    cachedir[0] = 0;
+    return;
+  }
+  strcat(cachedir, "netcache/");
+  MKDIR(cachedir);
+}
+
+
 /* same as getsavedir(), but looks into the old directory (as used by v1.0
  * and v1.0.1) */
 static void getsavedir_legacy(char *savedir, int maxlen) {
   char *prefpath;
   if (maxlen > 0) savedir[0] = 0;
+  if (rootoverride[0] != 0) return; /* no legacy data outside of the user directory */
   maxlen -= 16; /* to be sure we will always have enough room for the app's suffix and extra NULL terminator */
   if (maxlen < 1) return;
   prefpath = SDL_GetPrefPath("Mateusz Viste", "Simple Sokoban");
@@ -134,18 +109,228 @@ static void getsavedir_legacy(char *savedir, int maxlen) {
 }
 
 
+/*** background writer *******************************************************
+ *
+ * files are written by a thread of their own, so that a slow disk never
+ * stalls the game. jobs are done in the order they were queued, and are of
+ * two kinds:
+ *
+ *   append   data is appended to the file, after hdr if the file is empty
+ *   replace  data becomes the whole content of the file: it is written to a
+ *            temporary file first, then renamed over the original one
+ *
+ * replacing a file supersedes any pending replacement of the same file, and
+ * loading a file that is about to be replaced returns the pending content.
+ * if no thread can be started, jobs are done right away. */
+
+#define WRITEJOB_APPEND 0
+#define WRITEJOB_REPLACE 1
+
+struct writejob {
+  struct writejob *next;
+  int mode;             /* WRITEJOB_xxx */
+  int busy;             /* being written, must not be changed anymore */
+  const char *hdr;      /* written first to an empty file, may be NULL */
+  unsigned char *data;
+  size_t len;
+  char *fname;          /* allocated along with the job */
+};
+
+static struct {
+  CSDL_Mutex *lock;
+  CSDL_Cond *wake;      /* signalled when a job is queued, or on flush */
+  SDL_Thread *thread;
+  struct writejob *head; /* next job to write, NULL if none */
+  struct writejob *tail;
+  int quit;
+} writer;
+
+
+/* writes len bytes of buf to fname, atomically. returns 0 on success. */
+static int replacefile(const char *fname, const unsigned char *buf, size_t len) {
+  char tmpfname[4096 + 8];
+  FILE *fd;
+  int res = 0;
+  if (strlen(fname) + 5 > sizeof(tmpfname)) return(-1);
+  sprintf(tmpfname, "%s.tmp", fname);
+  fd = fopen(tmpfname, "wb");
+  if (fd == NULL) return(-1);
+  if (fwrite(buf, 1, len, fd) != len) res = -1;
+  if (fclose(fd) != 0) res = -1;
+#ifdef _WIN32
+  if (res == 0) remove(fname); /* rename() does not replace files on Windows */
+#endif
+  if ((res != 0) || (rename(tmpfname, fname) != 0)) {
+    remove(tmpfname);
+    return(-1);
+  }
+  return(0);
+}
+
+
+static void writejob_do(const struct writejob *job) {
+  FILE *fd;
+  int res = 0;
+  if (job->mode == WRITEJOB_REPLACE) {
+    res = replacefile(job->fname, job->data, job->len);
+  } else {
+    fd = fopen(job->fname, "ab");
+    if (fd == NULL) {
+      res = -1;
+    } else {
+      if ((job->hdr != NULL) && (ftell(fd) == 0) && (fwrite(job->hdr, 1, strlen(job->hdr), fd) != strlen(job->hdr))) res = -1;
+      if ((res == 0) && (fwrite(job->data, 1, job->len, fd) != job->len)) res = -1;
+      if (fclose(fd) != 0) res = -1;
+    }
+  }
+  if (res != 0) fprintf(stderr, "failed to write file '%s' (%s)\n", job->fname, strerror(errno));
+}
+
+
+static void writejob_free(struct writejob *job) {
+  free(job->data);
+  free(job);
+}
+
+
+static int writer_main(void *arg) {
+  struct writejob *job;
+  (void)arg;
+  SDL_LockMutex(writer.lock);
+  for (;;) {
+    while ((writer.head == NULL) && (writer.quit == 0)) CSDL_CondWait(writer.wake, writer.lock);
+    job = writer.head;
+    if (job == NULL) break; /* flushed */
+    job->busy = 1;
+    SDL_UnlockMutex(writer.lock);
+    writejob_do(job);
+    SDL_LockMutex(writer.lock);
+    writer.head = job->next;
+    if (writer.head == NULL) writer.tail = NULL;
+    writejob_free(job);
+  }
+  SDL_UnlockMutex(writer.lock);
+  return(0);
+}
+
+
+/* starts the writer thread if not running yet, returns 0 on success */
+static int writer_start(void) {
+  if (writer.thread != NULL) return(0);
+  writer.lock = SDL_CreateMutex();
+  writer.wake = CSDL_CreateCond();
+  if ((writer.lock != NULL) && (writer.wake != NULL)) writer.thread = SDL_CreateThread(writer_main, "simplesok writer", NULL);
+  if (writer.thread != NULL) return(0);
+  if (writer.wake != NULL) CSDL_DestroyCond(writer.wake);
+  if (writer.lock != NULL) SDL_DestroyMutex(writer.lock);
+  memset(&writer, 0, sizeof(writer));
+  return(-1);
+}
+
+
+/* queues a job writing data (that is taken over) to fname */
+static void writer_queue(int mode, const char *fname, const char *hdr, unsigned char *data, size_t len) {
+  struct writejob *job, *j;
+  job = malloc(sizeof(struct writejob) + strlen(fname) + 1);
+  if (job == NULL) {
+    free(data);
+    return;
+  }
+  job->next = NULL;
+  job->mode = mode;
+  job->busy = 0;
+  job->hdr = hdr;
+  job->data = data;
+  job->len = len;
+  job->fname = (char *)(job + 1);
+  strcpy(job->fname, fname);
+
+  /* no thread: do it now */
+  if (writer_start() != 0) {
+    writejob_do(job);
+    writejob_free(job);
+    return;
+  }
+
+  SDL_LockMutex(writer.lock);
+  if (mode == WRITEJOB_REPLACE) { /* coalesce with a pending replacement */
+    for (j = writer.head; j != NULL; j = j->next) {
+      if ((j->busy != 0) || (j->mode != WRITEJOB_REPLACE) || (strcmp(j->fname, fname) != 0)) continue;
+      free(j->data);
+      j->data = data;
+      j->len = len;
+      job->data = NULL;
+      writejob_free(job);
+      SDL_UnlockMutex(writer.lock);
+      return;
+    }
+  }
+  if (writer.tail == NULL) {
+    writer.head = job;
+  } else {
+    writer.tail->next = job;
+  }
+  writer.tail = job;
+  CSDL_CondSignal(writer.wake);
+  SDL_UnlockMutex(writer.lock);
+}
+
+
+/* returns a malloc()'ed copy of the content fname is about to be replaced
+ * with, or NULL if no such replacement is pending */
+static unsigned char *writer_peek(const char *fname, size_t *len) {
+  struct writejob *j, *found = NULL;
+  unsigned char *res = NULL;
+  if (writer.thread == NULL) return(NULL);
+  SDL_LockMutex(writer.lock);
+  for (j = writer.head; j != NULL; j = j->next) {
+    if ((j->mode == WRITEJOB_REPLACE) && (strcmp(j->fname, fname) == 0)) found = j;
+  }
+  if (found != NULL) {
+    res = malloc(found->len + 1);
+    if (res != NULL) {
+      memcpy(res, found->data, found->len);
+      *len = found->len;
+    }
+  }
+  SDL_UnlockMutex(writer.lock);
+  return(res);
+}
+
+
+void save_flush(void) {
+  if (writer.thread == NULL) return;
+  SDL_LockMutex(writer.lock);
+  writer.quit = 1;
+  CSDL_CondSignal(writer.wake);
+  SDL_UnlockMutex(writer.lock);
+  SDL_WaitThread(writer.thread, NULL);
+  CSDL_DestroyCond(writer.wake);
+  SDL_DestroyMutex(writer.lock);
+  memset(&writer, 0, sizeof(writer));
+}
+
+
 const char *loadconf_skin(void) {
   static char rootdir[512];
   FILE *fd;
   size_t len, i;
+  unsigned char *pending;
   getfname(rootdir, sizeof(rootdir), "skin.cfg");
   if (rootdir[0] == 0) return(NULL);
 
-  fd = fopen(rootdir, "rb");
-  if (fd == NULL) return(NULL);
-
-  len = fread(rootdir, 1, sizeof(rootdir) - 2, fd);
-  fclose(fd);
+  /* a skin just configured may not be written yet */
+  pending = writer_peek(rootdir, &len);
+  if (pending != NULL) {
+    if (len > sizeof(rootdir) - 2) len = sizeof(rootdir) - 2;
+    memcpy(rootdir, pending, len);
+    free(pending);
+  } else {
+    fd = fopen(rootdir, "rb");
+    if (fd == NULL) return(NULL);
+    len = fread(rootdir, 1, sizeof(rootdir) - 2, fd);
+    fclose(fd);
+  }
 
   if (len < 1) return(NULL);
 
@@ -161,32 +346,417 @@ const char *loadconf_skin(void) {
 
 void setconf_skin(const char *skin) {
   char rootdir[512];
-  FILE *fd;
+  unsigned char *data;
 
   getfname(rootdir, sizeof(rootdir), "skin.cfg");
   if (rootdir[0] == 0) return;
 
-  fd = fopen(rootdir, "wb");
+  data = malloc(strlen(skin) + 1);
+  if (data == NULL) return;
+  memcpy(data, skin, strlen(skin));
+  writer_queue(WRITEJOB_REPLACE, rootdir, NULL, data, strlen(skin));
+}
+
+
+/* loads a whole file to memory, returns a malloc()'ed buffer or NULL */
+static unsigned char *loadwholefile(const char *fname, size_t *len) {
+  unsigned char *buf = NULL, *newbuf;
+  size_t alloc = 0, got;
+  FILE *fd;
+  *len = 0;
+  buf = writer_peek(fname, len);
+  if (buf != NULL) return(buf);
+  fd = fopen(fname, "rb");
+  if (fd == NULL) return(NULL);
+  for (;;) {
+    if (*len == alloc) {
+      alloc = (alloc == 0) ? 4096 : alloc * 2;
+      newbuf = realloc(buf, alloc);
+      if (newbuf == NULL) break;
+      buf = newbuf;
+    }
+    got = fread(buf + *len, 1, alloc - *len, fd);
+    *len += got;
+    if (got == 0) {
+      if (ferror(fd)) break;
+      fclose(fd);
+      return(buf);
+    }
+  }
+  fclose(fd);
+  free(buf);
+  return(NULL);
+}
+
+
+/*** solutions database ******************************************************
+ *
+ * solutions (and pre-1.0.7 *.dat solutions, keyed by their CRC32) are kept in
+ * a single file, loaded once into an in-memory hash table. the file begins
+ * with SOLDB_MAGIC and is followed by records that are only ever appended:
+ *
+ *   kind (1 byte)  's' for a solution, 'd' for a legacy (CRC32) solution
+ *   key (8 bytes)  CRC64 (or CRC32) of the level, little endian
+ *   len (4 bytes)  length of the packed solution, little endian
+ *   data           packed solution, see ml_pack()
+ *   check (8 bytes) CRC64 of all the above, little endian
+ *
+ * the last record of a key wins. a torn record (crash in the middle of an
+ * append) fails its check: the file is truncated right before it. a file
+ * that does not begin with SOLDB_MAGIC is moved aside (to *.bad) and a new
+ * one is started, and a file that cannot be read is left alone, solutions
+ * being then kept in memory only. whenever the file needs compacting it is
+ * rewritten to a temporary file that is then renamed over the original
+ * one. */
+
+#define SOLDB_FNAME "solutions.db"
+#define SOLDB_MAGIC "SOKSOLDB1\n"
+#define SOLDB_MAGICLEN 10
+#define SOLDB_HDRLEN 13      /* kind + key + len */
+
+struct soldbentry {
+  uint64_t key;
+  int kind;                  /* 0 for an empty slot */
+  struct sokmovelist *solution;
+};
+
+static struct {
+  int opened;
+  char fname[4096];          /* empty if no save directory is available */
+  struct soldbentry *slot;
+  size_t slotcount;          /* power of 2 */
+  size_t used;
+  size_t dead;               /* superseded records in the file */
+  unsigned long generation;  /* bumped whenever a solution is saved */
+} soldb;
+
+
+/* maps a solution file extension to a database kind, 0 if not stored in the
+ * database */
+static int soldb_kind(const char *ext) {
+  if (strcmp(ext, "sol") == 0) return('s');
+  if (strcmp(ext, "dat") == 0) return('d');
+  return(0);
+}
+
+
+static void put_le(unsigned char *p, uint64_t v, int bytes) {
+  int i;
+  for (i = 0; i < bytes; i++) {
+    p[i] = (unsigned char)(v & 0xff);
+    v >>= 8;
+  }
+}
+
+
+static uint64_t get_le(const unsigned char *p, int bytes) {
+  uint64_t v = 0;
+  while (bytes-- > 0) v = (v << 8) | p[bytes];
+  return(v);
+}
+
+
+/* returns the slot of (kind, key): either its entry or the empty slot where
+ * it belongs */
+static struct soldbentry *soldb_slot(int kind, uint64_t key) {
+  size_t i = (size_t)(key ^ (key >> 31) ^ (uint64_t)kind) & (soldb.slotcount - 1);
+  while ((soldb.slot[i].kind != 0) && ((soldb.slot[i].kind != kind) || (soldb.slot[i].key != key))) {
+    i = (i + 1) & (soldb.slotcount - 1);
+  }
+  return(&(soldb.slot[i]));
+}
+
+
+/* stores solution (that is taken over) under (kind, key). returns 0 on
+ * success. */
+static int soldb_set(int kind, uint64_t key, struct sokmovelist *solution) {
+  struct soldbentry *e;
+  /* keep the table at most half full */
+  if ((soldb.used + 1) * 2 > soldb.slotcount) {
+    struct soldbentry *oldslot = soldb.slot;
+    size_t i, oldcount = soldb.slotcount;
+    size_t newcount = (oldcount == 0) ? 1024 : oldcount * 2;
+    struct soldbentry *newslot = calloc(newcount, sizeof(struct soldbentry));
+    if (newslot == NULL) {
+      ml_free(solution);
+      return(-1);
+    }
+    soldb.slot = newslot;
+    soldb.slotcount = newcount;
+    for (i = 0; i < oldcount; i++) {
+      if (oldslot[i].kind != 0) *soldb_slot(oldslot[i].kind, oldslot[i].key) = oldslot[i];
+    }
+    free(oldslot);
+  }
+  e = soldb_slot(kind, key);
+  if (e->kind != 0) {
+    ml_free(e->solution);
+    soldb.dead += 1;
+  } else {
+    soldb.used += 1;
+  }
+  e->kind = kind;
+  e->key = key;
+  e->solution = solution;
+  return(0);
+}
+
+
+#define DBLOAD_OK 0
+#define DBLOAD_MISSING 1  /* no file yet, a new one may be created */
+#define DBLOAD_FAILED 2   /* the file cannot be read, it must be left alone */
+
+/* loads database file fname into *buf (*buflen bytes). a file that does not
+ * begin with magic is renamed to fname.bad and reported as missing, so it
+ * can still be looked at later. returns a DBLOAD_xxx value. */
+static int db_load(const char *fname, const char *magic, unsigned char **buf, size_t *buflen) {
+  char badfname[4096 + 8];
+  FILE *fd;
+  *buf = NULL;
+  *buflen = 0;
+  fd = fopen(fname, "rb");
   if (fd == NULL) {
-    fprintf(stderr, "failed to open config file '%s' (%s)\n", rootdir, strerror(errno));
+    if (errno == ENOENT) return(DBLOAD_MISSING);
+    fprintf(stderr, "failed to open '%s' (%s), changes will not be saved\n", fname, strerror(errno));
+    return(DBLOAD_FAILED);
+  }
+  fclose(fd);
+  *buf = loadwholefile(fname, buflen);
+  if (*buf == NULL) {
+    fprintf(stderr, "failed to read '%s', changes will not be saved\n", fname);
+    return(DBLOAD_FAILED);
+  }
+  if ((*buflen >= strlen(magic)) && (memcmp(*buf, magic, strlen(magic)) == 0)) return(DBLOAD_OK);
+  free(*buf);
+  *buf = NULL;
+  *buflen = 0;
+  sprintf(badfname, "%s.bad", fname);
+  remove(badfname); /* rename() does not replace files on Windows */
+  if (rename(fname, badfname) != 0) {
+    fprintf(stderr, "'%s' is damaged and cannot be moved aside (%s), changes will not be saved\n", fname, strerror(errno));
+    return(DBLOAD_FAILED);
+  }
+  fprintf(stderr, "'%s' is damaged, it has been moved to '%s'\n", fname, badfname);
+  return(DBLOAD_MISSING);
+}
+
+
+/* drops the torn end of database file fname, of which buf holds the first
+ * len good bytes. returns 0 on success. */
+static int db_truncate(const char *fname, const unsigned char *buf, size_t len) {
+  fprintf(stderr, "'%s' ends with a torn record, dropping it\n", fname);
+  if (replacefile(fname, buf, len) == 0) return(0);
+  fprintf(stderr, "failed to repair '%s', changes will not be saved\n", fname);
+  return(-1);
+}
+
+
+/* returns a record of datalen bytes of data as a malloc()'ed buffer of *len
+ * bytes, or NULL */
+static unsigned char *db_record(int kind, uint64_t key, const unsigned char *data, size_t datalen, size_t *len) {
+  unsigned char *rec;
+  *len = SOLDB_HDRLEN + datalen + 8;
+  rec = malloc(*len);
+  if (rec == NULL) return(NULL);
+  rec[0] = (unsigned char)kind;
+  put_le(rec + 1, key, 8);
+  put_le(rec + 9, datalen, 4);
+  memcpy(rec + SOLDB_HDRLEN, data, datalen);
+  put_le(rec + SOLDB_HDRLEN + datalen, crc64(0, rec, (unsigned int)(SOLDB_HDRLEN + datalen)), 8);
+  return(rec);
+}
+
+
+/* checks the record at offset pos of buf (buflen bytes long). returns the
+ * length of its data, or -1 if the record is torn. */
+static long db_checkrecord(const unsigned char *buf, size_t buflen, size_t pos) {
+  size_t len;
+  if (buflen - pos < SOLDB_HDRLEN + 8) return(-1);
+  len = (size_t)get_le(buf + pos + 9, 4);
+  if (len > buflen - pos - SOLDB_HDRLEN - 8) return(-1);
+  if (crc64(0, buf + pos, (unsigned int)(SOLDB_HDRLEN + len)) != get_le(buf + pos + SOLDB_HDRLEN + len, 8)) return(-1);
+  return((long)len);
+}
+
+
+/* returns a record as a malloc()'ed buffer of *len bytes, or NULL */
+static unsigned char *soldb_record(int kind, uint64_t key, const struct sokmovelist *solution, size_t *len) {
+  unsigned char *rec, *packed;
+  size_t packedlen;
+  packed = ml_pack(solution, &packedlen);
+  if (packed == NULL) return(NULL);
+  rec = db_record(kind, key, packed, packedlen, len);
+  free(packed);
+  return(rec);
+}
+
+
+/* writes a record to fd, returns 0 on success */
+static int soldb_writerecord(FILE *fd, int kind, uint64_t key, const struct sokmovelist *solution) {
+  unsigned char *rec;
+  size_t len;
+  int res = 0;
+  rec = soldb_record(kind, key, solution, &len);
+  if (rec == NULL) return(-1);
+  if (fwrite(rec, 1, len, fd) != len) res = -1;
+  free(rec);
+  return(res);
+}
+
+
+/* rewrites the whole database file with live entries only, atomically */
+static void soldb_rewrite(void) {
+  char tmpfname[4096 + 8];
+  FILE *fd;
+  size_t i;
+  int res = 0;
+  sprintf(tmpfname, "%s.tmp", soldb.fname);
+  fd = fopen(tmpfname, "wb");
+  if (fd == NULL) return;
+  if (fwrite(SOLDB_MAGIC, 1, SOLDB_MAGICLEN, fd) != SOLDB_MAGICLEN) res = -1;
+  for (i = 0; (i < soldb.slotcount) && (res == 0); i++) {
+    if (soldb.slot[i].kind != 0) res = soldb_writerecord(fd, soldb.slot[i].kind, soldb.slot[i].key, soldb.slot[i].solution);
+  }
+  if (fclose(fd) != 0) res = -1;
+#ifdef _WIN32
+  if (res == 0) remove(soldb.fname); /* rename() does not replace files on Windows */
+#endif
+  if ((res != 0) || (rename(tmpfname, soldb.fname) != 0)) {
+    remove(tmpfname);
     return;
   }
+  soldb.dead = 0;
+}
 
-  fwrite(skin, 1, strlen(skin), fd);
-  fclose(fd);
+
+/* imports all solution files (*.sol, and legacy *.dat) of dir */
+static void soldb_importdir(const char *dir) {
+  char fname[4096];
+  struct dirent *dentry;
+  DIR *dirfd;
+  uint64_t key;
+  size_t len, packedlen, i;
+  unsigned char *packed;
+  struct sokmovelist *solution;
+  int kind;
+
+  if (dir[0] == 0) return;
+  dirfd = opendir(dir);
+  if (dirfd == NULL) return;
+  while ((dentry = readdir(dirfd)) != NULL) {
+    len = strlen(dentry->d_name);
+    /* <16 hex digits>.sol or <8 hex digits>.dat */
+    if ((len == 20) && (strcmp(dentry->d_name + 16, ".sol") == 0)) {
+      kind = 's';
+    } else if ((len == 12) && (strcmp(dentry->d_name + 8, ".dat") == 0)) {
+      kind = 'd';
+    } else {
+      continue;
+    }
+    key = 0;
+    for (i = 0; i < len - 4; i++) {
+      int c = dentry->d_name[i] | 0x20;
+      if ((c >= '0') && (c <= '9')) {
+        key = (key << 4) | (uint64_t)(c - '0');
+      } else if ((c >= 'a') && (c <= 'f')) {
+        key = (key << 4) | (uint64_t)(c - 'a' + 10);
+      } else {
+        break;
+      }
+    }
+    if (i != len - 4) continue;
+    if (strlen(dir) + len + 1 > sizeof(fname)) continue;
+    strcpy(fname, dir);
+    strcat(fname, dentry->d_name);
+    packed = loadwholefile(fname, &packedlen);
+    if (packed == NULL) continue;
+    solution = ml_unpack(packed, packedlen);
+    free(packed);
+    if (solution != NULL) soldb_set(kind, key, solution);
+  }
+  closedir(dirfd);
+}
+
+
+/* loads the database, or creates it out of solution files if there is none */
+static void soldb_open(void) {
+  char dir[4096];
+  unsigned char *buf;
+  size_t buflen, pos, len;
+  long reclen;
+  int res, torn = 0, lost = 0;
+
+  if (soldb.opened) return;
+  soldb.opened = 1;
+  soldb.generation = 1;
+
+  getsavedir(dir, sizeof(dir));
+  if ((dir[0] == 0) || (strlen(dir) + strlen(SOLDB_FNAME) + 1 > sizeof(soldb.fname))) return;
+  sprintf(soldb.fname, "%s%s", dir, SOLDB_FNAME);
+
+  res = db_load(soldb.fname, SOLDB_MAGIC, &buf, &buflen);
+  if (res == DBLOAD_FAILED) {
+    soldb.fname[0] = 0;
+    return;
+  }
+
+  /* no database yet: migrate existing solution files to a new one, those
+   * from the legacy directory first so that current ones take precedence */
+  if (res == DBLOAD_MISSING) {
+    char legacydir[4096];
+    getsavedir_legacy(legacydir, sizeof(legacydir));
+    soldb_importdir(legacydir);
+    soldb_importdir(dir);
+    soldb_rewrite();
+    return;
+  }
+
+  for (pos = SOLDB_MAGICLEN; pos < buflen; pos += SOLDB_HDRLEN + len + 8) {
+    struct sokmovelist *solution;
+    reclen = db_checkrecord(buf, buflen, pos);
+    if (reclen < 0) {
+      torn = 1;
+      break;
+    }
+    len = (size_t)reclen;
+    solution = ml_unpack(buf + pos + SOLDB_HDRLEN, len);
+    if ((solution == NULL) || (soldb_set(buf[pos], get_le(buf + pos + 1, 8), solution) != 0)) lost = 1;
+  }
+
+  /* drop the torn end, so new records do not follow it. the file is
+   * compacted once it is mostly made of superseded records, unless some of
+   * them could not be loaded */
+  if (torn) {
+    if (db_truncate(soldb.fname, buf, pos) != 0) soldb.fname[0] = 0;
+  } else if ((lost == 0) && (soldb.dead > 64) && (soldb.dead > soldb.used)) {
+    soldb_rewrite();
+  }
+  free(buf);
 }
 
 
-/* returns a malloc()'ed, null-terminated string with the solution to level levcrc32. if no solution available, returns NULL. */
-char *solution_load(uint64_t levcrc64, char *ext) {
-  char rootdir[4096], crcstr[32], *solution, *solutionfinal;
-  int bytebuff, rlecounter;
-  size_t solutionpos = 0, solution_alloc = 16;
-  FILE *fd = NULL;
+/* returns the solution to level levcrc64 (to be freed with ml_free()). if no solution available, returns NULL. */
+static struct sokmovelist *solution_doload(uint64_t levcrc64, char *ext) {
+  char rootdir[4096], crcstr[32];
+  unsigned char *packed;
+  size_t packedlen;
+  struct sokmovelist *solution;
+  int kind = soldb_kind(ext);
   unsigned short i;
 
+  /* solutions are looked up in the database */
+  if (kind != 0) {
+    struct soldbentry *e;
+    soldb_open();
+    if (soldb.slotcount == 0) return(NULL);
+    e = soldb_slot(kind, levcrc64);
+    if (e->kind == 0) return(NULL);
+    return(ml_dup(e->solution));
+  }
+
   /* try loading the solution from two sources: first from current preferred
    * directory, then from the legacy (1.0 and 1.0.1) directory */
+  packed = NULL;
   for (i = 0; i < 2; i++) {
     if (i == 0) {
       getsavedir(rootdir, sizeof(rootdir));
@@ -194,95 +764,510 @@ char *solution_load(uint64_t levcrc64, char *ext) {
       getsavedir_legacy(rootdir, sizeof(rootdir));
     }
     if (rootdir[0] == 0) continue;
-    if ((ext[0] | 0x20) == 'd') { /* legacy *.DAT loading (pre-1.0.7) */
-      sprintf(crcstr, "%08lX.%s", (unsigned long)levcrc64, ext);
-    } else {
-      sprintf(crcstr, "%016" PRIx64 ".%s", levcrc64, ext);
-    }
+    sprintf(crcstr, "%016" PRIx64 ".%s", levcrc64, ext);
     strcat(rootdir, crcstr);
-    fd = fopen(rootdir, "rb");
-    if (fd != NULL) break;
+    packed = loadwholefile(rootdir, &packedlen);
+    if (packed != NULL) break;
+  }
+  if (packed == NULL) return(NULL);
+
+  solution = ml_unpack(packed, packedlen);
+  free(packed);
+  return(solution);
+}
+
+/* returns the generation of solutions, it changes whenever a solution is saved */
+unsigned long solution_generation(void) {
+  soldb_open();
+  return(soldb.generation);
+}
+
+/* saves the solution for levcrc64 */
+static void solution_dosave(uint64_t levcrc64, const struct sokmovelist *solution, char *ext) {
+  char rootdir[4096], crcstr[32];
+  unsigned char *packed;
+  size_t packedlen;
+  int kind = soldb_kind(ext);
+
+  if (solution == NULL) return;
+
+  /* solutions go to the database: in memory, then appended to its file (a
+   * brand new file getting its signature first) */
+  if (kind != 0) {
+    struct sokmovelist *copy;
+    soldb_open();
+    copy = ml_dup(solution);
+    if ((copy == NULL) || (soldb_set(kind, levcrc64, copy) != 0)) return;
+    soldb.generation += 1;
+    if (soldb.fname[0] == 0) return;
+    packed = soldb_record(kind, levcrc64, solution, &packedlen);
+    if (packed != NULL) writer_queue(WRITEJOB_APPEND, soldb.fname, SOLDB_MAGIC, packed, packedlen);
+    return;
+  }
+
+  getsavedir(rootdir, sizeof(rootdir));
+  if (rootdir[0] == 0) return;
+  sprintf(crcstr, "%016" PRIx64 ".%s", levcrc64, ext);
+  strcat(rootdir, crcstr);
+  packed = ml_pack(solution, &packedlen);
+  if (packed != NULL) writer_queue(WRITEJOB_REPLACE, rootdir, NULL, packed, packedlen);
+}
+
+
+struct sokmovelist *solution_load(uint64_t levcrc64, char *ext) {
+  uint64_t perfstart = perf_begin();
+  struct sokmovelist *res = solution_doload(levcrc64, ext);
+  perf_end(perf_solload, perfstart);
+  return(res);
+}
+
+
+void solution_save(uint64_t levcrc64, const struct sokmovelist *solution, char *ext) {
+  uint64_t perfstart = perf_begin();
+  solution_dosave(levcrc64, solution, ext);
+  perf_end(perf_solsave, perfstart);
+}
+
+
+/* fills *fname with the path of the level cache entry of key, or with an
+ * empty string if no cache directory is available */
+static void levelcache_fname(char *fname, size_t maxlen, uint64_t key) {
+  char entry[32];
+  getsavedir(fname, maxlen);
+  if (fname[0] == 0) return;
+  sprintf(entry, "%016" PRIx64 ".lvc", key);
+  if (strlen(fname) + strlen("levcache/") + strlen(entry) + 1 > maxlen) {
+    fname[0] = 0;
+    return;
   }
+  strcat(fname, "levcache/");
+  MKDIR(fname);
+  strcat(fname, entry);
+}
+
+
+unsigned char *levelcache_load(uint64_t key, size_t *len) {
+  char fname[4096];
+  unsigned char *buf;
+  long fsize;
+  FILE *fd;
+  *len = 0;
+  levelcache_fname(fname, sizeof(fname), key);
+  if (fname[0] == 0) return(NULL);
+  buf = writer_peek(fname, len);
+  if (buf != NULL) return(buf);
+  fd = fopen(fname, "rb");
   if (fd == NULL) return(NULL);
+  if ((fseek(fd, 0, SEEK_END) != 0) || ((fsize = ftell(fd)) <= 0) || (fseek(fd, 0, SEEK_SET) != 0)) {
+    fclose(fd);
+    return(NULL);
+  }
+  /* the whole entry is fetched with a single read */
+  buf = malloc((size_t)fsize);
+  if ((buf != NULL) && (fread(buf, 1, (size_t)fsize, fd) != (size_t)fsize)) {
+    free(buf);
+    buf = NULL;
+  }
+  fclose(fd);
+  if (buf != NULL) *len = (size_t)fsize;
+  return(buf);
+}
 
-  solution = malloc(solution_alloc);
-  if (solution == NULL) return(NULL);
-  solution[0] = 0;
 
-  for (;;) {
-    bytebuff = getc(fd);
-    if (bytebuff < 0) break; /* if end of file -> stop here */
-    rlecounter = bytebuff >> 4; /* fetch the RLE counter */
-    bytebuff &= 15; /* strip the rle counter, so we have only the actual value */
-    while (rlecounter > 0) {
-      /* check first if we are in need of reallocation */
-      if (solutionpos + 1 >= solution_alloc) {
-        solution_alloc *= 2;
-        solution = realloc(solution, solution_alloc);
-        if (solution == NULL) {
-          printf("realloc() failed for %lu bytes: %s\n", (unsigned long)solution_alloc, strerror(errno));
-          solution = NULL;
-          break;
-        }
-      }
-      /* add one position to the solution and decrement the rle counter */
-      solution[solutionpos] = byte2xsb(bytebuff);
-      if (solution[solutionpos] == '!') { /* if corrupted solution, free it and return nothing */
-        free(solution);
-        solution = NULL;
-        break;
-      }
-      solutionpos += 1;
-      solution[solutionpos] = 0;
-      rlecounter -= 1;
+void levelcache_save(uint64_t key, const unsigned char *buf, size_t len) {
+  char fname[4096];
+  unsigned char *data;
+  levelcache_fname(fname, sizeof(fname), key);
+  if (fname[0] == 0) return;
+  /* replaced as a whole, so a crash never leaves a partial entry behind */
+  data = malloc(len + 1);
+  if (data == NULL) return;
+  memcpy(data, buf, len);
+  writer_queue(WRITEJOB_REPLACE, fname, NULL, data, len);
+}
+
+
+/*** level index *************************************************************
+ *
+ * every level of the sets that have been opened is indexed by CRC64, along
+ * with the sets it belongs to, so progress and duplicates can be reported
+ * across sets. the index is kept in memory and in a file made of records
+ * laid out like those of the solutions database: an 'S' record lists the
+ * CRC64 of the levels of a set (count, then 8 bytes per level, then the
+ * set's name), under the CRC64 of its name; an 'L' record holds the width,
+ * height and number of boxes of a level (2 bytes each), under its CRC64.
+ * records superseding older ones are appended. best scores are not stored,
+ * they come from the solutions database. */
+
+#define LEVDB_FNAME "levels.db"
+#define LEVDB_MAGIC "SOKLEVDB1\n"
+#define LEVDB_MAGICLEN 10
+
+struct levdblevel {
+  uint64_t key;
+  int used;                  /* 0 for an empty slot */
+  unsigned short width;      /* 0 if not known yet */
+  unsigned short height;
+  unsigned short boxes;
+  int sets;                  /* number of sets the level belongs to */
+  unsigned long mark;        /* levdb.mark of the last set pass that saw it */
+};
+
+struct levdbset {
+  uint64_t key;              /* CRC64 of name */
+  char *name;
+  int count;
+  uint64_t *levels;          /* count entries */
+};
+
+static struct {
+  int opened;
+  char fname[4096];          /* empty if no save directory is available */
+  struct levdblevel *slot;
+  size_t slotcount;          /* power of 2 */
+  size_t used;
+  struct levdbset *set;
+  int setcount;
+  int setalloc;
+  size_t dead;               /* superseded records in the file */
+  unsigned long mark;        /* bumped by each pass over the levels of a set */
+} levdb;
+
+
+/* returns the slot of key: either its entry or the empty slot where it
+ * belongs */
+static struct levdblevel *levdb_slot(uint64_t key) {
+  size_t i = (size_t)(key ^ (key >> 31)) & (levdb.slotcount - 1);
+  while ((levdb.slot[i].used != 0) && (levdb.slot[i].key != key)) {
+    i = (i + 1) & (levdb.slotcount - 1);
+  }
+  return(&(levdb.slot[i]));
+}
+
+
+/* returns the entry of level key, creating it if needed. returns NULL on out
+ * of memory. */
+static struct levdblevel *levdb_level(uint64_t key) {
+  struct levdblevel *e;
+  /* keep the table at most half full */
+  if ((levdb.used + 1) * 2 > levdb.slotcount) {
+    struct levdblevel *oldslot = levdb.slot;
+    size_t i, oldcount = levdb.slotcount;
+    size_t newcount = (oldcount == 0) ? 4096 : oldcount * 2;
+    struct levdblevel *newslot = calloc(newcount, sizeof(struct levdblevel));
+    if (newslot == NULL) return(NULL);
+    levdb.slot = newslot;
+    levdb.slotcount = newcount;
+    for (i = 0; i < oldcount; i++) {
+      if (oldslot[i].used != 0) *levdb_slot(oldslot[i].key) = oldslot[i];
     }
-    if (solution == NULL) break; /* break out on error */
+    free(oldslot);
+  }
+  e = levdb_slot(key);
+  if (e->used == 0) {
+    e->used = 1;
+    e->key = key;
+    levdb.used += 1;
   }
+  return(e);
+}
 
-  /* close the file descriptor */
-  fclose(fd);
 
-  /* strdup() the solution to make sure we use the least possible amount of memory */
-  solutionfinal = NULL;
-  if (solution != NULL) {
-    solutionfinal = strdup(solution);
-    free(solution);
+/* returns the set named name, or NULL if it is not indexed */
+static struct levdbset *levdb_findset(const char *name) {
+  uint64_t key = crc64(0, (const unsigned char *)name, (unsigned int)strlen(name));
+  int i;
+  for (i = 0; i < levdb.setcount; i++) {
+    if ((levdb.set[i].key == key) && (strcmp(levdb.set[i].name, name) == 0)) return(&(levdb.set[i]));
   }
-  /* return the solution string */
-  return(solutionfinal);
+  return(NULL);
 }
 
-/* saves the solution for levcrc64 */
-void solution_save(uint64_t levcrc64, char *solution, char *ext) {
-  char rootdir[4096], crcstr[32];
-  int curbyte, lastbyte = -1, lastbytecount = 0;
+
+/* makes levels the count levels of set name. returns 1 if the set was
+ * indexed with these very levels already, 0 if it has been updated, or -1
+ * on out of memory. */
+static int levdb_setset(const char *name, int count, const uint64_t *levels) {
+  struct levdbset *s;
+  struct levdblevel *e;
+  uint64_t *copy;
+  int i;
+
+  s = levdb_findset(name);
+  if ((s != NULL) && (s->count == count) && (memcmp(s->levels, levels, (size_t)count * 8) == 0)) return(1);
+
+  copy = malloc((size_t)count * 8 + 1);
+  if (copy == NULL) return(-1);
+  memcpy(copy, levels, (size_t)count * 8);
+
+  if (s == NULL) {
+    if (levdb.setcount == levdb.setalloc) {
+      int newalloc = (levdb.setalloc == 0) ? 16 : levdb.setalloc * 2;
+      struct levdbset *newset = realloc(levdb.set, (size_t)newalloc * sizeof(struct levdbset));
+      if (newset == NULL) {
+        free(copy);
+        return(-1);
+      }
+      levdb.set = newset;
+      levdb.setalloc = newalloc;
+    }
+    s = &(levdb.set[levdb.setcount]);
+    s->name = malloc(strlen(name) + 1);
+    if (s->name == NULL) {
+      free(copy);
+      return(-1);
+    }
+    strcpy(s->name, name);
+    s->key = crc64(0, (const unsigned char *)name, (unsigned int)strlen(name));
+    s->count = 0;
+    s->levels = NULL;
+    levdb.setcount += 1;
+  } else {
+    levdb.dead += 1;
+  }
+
+  /* levels the set used to have are no longer in it. a level that appears
+   * several times in a set counts once, passes mark the levels they saw. */
+  levdb.mark += 1;
+  for (i = 0; i < s->count; i++) {
+    e = levdb_slot(s->levels[i]);
+    if ((e->used == 0) || (e->mark == levdb.mark)) continue;
+    e->mark = levdb.mark;
+    e->sets -= 1;
+  }
+  free(s->levels);
+  s->levels = copy;
+  s->count = count;
+  levdb.mark += 1;
+  for (i = 0; i < count; i++) {
+    e = levdb_level(levels[i]);
+    if ((e == NULL) || (e->mark == levdb.mark)) continue;
+    e->mark = levdb.mark;
+    e->sets += 1;
+  }
+  return(0);
+}
+
+
+/* returns the 'S' record of set s as a malloc()'ed buffer of *len bytes, or
+ * NULL */
+static unsigned char *levdb_setrecord(const struct levdbset *s, size_t *len) {
+  unsigned char *data, *rec;
+  size_t datalen = 4 + (size_t)s->count * 8 + strlen(s->name);
+  int i;
+  data = malloc(datalen + 1);
+  if (data == NULL) return(NULL);
+  put_le(data, (uint64_t)s->count, 4);
+  for (i = 0; i < s->count; i++) put_le(data + 4 + i * 8, s->levels[i], 8);
+  memcpy(data + 4 + (size_t)s->count * 8, s->name, strlen(s->name));
+  rec = db_record('S', s->key, data, datalen, len);
+  free(data);
+  return(rec);
+}
+
+
+/* returns the 'L' record of level e as a malloc()'ed buffer of *len bytes,
+ * or NULL */
+static unsigned char *levdb_levelrecord(const struct levdblevel *e, size_t *len) {
+  unsigned char data[6];
+  put_le(data, e->width, 2);
+  put_le(data + 2, e->height, 2);
+  put_le(data + 4, e->boxes, 2);
+  return(db_record('L', e->key, data, sizeof(data), len));
+}
+
+
+/* writes rec (of len bytes, freed by this function) to fd. returns 0 on
+ * success. */
+static int levdb_writerecord(FILE *fd, unsigned char *rec, size_t len) {
+  int res = 0;
+  if (rec == NULL) return(-1);
+  if (fwrite(rec, 1, len, fd) != len) res = -1;
+  free(rec);
+  return(res);
+}
+
+
+/* rewrites the whole index file with live entries only, atomically */
+static void levdb_rewrite(void) {
+  char tmpfname[4096 + 8];
   FILE *fd;
-  getsavedir(rootdir, sizeof(rootdir));
-  if ((rootdir[0] == 0) || (solution == NULL)) return;
-  sprintf(crcstr, "%016" PRIx64 ".%s", levcrc64, ext);
-  strcat(rootdir, crcstr);
-  fd = fopen(rootdir, "wb");
+  size_t i, len = 0;
+  int x, res = 0;
+  sprintf(tmpfname, "%s.tmp", levdb.fname);
+  fd = fopen(tmpfname, "wb");
   if (fd == NULL) return;
-  for (;;) {
-    curbyte = xsb2byte(*solution);
-    if ((curbyte == lastbyte) && (lastbytecount < 15)) {
-        lastbytecount += 1; /* same pattern -> increment the RLE counter */
+  if (fwrite(LEVDB_MAGIC, 1, LEVDB_MAGICLEN, fd) != LEVDB_MAGICLEN) res = -1;
+  for (x = 0; (x < levdb.setcount) && (res == 0); x++) {
+    res = levdb_writerecord(fd, levdb_setrecord(&(levdb.set[x]), &len), len);
+  }
+  for (i = 0; (i < levdb.slotcount) && (res == 0); i++) {
+    if ((levdb.slot[i].used == 0) || (levdb.slot[i].width == 0)) continue;
+    res = levdb_writerecord(fd, levdb_levelrecord(&(levdb.slot[i]), &len), len);
+  }
+  if (fclose(fd) != 0) res = -1;
+#ifdef _WIN32
+  if (res == 0) remove(levdb.fname); /* rename() does not replace files on Windows */
+#endif
+  if ((res != 0) || (rename(tmpfname, levdb.fname) != 0)) {
+    remove(tmpfname);
+    return;
+  }
+  levdb.dead = 0;
+}
+
+
+/* loads the index file, if not done yet */
+static void levdb_open(void) {
+  char dir[4096];
+  unsigned char *buf;
+  size_t buflen, pos, len;
+  long reclen;
+  int res, torn = 0, lost = 0;
+
+  if (levdb.opened) return;
+  levdb.opened = 1;
+
+  getsavedir(dir, sizeof(dir));
+  if ((dir[0] == 0) || (strlen(dir) + strlen(LEVDB_FNAME) + 1 > sizeof(levdb.fname))) return;
+  sprintf(levdb.fname, "%s%s", dir, LEVDB_FNAME);
+
+  /* a missing index is created by the first append, an unreadable one is
+   * left alone (see db_load()) */
+  res = db_load(levdb.fname, LEVDB_MAGIC, &buf, &buflen);
+  if (res == DBLOAD_FAILED) levdb.fname[0] = 0;
+  if (res != DBLOAD_OK) return;
+
+  for (pos = LEVDB_MAGICLEN; pos < buflen; pos += SOLDB_HDRLEN + len + 8) {
+    const unsigned char *data;
+    reclen = db_checkrecord(buf, buflen, pos);
+    if (reclen < 0) {
+      torn = 1;
+      break;
+    }
+    len = (size_t)reclen;
+    data = buf + pos + SOLDB_HDRLEN;
+
+    if ((buf[pos] == 'S') && (len >= 4)) {
+      size_t count = (size_t)get_le(data, 4);
+      uint64_t *levels;
+      char *name;
+      size_t i;
+      if (count > (len - 4) / 8) {
+        lost = 1;
+        continue;
+      }
+      levels = malloc(count * 8 + 1);
+      name = malloc(len - 4 - count * 8 + 1);
+      if ((levels != NULL) && (name != NULL)) {
+        for (i = 0; i < count; i++) levels[i] = get_le(data + 4 + i * 8, 8);
+        memcpy(name, data + 4 + count * 8, len - 4 - count * 8);
+        name[len - 4 - count * 8] = 0;
+        if (levdb_setset(name, (int)count, levels) < 0) lost = 1;
       } else {
-        int bytebuff;
-        /* dump the lastbyte chunk */
-        if (lastbytecount > 0) {
-          bytebuff = lastbytecount;
-          bytebuff <<= 4;
-          bytebuff |= lastbyte;
-          fputc(bytebuff, fd);
-        }
-        /* save the new RLE counter */
-        lastbyte = curbyte;
-        lastbytecount = 1;
+        lost = 1;
+      }
+      free(levels);
+      free(name);
+    } else if ((buf[pos] == 'L') && (len == 6)) {
+      struct levdblevel *e = levdb_level(get_le(buf + pos + 1, 8));
+      if (e == NULL) {
+        lost = 1;
+        continue;
+      }
+      if (e->width != 0) levdb.dead += 1;
+      e->width = (unsigned short)get_le(data, 2);
+      e->height = (unsigned short)get_le(data + 2, 2);
+      e->boxes = (unsigned short)get_le(data + 4, 2);
+    } else {
+      lost = 1; /* unknown record, kept as it is */
     }
-    if (curbyte == solmove_ERR) break;
-    solution += 1;
   }
-  fclose(fd);
-  return;
+
+  /* drop the torn end, so new records do not follow it. the file is
+   * compacted once it is mostly made of superseded records, unless some of
+   * them could not be loaded */
+  if (torn) {
+    if (db_truncate(levdb.fname, buf, pos) != 0) levdb.fname[0] = 0;
+  } else if ((lost == 0) && (levdb.dead > 64) && (levdb.dead > levdb.used)) {
+    levdb_rewrite();
+  }
+  free(buf);
+}
+
+
+void levindex_addset(const char *name, int levelscount, const uint64_t *levels) {
+  size_t len;
+  unsigned char *rec;
+  levdb_open();
+  if (levdb_setset(name, levelscount, levels) != 0) return;
+  if (levdb.fname[0] == 0) return;
+  rec = levdb_setrecord(levdb_findset(name), &len);
+  if (rec != NULL) writer_queue(WRITEJOB_APPEND, levdb.fname, LEVDB_MAGIC, rec, len);
+}
+
+
+char *levindex_pathname(const char *fname) {
+#ifdef _WIN32
+  return(_fullpath(NULL, fname, 0));
+#else
+  return(realpath(fname, NULL));
+#endif
+}
+
+
+void levindex_addlevel(uint64_t crc64, unsigned short width, unsigned short height, unsigned short boxes) {
+  struct levdblevel *e;
+  size_t len;
+  unsigned char *rec;
+  levdb_open();
+  e = levdb_level(crc64);
+  if (e == NULL) return;
+  if ((e->width == width) && (e->height == height) && (e->boxes == boxes)) return;
+  e->width = width;
+  e->height = height;
+  e->boxes = boxes;
+  if (levdb.fname[0] == 0) return;
+  rec = levdb_levelrecord(e, &len);
+  if (rec != NULL) writer_queue(WRITEJOB_APPEND, levdb.fname, LEVDB_MAGIC, rec, len);
+}
+
+
+int levindex_getlevel(uint64_t crc64, struct levindexinfo *info) {
+  struct levdblevel *e;
+  levdb_open();
+  if (levdb.slotcount == 0) return(-1);
+  e = levdb_slot(crc64);
+  if (e->used == 0) return(-1);
+  info->width = e->width;
+  info->height = e->height;
+  info->boxes = e->boxes;
+  info->sets = e->sets;
+  info->bestmoves = -1;
+  info->bestpushes = -1;
+  soldb_open();
+  if (soldb.slotcount != 0) {
+    struct soldbentry *s = soldb_slot('s', crc64);
+    if (s->kind != 0) {
+      info->bestmoves = (long)ml_count(s->solution);
+      info->bestpushes = (long)ml_pushcount(s->solution);
+    }
+  }
+  return(0);
+}
+
+
+int levindex_setprogress(const char *name, int *solved) {
+  struct levdbset *s;
+  int i;
+  levdb_open();
+  s = levdb_findset(name);
+  if (s == NULL) return(-1);
+  *solved = 0;
+  soldb_open();
+  if (soldb.slotcount == 0) return(s->count);
+  for (i = 0; i < s->count; i++) {
+    if (soldb_slot('s', s->levels[i])->kind != 0) *solved += 1;
+  }
+  return(s->count);
 }
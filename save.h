@@ -28,17 +28,80 @@
 #ifndef save_h_sentinel
 #define save_h_sentinel
 
-/* saves the solution for levcrc64 */
-void solution_save(uint64_t levcrc64, char *solution, char *ext);
+struct sokmovelist; /* see movelist.h */
 
-/* returns a malloc()'ed, null-terminated string with the solution to level levcrc64. if no solution available, returns NULL. */
-char *solution_load(uint64_t levcrc64, char *ext);
+/* makes dir the user directory (where solutions, configuration and caches
+ * are kept) instead of the one SDL provides. must be called before any other
+ * function of this module. */
+void save_setroot(const char *dir);
+
+/* saves the solution for levcrc64. solutions ("sol", and legacy "dat") go to
+ * the solutions database, other kinds (eg. "sav") to a file of their own.
+ * like all writes of this module, the file is written in the background:
+ * the solution can be loaded right away, it only reaches the disk later. */
+void solution_save(uint64_t levcrc64, const struct sokmovelist *solution, char *ext);
+
+/* returns the solution to level levcrc64 (to be freed with ml_free()). if no solution available, returns NULL. */
+struct sokmovelist *solution_load(uint64_t levcrc64, char *ext);
+
+/* returns a number that changes whenever a solution ("sol" or "dat") is
+ * saved, never 0. lets callers know if solutions they loaded are stale. */
+unsigned long solution_generation(void);
 
 /* returns a pointer to a string with the currently configured skin, or NULL if
  * no skin configuration found. the returned pointer MUST NOT be freed. */
 const char *loadconf_skin(void);
 
-/* set skin as the new configured skin */
+/* set skin as the new configured skin. rapid changes are coalesced, only the
+ * last one being written. */
 void setconf_skin(const char *skin);
 
+/* fills *cachedir with the directory path where downloaded level sets are
+ * cached (a subdirectory of the save directory), or with an empty string if
+ * no such directory is available */
+void getcachedir(char *cachedir, size_t maxlen);
+
+/* returns the level cache entry of key as a malloc()'ed buffer of *len bytes,
+ * or NULL if there is none */
+unsigned char *levelcache_load(uint64_t key, size_t *len);
+
+/* stores the level cache entry of key */
+void levelcache_save(uint64_t key, const unsigned char *buf, size_t len);
+
+/* what the level index knows about a level */
+struct levindexinfo {
+  unsigned short width;      /* 0 if the level has not been parsed yet */
+  unsigned short height;
+  unsigned short boxes;
+  int sets;                  /* number of indexed sets the level belongs to */
+  long bestmoves;            /* moves and pushes of the saved solution, */
+  long bestpushes;           /* or -1 if the level is not solved */
+};
+
+/* records that the set called name is made of the levelscount levels whose
+ * CRC64 are levels. a set is identified by its name (eg. its file path), so
+ * indexing it again replaces what was known about it. */
+void levindex_addset(const char *name, int levelscount, const uint64_t *levels);
+
+/* returns the name level file fname is indexed under (its canonical path,
+ * so a file gets the same name however it is reached) as a malloc()'ed
+ * string, or NULL on error */
+char *levindex_pathname(const char *fname);
+
+/* records the dimensions and number of boxes of level crc64 */
+void levindex_addlevel(uint64_t crc64, unsigned short width, unsigned short height, unsigned short boxes);
+
+/* fills *info with what is known about level crc64. returns 0 on success,
+ * or -1 if the level is not indexed. */
+int levindex_getlevel(uint64_t crc64, struct levindexinfo *info);
+
+/* returns the number of levels of the set called name and sets *solved to
+ * the number of them that are solved, or returns -1 if the set is not
+ * indexed */
+int levindex_setprogress(const char *name, int *solved);
+
+/* waits until everything saved so far is written to disk. to be called
+ * before exiting. */
+void save_flush(void);
+
 #endif
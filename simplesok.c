@@ -33,12 +33,18 @@
 #include <inttypes.h>		/* PRIx64 */
 #include "compat-sdl.h"         /* SDL       */
 
+#include "batch.h"
+#include "draw.h"
 #include "gra.h"
+#include "movelist.h"
 #include "sok_core.h"
+#include "sok_solver.h"
 #include "save.h"
 #include "data.h"           /* embedded assets (font, levels...) */
 #include "gz.h"
 #include "net.h"
+#include "netcache.h"
+#include "perf.h"
 #include "skin.h"
 
 #include "dbg.h"
@@ -66,30 +72,26 @@
 
 #define DEFAULT_SKIN "antique3"
 
-#define MAXLEVELS 4096
 #define SCREEN_DEFAULT_WIDTH 800
 #define SCREEN_DEFAULT_HEIGHT 600
 
-#define DISPLAYCENTERED 1
-#define NOREFRESH 2
-
-#define DRAWSCREEN_REFRESH 1
-#define DRAWSCREEN_PLAYBACK 2
-#define DRAWSCREEN_PUSH 4
-#define DRAWSCREEN_NOBG 8
-#define DRAWSCREEN_NOTXT 16
+#define BATCH_NONE 0
+#define BATCH_VERIFY 1
+#define BATCH_SOLVE 2
+#define BATCH_THUMBS 3
 
-#define DRAWSTRING_CENTER -1
-#define DRAWSTRING_RIGHT -2
-#define DRAWSTRING_BOTTOM -3
+/* default solver limits, the in-game solver must answer fast */
+#define SOLVER_GUI_MAXTIME 5
+#define SOLVER_GUI_MAXMEM 256
+#define SOLVER_CLI_MAXTIME 60
+#define SOLVER_CLI_MAXMEM 1024
 
-#define DRAWPLAYFIELDTILE_DRAWATOM 1
-#define DRAWPLAYFIELDTILE_PUSH 2
+#define PERF_TRACEFILE "simplesok-trace.json" /* default --perf trace file */
 
-#define BLIT_LEVELMAP_BACKGROUND 1
+#define SEEK_MOVES 100 /* moves PageUp/PageDown go back/forth in the history */
 
-#define FONT_SPACE_WIDTH 12
-#define FONT_KERNING -3
+#define DISPLAYCENTERED 1
+#define NOREFRESH 2
 
 #define SELECTLEVEL_BACK -1
 #define SELECTLEVEL_QUIT -2
@@ -105,6 +107,7 @@ enum normalizedkeys {
   KEY_CTRL_DOWN,
   KEY_ENTER,
   KEY_BACKSPACE,
+  KEY_SHIFT_BACKSPACE,
   KEY_PAGEUP,
   KEY_PAGEDOWN,
   KEY_HOME,
@@ -126,6 +129,8 @@ enum normalizedkeys {
   KEY_R,
   KEY_CTRL_C,
   KEY_CTRL_V,
+  KEY_0, /* digits 0 to 9 follow each other */
+  KEY_9 = KEY_0 + 9,
   KEY_UNKNOWN
 };
 
@@ -136,13 +141,6 @@ enum leveltype {
 };
 
 
-struct videosettings {
-  unsigned short tilesize;
-  int rotspeed; /* player's rotation speed (1..100) */
-  int movspeed; /* player's moving [horizontal/vertical] speed (1..100) */
-  const char *customskinfile;
-};
-
 /* returns the absolute value of the 'i' integer. */
 static int absval(int i) {
   if (i < 0) return(-i);
@@ -187,6 +185,7 @@ static char *unRLE(const char *xsb) {
 
 /* normalize SDL keys to values easier to handle */
 static int normalizekeys(SDL_Keycode key) {
+  if ((key >= SDLK_0) && (key <= SDLK_9)) return(KEY_0 + (int)(key - SDLK_0));
   switch (key) {
     case SDLK_UP:
     case SDLK_KP_8:
@@ -207,6 +206,7 @@ static int normalizekeys(SDL_Keycode key) {
       if (SDL_GetModState() & CSDL_KMOD_ALT) return(KEY_FULLSCREEN);
       return(KEY_ENTER);
     case SDLK_BACKSPACE:
+      if (SDL_GetModState() & CSDL_KMOD_SHIFT) return(KEY_SHIFT_BACKSPACE);
       return(KEY_BACKSPACE);
     case SDLK_PAGEUP:
     case SDLK_KP_9:
@@ -320,14 +320,38 @@ static int isLegalSokoSolution(const char *solstr) {
 }
 
 
-/* a crude timer that "ticks" roughly every 30ms, providing simplesok with information that it is a good time to update the screen (which translates to a refresh rate of about 33 Hz) */
-static int sok_isitrefreshtime(void) {
-  static Uint32 nextrefresh;
-  Uint32 curtime = SDL_GetTicks();
-  if (curtime < nextrefresh) return(0);
-  /* schedule next refresh time and return a tick */
-  nextrefresh = curtime + 30; /* miliseconds */
-  return(1);
+/* frame pacing: frames are presented in sync with the display's refresh
+ * (vsync) and animations are computed from the time elapsed since they
+ * started, so they run at the same pace whatever the refresh rate is. speed
+ * settings are expressed in units per FRAME_REFMS, the fixed refresh period
+ * simplesok used to animate at. */
+#define FRAME_REFMS 30
+#define FRAME_MINMS 6     /* shortest frame period, should vsync be unavailable */
+#define FADE_MS 240       /* duration of a fade to texture */
+#define CONGRATS_FADEMS 250 /* duration of the fade in of a congrats message */
+#define AUTOPLAY_MS 400   /* pace of solution playback moves */
+
+struct frameclock {
+  Uint32 start;     /* when the animation started */
+  Uint32 lastframe; /* when the last frame has been presented */
+};
+
+static void frame_start(struct frameclock *clk) {
+  clk->start = SDL_GetTicks();
+  clk->lastframe = clk->start;
+}
+
+/* paces an animation: to be called once a frame has been presented. sleeps
+ * if the present did not wait for vsync and the frame came too soon, then
+ * returns the time (in ms) elapsed since the animation started */
+static unsigned long frame_wait(struct frameclock *clk) {
+  Uint32 now = SDL_GetTicks();
+  if (now - clk->lastframe < FRAME_MINMS) {
+    SDL_Delay(FRAME_MINMS - (now - clk->lastframe));
+    now = SDL_GetTicks();
+  }
+  clk->lastframe = now;
+  return(now - clk->start);
 }
 
 
@@ -350,46 +374,27 @@ static void switchfullscreen(SDL_Window *window) {
 }
 
 
-static int getoffseth(const struct sokgame *game, int winw, unsigned short tilesize) {
-  /* if playfield is smaller than the screen */
-  if (game->field_width * tilesize <= winw) return((winw / 2) - (game->field_width * tilesize / 2));
-  /* if playfield is larger than the screen */
-  if (game->positionx * tilesize + (tilesize / 2) > (winw / 2)) {
-    int res = (winw / 2) - (game->positionx * tilesize + (tilesize / 2));
-    if ((game->field_width * tilesize) + res < winw) res = winw - (game->field_width * tilesize);
-    return(res);
-  }
-  return(0);
-}
-
-static int getoffsetv(const struct sokgame *game, int winh, int tilesize) {
-  /* if playfield is smaller than the screen */
-  if (game->field_height * tilesize <= winh) return((winh / 2) - (game->field_height * tilesize / 2));
-  /* if playfield is larger than the screen */
-  if (game->positiony * tilesize + (tilesize / 2) > winh / 2) {
-    int res = (winh / 2) - (game->positiony * tilesize + (tilesize / 2));
-    if ((game->field_height * tilesize) + res < winh) res = winh - (game->field_height * tilesize);
-    return(res);
-  }
-  return(0);
-}
-
 /* wait for a key up to timeout seconds (-1 = indefinitely), while redrawing the renderer screen, if not null */
 static int wait_for_a_key(int timeout, SDL_Renderer *renderer) {
   SDL_Event event;
   Uint32 timeouttime = SDL_GetTicks();
   if (timeout > 0) timeouttime += (Uint32)timeout * 1000;
   for (;;) {
-    SDL_Delay(50);
-    if (SDL_PollEvent(&event) != 0) {
-      if (renderer != NULL) SDL_RenderPresent(renderer);
-      if (event.type == CSDL_EVENT_QUIT) {
-        return(1);
-      } else if (event.type == CSDL_EVENT_KEY_DOWN) {
-        return(0);
-      }
+    int gotevent;
+    if (timeout > 0) {
+      Sint32 left = (Sint32)(timeouttime - (Uint32)SDL_GetTicks());
+      if (left <= 0) return(0);
+      gotevent = SDL_WaitEventTimeout(&event, left);
+    } else {
+      gotevent = SDL_WaitEvent(&event);
+    }
+    if (gotevent == 0) continue;
+    if (renderer != NULL) SDL_RenderPresent(renderer);
+    if (event.type == CSDL_EVENT_QUIT) {
+      return(1);
+    } else if (event.type == CSDL_EVENT_KEY_DOWN) {
+      return(0);
     }
-    if ((timeout > 0) && (SDL_GetTicks() >= timeouttime)) return(0);
   }
 }
 
@@ -408,401 +413,13 @@ static int displaytexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Wind
   }
   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
   SDL_SetTextureAlphaMod(texture, alpha);
+  perf_count(perf_drawcall);
   if (CSDL_RenderTexture(renderer, texture, NULL, rectptr) != 0) printf("CSDL_RenderTexture() failed: %s\n", SDL_GetError());
   if ((flags & NOREFRESH) == 0) SDL_RenderPresent(renderer);
   if (timeout != 0) return(wait_for_a_key(timeout, renderer));
   return(0);
 }
 
-/* provides width and height of a string (in pixels) */
-static void get_string_size(const char *string, int fontsize, const struct spritesstruct *sprites, int *w, int *h) {
-  int glyphw, glyphh;
-  *w = 0;
-  *h = 0;
-  while (*string != 0) {
-    if (*string == ' ') {
-      *w += FONT_SPACE_WIDTH * fontsize / 100;
-    } else {
-      CSDL_QueryTexture(sprites->font[(unsigned char)(*string)], NULL, NULL, &glyphw, &glyphh);
-      *w += glyphw * fontsize / 100 + FONT_KERNING * fontsize / 100;
-      if (glyphh * fontsize / 100 > *h) *h = glyphh * fontsize / 100;
-    }
-    string += 1;
-  }
-}
-
-/* explode a string into wordwrapped substrings */
-static void wordwrap(const char *string, char **multiline, int maxlines, int maxwidth, int fontsize, const struct spritesstruct *sprites) {
-  int lastspace, multilineid;
-  int x, stringw, stringh;
-  char *tmpstring;
-  /* set all multiline entries to NULL */
-  for (x = 0; x < maxlines; x++) multiline[x] = NULL;
-
-  /* find the next word boundary */
-  lastspace = -1;
-  multilineid = 0;
-  for (;;) { /* loop on every word, and check if we reached the end */
-    for (x = lastspace + 1; ; x++) {
-      if ((string[x] == ' ') || (string[x] == '\t') || (string[x] == '\n') || (string[x] == 0)) {
-        lastspace = x;
-        break;
-      }
-    }
-    /* is this word boundary fitting on screen? */
-    tmpstring = strdup(string);
-    tmpstring[lastspace] = 0;
-    get_string_size(tmpstring, fontsize, sprites, &stringw, &stringh);
-    if (stringw < maxwidth) {
-      if (multiline[multilineid] != NULL) free(multiline[multilineid]);
-      multiline[multilineid] = tmpstring;
-    } else {
-      free(tmpstring);
-      if (multiline[multilineid] == NULL) break;
-      lastspace = -1;
-      string += strlen(multiline[multilineid]) + 1;
-      multilineid += 1;
-      if (multilineid >= maxlines) {
-        size_t lastlinelen = strlen(multiline[multilineid - 1]);
-        /* if text have been truncated, print '...' at the end of the last line */
-        if (lastlinelen >= 3) {
-          multiline[multilineid - 1][lastlinelen - 3] = '.';
-          multiline[multilineid - 1][lastlinelen - 2] = '.';
-          multiline[multilineid - 1][lastlinelen - 1] = '.';
-        }
-        break;
-      }
-    }
-    if ((lastspace >= 0) && (string[lastspace] == 0)) break;
-  }
-}
-
-/* blits a string onscreen, scaling the font at fontsize percents. The string is placed at starting position x/y */
-static void draw_string(const char *orgstring, int fontsize, unsigned char alpha, struct spritesstruct *sprites, SDL_Renderer *renderer, int x, int y, SDL_Window *window, int maxlines, int pheight) {
-  int i, winw, winh;
-  char *string;
-  SDL_Texture *glyph;
-  SDL_Rect rectsrc, rectdst;
-  char *multiline[16];
-  int multilineid = 0;
-  if (maxlines > 16) maxlines = 16;
-  /* get size of the window */
-  SDL_GetWindowSize(window, &winw, &winh);
-  wordwrap(orgstring, multiline, maxlines, winw - x, fontsize, sprites);
-  /* loop on every line */
-  for (multilineid = 0; (multilineid < maxlines) && (multiline[multilineid] != NULL); multilineid += 1) {
-    string = multiline[multilineid];
-    if (multilineid > 0) y += pheight;
-    /* if centering is requested, get size of the string */
-    if ((x < 0) || (y < 0)) {
-      int stringw, stringh;
-      /* get pixel length of the string */
-      get_string_size(string, fontsize, sprites, &stringw, &stringh);
-      if (x == DRAWSTRING_CENTER) x = (winw - stringw) >> 1;
-      if (x == DRAWSTRING_RIGHT) x = winw - stringw - 10;
-      if (y == DRAWSTRING_BOTTOM) y = winh - stringh;
-      if (y == DRAWSTRING_CENTER) y = (winh - stringh) / 2;
-    }
-    rectdst.x = x;
-    rectdst.y = y;
-    for (i = 0; string[i] != 0; i++) {
-      if (string[i] == ' ') {
-        rectdst.x += FONT_SPACE_WIDTH * fontsize / 100;
-        continue;
-      }
-      glyph = sprites->font[(unsigned char)(string[i])];
-      CSDL_QueryTexture(glyph, NULL, NULL, &rectsrc.w, &rectsrc.h);
-      rectdst.w = rectsrc.w * fontsize / 100;
-      rectdst.h = rectsrc.h * fontsize / 100;
-      SDL_SetTextureAlphaMod(glyph, alpha);
-      CSDL_RenderTexture(renderer, glyph, NULL, &rectdst);
-      rectdst.x += (rectsrc.w * fontsize / 100) + (FONT_KERNING * fontsize / 100);
-    }
-    /* free the multiline memory */
-    free(string);
-  }
-}
-
-
-/* get wall neighbors, returns an 8-bit value where each bit indicates the
- * presence of a neigbor:
- *
- * 128 064 032
- * 016     008
- * 004 002 001
- *
- * Example: if bits 0, 1 and 2 are set (ie. value 7) then walls are present on
- * both bottom corners and bottom center. */
-static unsigned short getwallneighb(const struct sokgame *game, int x, int y) {
-  unsigned short res = 0;
-  if (y > 0) { /* check top row */
-    if ((x > 0) && (game->field[x - 1][y - 1] & field_wall)) res |= 128;
-    if (game->field[x][y - 1] & field_wall) res |= 64;
-    if ((x < 63) && (game->field[x + 1][y - 1] & field_wall)) res |= 32;
-  }
-
-  /* middle row */
-  if ((x > 0) && (game->field[x - 1][y] & field_wall)) res |= 16;
-  if ((x < 63) && (game->field[x + 1][y] & field_wall)) res |= 8;
-
-  /* bottom row */
-  if (y < 63) {
-    if ((x > 0) && (game->field[x - 1][y + 1] & field_wall)) res |= 4;
-    if (game->field[x][y + 1] & field_wall) res |= 2;
-    if ((x < 63) && (game->field[x + 1][y + 1] & field_wall)) res |= 1;
-  }
-
-  return(res);
-}
-
-
-static void draw_wall(SDL_Renderer *renderer, const struct spritesstruct *sprites, const struct sokgame *game, int x, int y, unsigned short tilesize, int xoffset, int yoffset) {
-  unsigned short wallid, neighbors;
-
-  /* draw the wall elements (4 quarters) */
-  neighbors = getwallneighb(game, x, y);
-
-  /* top-left quarter */
-  switch (neighbors & 0xD0) { /* 11010000 */
-    case 0xC0: /* 11000000 */
-    case 0x40: /* 01000000 */
-      wallid = SPRITE_WALL_VERTIC;
-      break;
-    case 0x90: /* 10010000 */
-    case 0x10: /* 00010000 */
-      wallid = SPRITE_WALL_HORIZ;
-      break;
-    case 0x50: /* 01010000 (inner corner) */
-      wallid = SPRITE_WALL_CORNER;
-      break;
-    case 0xD0: /* 11010000 (full block) */
-      wallid = SPRITE_WALL_PLAIN;
-      break;
-    default:
-      wallid = SPRITE_WALL_ISLAND;
-      break;
-  }
-  gra_rendertilequarter(renderer, sprites, wallid, xoffset, yoffset, tilesize / 2, 0);
-
-  /* top-right quarter */
-  switch (neighbors & 0x68) { /* 011 01 000 */
-    case 0x60: /* 011 00 000 */
-    case 0x40: /* 010 00 000 */
-      wallid = SPRITE_WALL_VERTIC;
-      break;
-    case 0x28: /* 001 01 000 */
-    case 0x08: /* 000 01 000 */
-      wallid = SPRITE_WALL_HORIZ;
-      break;
-    case 0x48: /* 010 01 000 (inner corner) */
-      wallid = SPRITE_WALL_CORNER;
-      break;
-    case 0x68: /* 011 01 000 (full block) */
-      wallid = SPRITE_WALL_PLAIN;
-      break;
-    default:
-      wallid = SPRITE_WALL_ISLAND;
-      break;
-  }
-  gra_rendertilequarter(renderer, sprites, wallid, xoffset + (tilesize / 2), yoffset, tilesize / 2, 1);
-
-  /* bottom-left quarter */
-  switch (neighbors & 0x16) { /* 000 10 110 */
-    case 0x06: /* 000 00 110 */
-    case 0x02: /* 000 00 010 */
-      wallid = SPRITE_WALL_VERTIC;
-      break;
-    case 0x14: /* 000 10 100 */
-    case 0x10: /* 000 10 000 */
-      wallid = SPRITE_WALL_HORIZ;
-      break;
-    case 0x12: /* 000 10 010 (inner corner) */
-      wallid = SPRITE_WALL_CORNER;
-      break;
-    case 0x16: /* 000 10 110 (full block) */
-      wallid = SPRITE_WALL_PLAIN;
-      break;
-    default:
-      wallid = SPRITE_WALL_ISLAND;
-      break;
-  }
-  gra_rendertilequarter(renderer, sprites, wallid, xoffset, yoffset + (tilesize / 2), tilesize / 2, 2);
-
-  /* bottom-right quarter */
-  switch (neighbors & 0x0B) { /* 000 01 011 */
-    case 0x03: /* 000 00 011 */
-    case 0x02: /* 000 00 010 */
-      wallid = SPRITE_WALL_VERTIC;
-      break;
-    case 0x09: /* 000 01 001 */
-    case 0x08: /* 000 01 000 */
-      wallid = SPRITE_WALL_HORIZ;
-      break;
-    case 0x0A: /* 000 01 010 (inner corner) */
-      wallid = SPRITE_WALL_CORNER;
-      break;
-    case 0x0B: /* 000 01 011 (full block) */
-      wallid = SPRITE_WALL_PLAIN;
-      break;
-    default:
-      wallid = SPRITE_WALL_ISLAND;
-      break;
-  }
-  gra_rendertilequarter(renderer, sprites, wallid, xoffset + (tilesize / 2), yoffset + (tilesize / 2), tilesize / 2, 3);
-
-}
-
-
-static void draw_playfield_tile(const struct sokgame *game, int x, int y, struct spritesstruct *sprites, SDL_Renderer *renderer, int winw, int winh, const struct videosettings *settings, int flags, int moveoffsetx, int moveoffsety) {
-  int xpix, ypix;
-  /* compute the pixel coordinates of the destination field */
-  xpix = getoffseth(game, winw, settings->tilesize) + (x * settings->tilesize) + moveoffsetx;
-  ypix = getoffsetv(game, winh, settings->tilesize) + (y * settings->tilesize) + moveoffsety;
-
-  if ((flags & DRAWPLAYFIELDTILE_DRAWATOM) == 0) {
-    if (game->field[x][y] & field_floor) gra_rendertile(renderer, sprites, SPRITE_FLOOR, xpix, ypix, settings->tilesize, 0);
-    if (game->field[x][y] & field_goal) gra_rendertile(renderer, sprites, SPRITE_GOAL, xpix, ypix, settings->tilesize, 0);
-    if (game->field[x][y] & field_wall) draw_wall(renderer, sprites, game, x, y, settings->tilesize, xpix, ypix);
-  } else if (game->field[x][y] & field_atom) {
-    unsigned short boxsprite = SPRITE_BOX;
-    if (game->field[x][y] & field_goal) {
-      boxsprite = SPRITE_BOXOK;
-      if (flags & DRAWPLAYFIELDTILE_PUSH) {
-        if ((game->positionx == x - 1) && (game->positiony == y) && (moveoffsetx > 0) && ((game->field[x + 1][y] & field_goal) == 0)) boxsprite = SPRITE_BOX;
-        if ((game->positionx == x + 1) && (game->positiony == y) && (moveoffsetx < 0) && ((game->field[x - 1][y] & field_goal) == 0)) boxsprite = SPRITE_BOX;
-        if ((game->positionx == x) && (game->positiony == y - 1) && (moveoffsety > 0) && ((game->field[x][y + 1] & field_goal) == 0)) boxsprite = SPRITE_BOX;
-        if ((game->positionx == x) && (game->positiony == y + 1) && (moveoffsety < 0) && ((game->field[x][y - 1] & field_goal) == 0)) boxsprite = SPRITE_BOX;
-      }
-    }
-    gra_rendertile(renderer, sprites, boxsprite, xpix, ypix, settings->tilesize, 0);
-  }
-}
-
-static void draw_player(const struct sokgame *game, const struct sokgamestates *states, struct spritesstruct *sprites, SDL_Renderer *renderer, int winw, int winh, const struct videosettings *settings, int offsetx, int offsety) {
-  SDL_Rect rect;
-  unsigned short playersprite = SPRITE_PLAYERUP;
-  int angle = states->angle;
-
-  /* compute the dst rect */
-  rect.x = getoffseth(game, winw, settings->tilesize) + (game->positionx * settings->tilesize) + offsetx;
-  rect.y = getoffsetv(game, winh, settings->tilesize) + (game->positiony * settings->tilesize) + offsety;
-  rect.w = settings->tilesize;
-  rect.h = settings->tilesize;
-
-  if ((sprites->flags & SPRITES_FLAG_PLAYERROTATE) == 0) {
-    switch (states->angle) {
-      case 0:
-        playersprite = SPRITE_PLAYERUP;
-        break;
-      case 90:
-        playersprite = SPRITE_PLAYERRIGHT;
-        break;
-      case 180:
-        playersprite = SPRITE_PLAYERDOWN;
-        break;
-      case 270:
-        playersprite = SPRITE_PLAYERLEFT;
-        break;
-    }
-    angle = 0;
-  }
-
-  /* if player happens to be on a goal, then use the special "player on goal" version of the sprite */
-  if (game->field[game->positionx][game->positiony] & field_goal) playersprite += 4;
-
-  gra_rendertile(renderer, sprites, playersprite, rect.x, rect.y, settings->tilesize, angle);
-}
-
-
-static void draw_screen(const struct sokgame *game, const struct sokgamestates *states, struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, const struct videosettings *settings, int moveoffsetx, int moveoffsety, int scrolling, int flags, const char *levelname) {
-  int x, y, winw, winh, offx, offy;
-  /* int partialoffsetx = 0, partialoffsety = 0; */
-  char stringbuff[256];
-  int scrollingadjx = 0, scrollingadjy = 0; /* this is used when scrolling + movement of player is needed */
-  int drawtile_flags = 0;
-
-  SDL_GetWindowSize(window, &winw, &winh);
-  SDL_RenderClear(renderer);
-
-  if ((flags & DRAWSCREEN_NOBG) == 0) {
-    gra_renderbg(renderer, sprites, SPRITE_BG, winw, winh);
-  }
-
-  if (flags & DRAWSCREEN_PUSH) drawtile_flags = DRAWPLAYFIELDTILE_PUSH;
-
-  if (scrolling > 0) {
-    if (moveoffsetx > scrolling) {
-      scrollingadjx = moveoffsetx - scrolling;
-      moveoffsetx = scrolling;
-    }
-    if (moveoffsetx < -scrolling) {
-      scrollingadjx = moveoffsetx + scrolling;
-      moveoffsetx = -scrolling;
-    }
-    if (moveoffsety > scrolling) {
-      scrollingadjy = moveoffsety - scrolling;
-      moveoffsety = scrolling;
-    }
-    if (moveoffsety < -scrolling) {
-      scrollingadjy = moveoffsety + scrolling;
-      moveoffsety = -scrolling;
-    }
-  }
-  /* draw non-moveable tiles (floors, walls, goals) */
-  for (y = 0; y < game->field_height; y++) {
-    for (x = 0; x < game->field_width; x++) {
-      if (scrolling != 0) {
-        draw_playfield_tile(game, x, y, sprites, renderer, winw, winh, settings, drawtile_flags, -moveoffsetx, -moveoffsety);
-      } else {
-        draw_playfield_tile(game, x, y, sprites, renderer, winw, winh, settings, drawtile_flags, 0, 0);
-      }
-    }
-  }
-  /* draw moveable elements (atoms) */
-  for (y = 0; y < game->field_height; y++) {
-    for (x = 0; x < game->field_width; x++) {
-      offx = 0;
-      offy = 0;
-      if (scrolling == 0) {
-        if ((moveoffsetx > 0) && (x == game->positionx + 1) && (y == game->positiony)) offx = moveoffsetx;
-        if ((moveoffsetx < 0) && (x == game->positionx - 1) && (y == game->positiony)) offx = moveoffsetx;
-        if ((moveoffsety > 0) && (y == game->positiony + 1) && (x == game->positionx)) offy = moveoffsety;
-        if ((moveoffsety < 0) && (y == game->positiony - 1) && (x == game->positionx)) offy = moveoffsety;
-      } else {
-        offx = -moveoffsetx;
-        offy = -moveoffsety;
-        if ((moveoffsetx > 0) && (x == game->positionx + 1) && (y == game->positiony)) offx = scrollingadjx;
-        if ((moveoffsetx < 0) && (x == game->positionx - 1) && (y == game->positiony)) offx = scrollingadjx;
-        if ((moveoffsety > 0) && (y == game->positiony + 1) && (x == game->positionx)) offy = scrollingadjy;
-        if ((moveoffsety < 0) && (y == game->positiony - 1) && (x == game->positionx)) offy = scrollingadjy;
-      }
-      draw_playfield_tile(game, x, y, sprites, renderer, winw, winh, settings, DRAWPLAYFIELDTILE_DRAWATOM, offx, offy);
-    }
-  }
-  /* draw where the player is */
-  if (scrolling != 0) {
-    draw_player(game, states, sprites, renderer, winw, winh, settings, scrollingadjx, scrollingadjy);
-  } else {
-    draw_player(game, states, sprites, renderer, winw, winh, settings, moveoffsetx, moveoffsety);
-  }
-  /* draw text */
-  if ((flags & DRAWSCREEN_NOTXT) == 0) {
-    sprintf(stringbuff, "%s, level %d", levelname, game->level);
-    draw_string(stringbuff, 100, 255, sprites, renderer, 10, DRAWSTRING_BOTTOM, window, 1, 0);
-    if (game->solution != NULL) {
-      sprintf(stringbuff, "best score: %lu/%lu", (unsigned long)sok_history_getlen(game->solution), (unsigned long)sok_history_getpushes(game->solution));
-    } else {
-      sprintf(stringbuff, "best score: -");
-    }
-    draw_string(stringbuff, 100, 255, sprites, renderer, DRAWSTRING_RIGHT, 0, window, 1, 0);
-    sprintf(stringbuff, "moves: %lu / pushes: %lu", (unsigned long)sok_history_getlen(states->history), (unsigned long)sok_history_getpushes(states->history));
-    draw_string(stringbuff, 100, 255, sprites, renderer, 10, 0, window, 1, 0);
-  }
-  if ((flags & DRAWSCREEN_PLAYBACK) && (time(NULL) % 2 == 0)) draw_string("*** PLAYBACK ***", 100, 255, sprites, renderer, DRAWSTRING_CENTER, 32, window, 1, 0);
-  /* Update the screen */
-  if (flags & DRAWSCREEN_REFRESH) SDL_RenderPresent(renderer);
-}
-
 
 static int rotatePlayer(struct spritesstruct *sprites, const struct sokgame *game, struct sokgamestates *states, enum SOKMOVE dir, SDL_Renderer *renderer, SDL_Window *window, const struct videosettings *settings, const char *levelname, int drawscreenflags) {
   /* shortest-path vectors to get from one angle to another */
@@ -810,8 +427,9 @@ static int rotatePlayer(struct spritesstruct *sprites, const struct sokgame *gam
                          {-1,  0,  1,  0}, /* angle 90->0, 90->90, 90->180, etc */
                          { 0, -1,  0,  1},
                          { 1,  0, -1,  0}};
-  int dstangle;
-  int dirmotion;
+  int dstangle, srcangle;
+  int dirmotion, distance;
+  struct frameclock clk;
 
   switch (dir) {
     default:    /* sokmoveNONE, sokmoveUP */
@@ -839,24 +457,25 @@ static int rotatePlayer(struct spritesstruct *sprites, const struct sokgame *gam
   dirmotion = arr[states->angle / 90][dstangle / 90];
   if (dirmotion == 0) dirmotion = (time(NULL) & 1) * 2 - 1; /* add some pseudo random behavior for extra fun */
 
-  /* perform the animated rotation */
-  for (;;) {
-    SDL_Delay(1);
-    if (sok_isitrefreshtime()) {
-      int i;
-
-      /* make sure not to rotate past the destination angle */
-      for (i = 0; i < settings->rotspeed; i++) {
-        states->angle += dirmotion;
-        if (states->angle >= 360) states->angle = 0;
-        if (states->angle < 0) states->angle = 359;
-        if (states->angle == dstangle) break;
-      }
+  /* how many degrees to rotate by */
+  srcangle = states->angle;
+  distance = (dirmotion > 0) ? (dstangle - srcangle + 360) % 360 : (srcangle - dstangle + 360) % 360;
 
-      draw_screen(game, states, sprites, renderer, window, settings, 0, 0, 0, DRAWSCREEN_REFRESH | drawscreenflags, levelname);
+  /* perform the animated rotation, by rotspeed degrees per FRAME_REFMS */
+  frame_start(&clk);
+  for (;;) {
+    int progress = (int)(frame_wait(&clk) * (unsigned long)settings->rotspeed / FRAME_REFMS);
 
-      if (dstangle == states->angle) break;
+    /* make sure not to rotate past the destination angle */
+    if (progress >= distance) {
+      states->angle = dstangle;
+    } else {
+      states->angle = (srcangle + dirmotion * progress + 360) % 360;
     }
+
+    draw_screen(game, states, sprites, renderer, window, settings, 0, 0, 0, DRAWSCREEN_REFRESH | drawscreenflags, levelname);
+
+    if (dstangle == states->angle) break;
   }
 
   return(1);
@@ -866,21 +485,27 @@ static int rotatePlayer(struct spritesstruct *sprites, const struct sokgame *gam
 static int scrollneeded(struct sokgame *game, SDL_Window *window, unsigned short tilesize, int offx, int offy) {
   int winw, winh, offsetx, offsety, result = 0;
   SDL_GetWindowSize(window, &winw, &winh);
-  offsetx = absval(getoffseth(game, winw, tilesize));
-  offsety = absval(getoffsetv(game, winh, tilesize));
+  offsetx = absval(draw_offseth(game, winw, tilesize));
+  offsety = absval(draw_offsetv(game, winh, tilesize));
   game->positionx += offx;
   game->positiony += offy;
-  result = offsetx - absval(getoffseth(game, winw, tilesize));
-  if (result == 0) result = offsety - absval(getoffsetv(game, winh, tilesize));
+  result = offsetx - absval(draw_offseth(game, winw, tilesize));
+  if (result == 0) result = offsety - absval(draw_offsetv(game, winh, tilesize));
   if (result < 0) result = -result; /* convert to abs() value */
   game->positionx -= offx;
   game->positiony -= offy;
   return(result);
 }
 
-static void loadlevel(struct sokgame *togame, struct sokgame *fromgame, struct sokgamestates *states) {
-  memcpy(togame, fromgame, sizeof(struct sokgame));
+/* replaces *togame by a fresh copy of fromgame to play on. returns 0 on
+ * success, or -1 (*togame being left untouched) on out of memory. */
+static int loadlevel(struct sokgame **togame, const struct sokgame *fromgame, struct sokgamestates *states) {
+  struct sokgame *game = sok_copygame(fromgame);
+  if (game == NULL) return(-1);
+  free(*togame);
+  *togame = game;
   sok_resetstates(states);
+  return(0);
 }
 
 static char *processDropFileEvent(SDL_Event *event, char **levelfile) {
@@ -913,18 +538,14 @@ static int menu(SDL_Renderer *renderer, struct spritesstruct *sprites, SDL_Windo
   higheststringh = 0;
   for (poscount = 0; positions[poscount] != NULL; poscount++) {
     int stringw, stringh;
-    get_string_size(positions[poscount], fontsize, sprites, &stringw, &stringh);
+    draw_stringsize(positions[poscount], fontsize, sprites, &stringw, &stringh);
     if (stringw > longeststringw) longeststringw = stringw;
     if (stringh > higheststringh) higheststringh = stringh;
   }
 
   for (;;) {
     int winw, winh, x;
-    int step;
-
-    /* by how many pixels the cursor should be moved at each screen refresh */
-    step = (settings->movspeed * settings->tilesize) / 100;
-    if (step == 0) step = 1;
+    struct frameclock clk;
 
     /* get window's width and height */
     SDL_GetWindowSize(window, &winw, &winh);
@@ -961,56 +582,56 @@ static int menu(SDL_Renderer *renderer, struct spritesstruct *sprites, SDL_Windo
     rect.y = oldpusherposy;
     if ((settings->movspeed == 100) || (sprites->flags & SPRITES_FLAG_PRIMITIVE)) rect.y = newpusherposy; /* movspeed=100 means 'instant move' */
 
+    frame_start(&clk);
     for (;;) {
-      if (sok_isitrefreshtime()) {
-        SDL_RenderClear(renderer);
-        gra_renderbg(renderer, sprites, SPRITE_BG, winw, winh);
-        { /* render title and version strings */
-          int sokow, sokoh, simpw, simph, verw, verh;
-          int tity;
-          const char *simpstr = "simple";
-          const char *sokostr = "SOKOBAN";
-          const char *verstr = "ver " PACKAGE_VERSION;
-
-          get_string_size(simpstr, 100, sprites, &simpw, &simph);
-          get_string_size(sokostr, 300, sprites, &sokow, &sokoh);
-          get_string_size(verstr, 100, sprites, &verw, &verh);
-
-          tity = (selectionpos[0] - (sokoh * 8 / 10)) / 2 - (simph * 8 / 10);
-
-          draw_string(simpstr, 100, 200, sprites, renderer, 10 + (winw - sokow) / 2, tity, window, 1, 0);
-          tity += simph * 8 / 10;
-          draw_string(sokostr, 300, 255, sprites, renderer, (winw - sokow) / 2, tity, window, 1, 0);
-          tity += sokoh * 8 / 10;
-          draw_string(verstr, 100, 180, sprites, renderer, (sokow + (winw - sokow) / 2) - verw, tity, window, 1, 0);
+      SDL_RenderClear(renderer);
+      gra_renderbg(renderer, sprites, SPRITE_BG, winw, winh);
+      { /* render title and version strings */
+        int sokow, sokoh, simpw, simph, verw, verh;
+        int tity;
+        const char *simpstr = "simple";
+        const char *sokostr = "SOKOBAN";
+        const char *verstr = "ver " PACKAGE_VERSION;
+
+        draw_stringsize(simpstr, 100, sprites, &simpw, &simph);
+        draw_stringsize(sokostr, 300, sprites, &sokow, &sokoh);
+        draw_stringsize(verstr, 100, sprites, &verw, &verh);
+
+        tity = (selectionpos[0] - (sokoh * 8 / 10)) / 2 - (simph * 8 / 10);
+
+        draw_string(simpstr, 100, 200, sprites, renderer, 10 + (winw - sokow) / 2, tity, window, 1, 0);
+        tity += simph * 8 / 10;
+        draw_string(sokostr, 300, 255, sprites, renderer, (winw - sokow) / 2, tity, window, 1, 0);
+        tity += sokoh * 8 / 10;
+        draw_string(verstr, 100, 180, sprites, renderer, (sokow + (winw - sokow) / 2) - verw, tity, window, 1, 0);
 
-        }
+      }
 
-        {
-          int player_cursor = SPRITE_PLAYERRIGHT, angle = 0;
-          if (sprites->flags & SPRITES_FLAG_PLAYERROTATE) {
-            player_cursor = SPRITE_PLAYERUP;
-            angle = 90;
-          }
-          gra_rendertile(renderer, sprites, player_cursor, rect.x, rect.y, settings->tilesize, angle);
+      {
+        int player_cursor = SPRITE_PLAYERRIGHT, angle = 0;
+        if (sprites->flags & SPRITES_FLAG_PLAYERROTATE) {
+          player_cursor = SPRITE_PLAYERUP;
+          angle = 90;
         }
+        gra_rendertile(renderer, sprites, player_cursor, rect.x, rect.y, settings->tilesize, angle);
+      }
 
-        for (x = posoffset; x < poscount; x++) {
-          draw_string(positions[x], fontsize, 255, sprites, renderer, rect.x + 54, textvadj + selectionpos[x], window, 1, 0);
-        }
-        SDL_RenderPresent(renderer);
-        if (rect.y == newpusherposy) break;
+      for (x = posoffset; x < poscount; x++) {
+        draw_string(positions[x], fontsize, 255, sprites, renderer, rect.x + 54, textvadj + selectionpos[x], window, 1, 0);
+      }
+      SDL_RenderPresent(renderer);
+      if (rect.y == newpusherposy) break;
 
+      { /* the cursor moves by movspeed% of a tile per FRAME_REFMS */
+        int dist = (int)(frame_wait(&clk) * settings->tilesize * (unsigned long)settings->movspeed / (100 * FRAME_REFMS));
         if (newpusherposy < oldpusherposy) {
-          rect.y -= step;
+          rect.y = oldpusherposy - dist;
           if (rect.y < newpusherposy) rect.y = newpusherposy;
         } else {
-          rect.y += step;
+          rect.y = oldpusherposy + dist;
           if (rect.y > newpusherposy) rect.y = newpusherposy;
         }
-
       }
-      SDL_Delay(1);
     }
     oldpusherposy = newpusherposy;
     selectionchangeflag = 0;
@@ -1055,14 +676,20 @@ static int menu(SDL_Renderer *renderer, struct spritesstruct *sprites, SDL_Windo
 }
 
 
-/* waits for the user to choose a game type or to load an external xsb file and returns either a pointer to a memory chunk with xsb data or to fill levelfile with a filename */
-static unsigned char *selectgametype(SDL_Renderer *renderer, struct spritesstruct *sprites, SDL_Window *window, const struct videosettings *settings, char **levelfile, size_t *levelfilelen) {
+/* waits for the user to choose a game type or to load an external xsb file and returns either a pointer to a memory chunk with xsb data or to fill levelfile with a filename.
+ * *setname is set to the name an embedded set is indexed under. */
+static unsigned char *selectgametype(SDL_Renderer *renderer, struct spritesstruct *sprites, SDL_Window *window, const struct videosettings *settings, char **levelfile, size_t *levelfilelen, const char **setname) {
   static int selection = 0;
-  int choice;
-  const char *levname[] = {"Easy (Microban)",
-                           "Normal (Sasquatch)",
-                           "Hard (Sasquatch III)",
-                           "Boxworld 100 levels",
+  int choice, i, count, solved;
+  const char *setnames[] = {"Easy (Microban)",
+                            "Normal (Sasquatch)",
+                            "Hard (Sasquatch III)",
+                            "Boxworld 100 levels"};
+  static char labels[4][64];
+  const char *levname[] = {labels[0],
+                           labels[1],
+                           labels[2],
+                           labels[3],
                            "",
                            "Internet levels",
                            "Skin configuration",
@@ -1072,8 +699,19 @@ static unsigned char *selectgametype(SDL_Renderer *renderer, struct spritesstruc
 
   *levelfilelen = 0;
 
+  /* embedded sets that have been played already show how far they are solved */
+  for (i = 0; i < 4; i++) {
+    count = levindex_setprogress(setnames[i], &solved);
+    if (count > 0) {
+      sprintf(labels[i], "%s %d/%d", setnames[i], solved, count);
+    } else {
+      strcpy(labels[i], setnames[i]);
+    }
+  }
+
   choice = menu(renderer, sprites, window, settings, levname, 100, selection, levelfile);
   if (choice >= 0) selection = choice;
+  if ((choice >= 0) && (choice < 4)) *setname = setnames[choice];
 
   switch (choice) {
     case 0: /* easy (Microban) */
@@ -1098,99 +736,142 @@ static unsigned char *selectgametype(SDL_Renderer *renderer, struct spritesstruc
 }
 
 
-/* blit a level preview */
-static void blit_levelmap(const struct sokgame *game, struct spritesstruct *sprites, int xpos, int ypos, SDL_Renderer *renderer, unsigned short tilesize, unsigned char alpha, int flags) {
-  int x, y, bgpadding = tilesize * 3;
-  SDL_Rect rect, bgrect;
-
-  bgrect.x = xpos - (game->field_width * tilesize + bgpadding) / 2;
-  bgrect.y = ypos - (game->field_height * tilesize + bgpadding) / 2;
-  bgrect.w = game->field_width * tilesize + bgpadding;
-  bgrect.h = game->field_height * tilesize + bgpadding;
-  /* if background enabled, compute coordinates of the background and draw it */
-  if (flags & BLIT_LEVELMAP_BACKGROUND) {
-    SDL_SetRenderDrawColor(renderer, 0x12, 0x12, 0x12, 255);
-    CSDL_RenderFillRect(renderer, &bgrect);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-  }
-  for (y = 0; y < game->field_height; y++) {
-    for (x = 0; x < game->field_width; x++) {
-      /* compute coordinates of the tile on screen */
-      rect.x = xpos + (tilesize * x) - (game->field_width * tilesize) / 2;
-      rect.y = ypos + (tilesize * y) - (game->field_height * tilesize) / 2;
-      /* draw the tile */
-      if (game->field[x][y] & field_floor) gra_rendertile(renderer, sprites, SPRITE_FLOOR, rect.x, rect.y, tilesize, 0);
-      if (game->field[x][y] & field_wall) draw_wall(renderer, sprites, game, x, y, tilesize, rect.x, rect.y);
-      if ((game->field[x][y] & field_goal) && (game->field[x][y] & field_atom)) { /* atom on goal */
-        gra_rendertile(renderer, sprites, SPRITE_BOXOK, rect.x, rect.y, tilesize, 0);
-      } else if (game->field[x][y] & field_goal) { /* goal */
-        gra_rendertile(renderer, sprites, SPRITE_GOAL, rect.x, rect.y, tilesize, 0);
-      } else if (game->field[x][y] & field_atom) { /* atom */
-        gra_rendertile(renderer, sprites, SPRITE_BOX, rect.x, rect.y, tilesize, 0);
-      }
-    }
+/* level previews are rendered once into textures (thumbnails) kept in a
+ * small cache, so browsing levels costs a few blits per frame. the least
+ * recently used thumbnail is evicted when the cache is full. */
+#define THUMBCACHE_SIZE 16
+
+static struct thumbnail {
+  SDL_Texture *tex;         /* NULL for an empty slot */
+  const struct spritesstruct *sprites;
+  uint64_t crc64;
+  unsigned short width;
+  unsigned short height;
+  unsigned short tilesize;
+  unsigned char alpha;
+  int flags;
+  int cx, cy;               /* position of the preview's center on the texture */
+  unsigned long lastuse;
+} thumbcache[THUMBCACHE_SIZE];
+
+static unsigned long thumbclock;
+
+/* drops all thumbnails */
+static void thumbcache_free(void) {
+  int i;
+  for (i = 0; i < THUMBCACHE_SIZE; i++) {
+    if (thumbcache[i].tex != NULL) SDL_DestroyTexture(thumbcache[i].tex);
+    thumbcache[i].tex = NULL;
   }
-  /* apply alpha filter */
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255 - alpha);
-  CSDL_RenderFillRect(renderer, &bgrect);
-  /* if background enabled, then draw the border */
-  if (flags & BLIT_LEVELMAP_BACKGROUND) {
-    unsigned char fadealpha;
-    SDL_SetRenderDrawColor(renderer, 0x28, 0x28, 0x28, 255);
-    CSDL_RenderRect(renderer, &bgrect);
-    /* draw a nice fade-out effect around the selected level */
-    for (fadealpha = 1; fadealpha < 20; fadealpha++) {
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255 - fadealpha * (255 / 20));
-      bgrect.x -= 1;
-      bgrect.y -= 1;
-      bgrect.w += 2;
-      bgrect.h += 2;
-      CSDL_RenderRect(renderer, &bgrect);
+}
+
+/* returns the thumbnail of a level preview, rendering it first if needed.
+ * returns NULL if the renderer cannot provide such texture, the preview must
+ * then be drawn with draw_levelmap(). */
+static struct thumbnail *thumbcache_get(const struct sokgame *game, struct spritesstruct *sprites, SDL_Renderer *renderer, unsigned short tilesize, unsigned char alpha, int flags) {
+  struct thumbnail *t = &(thumbcache[0]);
+  int i, w, h, margin;
+
+  for (i = 0; i < THUMBCACHE_SIZE; i++) {
+    struct thumbnail *c = &(thumbcache[i]);
+    if ((c->tex != NULL) && (c->sprites == sprites) && (c->crc64 == game->crc64) && (c->width == game->field_width) && (c->height == game->field_height) && (c->tilesize == tilesize) && (c->alpha == alpha) && (c->flags == flags)) {
+      c->lastuse = ++thumbclock;
+      return(c);
     }
-    /* set the drawing color to its default, plain black color */
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    /* remember the empty or least recently used slot */
+    if ((t->tex != NULL) && ((c->tex == NULL) || (c->lastuse < t->lastuse))) t = c;
+  }
+
+  if (t->tex != NULL) SDL_DestroyTexture(t->tex);
+  margin = (flags & DRAWLEVELMAP_BACKGROUND) ? DRAWLEVELMAP_FADEWIDTH : 0;
+  w = game->field_width * tilesize + tilesize * 3 + margin * 2;
+  h = game->field_height * tilesize + tilesize * 3 + margin * 2;
+  t->tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+  if (t->tex == NULL) {
+    if (debugmode) printf("thumbnail (%dx%d) not available: %s\n", w, h, SDL_GetError());
+    return(NULL);
+  }
+  SDL_SetTextureBlendMode(t->tex, SDL_BLENDMODE_BLEND); /* the alpha filter and the fade-out border darken what lies below */
+  t->sprites = sprites;
+  t->crc64 = game->crc64;
+  t->width = game->field_width;
+  t->height = game->field_height;
+  t->tilesize = tilesize;
+  t->alpha = alpha;
+  t->flags = flags;
+  t->cx = margin + (game->field_width * tilesize + tilesize * 3) / 2;
+  t->cy = margin + (game->field_height * tilesize + tilesize * 3) / 2;
+  t->lastuse = ++thumbclock;
+
+  SDL_SetRenderTarget(renderer, t->tex);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); /* fill texture with transparency */
+  SDL_RenderClear(renderer);
+  draw_levelmap(game, sprites, t->cx, t->cy, renderer, tilesize, alpha, flags);
+  SDL_SetRenderTarget(renderer, NULL); /* reset the renderer (detach any texture) so I can draw to screen again */
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+  return(t);
+}
+
+
+/* blit a level preview */
+static void blit_levelmap(const struct sokgame *game, struct spritesstruct *sprites, int xpos, int ypos, SDL_Renderer *renderer, unsigned short tilesize, unsigned char alpha, int flags) {
+  struct thumbnail *t = thumbcache_get(game, sprites, renderer, tilesize, alpha, flags);
+  SDL_Rect rect;
+
+  if (t != NULL) {
+    CSDL_QueryTexture(t->tex, NULL, NULL, &rect.w, &rect.h);
+    rect.x = xpos - t->cx;
+    rect.y = ypos - t->cy;
+    perf_count(perf_drawcall);
+    CSDL_RenderTexture(renderer, t->tex, NULL, &rect);
+  } else {
+    draw_levelmap(game, sprites, xpos, ypos, renderer, tilesize, alpha, flags);
   }
   /* if level is solved, draw a 'complete' tag */
   if (game->solution != NULL) {
-    /* SDL_Rect rect; */
     CSDL_QueryTexture(sprites->solved, NULL, NULL, &rect.w, &rect.h);
     rect.w = rect.w * sprites->em / 60;
     rect.h = rect.h * sprites->em / 60;
     rect.x = xpos - (rect.w / 2);
     rect.y = ypos - (rect.h * 3 / 4);
+    perf_count(perf_drawcall);
     CSDL_RenderTexture(renderer, sprites->solved, NULL, &rect);
   }
 }
 
 static int fade2texture(SDL_Renderer *renderer, SDL_Window *window, SDL_Texture *texture) {
   int exitflag = 0;
-  unsigned char alphaval;
+  unsigned long elapsed = 0;
+  struct frameclock clk;
 
-  for (alphaval = 0; alphaval < 64; alphaval += 4) {
-    exitflag = displaytexture(renderer, texture, window, 0, 0, alphaval);
+  frame_start(&clk);
+  while (elapsed < FADE_MS) {
+    exitflag = displaytexture(renderer, texture, window, 0, 0, (unsigned char)(elapsed * 64 / FADE_MS));
     if (exitflag != 0) break;
-    SDL_Delay(15);  /* wait for 15ms */
+    elapsed = frame_wait(&clk);
   }
 
   if (exitflag == 0) exitflag = displaytexture(renderer, texture, window, 0, 0, 255);
   return(exitflag);
 }
 
-static int selectlevel(struct sokgame **gameslist, struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, struct videosettings *settings, const char *levcomment, int levelscount, int selection, char **levelfile) {
-  int i, winw, winh, maxallowedlevel;
-  char levelnum[64];
+static int selectlevel(struct soklevelset *levelset, struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, struct videosettings *settings, const char *levcomment, int selection, char **levelfile) {
+  int i, winw, winh, maxallowedlevel, levelscount = levelset->count;
+  int prerender;
+  char levelnum[96];
+  struct sokgame *lev;
+  struct levindexinfo levinfo;
   SDL_Event event;
   /* reload all solutions for levels, in case they changed (for ex. because we just solved a level..) */
-  sok_loadsolutions(gameslist, levelscount);
+  sok_loadsetsolutions(levelset);
 
   /* if no current level is selected, then preselect the first unsolved level */
   if (selection < 0) {
     for (i = 0; i < levelscount; i++) {
-      if (gameslist[i]->solution != NULL) {
-        if (debugmode != 0) printf("Level %d [%016" PRIx64 "] has solution: %s\n", i + 1, gameslist[i]->crc64, gameslist[i]->solution);
+      if (levelset->info[i].solution != NULL) {
+        if (debugmode != 0) printf("Level %d [%016" PRIx64 "] has solution: %lu moves\n", i + 1, levelset->info[i].crc64, (unsigned long)ml_count(levelset->info[i].solution));
       } else {
-        if (debugmode != 0) printf("Level %d [%16" PRIx64 "] has NO solution\n", i + 1, gameslist[i]->crc64);
+        if (debugmode != 0) printf("Level %d [%16" PRIx64 "] has NO solution\n", i + 1, levelset->info[i].crc64);
         selection = i;
         break;
       }
@@ -1203,7 +884,7 @@ static int selectlevel(struct sokgame **gameslist, struct spritesstruct *sprites
   /* compute the last allowed level */
   i = 0; /* i will temporarily store the number of unsolved levels */
   for (maxallowedlevel = 0; maxallowedlevel < levelscount; maxallowedlevel++) {
-    if (gameslist[maxallowedlevel]->solution == NULL) i++;
+    if (levelset->info[maxallowedlevel].solution == NULL) i++;
     if (i > 3) break; /* user can see up to 3 unsolved levels */
   }
 
@@ -1216,39 +897,70 @@ static int selectlevel(struct sokgame **gameslist, struct spritesstruct *sprites
      * otherwise glitches will appear between tile boundaries */
     SDL_RenderClear(renderer);
 
-    /* draw the level before */
-    if (selection > 0) blit_levelmap(gameslist[selection - 1], sprites, winw / 5, winh / 2, renderer, (settings->tilesize / 4) & 254, 96, 0);
+    /* draw the level before (levels are parsed on first display) */
+    if ((selection > 0) && ((lev = sok_getlevel(levelset, selection - 1)) != NULL)) blit_levelmap(lev, sprites, winw / 5, winh / 2, renderer, (settings->tilesize / 4) & 254, 96, 0);
 
     /* draw the level after */
-    if (selection + 1 < maxallowedlevel) blit_levelmap(gameslist[selection + 1], sprites, winw * 4 / 5,  winh / 2, renderer, (settings->tilesize / 4) & 254, 96, 0);
+    if ((selection + 1 < maxallowedlevel) && ((lev = sok_getlevel(levelset, selection + 1)) != NULL)) blit_levelmap(lev, sprites, winw * 4 / 5,  winh / 2, renderer, (settings->tilesize / 4) & 254, 96, 0);
 
     /* draw the selected level */
-    blit_levelmap(gameslist[selection], sprites,  winw / 2,  winh / 2, renderer, (settings->tilesize / 3) & 254, 210, BLIT_LEVELMAP_BACKGROUND);
+    lev = sok_getlevel(levelset, selection);
+    if (lev != NULL) blit_levelmap(lev, sprites,  winw / 2,  winh / 2, renderer, (settings->tilesize / 3) & 254, 210, DRAWLEVELMAP_BACKGROUND);
 
     /* draw strings, etc */
     draw_string(levcomment, 100, 255, sprites, renderer, DRAWSTRING_CENTER, winh / 8, window, 1, 0);
     draw_string("(choose a level)", 100, 255, sprites, renderer, DRAWSTRING_CENTER, winh / 8 + 40, window, 1, 0);
     sprintf(levelnum, "Level %d of %d", selection + 1, levelscount);
+    /* levels found in other sets are solved there as well */
+    if ((levindex_getlevel(levelset->info[selection].crc64, &levinfo) == 0) && (levinfo.sets > 1)) {
+      sprintf(levelnum + strlen(levelnum), " (also in %d other set%s)", levinfo.sets - 1, (levinfo.sets > 2) ? "s" : "");
+    }
     draw_string(levelnum, 100, 255, sprites, renderer, DRAWSTRING_CENTER, winh * 3 / 4, window, 1, 0);
 
     /* if level has a comment then display it, too (between quotes) */
-    if (strlen(gameslist[selection]->comment) > 4) {
-      char buf[sizeof(gameslist[0]->comment) + 2];
-      sprintf(buf, "\"%s\"", gameslist[selection]->comment);
+    if ((lev != NULL) && (strlen(lev->comment) > 4)) {
+      char buf[sizeof(lev->comment) + 2];
+      sprintf(buf, "\"%s\"", lev->comment);
       draw_string(buf, 80, 255, sprites, renderer, DRAWSTRING_CENTER, winh * 3 / 4 + 50, window, 1, 0);
     }
 
     SDL_RenderPresent(renderer);
 
     /* Wait for an event - but ignore 'KEYUP' and 'MOUSEMOTION' events, since they are worthless in this game */
-    for (;;)
-      if (SDL_WaitEvent(&event) != 0 && event.type != CSDL_EVENT_KEY_UP &&
+    prerender = 0;
+    for (;;) {
+      if (SDL_PollEvent(&event) == 0) {
+        /* idle: render the thumbnails that the next move will need, one at a
+         * time so a key press is never kept waiting for long. the neighbours
+         * get the centre style, those next to them and the selection itself
+         * the side style */
+        if (prerender < 5) {
+          static const int offset[5] = {-1, 1, -2, 2, 0};
+          int p = selection + offset[prerender];
+          if ((p >= 0) && (p < maxallowedlevel) && ((lev = sok_getlevel(levelset, p)) != NULL)) {
+            if (prerender < 2) {
+              thumbcache_get(lev, sprites, renderer, (settings->tilesize / 3) & 254, 210, DRAWLEVELMAP_BACKGROUND);
+            } else {
+              thumbcache_get(lev, sprites, renderer, (settings->tilesize / 4) & 254, 96, 0);
+            }
+          }
+          prerender++;
+          continue;
+        }
+        if (SDL_WaitEvent(&event) == 0) continue;
+      }
+      if (event.type != CSDL_EVENT_KEY_UP &&
 	  event.type != CSDL_EVENT_MOUSE_MOTION)
 	break;
+    }
 
     /* check what event we got */
     if (event.type == CSDL_EVENT_QUIT) {
       return(SELECTLEVEL_QUIT);
+    } else if (event.type == CSDL_EVENT_RENDER_TARGETS_RESET) {
+      thumbcache_free(); /* content of render target textures got lost */
+      draw_droptextures();
+      skin_resettargets(sprites, renderer);
     } else if (event.type == CSDL_EVENT_DROP_FILE) {
       if (processDropFileEvent(&event, levelfile) != NULL) {
         fade2texture(renderer, window, sprites->black);
@@ -1321,62 +1033,65 @@ static void setsokicon(SDL_Window *window) {
 }
 
 /* returns 1 if curlevel is the last level to solve in the set. returns 0 otherwise. */
-static int islevelthelastleft(struct sokgame **gamelist, int curlevel, int levelscount) {
+static int islevelthelastleft(const struct soklevelset *levelset, int curlevel) {
   int x;
   if (curlevel < 0) return(0);
-  if (gamelist[curlevel]->solution != NULL) return(0);
-  for (x = 0; x < levelscount; x++) {
-    if ((gamelist[x]->solution == NULL) && (x != curlevel)) return(0);
+  if (levelset->info[curlevel].solution != NULL) return(0);
+  for (x = 0; x < levelset->count; x++) {
+    if ((levelset->info[x].solution == NULL) && (x != curlevel)) return(0);
   }
   return(1);
 }
 
-static void dumplevel2clipboard(struct sokgame *game, char *history) {
+static void dumplevel2clipboard(struct sokgame *game, const struct sokmovelist *history) {
   char *txt;
-  unsigned long solutionlen = 0, playfieldsize;
+  unsigned long solutionlen, playfieldsize;
+  size_t i, len;
   int x, y;
-  if (game->solution != NULL) solutionlen = strlen(game->solution);
+  solutionlen = ml_count(history);
   playfieldsize = (game->field_width + 1) * game->field_height;
   txt = malloc(solutionlen + playfieldsize + 4096);
   if (txt == NULL) return;
-  sprintf(txt, "; Level id: %016" PRIx64 "\n\n", game->crc64);
+  /* written at a running offset: strcat() would rescan the whole text for
+   * every cell */
+  len = (size_t)sprintf(txt, "; Level id: %016" PRIx64 "\n\n", game->crc64);
   for (y = 0; y < game->field_height; y++) {
     for (x = 0; x < game->field_width; x++) {
-      switch (game->field[x][y] & ~field_floor) {
+      switch (SOK_FIELD(game, x, y) & ~field_floor) {
         case field_wall:
-          strcat(txt, "#");
+          txt[len++] = '#';
           break;
         case (field_atom | field_goal):
-          strcat(txt, "*");
+          txt[len++] = '*';
           break;
         case field_atom:
-          strcat(txt, "$");
+          txt[len++] = '$';
           break;
         case field_goal:
           if ((game->positionx == x) && (game->positiony == y)) {
-            strcat(txt, "+");
+            txt[len++] = '+';
           } else {
-            strcat(txt, ".");
+            txt[len++] = '.';
           }
           break;
         default:
           if ((game->positionx == x) && (game->positiony == y)) {
-            strcat(txt, "@");
+            txt[len++] = '@';
           } else {
-            strcat(txt, " ");
+            txt[len++] = ' ';
           }
           break;
       }
     }
-    strcat(txt, "\n");
+    txt[len++] = '\n';
   }
-  strcat(txt, "\n");
-  if ((history != NULL) && (history[0] != 0)) { /* only allow if there actually is a solution */
-    strcat(txt, "; Solution\n; ");
-    strcat(txt, history);
-    strcat(txt, "\n");
+  txt[len++] = '\n';
+  if (ml_count(history) > 0) { /* only allow if there actually is a solution */
+    len += (size_t)sprintf(txt + len, "; Solution\n; ");
+    for (i = 0; i < solutionlen; i++) txt[len++] = ml_move2char(ml_get(history, i));
+    sprintf(txt + len, "\n");
   } else {
-    strcat(txt, "; No solution available\n");
+    sprintf(txt + len, "; No solution available\n");
   }
   SDL_SetClipboardText(txt);
   free(txt);
@@ -1457,15 +1172,53 @@ static int selectskinmenu(SDL_Renderer *renderer, SDL_Window *window, struct spr
 }
 
 
-static int selectinternetlevel(SDL_Renderer *renderer, SDL_Window *window, struct spritesstruct *sprites, const char *host, unsigned short port, const char *path, char *levelslist, unsigned char **xsbptr, size_t *reslen) {
-  unsigned char *res = NULL;
+/* waits for a background fetch to complete, displaying its progress in the
+ * meantime. returns 0 once the fetch is over (*resptr and *reslen being set
+ * to its result, possibly empty), or SELECTLEVEL_BACK / SELECTLEVEL_QUIT if
+ * the user aborted it */
+static int waitfetch(SDL_Renderer *renderer, SDL_Window *window, struct spritesstruct *sprites, struct netfetch *f, unsigned char **resptr, size_t *reslen) {
+  SDL_Event event;
+  size_t received;
+  char msg[64];
+  *resptr = NULL;
+  *reslen = 0;
+  if (f == NULL) return(0);
+  while (netcache_poll(f, &received) == NETFETCH_PENDING) {
+    SDL_RenderClear(renderer);
+    sprintf(msg, "Downloading... %lu KiB", (unsigned long)(received / 1024));
+    draw_string(msg, 100, 255, sprites, renderer, DRAWSTRING_CENTER, DRAWSTRING_CENTER, window, 1, 0);
+    SDL_RenderPresent(renderer);
+    if (SDL_WaitEventTimeout(&event, 100) == 0) continue;
+    if (event.type == CSDL_EVENT_QUIT) {
+      netcache_cancel(f);
+      return(SELECTLEVEL_QUIT);
+    }
+    if ((event.type == CSDL_EVENT_KEY_DOWN) && (normalizekeys(CSDL_KEY_SYM(event.key)) == KEY_ESCAPE)) {
+      netcache_cancel(f);
+      return(SELECTLEVEL_BACK);
+    }
+  }
+  *reslen = netcache_finish(f, resptr);
+  return(0);
+}
+
+
+/* lets the user choose an internet level set and fetches it. the path of the
+ * set (that it is indexed under) is copied to setname, of setnamesz bytes. */
+static int selectinternetlevel(SDL_Renderer *renderer, SDL_Window *window, struct spritesstruct *sprites, const char *host, unsigned short port, const char *path, char *levelslist, unsigned char **xsbptr, size_t *reslen, char *setname, size_t setnamesz) {
+  #define PREFETCH_DELAY 300 /* ms an entry must stay highlighted to get prefetched */
   char url[2048], buff[1200], buff2[1024];
   char *inetlist[1024];
   int inetlistlen = 0, i, selected = 0, windowrows, fontheight = 24, winw, winh;
+  int count, solved;
   static int selection = 0, seloffset = 0;
+  struct netfetch *prefetch = NULL;
+  int prefetchsel = -1;
+  Uint32 seltime = SDL_GetTicks();
   SDL_Event event;
   *xsbptr = NULL;
   *reslen = 0;
+  setname[0] = 0;
   /* load levelslist into an array */
   for (;;) {
     inetlist[inetlistlen] = readmemline(&levelslist);
@@ -1509,7 +1262,15 @@ static int selectinternetlevel(SDL_Renderer *renderer, SDL_Window *window, struc
     /* draw level description */
     rect.y += fontheight / 2;
     fetchtoken(buff2, inetlist[selection], 1);
-    draw_string(buff2, 100, 250, sprites, renderer, DRAWSTRING_CENTER, rect.y, window, 1, 0);
+    fetchtoken(buff, inetlist[selection], 0);
+    sprintf(url, "%s%s", path, buff);
+    count = levindex_setprogress(url, &solved);
+    if (count > 0) {
+      sprintf(buff, "%s (%d/%d solved)", buff2, solved, count);
+    } else {
+      strcpy(buff, buff2);
+    }
+    draw_string(buff, 100, 250, sprites, renderer, DRAWSTRING_CENTER, rect.y, window, 1, 0);
     fetchtoken(buff2, inetlist[selection], 2);
     sprintf(buff, "Copyright (C) %s", buff2);
     draw_string(buff, 65, 200, sprites, renderer, DRAWSTRING_CENTER, rect.y + (fontheight * 12 / 10), window, 1, 0);
@@ -1519,11 +1280,23 @@ static int selectinternetlevel(SDL_Renderer *renderer, SDL_Window *window, struc
     SDL_RenderPresent(renderer);
     /* Wait for an event - but ignore 'KEYUP' and 'MOUSEMOTION' events, since they are worthless in this game */
     for (;;) {
-      SDL_WaitEvent(&event);
+      if (SDL_WaitEventTimeout(&event, 100) == 0) {
+        /* idle: prefetch the highlighted set once it stayed highlighted for
+         * a while, dropping the prefetch of a previously highlighted one */
+        if ((prefetchsel != selection) && (SDL_GetTicks() - seltime >= PREFETCH_DELAY)) {
+          if (prefetch != NULL) netcache_cancel(prefetch);
+          fetchtoken(buff, inetlist[selection], 0);
+          sprintf(url, "%s%s", path, buff);
+          prefetch = netcache_fetch(host, port, url);
+          prefetchsel = selection;
+        }
+        continue;
+      }
       if (event.type != CSDL_EVENT_KEY_UP &&
 	  event.type != CSDL_EVENT_MOUSE_MOTION)
 	break;
     }
+    seltime = SDL_GetTicks();
     /* check what event we got */
     if (event.type == CSDL_EVENT_QUIT) {
         selected = SELECTLEVEL_QUIT;
@@ -1563,12 +1336,18 @@ static int selectinternetlevel(SDL_Renderer *renderer, SDL_Window *window, struc
     }
     if (selected != 0) break;
   }
-  /* fetch the selected level */
+  /* fetch the selected level, possibly reusing its prefetch */
+  if ((prefetch != NULL) && ((selected != SELECTLEVEL_OK) || (prefetchsel != selection))) {
+    netcache_cancel(prefetch);
+    prefetch = NULL;
+  }
   if (selected == SELECTLEVEL_OK) {
     fetchtoken(buff, inetlist[selection], 0);
     sprintf(url, "%s%s", path, buff);
-    *reslen = http_get(host, port, url, &res);
-    *xsbptr = res;
+    if (strlen(url) < setnamesz) strcpy(setname, url);
+    if (prefetch == NULL) prefetch = netcache_fetch(host, port, url);
+    i = waitfetch(renderer, window, sprites, prefetch, xsbptr, reslen);
+    if (i != 0) selected = i;
   } else {
     *xsbptr = NULL;
   }
@@ -1626,11 +1405,28 @@ static int parse_cmdline(struct videosettings *settings, int argc, char **argv,
         settings->movspeed = atoi(argv[i] + strlen("--movspeed="));
       } else if (strstr(argv[i], "--rotspeed=") == argv[i]) {
         settings->rotspeed = atoi(argv[i] + strlen("--rotspeed="));
+      } else if (strstr(argv[i], "--threads=") == argv[i]) {
+        settings->threads = atoi(argv[i] + strlen("--threads="));
       } else if (strstr(argv[i], "--skin=") == argv[i]) {
         settings->customskinfile = argv[i] + strlen("--skin=");
       } else if (strcmp(argv[i], "--skinlist") == 0) {
         list_installed_skins();
         return(1);
+      } else if (strcmp(argv[i], "--verify") == 0) {
+        settings->batchmode = BATCH_VERIFY;
+      } else if (strcmp(argv[i], "--solve") == 0) {
+        settings->batchmode = BATCH_SOLVE;
+      } else if (strstr(argv[i], "--render-thumbs=") == argv[i]) {
+        settings->batchmode = BATCH_THUMBS;
+        settings->thumbsdir = argv[i] + strlen("--render-thumbs=");
+      } else if (strstr(argv[i], "--solvetime=") == argv[i]) {
+        settings->solvetime = strtoul(argv[i] + strlen("--solvetime="), NULL, 10);
+      } else if (strstr(argv[i], "--solvemem=") == argv[i]) {
+        settings->solvemem = strtoul(argv[i] + strlen("--solvemem="), NULL, 10);
+      } else if (strcmp(argv[i], "--perf") == 0) {
+        perf_init(PERF_TRACEFILE);
+      } else if (strstr(argv[i], "--perf=") == argv[i]) {
+        perf_init(argv[i] + strlen("--perf="));
       } else if ((*levelfile == NULL) && (argv[i][0] != '-')) { /* else assume it is a level file */
         *levelfile = strdup(argv[i]);
       } else { /* invalid argument */
@@ -1642,8 +1438,17 @@ static int parse_cmdline(struct videosettings *settings, int argc, char **argv,
         puts("options:");
         puts(" --movspeed=n   player's moving speed (1..100, 1=slowest 100=instant default=22)");
         puts(" --rotspeed=n   player's rotation speed (1..100, default=22)");
+        puts(" --threads=n    threads for the solver, --verify and --render-thumbs (default: one per CPU)");
         puts(" --skin=name    skin name to be used (default: antique3)");
         puts(" --skinlist     display the list of installed skins");
+        puts(" --verify       replay all saved solutions of levelfile and report results");
+        puts(" --solve        compute and save solutions for unsolved levels of levelfile");
+        puts(" --render-thumbs=dir");
+        puts("                write a PNG preview of every level of levelfile to dir");
+        puts(" --solvetime=n  solver's time limit per level, in seconds (default: 60, in-game: 5)");
+        puts(" --solvemem=n   solver's memory limit, in MiB (default: 1024, in-game: 256)");
+        puts(" --perf[=file]  show timings on screen and write a Chrome trace to file on exit");
+        puts("                (default: " PERF_TRACEFILE ")");
         puts("");
         puts("Skin files can be located in the following directories:");
         puts(" * a skins/ subdirectory in SimpleSok's user directory");
@@ -1661,46 +1466,251 @@ static int parse_cmdline(struct videosettings *settings, int argc, char **argv,
 }
 
 
-/* process playback */
-static void process_autoplayback(enum SOKMOVE *movedir, int *playsolution, const char *playsource) {
+/* fills solver limits from settings, or from defaults if not set */
+static void getsolverparams(struct soksolver_params *params, const struct videosettings *settings, unsigned long deftime, unsigned long defmem) {
+  params->maxtime = settings->solvetime;
+  if (params->maxtime == 0) params->maxtime = deftime;
+  if (settings->solvemem != 0) defmem = settings->solvemem;
+  params->maxmemory = (size_t)defmem * 1024 * 1024;
+  params->threads = settings->threads;
+  params->cancel = NULL;
+  params->cancelctx = NULL;
+}
 
-  switch (playsource[*playsolution - 1]) {
-    case 'u':
-    case 'U':
-      *movedir = sokmoveUP;
-      break;
-    case 'r':
-    case 'R':
-      *movedir = sokmoveRIGHT;
-      break;
-    case 'd':
-    case 'D':
-      *movedir = sokmoveDOWN;
-      break;
-    case 'l':
-    case 'L':
-      *movedir = sokmoveLEFT;
-      break;
-    default:
-      *movedir = sokmoveNONE;
+
+/* a solver search run by a background thread, so the UI stays responsive */
+struct bgsolve {
+  const struct sokgame *level;
+  struct soksolver_params params;
+  CSDL_AtomicInt cancelled;  /* set by the UI to abandon the search */
+  CSDL_AtomicInt done;       /* set by the thread once the search is over */
+  int res;
+  char *solution;
+};
+
+static int bgsolve_cancel(void *ctx) {
+  struct bgsolve *b = ctx;
+  return(CSDL_AtomicGet(&(b->cancelled)));
+}
+
+static int bgsolve_worker(void *arg) {
+  struct bgsolve *b = arg;
+  b->res = sok_solve(b->level, &(b->params), &(b->solution), NULL);
+  CSDL_AtomicSet(&(b->done), 1);
+  return(0);
+}
+
+/* solves level in a background thread, keeping game drawn with a "solving"
+ * notice in the meantime. ESC abandons the search (soksolver_cancelled is
+ * returned then), and so does closing the window, which also sets
+ * *exitflag. on success *solution is set to a malloc()'ed string of moves */
+static int solvelevel(const struct sokgame *level, const struct soksolver_params *params, char **solution, int *exitflag, const struct sokgame *game, const struct sokgamestates *states, struct spritesstruct *sprites, SDL_Renderer *renderer, SDL_Window *window, const struct videosettings *settings, int drawscreenflags, const char *levcomment) {
+  struct bgsolve b;
+  SDL_Thread *thread;
+  SDL_Event event;
+
+  memset(&b, 0, sizeof(b));
+  b.level = level;
+  b.params = *params;
+  b.params.cancel = bgsolve_cancel;
+  b.params.cancelctx = &b;
+  CSDL_AtomicSet(&(b.cancelled), 0);
+  CSDL_AtomicSet(&(b.done), 0);
+  *solution = NULL;
+
+  thread = SDL_CreateThread(bgsolve_worker, "simplesok solver", &b);
+  /* no thread: solve right away, the UI freezing until done */
+  if (thread == NULL) bgsolve_worker(&b);
+
+  while (CSDL_AtomicGet(&(b.done)) == 0) {
+    draw_screen(game, states, sprites, renderer, window, settings, 0, 0, 0, drawscreenflags, levcomment);
+    draw_string((CSDL_AtomicGet(&(b.cancelled)) != 0) ? "cancelling..." : "solving... (ESC to cancel)", 100, 255, sprites, renderer, DRAWSTRING_CENTER, DRAWSTRING_CENTER, window, 1, 0);
+    SDL_RenderPresent(renderer);
+    if (SDL_WaitEventTimeout(&event, 100) == 0) continue;
+    if (event.type == CSDL_EVENT_QUIT) {
+      *exitflag = 1;
+      CSDL_AtomicSet(&(b.cancelled), 1);
+    } else if (event.type == CSDL_EVENT_RENDER_TARGETS_RESET) {
+      draw_droptextures(); /* content of render target textures got lost */
+      thumbcache_free();
+      skin_resettargets(sprites, renderer);
+    } else if ((event.type == CSDL_EVENT_KEY_DOWN) && (normalizekeys(CSDL_KEY_SYM(event.key)) == KEY_ESCAPE)) {
+      CSDL_AtomicSet(&(b.cancelled), 1);
+    }
+  }
+  if (thread != NULL) SDL_WaitThread(thread, NULL);
+
+  if ((b.res == soksolver_solved) && (CSDL_AtomicGet(&(b.cancelled)) == 0)) {
+    *solution = b.solution;
+    return(soksolver_solved);
+  }
+  free(b.solution);
+  if (CSDL_AtomicGet(&(b.cancelled)) != 0) return(soksolver_cancelled);
+  return(b.res);
+}
+
+
+/* process playback */
+static void process_autoplayback(enum SOKMOVE *movedir, int *playsolution, const struct sokmovelist *playsource) {
+  if ((size_t)*playsolution > ml_count(playsource)) {
+    *movedir = sokmoveNONE;
+    *playsolution = 0;
+    return;
   }
+  *movedir = sok_ml2move(ml_get(playsource, (size_t)*playsolution - 1));
   (*playsolution)++;
-  if (playsource[*playsolution - 1] == 0) *playsolution = 0;
+  if ((size_t)*playsolution > ml_count(playsource)) *playsolution = 0;
+}
+
+
+/* time between two playback moves at each playback speed, 0 meaning that
+ * all the remaining moves are played at once */
+static const unsigned short playspeed_ms[] = {AUTOPLAY_MS, AUTOPLAY_MS / 4, AUTOPLAY_MS / 16, 0};
+
+
+/* plays the next count moves of the playback without drawing anything,
+ * stopping early after the first push if topush is set. playback ends once
+ * its last move is played. returns non-zero if the level gets solved. */
+static int playback_forward(struct sokgame *game, struct sokgamestates *states, int *playsolution, const struct sokmovelist *playsource, size_t count, int topush) {
+  int res;
+  while ((count-- > 0) && (*playsolution > 0)) {
+    res = sok_move(game, sok_ml2move(ml_get(playsource, (size_t)*playsolution - 1)), 0, states);
+    (*playsolution)++;
+    if ((size_t)*playsolution > ml_count(playsource)) *playsolution = 0;
+    if (res < 0) continue;
+    if (res & sokmove_solved) return(1);
+    if ((res & sokmove_pushed) && (topush != 0)) break;
+  }
+  return(0);
+}
+
+
+/* goes back count moves in the playback, or if topush is set back to right
+ * after the last push before the current position (or to the start) */
+static void playback_back(struct sokgame *game, struct sokgamestates *states, int *playsolution, size_t count, int topush) {
+  size_t moves = sok_states_getmoves(states), back;
+  if (*playsolution <= 0) return;
+  back = (size_t)*playsolution - 1; /* moves of the playback played so far */
+  if (back > moves) back = moves;
+  if (topush != 0) {
+    for (count = 1; count < back; count++) {
+      if (ml_get(states->history, moves - count - 1) & mlmove_push) break;
+    }
+  }
+  if (count > back) count = back;
+  *playsolution -= (int)(moves - sok_seek(game, states, moves - count));
+}
+
+
+/* jumps the playback to right after its push-th push (or to its start if
+ * push is 0), going back through the keyframes of states if needed. the
+ * playback ends if it has less pushes. returns non-zero if the level gets
+ * solved. */
+static int playback_topush(struct sokgame *game, struct sokgamestates *states, int *playsolution, const struct sokmovelist *playsource, long push) {
+  size_t target = 0, played, count = ml_count(playsource);
+  if (*playsolution <= 0) return(0);
+  while ((push > 0) && (target < count)) {
+    if (ml_get(playsource, target) & mlmove_push) push--;
+    target++;
+  }
+  played = (size_t)*playsolution - 1;
+  if (target < played) {
+    playback_back(game, states, playsolution, played - target, 0);
+    return(0);
+  }
+  return(playback_forward(game, states, playsolution, playsource, target - played, 0));
+}
+
+
+/* process a mouse click: a left click on a floor cell walks the player there,
+ * a left click on an atom selects it and the next left click pushes the
+ * selected atom to the clicked cell. a right click drops the selection. all
+ * moves are played at once except the last one, which is returned so it gets
+ * animated like any key move. */
+static enum SOKMOVE process_mouseclick(const SDL_Event *event, struct sokgame *game, struct sokgamestates *states, SDL_Window *window, const struct videosettings *settings, int *selx, int *sely) {
+  int winw, winh, x, y, oldselx = *selx, oldsely = *sely;
+  char *path;
+  struct sokmovelist *moves;
+  enum SOKMOVE res = sokmoveNONE;
+
+  *selx = -1;
+  if (event->button.button != SDL_BUTTON_LEFT) return(sokmoveNONE);
+
+  /* which cell has been clicked? */
+  SDL_GetWindowSize(window, &winw, &winh);
+  x = CSDL_BUTTON_X(event->button) - draw_offseth(game, winw, settings->tilesize);
+  y = CSDL_BUTTON_Y(event->button) - draw_offsetv(game, winh, settings->tilesize);
+  if ((x < 0) || (y < 0)) return(sokmoveNONE);
+  x /= settings->tilesize;
+  y /= settings->tilesize;
+  if ((x >= game->field_width) || (y >= game->field_height)) return(sokmoveNONE);
+
+  if (SOK_FIELD(game, x, y) & field_atom) {
+    /* clicking the selected atom again unselects it */
+    if ((x != oldselx) || (y != oldsely)) {
+      *selx = x;
+      *sely = y;
+    }
+    return(sokmoveNONE);
+  }
+  if (oldselx >= 0) {
+    path = sok_pushpath(game, oldselx, oldsely, x, y);
+  } else {
+    path = sok_walkpath(game, x, y);
+  }
+  if (path == NULL) return(sokmoveNONE);
+
+  moves = ml_fromstring(path);
+  free(path);
+  if (moves == NULL) return(sokmoveNONE);
+  if (ml_count(moves) > 0) {
+    res = sok_ml2move(ml_get(moves, ml_count(moves) - 1));
+    ml_undo(moves);
+    sok_play(game, states, moves);
+  }
+  ml_free(moves);
+  return(res);
+}
+
+
+/* outlines the atom selected with the mouse */
+static void draw_selection(const struct sokgame *game, SDL_Renderer *renderer, SDL_Window *window, const struct videosettings *settings, int selx, int sely) {
+  SDL_Rect rect;
+  int winw, winh;
+  SDL_GetWindowSize(window, &winw, &winh);
+  rect.x = draw_offseth(game, winw, settings->tilesize) + (selx * settings->tilesize);
+  rect.y = draw_offsetv(game, winh, settings->tilesize) + (sely * settings->tilesize);
+  rect.w = settings->tilesize;
+  rect.h = settings->tilesize;
+  SDL_SetRenderDrawColor(renderer, 0xff, 0xff, 0xff, 255);
+  CSDL_RenderRect(renderer, &rect);
+  rect.x += 1;
+  rect.y += 1;
+  rect.w -= 2;
+  rect.h -= 2;
+  CSDL_RenderRect(renderer, &rect);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
 }
 
 
 int main(int argc, char **argv) {
-  struct sokgame **gameslist, game;
+  struct soklevelset *levelset = NULL;
+  struct sokgame *game = NULL, *curgame = NULL;
   struct sokgamestates *states;
   struct spritesstruct *sprites;
   int levelscount, curlevel, exitflag = 0, showhelp = 0, lastlevelleft = 0;
   int playsolution, drawscreenflags;
   int autoplay = 0;
+  Uint32 nextplayback = 0; /* when the next autoplay move is due */
+  int selx = -1, sely = -1; /* atom selected with the mouse, if any */
+  long seekpush = -1;       /* push typed during playback to jump to, if any */
   char *levelfile = NULL;
-  char *playsource = NULL;
+  struct sokmovelist *playsource = NULL;
   char *levelslist = NULL;
   #define LEVCOMMENTMAXLEN 32
   char levcomment[LEVCOMMENTMAXLEN];
+  char setname[2048];       /* name the set is indexed under, unless it is a file */
+  const char *internalset = NULL;
   struct videosettings settings;
   unsigned char *xsblevelptr = NULL;
   size_t xsblevelptrlen = 0;
@@ -1713,6 +1723,25 @@ int main(int argc, char **argv) {
   exitflag = parse_cmdline(&settings, argc, argv, &levelfile);
   if (exitflag != 0) return(1);
 
+  /* headless modes do not need any video nor network */
+  if (settings.batchmode != BATCH_NONE) {
+    int res;
+    if (settings.batchmode == BATCH_VERIFY) {
+      res = batch_verify(levelfile, settings.threads);
+    } else if (settings.batchmode == BATCH_THUMBS) {
+      if (settings.customskinfile == NULL) settings.customskinfile = loadconf_skin();
+      if (settings.customskinfile == NULL) settings.customskinfile = DEFAULT_SKIN;
+      res = batch_renderthumbs(levelfile, settings.thumbsdir, settings.customskinfile, settings.threads);
+    } else {
+      struct soksolver_params params;
+      getsolverparams(&params, &settings, SOLVER_CLI_MAXTIME, SOLVER_CLI_MAXMEM);
+      res = batch_solve(levelfile, &params);
+    }
+    save_flush();
+    perf_shutdown();
+    return(res);
+  }
+
   /* init networking stack (required on windows) */
   init_net();
 
@@ -1742,6 +1771,10 @@ int main(int argc, char **argv) {
     return(1);
   }
 
+  /* present frames in sync with the display refresh, animations are paced by
+   * the time elapsed anyway, so this is not fatal if unsupported */
+  if (CSDL_SetRenderVSync(renderer, 1) != 0) printf("vsync unavailable: %s\n", SDL_GetError());
+
   SDL_SetWindowMinimumSize(window, 600, 400);
 
   LoadSprites:
@@ -1764,21 +1797,15 @@ int main(int argc, char **argv) {
     puts("\nNOTICE: this skin is primitive (no transparency found on player's sprite)\nthus it is unsuitable for animated movements. ALL ANIMATIONS DISABLED!\n");
   }
 
-  /* Hide the mouse cursor, disable mouse events and make sure DropEvents are enabled (sometimes they are not) */
-  CSDL_ShowCursor(0);
+  /* Disable mouse motion events (only clicks are of any use) and make sure DropEvents are enabled (sometimes they are not) */
   CSDL_SetEventEnabled(CSDL_EVENT_MOUSE_MOTION, 0);
+  CSDL_SetEventEnabled(CSDL_EVENT_MOUSE_BUTTON_UP, 0);
   CSDL_SetEventEnabled(CSDL_EVENT_DROP_FILE, 1);
 
   /* validate parameters */
   if ((settings.movspeed < 1) || (settings.movspeed > 100)) settings.movspeed = 22;
   if ((settings.rotspeed < 1) || (settings.rotspeed > 100)) settings.rotspeed = 22;
 
-  gameslist = malloc(sizeof(struct sokgame *) * MAXLEVELS);
-  if (gameslist == NULL) {
-    puts("Memory allocation failed!");
-    return(1);
-  }
-
   states = sok_newstates();
   if (states == NULL) return(1);
 
@@ -1791,7 +1818,9 @@ int main(int argc, char **argv) {
   levelscount = -1;
   settings.tilesize = auto_tilesize(sprites);
   if (levelfile != NULL) goto LoadLevelFile;
-  xsblevelptr = selectgametype(renderer, sprites, window, &settings, &levelfile, &xsblevelptrlen);
+  setname[0] = 0;
+  xsblevelptr = selectgametype(renderer, sprites, window, &settings, &levelfile, &xsblevelptrlen, &internalset);
+  if ((xsblevelptrlen != 0) && (internalset != NULL)) strcpy(setname, internalset);
   levelsource = LEVEL_INTERNAL;
   if ((xsblevelptrlen == 0) && (xsblevelptr != NULL)) {
     if (*xsblevelptr == '@') {
@@ -1801,6 +1830,8 @@ int main(int argc, char **argv) {
         /* quit application (window closed) */
         exitflag = 1;
       } else {
+        draw_free();
+        thumbcache_free();
         skin_free(sprites);
         goto LoadSprites;
       }
@@ -1812,14 +1843,19 @@ int main(int argc, char **argv) {
   if (levelsource == LEVEL_INTERNET) { /* internet levels */
     int selectres;
     size_t httpres;
-    httpres = http_get(INET_HOST, INET_PORT, INET_PATH, (unsigned char **) &levelslist);
+    selectres = waitfetch(renderer, window, sprites, netcache_fetch(INET_HOST, INET_PORT, INET_PATH), (unsigned char **) &levelslist, &httpres);
+    if (selectres == SELECTLEVEL_BACK) goto GametypeSelectMenu;
+    if (selectres == SELECTLEVEL_QUIT) {
+      exitflag = 1;
+      goto LoadLevelFile;
+    }
     if ((httpres == 0) || (levelslist == NULL)) {
       SDL_RenderClear(renderer);
       draw_string("Failed to fetch internet levels!", 100, 255, sprites, renderer, DRAWSTRING_CENTER, DRAWSTRING_CENTER, window, 1, 0);
       wait_for_a_key(-1, renderer);
       goto GametypeSelectMenu;
     }
-    selectres = selectinternetlevel(renderer, window, sprites, INET_HOST, INET_PORT, INET_PATH, levelslist, &xsblevelptr, &xsblevelptrlen);
+    selectres = selectinternetlevel(renderer, window, sprites, INET_HOST, INET_PORT, INET_PATH, levelslist, &xsblevelptr, &xsblevelptrlen, setname, sizeof(setname));
     if (selectres == SELECTLEVEL_BACK) goto GametypeSelectMenu;
     if (selectres == SELECTLEVEL_QUIT) exitflag = 1;
     if (exitflag == 0) fade2texture(renderer, window, sprites->black);
@@ -1828,10 +1864,22 @@ int main(int argc, char **argv) {
   }
 
   LoadLevelFile:
+  sok_closeset(levelset);
+  levelset = NULL;
   if ((levelfile != NULL) && (exitflag == 0)) {
-    levelscount = sok_loadfile(gameslist, MAXLEVELS, levelfile, NULL, 0, levcomment, LEVCOMMENTMAXLEN);
+    levelset = sok_openset(levelfile, NULL, 0, levcomment, LEVCOMMENTMAXLEN, &levelscount);
   } else if (exitflag == 0) {
-    levelscount = sok_loadfile(gameslist, MAXLEVELS, NULL, xsblevelptr, xsblevelptrlen, levcomment, LEVCOMMENTMAXLEN);
+    levelset = sok_openset(NULL, xsblevelptr, xsblevelptrlen, levcomment, LEVCOMMENTMAXLEN, &levelscount);
+  }
+  if (levelset != NULL) levelscount = levelset->count; /* levelscount holds the error code otherwise */
+
+  /* keep the level index up to date with the set, files being known by their path */
+  if ((levelset != NULL) && (levelfile != NULL)) {
+    char *path = levindex_pathname(levelfile);
+    if (path != NULL) sok_indexset(levelset, path);
+    free(path);
+  } else if ((levelset != NULL) && (setname[0] != 0)) {
+    sok_indexset(levelset, setname);
   }
 
   if ((levelscount < 1) && (exitflag == 0)) {
@@ -1849,7 +1897,7 @@ int main(int argc, char **argv) {
   if (exitflag == 0) exitflag = flush_events();
 
   if (exitflag == 0) {
-    curlevel = selectlevel(gameslist, sprites, renderer, window, &settings, levcomment, levelscount, curlevel, &levelfile);
+    curlevel = selectlevel(levelset, sprites, renderer, window, &settings, levcomment, curlevel, &levelfile);
     if (curlevel == SELECTLEVEL_BACK) {
       if (levelfile == NULL) {
         if (levelsource == LEVEL_INTERNET) goto LoadInternetLevels;
@@ -1864,15 +1912,20 @@ int main(int argc, char **argv) {
     }
   }
   if (exitflag == 0) fade2texture(renderer, window, sprites->black);
-  if (exitflag == 0) loadlevel(&game, gameslist[curlevel], states);
+  if (exitflag == 0) {
+    curgame = sok_getlevel(levelset, curlevel);
+    if (curgame == NULL) exitflag = 1;
+  }
+  if ((exitflag == 0) && (loadlevel(&game, curgame, states) != 0)) exitflag = 1;
 
   /* here we start the actual game */
 
   settings.tilesize = auto_tilesize(sprites);
-  if ((curlevel == 0) && (game.solution == NULL)) showhelp = 1;
+  if ((exitflag == 0) && (curlevel == 0) && (game->solution == NULL)) showhelp = 1;
   playsolution = 0;
+  selx = -1;
   drawscreenflags = 0;
-  if (exitflag == 0) lastlevelleft = islevelthelastleft(gameslist, curlevel, levelscount);
+  if (exitflag == 0) lastlevelleft = islevelthelastleft(levelset, curlevel);
 
   while (exitflag == 0) {
     if (playsolution > 0) {
@@ -1880,18 +1933,44 @@ int main(int argc, char **argv) {
     } else {
       drawscreenflags &= ~DRAWSCREEN_PLAYBACK;
     }
-    draw_screen(&game, states, sprites, renderer, window, &settings, 0, 0, 0, DRAWSCREEN_REFRESH | drawscreenflags, levcomment);
+    if (playsolution <= 0) seekpush = -1;
+    if (selx >= 0) {
+      draw_screen(game, states, sprites, renderer, window, &settings, 0, 0, 0, drawscreenflags, levcomment);
+      draw_selection(game, renderer, window, &settings, selx, sely);
+      SDL_RenderPresent(renderer);
+    } else if (seekpush >= 0) {
+      char msg[64];
+      sprintf(msg, "go to push %ld", seekpush);
+      draw_screen(game, states, sprites, renderer, window, &settings, 0, 0, 0, drawscreenflags, levcomment);
+      draw_string(msg, 100, 255, sprites, renderer, DRAWSTRING_CENTER, DRAWSTRING_CENTER, window, 1, 0);
+      SDL_RenderPresent(renderer);
+    } else {
+      draw_screen(game, states, sprites, renderer, window, &settings, 0, 0, 0, DRAWSCREEN_REFRESH | drawscreenflags, levcomment);
+    }
     if (showhelp != 0) {
       exitflag = displaytexture(renderer, sprites->help, window, -1, DISPLAYCENTERED, 255);
-      draw_screen(&game, states, sprites, renderer, window, &settings, 0, 0, 0, DRAWSCREEN_REFRESH | drawscreenflags, levcomment);
+      draw_screen(game, states, sprites, renderer, window, &settings, 0, 0, 0, DRAWSCREEN_REFRESH | drawscreenflags, levcomment);
       showhelp = 0;
     }
-    if (debugmode != 0) printf("history: %s\n", states->history);
+    if (debugmode != 0) {
+      char *history = ml_tostring(states->history);
+      if (history != NULL) printf("history: %s\n", history);
+      free(history);
+    }
 
     /* Wait for an event - but ignore 'KEYUP' and 'MOUSEMOTION' events, since they are worthless in this game */
     for (;;) {
-      if (SDL_WaitEventTimeout(&event, 80) == 0) {
-        if (playsolution == 0) continue;
+      int gotevent;
+      if ((playsolution > 0) && (autoplay != 0)) {
+        /* playback ongoing: wake up when the next move is due */
+        Sint32 due = (Sint32)(nextplayback - (Uint32)SDL_GetTicks());
+        gotevent = (due > 0) ? SDL_WaitEventTimeout(&event, due) : 0;
+      } else {
+        /* nothing animates: sleep until something happens */
+        gotevent = SDL_WaitEvent(&event);
+      }
+      if (gotevent == 0) {
+        if ((playsolution == 0) || (autoplay == 0)) continue;
         event.type = CSDL_EVENT_KEY_DOWN;
         CSDL_KEY_SYM(event.key) = SDLK_F10;
       }
@@ -1903,56 +1982,111 @@ int main(int argc, char **argv) {
     /* check what event we got */
     if (event.type == CSDL_EVENT_QUIT) {
       exitflag = 1;
+    } else if (event.type == CSDL_EVENT_RENDER_TARGETS_RESET) {
+      draw_droptextures(); /* content of render target textures got lost */
+      thumbcache_free();
+      skin_resettargets(sprites, renderer);
     } else if (event.type == CSDL_EVENT_DROP_FILE) {
       if (processDropFileEvent(&event, &levelfile) != NULL) {
         fade2texture(renderer, window, sprites->black);
         goto GametypeSelectMenu;
       }
-    } else if (event.type == CSDL_EVENT_KEY_DOWN) {
-      int res = 0;
+    } else if ((event.type == CSDL_EVENT_KEY_DOWN) || (event.type == CSDL_EVENT_MOUSE_BUTTON_DOWN)) {
+      int res = 0, solved = 0;
       enum SOKMOVE movedir = sokmoveNONE;
-      switch (normalizekeys(CSDL_KEY_SYM(event.key))) {
-        case KEY_LEFT:
-          if (playsolution == 0) movedir = sokmoveLEFT;
+      int key = KEY_UNKNOWN;
+      if (event.type == CSDL_EVENT_KEY_DOWN) {
+        key = normalizekeys(CSDL_KEY_SYM(event.key));
+        selx = -1; /* any key drops the mouse selection */
+      } else if (playsolution == 0) {
+        movedir = process_mouseclick(&event, game, states, window, &settings, &selx, &sely);
+      }
+      switch (key) {
+        case KEY_LEFT: /* during playback: back to the previous push */
+          if (playsolution == 0) {
+            movedir = sokmoveLEFT;
+          } else {
+            playback_back(game, states, &playsolution, 0, 1);
+          }
           break;
-        case KEY_RIGHT:
-          if (playsolution == 0) movedir = sokmoveRIGHT;
+        case KEY_RIGHT: /* during playback: forth to the next push */
+          if (playsolution == 0) {
+            movedir = sokmoveRIGHT;
+          } else {
+            solved = playback_forward(game, states, &playsolution, playsource, ml_count(playsource), 1);
+          }
           break;
-        case KEY_UP:
-          if (playsolution == 0) movedir = sokmoveUP;
+        case KEY_UP: /* during playback: faster */
+          if (playsolution == 0) {
+            movedir = sokmoveUP;
+          } else if (settings.playspeed < PLAYSPEED_INSTANT) {
+            settings.playspeed++;
+            nextplayback = (Uint32)SDL_GetTicks();
+          }
           break;
         case KEY_CTRL_UP:
           if (settings.tilesize < 255) settings.tilesize += 2;
           break;
-        case KEY_DOWN:
-          if (playsolution == 0) movedir = sokmoveDOWN;
+        case KEY_DOWN: /* during playback: slower */
+          if (playsolution == 0) {
+            movedir = sokmoveDOWN;
+          } else if (settings.playspeed > PLAYSPEED_1X) {
+            settings.playspeed--;
+            nextplayback = (Uint32)SDL_GetTicks();
+          }
           break;
         case KEY_CTRL_DOWN:
           if (settings.tilesize > 4) settings.tilesize -= 2;
           break;
         case KEY_BACKSPACE:
           if (autoplay == 0) {
-            sok_undo(&game, states);
+            sok_undo(game, states);
             if (playsolution > 1) playsolution--;
           } else {
             autoplay = 0;
           }
           break;
-        case KEY_R:
+        case KEY_SHIFT_BACKSPACE: /* redo */
+          if (playsolution == 0) sok_seek(game, states, sok_states_getmoves(states) + 1);
+          break;
+        case KEY_PAGEUP:
+          if (playsolution == 0) {
+            size_t moves = sok_states_getmoves(states);
+            sok_seek(game, states, (moves > SEEK_MOVES) ? moves - SEEK_MOVES : 0);
+          } else {
+            playback_back(game, states, &playsolution, SEEK_MOVES, 0);
+          }
+          break;
+        case KEY_PAGEDOWN:
+          if (playsolution == 0) {
+            sok_seek(game, states, sok_states_getmoves(states) + SEEK_MOVES);
+          } else {
+            solved = playback_forward(game, states, &playsolution, playsource, SEEK_MOVES, 0);
+          }
+          break;
+        case KEY_END: /* during playback: play all the remaining moves */
+          if (playsolution == 0) {
+            sok_seek(game, states, sok_states_getmoves(states) + sok_states_getredo(states));
+          } else {
+            solved = playback_forward(game, states, &playsolution, playsource, ml_count(playsource), 0);
+          }
+          break;
+        case KEY_HOME:
+        case KEY_R: /* restart, moves played being kept for redo */
           playsolution = 0;
-          loadlevel(&game, gameslist[curlevel], states);
+          sok_seek(game, states, 0);
           break;
         case KEY_F3: /* dump level & solution (if any) to clipboard */
-          dumplevel2clipboard(gameslist[curlevel], gameslist[curlevel]->solution);
+          dumplevel2clipboard(curgame, curgame->solution);
           exitflag = displaytexture(renderer, sprites->copiedtoclipboard, window, 2, DISPLAYCENTERED, 255);
           break;
         case KEY_CTRL_C:
-          dumplevel2clipboard(&game, states->history);
+          dumplevel2clipboard(game, states->history);
           exitflag = displaytexture(renderer, sprites->snapshottoclipboard, window, 2, DISPLAYCENTERED, 255);
           break;
         case KEY_CTRL_V:
           {
-          char *solFromClipboard;
+          char *solFromClipboard, *moves;
           solFromClipboard = SDL_GetClipboardText();
           if (debugmode) {
             printf("CTRL+V: got %lu bytes from clipboard\n", (unsigned long)strlen(solFromClipboard));
@@ -1960,31 +2094,56 @@ int main(int argc, char **argv) {
           }
           trimstr(solFromClipboard);
           if (isLegalSokoSolution(solFromClipboard) != 0) {
-            loadlevel(&game, gameslist[curlevel], states);
+            loadlevel(&game, curgame, states);
             exitflag = displaytexture(renderer, sprites->playfromclipboard, window, 2, DISPLAYCENTERED, 255);
             playsolution = 1;
             autoplay = 1;
-            if (playsource != NULL) free(playsource);
-            playsource = unRLE(solFromClipboard);
+            nextplayback = (Uint32)SDL_GetTicks();
+            moves = unRLE(solFromClipboard);
+            ml_free(playsource);
+            playsource = (moves != NULL) ? ml_fromstring(moves) : NULL;
+            free(moves);
+            if (playsource == NULL) playsolution = 0;
           }
           if (solFromClipboard != NULL) free(solFromClipboard);
           }
           break;
         case KEY_S:
           if (playsolution == 0) {
-            if (game.solution != NULL) { /* only allow if there actually is a solution */
-              if (playsource != NULL) free(playsource);
-              playsource = unRLE(game.solution); /* I duplicate the solution string, because I want to free it later, since it can originate both from the game's solution as well as from a clipboard string */
+            if (game->solution != NULL) { /* only allow if there actually is a solution */
+              ml_free(playsource);
+              playsource = ml_dup(game->solution); /* I duplicate the solution, because I want to free it later, since it can originate both from the game's solution as well as from a clipboard string */
               if (playsource != NULL) {
-                loadlevel(&game, gameslist[curlevel], states);
+                loadlevel(&game, curgame, states);
                 playsolution = 1;
                 autoplay = 1;
+                nextplayback = (Uint32)SDL_GetTicks();
               }
-            } else {
-              exitflag = displaytexture(renderer, sprites->nosolution, window, 1, DISPLAYCENTERED, 255);
+            } else { /* no known solution, try to compute one */
+              struct soksolver_params params;
+              char *computed;
+              int solres;
+              getsolverparams(&params, &settings, SOLVER_GUI_MAXTIME, SOLVER_GUI_MAXMEM);
+              solres = solvelevel(curgame, &params, &computed, &exitflag, game, states, sprites, renderer, window, &settings, drawscreenflags, levcomment);
+              if (solres == soksolver_solved) {
+                ml_free(playsource);
+                playsource = ml_fromstring(computed);
+                free(computed);
+                if (playsource != NULL) {
+                  loadlevel(&game, curgame, states);
+                  playsolution = 1;
+                  autoplay = 1;
+                  nextplayback = (Uint32)SDL_GetTicks();
+                }
+              } else if ((solres != soksolver_cancelled) && (exitflag == 0)) {
+                exitflag = displaytexture(renderer, sprites->nosolution, window, 1, DISPLAYCENTERED, 255);
+              }
+              /* drop whatever the user pressed while the solver was busy */
+              if (exitflag == 0) exitflag = flush_events();
             }
           } else {
             autoplay = 1;
+            nextplayback = (Uint32)SDL_GetTicks();
           }
           break;
         case KEY_F1:
@@ -2005,21 +2164,21 @@ int main(int argc, char **argv) {
         case KEY_F5:
           if (playsolution == 0) {
             exitflag = displaytexture(renderer, sprites->saved, window, 1, DISPLAYCENTERED, 255);
-            solution_save(game.crc64, states->history, "sav");
+            solution_save(game->crc64, states->history, "sav");
           }
           break;
         case KEY_F7:
           {
-          char *loadsol;
-          loadsol = solution_load(game.crc64, "sav");
+          struct sokmovelist *loadsol;
+          loadsol = solution_load(game->crc64, "sav");
           if (loadsol == NULL) {
             exitflag = displaytexture(renderer, sprites->nosave, window, 1, DISPLAYCENTERED, 255);
           } else {
             exitflag = displaytexture(renderer, sprites->loaded, window, 1, DISPLAYCENTERED, 255);
             playsolution = 0;
-            loadlevel(&game, gameslist[curlevel], states);
-            sok_play(&game, states, loadsol);
-            free(loadsol);
+            loadlevel(&game, curgame, states);
+            sok_play(game, states, loadsol);
+            ml_free(loadsol);
           }
           }
           break;
@@ -2027,23 +2186,48 @@ int main(int argc, char **argv) {
           switchfullscreen(window);
           break;
         case KEY_ESCAPE:
+          if (seekpush >= 0) break; /* only drops the push being typed */
           fade2texture(renderer, window, sprites->black);
           goto LevelSelectMenu;
+        case KEY_ENTER: /* during playback: jump to the push typed */
+          if (seekpush >= 0) solved = playback_topush(game, states, &playsolution, playsource, seekpush);
+          break;
+        default: /* during playback: digits type a push to jump to */
+          if ((playsolution > 0) && (key >= KEY_0) && (key <= KEY_9)) {
+            if (seekpush < 0) seekpush = 0;
+            if (seekpush < 100000) seekpush = seekpush * 10 + (key - KEY_0);
+          }
+          break;
       }
+      /* anything but a digit ends the typing (autoplay ticks aside) */
+      if ((key != KEY_F10) && ((key < KEY_0) || (key > KEY_9))) seekpush = -1;
 
       /* if playback is ongoing then process it now (and overwrite movedir) */
-      if ((playsolution > 0) && (autoplay != 0)) {
-        SDL_Delay(300); /* make sure autoplay does not run too fast */
-        process_autoplayback(&movedir, &playsolution, playsource);
+      if ((playsolution > 0) && (autoplay != 0) && (solved == 0) && ((Sint32)((Uint32)SDL_GetTicks() - nextplayback) >= 0)) {
+        Uint32 now = (Uint32)SDL_GetTicks();
+        unsigned short pace = playspeed_ms[settings.playspeed];
+        if (settings.playspeed == PLAYSPEED_1X) {
+          nextplayback = now + pace; /* make sure autoplay does not run too fast */
+          process_autoplayback(&movedir, &playsolution, playsource);
+        } else if (pace == 0) {
+          solved = playback_forward(game, states, &playsolution, playsource, ml_count(playsource), 0);
+        } else {
+          /* not animated: play all the moves due since the last frame, so
+           * the pace holds however long frames take to draw */
+          size_t due = 1 + (now - nextplayback) / pace;
+          nextplayback += (Uint32)(due * pace);
+          solved = playback_forward(game, states, &playsolution, playsource, due, 0);
+        }
       }
 
       if (movedir != sokmoveNONE) {
-        if (sprites->flags & SPRITES_FLAG_PLAYERROTATE) rotatePlayer(sprites, &game, states, movedir, renderer, window, &settings, levcomment, drawscreenflags);
-        res = sok_move(&game, movedir, 1, states);
+        if (sprites->flags & SPRITES_FLAG_PLAYERROTATE) rotatePlayer(sprites, game, states, movedir, renderer, window, &settings, levcomment, drawscreenflags);
+        res = sok_move(game, movedir, 1, states);
 
         /* do animations (unless movspeed is set to instant speed or skin is primitive) */
         if ((res >= 0) && (settings.movspeed < 100) && ((sprites->flags & SPRITES_FLAG_PRIMITIVE) == 0)) {
-          int offset, vectorx = 0, vectory = 0, scrollflag, step;
+          int offset, vectorx = 0, vectory = 0, scrollflag;
+          struct frameclock clk;
           if (res & sokmove_pushed) drawscreenflags |= DRAWSCREEN_PUSH;
 
           /* How do I need to move? */
@@ -2052,58 +2236,57 @@ int main(int argc, char **argv) {
           if (movedir == sokmoveDOWN) vectory = 1;
           if (movedir == sokmoveLEFT) vectorx = -1;
 
-          /* what's my per-screen-refresh step? */
-          step = (settings.tilesize * settings.movspeed) / 100;
-          if (step == 0) step = 1;
-
           /* Do I need to move the player, or the entire field? */
-          scrollflag = scrollneeded(&game, window, settings.tilesize, vectorx, vectory);
-
-          /* moving */
-          for (offset = 0; offset < settings.tilesize; offset += step) {
-            draw_screen(&game, states, sprites, renderer, window, &settings, offset * vectorx, offset * vectory, scrollflag, DRAWSCREEN_REFRESH | drawscreenflags, levcomment);
+          scrollflag = scrollneeded(game, window, settings.tilesize, vectorx, vectory);
 
-            /* wait for screen refresh time */
-            while (sok_isitrefreshtime() == 0) SDL_Delay(1);
+          /* moving, by movspeed% of a tile per FRAME_REFMS */
+          frame_start(&clk);
+          for (offset = 0; offset < settings.tilesize;) {
+            draw_screen(game, states, sprites, renderer, window, &settings, offset * vectorx, offset * vectory, scrollflag, DRAWSCREEN_REFRESH | drawscreenflags, levcomment);
+            offset = (int)(frame_wait(&clk) * settings.tilesize * (unsigned long)settings.movspeed / (100 * FRAME_REFMS));
           }
         }
 
-        res = sok_move(&game, movedir, 0, states);
-        if ((res >= 0) && (res & sokmove_solved)) {
-          unsigned short alphaval;
-          SDL_Texture *tmptex;
-          /* display a congrats message */
+        res = sok_move(game, movedir, 0, states);
+        if ((res >= 0) && (res & sokmove_solved)) solved = 1;
+      }
+
+      if (solved != 0) {
+        unsigned long elapsed = 0;
+        struct frameclock clk;
+        SDL_Texture *tmptex;
+        /* display a congrats message */
+        if (lastlevelleft != 0) {
+          tmptex = sprites->congrats;
+        } else {
+          tmptex = sprites->cleared;
+        }
+        flush_events();
+        frame_start(&clk);
+        while (elapsed < CONGRATS_FADEMS) {
+          draw_screen(game, states, sprites, renderer, window, &settings, 0, 0, 0, drawscreenflags, levcomment);
+          exitflag = displaytexture(renderer, tmptex, window, 0, DISPLAYCENTERED, (unsigned char)(elapsed * 255 / CONGRATS_FADEMS));
+          if (exitflag != 0) break;
+          elapsed = frame_wait(&clk);
+        }
+        if (exitflag == 0) {
+          draw_screen(game, states, sprites, renderer, window, &settings, 0, 0, 0, drawscreenflags, levcomment);
+          /* if this was the last level left, display a congrats screen */
           if (lastlevelleft != 0) {
-            tmptex = sprites->congrats;
+            exitflag = displaytexture(renderer, sprites->congrats, window, 10, DISPLAYCENTERED, 255);
           } else {
-            tmptex = sprites->cleared;
-          }
-          flush_events();
-          for (alphaval = 0; alphaval < 255; alphaval += 30) {
-            draw_screen(&game, states, sprites, renderer, window, &settings, 0, 0, 0, drawscreenflags, levcomment);
-            exitflag = displaytexture(renderer, tmptex, window, 0, DISPLAYCENTERED, (unsigned char)alphaval);
-            SDL_Delay(25);
-            if (exitflag != 0) break;
+            exitflag = displaytexture(renderer, sprites->cleared, window, 3, DISPLAYCENTERED, 255);
           }
+          /* fade out to black */
           if (exitflag == 0) {
-            draw_screen(&game, states, sprites, renderer, window, &settings, 0, 0, 0, drawscreenflags, levcomment);
-            /* if this was the last level left, display a congrats screen */
-            if (lastlevelleft != 0) {
-              exitflag = displaytexture(renderer, sprites->congrats, window, 10, DISPLAYCENTERED, 255);
-            } else {
-              exitflag = displaytexture(renderer, sprites->cleared, window, 3, DISPLAYCENTERED, 255);
-            }
-            /* fade out to black */
-            if (exitflag == 0) {
-              fade2texture(renderer, window, sprites->black);
-              exitflag = flush_events();
-            }
+            fade2texture(renderer, window, sprites->black);
+            exitflag = flush_events();
           }
-          /* load the new level and reset states */
-          curlevel++; /* select next level */
-          if (curlevel >= levelscount) curlevel = -1; /* if no more levels available then let selectlevel() choose either the first unsolved one, or level 0 */
-          goto LevelSelectMenu;
         }
+        /* load the new level and reset states */
+        curlevel++; /* select next level */
+        if (curlevel >= levelscount) curlevel = -1; /* if no more levels available then let selectlevel() choose either the first unsolved one, or level 0 */
+        goto LevelSelectMenu;
       }
       drawscreenflags &= ~DRAWSCREEN_PUSH;
     }
@@ -2111,15 +2294,23 @@ int main(int argc, char **argv) {
     if (exitflag != 0) break;
   }
 
-  /* free the states struct */
+  /* free the states struct, the played game and the level set */
   sok_freestates(states);
+  free(game);
+  sok_closeset(levelset);
 
   if (levelfile != NULL) free(levelfile);
 
   /* free all textures */
+  draw_free();
+  thumbcache_free();
   skin_free(sprites);
 
-  /* clean up SDL */
+  /* no cancelled fetch may outlive the network layer, nor SDL */
+  netcache_shutdown();
+
+  /* clean up SDL, once all saved data is on disk */
+  save_flush();
   flush_events();
   SDL_DestroyWindow(window);
   SDL_Quit();
@@ -2127,5 +2318,8 @@ int main(int argc, char **argv) {
   /* Clean-up networking. */
   cleanup_net();
 
+  /* write out measurements, if any */
+  perf_shutdown();
+
   return(0);
 }
@@ -44,6 +44,9 @@
 #define PKGDATADIR "/usr/share/simplesok"
 #endif
 
+/* width of the font atlas, glyphs being packed on as many rows as needed */
+#define FONTATLAS_WIDTH 512
+
 
 /* loads a bmp.gz graphic and returns it as a texture, NULL on error */
 static SDL_Texture *loadGraphic(SDL_Renderer *renderer, const void *memptr, size_t memlen) {
@@ -61,6 +64,18 @@ static SDL_Texture *loadGraphic(SDL_Renderer *renderer, const void *memptr, size
 }
 
 
+/* loads a bmp.gz (or png) graphic and returns it as a RGBA8888 surface, NULL on error */
+static SDL_Surface *loadSurface(const void *memptr, size_t memlen) {
+  SDL_Surface *surface;
+
+  surface = loadgzsurface(memptr, memlen);
+
+  if (surface == NULL) printf("failed to load image: %s\n", SDL_GetError());
+
+  return(surface);
+}
+
+
 /* looks out for a skin file and opens it, if found */
 static FILE *skin_lookup(const char *name) {
   FILE *fd = NULL;
@@ -190,79 +205,59 @@ struct skinlist *skin_list(void) {
 }
 
 
-/* analyzes a texture and returs:
+/* returns the pixel at (x,y) of a RGBA8888 surface, pixels outside of the
+ * surface being transparent */
+static uint32_t getpixel(const SDL_Surface *s, int x, int y) {
+  if ((x < 0) || (y < 0) || (x >= s->w) || (y >= s->h)) return(0);
+  return(((const uint32_t *)((const unsigned char *)s->pixels + y * s->pitch))[x]);
+}
+
+
+/* copies the w*h area at (sx,sy) of src into the atlas cell at (dx,dy) of
+ * dst, the edges of the area being repeated over the cell's gutter. both
+ * surfaces are RGBA8888. */
+static void atlas_put(SDL_Surface *dst, int dx, int dy, const SDL_Surface *src, int sx, int sy, int w, int h) {
+  uint32_t *row;
+  int x, y, cx, cy;
+
+  for (y = -1; y <= h; y++) {
+    cy = y;
+    if (cy < 0) cy = 0;
+    if (cy >= h) cy = h - 1;
+    row = (uint32_t *)((unsigned char *)dst->pixels + (dy + 1 + y) * dst->pitch) + dx + 1;
+    for (x = -1; x <= w; x++) {
+      cx = x;
+      if (cx < 0) cx = 0;
+      if (cx >= w) cx = w - 1;
+      row[x] = getpixel(src, sx + cx, sy + cy);
+    }
+  }
+}
+
+
+/* analyzes an area of a RGBA8888 surface and returns:
  * 0 if no pixels are found
  * 1 if only transparent pixels were found
  * 2 if only non-transparent pixels were found
  * 3 if both transparent and non-transparent pixels were found */
-static int texture_check_transparency(SDL_Texture *tex, SDL_Renderer *renderer)  {
-  uint32_t *pixels;
-  SDL_Texture *workscreen;
-  int texw, texh;
-  int i;
+static int surface_check_transparency(const SDL_Surface *s, const SDL_Rect *r) {
+  int x, y;
   int verdict = 0;
-  SDL_Rect r;
-
-  if (tex == NULL) return(0);
-
-  CSDL_QueryTexture(tex, NULL, NULL, &texw, &texh);
-
-  workscreen = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, texw, texh);
-
-  if (workscreen == NULL) printf("%d: Ooops! %s\n", __LINE__, SDL_GetError());
-
-  SDL_SetTextureBlendMode(workscreen, SDL_BLENDMODE_BLEND); /* enable transparency support for this texture */
 
-  /* fill the renderer with all-transparent pixels and blit tex to it */
-  SDL_SetRenderTarget(renderer, workscreen);
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); /* fill texture with transparency */
-  SDL_RenderClear(renderer);
-  CSDL_RenderTexture(renderer, tex, NULL, NULL);
-
-  pixels = calloc(4, texw * texh);
-  r.x = 0;
-  r.y = 0;
-  r.w = texw;
-  r.h = texh;
-
-  if (CSDL_RenderReadPixels(renderer, &r, SDL_PIXELFORMAT_RGBA8888, pixels, texw * 4) != 0) {
-    printf("OOOPS: %s\n", SDL_GetError());
-  }
-  for (i = 0; i < texw * texh; i++) {
-    if (pixels[i] & 0xff) { /* alpha channel is in lowest 8 bits (RGBA8888) */
-      verdict |= 2;
-    } else {
-      verdict |= 1;
+  for (y = r->y; y < r->y + r->h; y++) {
+    for (x = r->x; x < r->x + r->w; x++) {
+      if (getpixel(s, x, y) & 0xff) { /* alpha channel is in lowest 8 bits (RGBA8888) */
+        verdict |= 2;
+      } else {
+        verdict |= 1;
+      }
     }
   }
 
-  free(pixels);
-
-  /* reset the renderer (detach any texture) so I can draw to screen again */
-  SDL_SetRenderTarget(renderer, NULL);
-
   return(verdict);
 }
 
 
-/* extracts a tile from a tilemap at coordinates pointed by rect r and return it as a texture */
-static SDL_Texture *copy_tile_from_map(SDL_Renderer *renderer, SDL_Texture *map, const SDL_Rect *r) {
-  SDL_Texture *tile;
-
-  tile = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, r->w, r->h);
-  SDL_SetTextureBlendMode(tile, SDL_BLENDMODE_BLEND); /* enable transparency support for this texture */
-
-  /* cut the sprite out of the map and copy it into an isolated texture so it can be used later and rescaled without the risk of any texture bleed */
-  SDL_SetRenderTarget(renderer, tile);
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); /* fill texture with transparency */
-  SDL_RenderClear(renderer);
-  CSDL_RenderTexture(renderer, map, r, NULL);
-  SDL_SetRenderTarget(renderer, NULL); /* reset the renderer (detach any texture) so I can draw to screen again */
-
-  return(tile);
-}
-
-
 /* fills rect with coordinates of tile id withing sprite map */
 static void locate_sprite(SDL_Rect *r, unsigned short id, unsigned short tilesize) {
   r->x = (id % 4) * tilesize;
@@ -272,31 +267,111 @@ static void locate_sprite(SDL_Rect *r, unsigned short id, unsigned short tilesiz
 }
 
 
-/* translates a simplesok-format tilemap into sprites */
-static void load_spritemap(struct spritesstruct *sprites, SDL_Texture *map, SDL_Renderer *renderer) {
-  int i;
+/* translates a simplesok-format tilemap into a single atlas texture, with
+ * each tile padded so it can be rescaled without the risk of any texture
+ * bleed. returns 0 on success, non-zero otherwise. */
+static int load_spritemap(struct spritesstruct *sprites, const SDL_Surface *map, SDL_Renderer *renderer) {
+  SDL_Surface *atlas;
+  int i, cell = ATLAS_CELL(sprites->tilesize);
   SDL_Rect r;
 
+  atlas = CSDL_CreateSurface(4 * cell, 8 * cell, SDL_PIXELFORMAT_RGBA8888);
+  if (atlas == NULL) {
+    printf("failed to create the sprite atlas: %s\n", SDL_GetError());
+    return(-1);
+  }
+
   /* explode the map into tiles */
   for (i = 0; i < 4*8; i++) {
     locate_sprite(&r, i, sprites->tilesize);
-    sprites->map[i] = copy_tile_from_map(renderer, map, &r);
+    atlas_put(atlas, (i % 4) * cell, (i / 4) * cell, map, r.x, r.y, r.w, r.h);
+    sprites->tile[i].x = (i % 4) * cell + 1;
+    sprites->tile[i].y = (i / 4) * cell + 1;
+    sprites->tile[i].w = sprites->tilesize;
+    sprites->tile[i].h = sprites->tilesize;
   }
 
   /* check the WALL_PLAIN tile - some skins have this transparent, in such
    * case rewire it to WALL_CORNER for a best effort rendering */
-  if (texture_check_transparency(sprites->map[SPRITE_WALL_PLAIN], renderer) < 2) {
-    if (sprites->map[SPRITE_WALL_PLAIN]) SDL_DestroyTexture(sprites->map[SPRITE_WALL_PLAIN]);
-    locate_sprite(&r, SPRITE_WALL_CORNER, sprites->tilesize);
-    sprites->map[SPRITE_WALL_PLAIN] = copy_tile_from_map(renderer, map, &r);
+  if (surface_check_transparency(atlas, &(sprites->tile[SPRITE_WALL_PLAIN])) < 2) {
+    sprites->tile[SPRITE_WALL_PLAIN] = sprites->tile[SPRITE_WALL_CORNER];
   }
+
+  /* analyze the "player right" position - if completely transparent, then
+   * player character is rotatable */
+  if (surface_check_transparency(atlas, &(sprites->tile[SPRITE_PLAYERRIGHT])) < 2) {
+    sprites->flags |= SPRITES_FLAG_PLAYERROTATE;
+  }
+
+  /* analyze the player's sprite - if it has no transparent pixels, then flag the sprite map as "primitive" to hint simplesok that animations may be unadvisable */
+  if (surface_check_transparency(atlas, &(sprites->tile[SPRITE_PLAYERUP])) == 2) {
+    sprites->flags |= SPRITES_FLAG_PRIMITIVE;
+  }
+
+  sprites->atlas = SDL_CreateTextureFromSurface(renderer, atlas);
+  CSDL_DestroySurface(atlas);
+  if (sprites->atlas == NULL) {
+    printf("SDL_CreateTextureFromSurface() failed: %s\n", SDL_GetError());
+    return(-1);
+  }
+  SDL_SetTextureBlendMode(sprites->atlas, SDL_BLENDMODE_BLEND); /* enable transparency support for this texture */
+  return(0);
+}
+
+
+/* packs all glyphs into a single atlas texture, row after row. glyphs that
+ * are missing are rendered with the '_' glyph. returns 0 on success. */
+static int load_fontatlas(struct spritesstruct *sprites, SDL_Surface **glyphs, SDL_Renderer *renderer) {
+  SDL_Surface *atlas;
+  int i, x = 0, y = 0, rowh = 0;
+
+  /* place glyphs */
+  for (i = 0; i < 256; i++) {
+    if (glyphs[i] == NULL) continue;
+    if ((x > 0) && (x + ATLAS_CELL(glyphs[i]->w) > FONTATLAS_WIDTH)) {
+      x = 0;
+      y += rowh;
+      rowh = 0;
+    }
+    sprites->glyph[i].x = x + 1;
+    sprites->glyph[i].y = y + 1;
+    sprites->glyph[i].w = glyphs[i]->w;
+    sprites->glyph[i].h = glyphs[i]->h;
+    x += ATLAS_CELL(glyphs[i]->w);
+    if (ATLAS_CELL(glyphs[i]->h) > rowh) rowh = ATLAS_CELL(glyphs[i]->h);
+  }
+  if (rowh == 0) return(-1);
+
+  atlas = CSDL_CreateSurface(FONTATLAS_WIDTH, y + rowh, SDL_PIXELFORMAT_RGBA8888);
+  if (atlas == NULL) {
+    printf("failed to create the font atlas: %s\n", SDL_GetError());
+    return(-1);
+  }
+  for (i = 0; i < 256; i++) {
+    if (glyphs[i] == NULL) continue;
+    atlas_put(atlas, sprites->glyph[i].x - 1, sprites->glyph[i].y - 1, glyphs[i], 0, 0, glyphs[i]->w, glyphs[i]->h);
+  }
+
+  /* set all missing glyphs to '_' */
+  for (i = 0; i < 256; i++) {
+    if (glyphs[i] == NULL) sprites->glyph[i] = sprites->glyph['_'];
+  }
+
+  sprites->fontatlas = SDL_CreateTextureFromSurface(renderer, atlas);
+  CSDL_DestroySurface(atlas);
+  if (sprites->fontatlas == NULL) {
+    printf("SDL_CreateTextureFromSurface() failed: %s\n", SDL_GetError());
+    return(-1);
+  }
+  SDL_SetTextureBlendMode(sprites->fontatlas, SDL_BLENDMODE_BLEND);
+  return(0);
 }
 
 
 /* try to load a skin named "name" */
-static SDL_Texture *loadmap(const char *name, SDL_Renderer *renderer) {
+static SDL_Surface *loadmap(const char *name) {
   FILE *fd;
-  SDL_Texture *map = NULL;
+  SDL_Surface *map = NULL;
 
   /* look out for a skin file */
   if ((name != NULL) && ((fd = skin_lookup(name)) != NULL)) {
@@ -317,21 +392,66 @@ static SDL_Texture *loadmap(const char *name, SDL_Renderer *renderer) {
       fprintf(stderr, "warning: unexpectedly short skin (%s, expected len=%ld)\n", name, (long int)skinlen);
     }
     fclose(fd);
-    map = loadGraphic(renderer, memptr, skinlen);
+    map = loadSurface(memptr, skinlen);
     free(memptr);
   } else { /* otherwise load the embedded skin */
-    fprintf(stderr, "skin load failed ('%s'), falling back to embedded default\n", name);
-    map = loadGraphic(renderer, skins_yoshi_png, skins_yoshi_png_len);
+    if (name != NULL) fprintf(stderr, "skin load failed ('%s'), falling back to embedded default\n", name);
+    map = loadSurface(skins_yoshi_png, skins_yoshi_png_len);
   }
 
   return(map);
 }
 
 
+/* pre-composes the 256 possible wall tiles into a single atlas texture, so
+ * any wall can be drawn with one copy instead of 4 quarters. returns NULL
+ * if the renderer cannot provide such a texture. */
+static SDL_Texture *build_wallatlas(const struct spritesstruct *sprites, SDL_Renderer *renderer) {
+  SDL_Texture *atlas;
+  unsigned short wallid[4];
+  int cell = WALLATLAS_CELL(sprites->tilesize);
+  int half = sprites->tilesize / 2;
+  int i, q, x, y;
+
+  atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, cell * 16, cell * 16);
+  if (atlas == NULL) {
+    printf("wall atlas not available, walls will be drawn by quarters: %s\n", SDL_GetError());
+    return(NULL);
+  }
+  SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND); /* enable transparency support for this texture */
+
+  /* wall sprites are copied as-is, alpha channel included */
+  SDL_SetTextureBlendMode(sprites->atlas, SDL_BLENDMODE_NONE);
+
+  SDL_SetRenderTarget(renderer, atlas);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); /* fill texture with transparency */
+  SDL_RenderClear(renderer);
+  for (i = 0; i < 256; i++) {
+    x = (i % 16) * cell;
+    y = (i / 16) * cell;
+    gra_wallquarters((unsigned char)i, wallid);
+    /* the variant stretched over the whole cell makes the gutter, then the
+     * variant itself is drawn over it at its natural size */
+    for (q = 0; q < 4; q++) {
+      gra_rendertilequarter(renderer, sprites, wallid[q], x + (q & 1) * (cell / 2), y + (q >> 1) * (cell / 2), cell / 2, q);
+    }
+    for (q = 0; q < 4; q++) {
+      gra_rendertilequarter(renderer, sprites, wallid[q], x + 1 + (q & 1) * half, y + 1 + (q >> 1) * half, half, q);
+    }
+  }
+  SDL_SetRenderTarget(renderer, NULL); /* reset the renderer (detach any texture) so I can draw to screen again */
+
+  SDL_SetTextureBlendMode(sprites->atlas, SDL_BLENDMODE_BLEND);
+
+  return(atlas);
+}
+
+
 struct spritesstruct *skin_load(const char *name, SDL_Renderer *renderer) {
   struct spritesstruct *sprites;
-  SDL_Texture *map;
-  int i;
+  SDL_Surface *map;
+  SDL_Surface *glyphs[256];
+  int i, res;
 
   sprites = calloc(1, sizeof(struct spritesstruct));
   if (sprites == NULL) {
@@ -340,15 +460,14 @@ struct spritesstruct *skin_load(const char *name, SDL_Renderer *renderer) {
   }
 
   /* load the tilemap */
-  map = loadmap(name, renderer);
+  map = loadmap(name);
   if (map == NULL) return(NULL);
 
   /* figure out how big the tiles of this skin are */
   {
-    int gwidth, gheight;
-    CSDL_QueryTexture(map, NULL, NULL, &gwidth, &gheight);
+    int gwidth = map->w, gheight = map->h;
     if ((gwidth == 0) || (gheight == 0)) {
-      SDL_DestroyTexture(map);
+      CSDL_DestroySurface(map);
       return(NULL);
     }
 
@@ -380,10 +499,17 @@ struct spritesstruct *skin_load(const char *name, SDL_Renderer *renderer) {
   }
 
   /* explode the map into tiles (and free the big-ass map afterwards) */
-  load_spritemap(sprites, map, renderer);
+  res = load_spritemap(sprites, map, renderer);
 
-  SDL_DestroyTexture(map);
+  CSDL_DestroySurface(map);
   map = NULL;
+  if (res != 0) {
+    skin_free(sprites);
+    return(NULL);
+  }
+
+  /* walls come in 256 variants, depending on their neighbours */
+  sprites->wallatlas = build_wallatlas(sprites, renderer);
 
   /* playfield items */
   sprites->black = loadGraphic(renderer, assets_img_black_bmp_gz, assets_img_black_bmp_gz_len);
@@ -402,119 +528,110 @@ struct spritesstruct *skin_load(const char *name, SDL_Renderer *renderer) {
   sprites->nosave = loadGraphic(renderer, assets_img_nosave_bmp_gz, assets_img_nosave_bmp_gz_len);
 
   /* load font */
-  sprites->font['0'] = loadGraphic(renderer, assets_font_0_bmp_gz, assets_font_0_bmp_gz_len);
-  sprites->font['1'] = loadGraphic(renderer, assets_font_1_bmp_gz, assets_font_1_bmp_gz_len);
-  sprites->font['2'] = loadGraphic(renderer, assets_font_2_bmp_gz, assets_font_2_bmp_gz_len);
-  sprites->font['3'] = loadGraphic(renderer, assets_font_3_bmp_gz, assets_font_3_bmp_gz_len);
-  sprites->font['4'] = loadGraphic(renderer, assets_font_4_bmp_gz, assets_font_4_bmp_gz_len);
-  sprites->font['5'] = loadGraphic(renderer, assets_font_5_bmp_gz, assets_font_5_bmp_gz_len);
-  sprites->font['6'] = loadGraphic(renderer, assets_font_6_bmp_gz, assets_font_6_bmp_gz_len);
-  sprites->font['7'] = loadGraphic(renderer, assets_font_7_bmp_gz, assets_font_7_bmp_gz_len);
-  sprites->font['8'] = loadGraphic(renderer, assets_font_8_bmp_gz, assets_font_8_bmp_gz_len);
-  sprites->font['9'] = loadGraphic(renderer, assets_font_9_bmp_gz, assets_font_9_bmp_gz_len);
-  sprites->font['a'] = loadGraphic(renderer, assets_font_a_bmp_gz, assets_font_a_bmp_gz_len);
-  sprites->font['b'] = loadGraphic(renderer, assets_font_b_bmp_gz, assets_font_b_bmp_gz_len);
-  sprites->font['c'] = loadGraphic(renderer, assets_font_c_bmp_gz, assets_font_c_bmp_gz_len);
-  sprites->font['d'] = loadGraphic(renderer, assets_font_d_bmp_gz, assets_font_d_bmp_gz_len);
-  sprites->font['e'] = loadGraphic(renderer, assets_font_e_bmp_gz, assets_font_e_bmp_gz_len);
-  sprites->font['f'] = loadGraphic(renderer, assets_font_f_bmp_gz, assets_font_f_bmp_gz_len);
-  sprites->font['g'] = loadGraphic(renderer, assets_font_g_bmp_gz, assets_font_g_bmp_gz_len);
-  sprites->font['h'] = loadGraphic(renderer, assets_font_h_bmp_gz, assets_font_h_bmp_gz_len);
-  sprites->font['i'] = loadGraphic(renderer, assets_font_i_bmp_gz, assets_font_i_bmp_gz_len);
-  sprites->font['j'] = loadGraphic(renderer, assets_font_j_bmp_gz, assets_font_j_bmp_gz_len);
-  sprites->font['k'] = loadGraphic(renderer, assets_font_k_bmp_gz, assets_font_k_bmp_gz_len);
-  sprites->font['l'] = loadGraphic(renderer, assets_font_l_bmp_gz, assets_font_l_bmp_gz_len);
-  sprites->font['m'] = loadGraphic(renderer, assets_font_m_bmp_gz, assets_font_m_bmp_gz_len);
-  sprites->font['n'] = loadGraphic(renderer, assets_font_n_bmp_gz, assets_font_n_bmp_gz_len);
-  sprites->font['o'] = loadGraphic(renderer, assets_font_o_bmp_gz, assets_font_o_bmp_gz_len);
-  sprites->font['p'] = loadGraphic(renderer, assets_font_p_bmp_gz, assets_font_p_bmp_gz_len);
-  sprites->font['q'] = loadGraphic(renderer, assets_font_q_bmp_gz, assets_font_q_bmp_gz_len);
-  sprites->font['r'] = loadGraphic(renderer, assets_font_r_bmp_gz, assets_font_r_bmp_gz_len);
-  sprites->font['s'] = loadGraphic(renderer, assets_font_s_bmp_gz, assets_font_s_bmp_gz_len);
-  sprites->font['t'] = loadGraphic(renderer, assets_font_t_bmp_gz, assets_font_t_bmp_gz_len);
-  sprites->font['u'] = loadGraphic(renderer, assets_font_u_bmp_gz, assets_font_u_bmp_gz_len);
-  sprites->font['v'] = loadGraphic(renderer, assets_font_v_bmp_gz, assets_font_v_bmp_gz_len);
-  sprites->font['w'] = loadGraphic(renderer, assets_font_w_bmp_gz, assets_font_w_bmp_gz_len);
-  sprites->font['x'] = loadGraphic(renderer, assets_font_x_bmp_gz, assets_font_x_bmp_gz_len);
-  sprites->font['y'] = loadGraphic(renderer, assets_font_y_bmp_gz, assets_font_y_bmp_gz_len);
-  sprites->font['z'] = loadGraphic(renderer, assets_font_z_bmp_gz, assets_font_z_bmp_gz_len);
-  sprites->font['A'] = loadGraphic(renderer, assets_font_aa_bmp_gz, assets_font_aa_bmp_gz_len);
-  sprites->font['B'] = loadGraphic(renderer, assets_font_bb_bmp_gz, assets_font_bb_bmp_gz_len);
-  sprites->font['C'] = loadGraphic(renderer, assets_font_cc_bmp_gz, assets_font_cc_bmp_gz_len);
-  sprites->font['D'] = loadGraphic(renderer, assets_font_dd_bmp_gz, assets_font_dd_bmp_gz_len);
-  sprites->font['E'] = loadGraphic(renderer, assets_font_ee_bmp_gz, assets_font_ee_bmp_gz_len);
-  sprites->font['F'] = loadGraphic(renderer, assets_font_ff_bmp_gz, assets_font_ff_bmp_gz_len);
-  sprites->font['G'] = loadGraphic(renderer, assets_font_gg_bmp_gz, assets_font_gg_bmp_gz_len);
-  sprites->font['H'] = loadGraphic(renderer, assets_font_hh_bmp_gz, assets_font_hh_bmp_gz_len);
-  sprites->font['I'] = loadGraphic(renderer, assets_font_ii_bmp_gz, assets_font_ii_bmp_gz_len);
-  sprites->font['J'] = loadGraphic(renderer, assets_font_jj_bmp_gz, assets_font_jj_bmp_gz_len);
-  sprites->font['K'] = loadGraphic(renderer, assets_font_kk_bmp_gz, assets_font_kk_bmp_gz_len);
-  sprites->font['L'] = loadGraphic(renderer, assets_font_ll_bmp_gz, assets_font_ll_bmp_gz_len);
-  sprites->font['M'] = loadGraphic(renderer, assets_font_mm_bmp_gz, assets_font_mm_bmp_gz_len);
-  sprites->font['N'] = loadGraphic(renderer, assets_font_nn_bmp_gz, assets_font_nn_bmp_gz_len);
-  sprites->font['O'] = loadGraphic(renderer, assets_font_oo_bmp_gz, assets_font_oo_bmp_gz_len);
-  sprites->font['P'] = loadGraphic(renderer, assets_font_pp_bmp_gz, assets_font_pp_bmp_gz_len);
-  sprites->font['Q'] = loadGraphic(renderer, assets_font_qq_bmp_gz, assets_font_qq_bmp_gz_len);
-  sprites->font['R'] = loadGraphic(renderer, assets_font_rr_bmp_gz, assets_font_rr_bmp_gz_len);
-  sprites->font['S'] = loadGraphic(renderer, assets_font_ss_bmp_gz, assets_font_ss_bmp_gz_len);
-  sprites->font['T'] = loadGraphic(renderer, assets_font_tt_bmp_gz, assets_font_tt_bmp_gz_len);
-  sprites->font['U'] = loadGraphic(renderer, assets_font_uu_bmp_gz, assets_font_uu_bmp_gz_len);
-  sprites->font['V'] = loadGraphic(renderer, assets_font_vv_bmp_gz, assets_font_vv_bmp_gz_len);
-  sprites->font['W'] = loadGraphic(renderer, assets_font_ww_bmp_gz, assets_font_ww_bmp_gz_len);
-  sprites->font['X'] = loadGraphic(renderer, assets_font_xx_bmp_gz, assets_font_xx_bmp_gz_len);
-  sprites->font['Y'] = loadGraphic(renderer, assets_font_yy_bmp_gz, assets_font_yy_bmp_gz_len);
-  sprites->font['Z'] = loadGraphic(renderer, assets_font_zz_bmp_gz, assets_font_zz_bmp_gz_len);
-  sprites->font[':'] = loadGraphic(renderer, assets_font_sym_col_bmp_gz, assets_font_sym_col_bmp_gz_len);
-  sprites->font[';'] = loadGraphic(renderer, assets_font_sym_scol_bmp_gz, assets_font_sym_scol_bmp_gz_len);
-  sprites->font['!'] = loadGraphic(renderer, assets_font_sym_excl_bmp_gz, assets_font_sym_excl_bmp_gz_len);
-  sprites->font['$'] = loadGraphic(renderer, assets_font_sym_doll_bmp_gz, assets_font_sym_doll_bmp_gz_len);
-  sprites->font['.'] = loadGraphic(renderer, assets_font_sym_dot_bmp_gz, assets_font_sym_dot_bmp_gz_len);
-  sprites->font['&'] = loadGraphic(renderer, assets_font_sym_ampe_bmp_gz, assets_font_sym_ampe_bmp_gz_len);
-  sprites->font['*'] = loadGraphic(renderer, assets_font_sym_star_bmp_gz, assets_font_sym_star_bmp_gz_len);
-  sprites->font[','] = loadGraphic(renderer, assets_font_sym_comm_bmp_gz, assets_font_sym_comm_bmp_gz_len);
-  sprites->font['('] = loadGraphic(renderer, assets_font_sym_par1_bmp_gz, assets_font_sym_par1_bmp_gz_len);
-  sprites->font[')'] = loadGraphic(renderer, assets_font_sym_par2_bmp_gz, assets_font_sym_par2_bmp_gz_len);
-  sprites->font['['] = loadGraphic(renderer, assets_font_sym_bra1_bmp_gz, assets_font_sym_bra1_bmp_gz_len);
-  sprites->font[']'] = loadGraphic(renderer, assets_font_sym_bra2_bmp_gz, assets_font_sym_bra2_bmp_gz_len);
-  sprites->font['-'] = loadGraphic(renderer, assets_font_sym_minu_bmp_gz, assets_font_sym_minu_bmp_gz_len);
-  sprites->font['_'] = loadGraphic(renderer, assets_font_sym_unde_bmp_gz, assets_font_sym_unde_bmp_gz_len);
-  sprites->font['/'] = loadGraphic(renderer, assets_font_sym_slas_bmp_gz, assets_font_sym_slas_bmp_gz_len);
-  sprites->font['"'] = loadGraphic(renderer, assets_font_sym_quot_bmp_gz, assets_font_sym_quot_bmp_gz_len);
-  sprites->font['#'] = loadGraphic(renderer, assets_font_sym_hash_bmp_gz, assets_font_sym_hash_bmp_gz_len);
-  sprites->font['@'] = loadGraphic(renderer, assets_font_sym_at_bmp_gz, assets_font_sym_at_bmp_gz_len);
-  sprites->font['\''] = loadGraphic(renderer, assets_font_sym_apos_bmp_gz, assets_font_sym_apos_bmp_gz_len);
-
-  /* set all NULL fonts to '_' */
+  for (i = 0; i < 256; i++) glyphs[i] = NULL;
+  glyphs['0'] = loadSurface(assets_font_0_bmp_gz, assets_font_0_bmp_gz_len);
+  glyphs['1'] = loadSurface(assets_font_1_bmp_gz, assets_font_1_bmp_gz_len);
+  glyphs['2'] = loadSurface(assets_font_2_bmp_gz, assets_font_2_bmp_gz_len);
+  glyphs['3'] = loadSurface(assets_font_3_bmp_gz, assets_font_3_bmp_gz_len);
+  glyphs['4'] = loadSurface(assets_font_4_bmp_gz, assets_font_4_bmp_gz_len);
+  glyphs['5'] = loadSurface(assets_font_5_bmp_gz, assets_font_5_bmp_gz_len);
+  glyphs['6'] = loadSurface(assets_font_6_bmp_gz, assets_font_6_bmp_gz_len);
+  glyphs['7'] = loadSurface(assets_font_7_bmp_gz, assets_font_7_bmp_gz_len);
+  glyphs['8'] = loadSurface(assets_font_8_bmp_gz, assets_font_8_bmp_gz_len);
+  glyphs['9'] = loadSurface(assets_font_9_bmp_gz, assets_font_9_bmp_gz_len);
+  glyphs['a'] = loadSurface(assets_font_a_bmp_gz, assets_font_a_bmp_gz_len);
+  glyphs['b'] = loadSurface(assets_font_b_bmp_gz, assets_font_b_bmp_gz_len);
+  glyphs['c'] = loadSurface(assets_font_c_bmp_gz, assets_font_c_bmp_gz_len);
+  glyphs['d'] = loadSurface(assets_font_d_bmp_gz, assets_font_d_bmp_gz_len);
+  glyphs['e'] = loadSurface(assets_font_e_bmp_gz, assets_font_e_bmp_gz_len);
+  glyphs['f'] = loadSurface(assets_font_f_bmp_gz, assets_font_f_bmp_gz_len);
+  glyphs['g'] = loadSurface(assets_font_g_bmp_gz, assets_font_g_bmp_gz_len);
+  glyphs['h'] = loadSurface(assets_font_h_bmp_gz, assets_font_h_bmp_gz_len);
+  glyphs['i'] = loadSurface(assets_font_i_bmp_gz, assets_font_i_bmp_gz_len);
+  glyphs['j'] = loadSurface(assets_font_j_bmp_gz, assets_font_j_bmp_gz_len);
+  glyphs['k'] = loadSurface(assets_font_k_bmp_gz, assets_font_k_bmp_gz_len);
+  glyphs['l'] = loadSurface(assets_font_l_bmp_gz, assets_font_l_bmp_gz_len);
+  glyphs['m'] = loadSurface(assets_font_m_bmp_gz, assets_font_m_bmp_gz_len);
+  glyphs['n'] = loadSurface(assets_font_n_bmp_gz, assets_font_n_bmp_gz_len);
+  glyphs['o'] = loadSurface(assets_font_o_bmp_gz, assets_font_o_bmp_gz_len);
+  glyphs['p'] = loadSurface(assets_font_p_bmp_gz, assets_font_p_bmp_gz_len);
+  glyphs['q'] = loadSurface(assets_font_q_bmp_gz, assets_font_q_bmp_gz_len);
+  glyphs['r'] = loadSurface(assets_font_r_bmp_gz, assets_font_r_bmp_gz_len);
+  glyphs['s'] = loadSurface(assets_font_s_bmp_gz, assets_font_s_bmp_gz_len);
+  glyphs['t'] = loadSurface(assets_font_t_bmp_gz, assets_font_t_bmp_gz_len);
+  glyphs['u'] = loadSurface(assets_font_u_bmp_gz, assets_font_u_bmp_gz_len);
+  glyphs['v'] = loadSurface(assets_font_v_bmp_gz, assets_font_v_bmp_gz_len);
+  glyphs['w'] = loadSurface(assets_font_w_bmp_gz, assets_font_w_bmp_gz_len);
+  glyphs['x'] = loadSurface(assets_font_x_bmp_gz, assets_font_x_bmp_gz_len);
+  glyphs['y'] = loadSurface(assets_font_y_bmp_gz, assets_font_y_bmp_gz_len);
+  glyphs['z'] = loadSurface(assets_font_z_bmp_gz, assets_font_z_bmp_gz_len);
+  glyphs['A'] = loadSurface(assets_font_aa_bmp_gz, assets_font_aa_bmp_gz_len);
+  glyphs['B'] = loadSurface(assets_font_bb_bmp_gz, assets_font_bb_bmp_gz_len);
+  glyphs['C'] = loadSurface(assets_font_cc_bmp_gz, assets_font_cc_bmp_gz_len);
+  glyphs['D'] = loadSurface(assets_font_dd_bmp_gz, assets_font_dd_bmp_gz_len);
+  glyphs['E'] = loadSurface(assets_font_ee_bmp_gz, assets_font_ee_bmp_gz_len);
+  glyphs['F'] = loadSurface(assets_font_ff_bmp_gz, assets_font_ff_bmp_gz_len);
+  glyphs['G'] = loadSurface(assets_font_gg_bmp_gz, assets_font_gg_bmp_gz_len);
+  glyphs['H'] = loadSurface(assets_font_hh_bmp_gz, assets_font_hh_bmp_gz_len);
+  glyphs['I'] = loadSurface(assets_font_ii_bmp_gz, assets_font_ii_bmp_gz_len);
+  glyphs['J'] = loadSurface(assets_font_jj_bmp_gz, assets_font_jj_bmp_gz_len);
+  glyphs['K'] = loadSurface(assets_font_kk_bmp_gz, assets_font_kk_bmp_gz_len);
+  glyphs['L'] = loadSurface(assets_font_ll_bmp_gz, assets_font_ll_bmp_gz_len);
+  glyphs['M'] = loadSurface(assets_font_mm_bmp_gz, assets_font_mm_bmp_gz_len);
+  glyphs['N'] = loadSurface(assets_font_nn_bmp_gz, assets_font_nn_bmp_gz_len);
+  glyphs['O'] = loadSurface(assets_font_oo_bmp_gz, assets_font_oo_bmp_gz_len);
+  glyphs['P'] = loadSurface(assets_font_pp_bmp_gz, assets_font_pp_bmp_gz_len);
+  glyphs['Q'] = loadSurface(assets_font_qq_bmp_gz, assets_font_qq_bmp_gz_len);
+  glyphs['R'] = loadSurface(assets_font_rr_bmp_gz, assets_font_rr_bmp_gz_len);
+  glyphs['S'] = loadSurface(assets_font_ss_bmp_gz, assets_font_ss_bmp_gz_len);
+  glyphs['T'] = loadSurface(assets_font_tt_bmp_gz, assets_font_tt_bmp_gz_len);
+  glyphs['U'] = loadSurface(assets_font_uu_bmp_gz, assets_font_uu_bmp_gz_len);
+  glyphs['V'] = loadSurface(assets_font_vv_bmp_gz, assets_font_vv_bmp_gz_len);
+  glyphs['W'] = loadSurface(assets_font_ww_bmp_gz, assets_font_ww_bmp_gz_len);
+  glyphs['X'] = loadSurface(assets_font_xx_bmp_gz, assets_font_xx_bmp_gz_len);
+  glyphs['Y'] = loadSurface(assets_font_yy_bmp_gz, assets_font_yy_bmp_gz_len);
+  glyphs['Z'] = loadSurface(assets_font_zz_bmp_gz, assets_font_zz_bmp_gz_len);
+  glyphs[':'] = loadSurface(assets_font_sym_col_bmp_gz, assets_font_sym_col_bmp_gz_len);
+  glyphs[';'] = loadSurface(assets_font_sym_scol_bmp_gz, assets_font_sym_scol_bmp_gz_len);
+  glyphs['!'] = loadSurface(assets_font_sym_excl_bmp_gz, assets_font_sym_excl_bmp_gz_len);
+  glyphs['$'] = loadSurface(assets_font_sym_doll_bmp_gz, assets_font_sym_doll_bmp_gz_len);
+  glyphs['.'] = loadSurface(assets_font_sym_dot_bmp_gz, assets_font_sym_dot_bmp_gz_len);
+  glyphs['&'] = loadSurface(assets_font_sym_ampe_bmp_gz, assets_font_sym_ampe_bmp_gz_len);
+  glyphs['*'] = loadSurface(assets_font_sym_star_bmp_gz, assets_font_sym_star_bmp_gz_len);
+  glyphs[','] = loadSurface(assets_font_sym_comm_bmp_gz, assets_font_sym_comm_bmp_gz_len);
+  glyphs['('] = loadSurface(assets_font_sym_par1_bmp_gz, assets_font_sym_par1_bmp_gz_len);
+  glyphs[')'] = loadSurface(assets_font_sym_par2_bmp_gz, assets_font_sym_par2_bmp_gz_len);
+  glyphs['['] = loadSurface(assets_font_sym_bra1_bmp_gz, assets_font_sym_bra1_bmp_gz_len);
+  glyphs[']'] = loadSurface(assets_font_sym_bra2_bmp_gz, assets_font_sym_bra2_bmp_gz_len);
+  glyphs['-'] = loadSurface(assets_font_sym_minu_bmp_gz, assets_font_sym_minu_bmp_gz_len);
+  glyphs['_'] = loadSurface(assets_font_sym_unde_bmp_gz, assets_font_sym_unde_bmp_gz_len);
+  glyphs['/'] = loadSurface(assets_font_sym_slas_bmp_gz, assets_font_sym_slas_bmp_gz_len);
+  glyphs['"'] = loadSurface(assets_font_sym_quot_bmp_gz, assets_font_sym_quot_bmp_gz_len);
+  glyphs['#'] = loadSurface(assets_font_sym_hash_bmp_gz, assets_font_sym_hash_bmp_gz_len);
+  glyphs['@'] = loadSurface(assets_font_sym_at_bmp_gz, assets_font_sym_at_bmp_gz_len);
+  glyphs['\''] = loadSurface(assets_font_sym_apos_bmp_gz, assets_font_sym_apos_bmp_gz_len);
+
+  /* pack the glyphs into a single texture */
+  res = load_fontatlas(sprites, glyphs, renderer);
   for (i = 0; i < 256; i++) {
-    if (sprites->font[i] == NULL) sprites->font[i] = sprites->font['_'];
-  }
-
-  /* analyze the "player right" position - if completely transparent, then
-   * player character is rotatable */
-  if (texture_check_transparency(sprites->map[SPRITE_PLAYERRIGHT], renderer) < 2) {
-    sprites->flags |= SPRITES_FLAG_PLAYERROTATE;
+    if (glyphs[i] != NULL) CSDL_DestroySurface(glyphs[i]);
   }
-
-  /* analyze the player's sprite - if it has no transparent pixels, then flag the sprite map as "primitive" to hint simplesok that animations may be unadvisable */
-  if (texture_check_transparency(sprites->map[SPRITE_PLAYERUP], renderer) == 2) {
-    sprites->flags |= SPRITES_FLAG_PRIMITIVE;
+  if (res != 0) {
+    skin_free(sprites);
+    return(NULL);
   }
 
   /* compute the em unit used to scale other things in the game */
-  {
-    int em;
-    /* the reference is the height of the 'A' glyph */
-    CSDL_QueryTexture(sprites->font['A'], NULL, NULL, NULL, &em);
-    sprites->em = (unsigned short)em;
-  }
+  /* the reference is the height of the 'A' glyph */
+  sprites->em = (unsigned short)(sprites->glyph['A'].h);
 
   return(sprites);
 }
 
 
 void skin_free(struct spritesstruct *sprites) {
-  int x;
-  for (x = 0; x < 4*8; x++) if (sprites->map[x]) SDL_DestroyTexture(sprites->map[x]);
+  if (sprites->atlas) SDL_DestroyTexture(sprites->atlas);
+  if (sprites->fontatlas) SDL_DestroyTexture(sprites->fontatlas);
   if (sprites->black) SDL_DestroyTexture(sprites->black);
   if (sprites->nosolution) SDL_DestroyTexture(sprites->nosolution);
   if (sprites->cleared) SDL_DestroyTexture(sprites->cleared);
@@ -526,13 +643,12 @@ void skin_free(struct spritesstruct *sprites) {
   if (sprites->saved) SDL_DestroyTexture(sprites->saved);
   if (sprites->loaded) SDL_DestroyTexture(sprites->loaded);
   if (sprites->nosave) SDL_DestroyTexture(sprites->nosave);
-  for (x = 0; x < 256; x++) {
-    /* skip font['_'] because it may be used as a placeholder pointer for many
-     * glyphs, so I will explicitely free it afterwards */
-    if (sprites->font[x] && sprites->font[x] != sprites->font['_']) {
-      SDL_DestroyTexture(sprites->font[x]);
-    }
-  }
-  if (sprites->font['_']) SDL_DestroyTexture(sprites->font['_']);
+  if (sprites->wallatlas) SDL_DestroyTexture(sprites->wallatlas);
   free(sprites);
 }
+
+
+void skin_resettargets(struct spritesstruct *sprites, SDL_Renderer *renderer) {
+  if (sprites->wallatlas) SDL_DestroyTexture(sprites->wallatlas);
+  sprites->wallatlas = build_wallatlas(sprites, renderer);
+}
@@ -55,7 +55,12 @@ struct skinlist {
 struct skinlist *skin_list(void);
 void skin_list_free(struct skinlist *l);
 
+/* loads skin name, or the embedded default one if name is NULL or not found */
 struct spritesstruct *skin_load(const char *name, SDL_Renderer *renderer);
 void skin_free(struct spritesstruct *skin);
 
+/* rebuilds the textures of skin that are drawn at runtime, to be called when
+ * the content of render target textures got lost */
+void skin_resettargets(struct spritesstruct *skin, SDL_Renderer *renderer);
+
 #endif
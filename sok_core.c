@@ -24,14 +24,23 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "config.h"
+
 #include <inttypes.h>   /* PRIx64 */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+#include <sys/mman.h>   /* mmap() */
+#define SOK_MMAP 1
+#endif
+#include "bitboard.h"
 #include "crc32.h"
 #include "crc64.h"
 #include "gz.h"
+#include "movelist.h"
+#include "perf.h"
 #include "save.h"
 #include "sok_core.h"
 
@@ -81,35 +90,50 @@ static void trim(char *comment) {
   }
 }
 
-size_t sok_history_getlen(const char *history) {
-  size_t res = 0;
-  if (history == NULL) return(0);
-  while (*history != 0) {
-    res += 1;
-    history += 1;
-  }
-  return(res);
+size_t sok_states_getmoves(const struct sokgamestates *states) {
+  return(ml_count(states->history));
 }
 
-size_t sok_history_getpushes(const char *history) {
-  size_t res = 0;
-  if (history == NULL) return(0);
-  while (*history != 0) {
-    if ((*history >= 'A') && (*history <= 'Z')) res += 1;
-    history += 1;
-  }
-  return(res);
+size_t sok_states_getpushes(const struct sokgamestates *states) {
+  return(ml_pushcount(states->history));
 }
 
-static struct sokgame *sok_allocgame(void) {
+size_t sok_states_getredo(const struct sokgamestates *states) {
+  return(ml_count(states->redo));
+}
+
+/* allocates a game of width x height cells, all of them outside. the field
+ * and wallmask are allocated along with the game, so free() frees all. */
+static struct sokgame *sok_allocgame(unsigned short width, unsigned short height) {
   struct sokgame *result;
-  result = malloc(sizeof(struct sokgame));
+  size_t cells = (size_t)(width + 2) * (height + 2);
+  result = calloc(1, sizeof(struct sokgame) + cells * 2);
+  if (result == NULL) return(NULL);
+  result->field_width = width;
+  result->field_height = height;
+  result->field = (unsigned char *)(result + 1);
+  result->wallmask = result->field + cells;
+  return(result);
+}
+
+struct sokgame *sok_copygame(const struct sokgame *game) {
+  struct sokgame *result = sok_allocgame(game->field_width, game->field_height);
+  unsigned char *field, *wallmask;
+  if (result == NULL) return(NULL);
+  field = result->field;
+  wallmask = result->wallmask;
+  memcpy(result, game, sizeof(struct sokgame));
+  result->field = field;
+  result->wallmask = wallmask;
+  memcpy(result->field, game->field, SOK_CELLS(game));
+  memcpy(result->wallmask, game->wallmask, SOK_CELLS(game));
   return(result);
 }
 
 static void sok_freegame(struct sokgame *game) {
   if (game == NULL) return;
-  if (game->solution != NULL) free(game->solution);
+  ml_free(game->solution);
+  bb_free(game->bitboard);
   free(game);
 }
 
@@ -121,22 +145,84 @@ void sok_freefile(struct sokgame **gamelist, int gamescount) {
   }
 }
 
-/* reads a byte from memory of from a file, whichever is passed as a parameter */
-static int readbytefrommem(unsigned char **memptr) {
-  int result = -1;
-  if (memptr != NULL) {
-    result = **memptr;
-    *memptr += 1;
-    if (result == 0) result = -1;
+/* level data, read through a fixed-size window so that only a small part of a
+ * (possibly huge, possibly gzipped) level file is ever held in memory. a
+ * stream without gz reads straight from memory, between pos and end. */
+#define LEVSTREAM_WINDOW 65536
+/* levels are parsed into a grid large enough for the largest possible level
+ * plus a one-cell margin, level cells starting at (1,1) */
+#define LEVGRID_SIZE (SOK_MAXSIZE + 2)
+struct levstream {
+  struct gzreader *gz;
+  const unsigned char *pos;  /* next byte to read from buf */
+  const unsigned char *end;  /* end of the valid data in buf */
+  int eof;             /* set once a NUL byte or the end of data is reached */
+  int err;             /* set if data could not be read */
+  unsigned char buf[LEVSTREAM_WINDOW];
+  int gridrows;        /* rows of grid initialized for the level being parsed */
+  unsigned char grid[LEVGRID_SIZE * LEVGRID_SIZE]; /* row-major */
+  unsigned int *fillstack; /* seeds of floodFillField(), kept across levels */
+  size_t fillstacklen;
+};
+
+/* allocates a level stream reading from gz, or from memory between pos and
+ * end if gz is NULL. returns NULL on out of memory. */
+static struct levstream *levstream_new(struct gzreader *gz, const unsigned char *pos, const unsigned char *end) {
+  struct levstream *s = malloc(sizeof(struct levstream));
+  if (s == NULL) return(NULL);
+  s->gz = gz;
+  s->pos = pos;
+  s->end = end;
+  if (gz != NULL) { /* data comes through buf */
+    s->pos = s->buf;
+    s->end = s->buf;
+  }
+  s->eof = 0;
+  s->err = 0;
+  s->fillstack = NULL;
+  s->fillstacklen = 0;
+  return(s);
+}
+
+static void levstream_free(struct levstream *s) {
+  if (s == NULL) return;
+  free(s->fillstack);
+  free(s);
+}
+
+/* reads a byte from the level stream, returns -1 at end of data */
+static int readbytefromstream(struct levstream *s) {
+  int result;
+  long len;
+  if (s->eof) return(-1);
+  if (s->pos == s->end) {
+    if (s->gz == NULL) { /* level data of a set in memory: no refill */
+      s->eof = 1;
+      return(-1);
+    }
+    len = gzr_read(s->gz, s->buf, sizeof(s->buf));
+    if (len < 0) s->err = 1;
+    if (len <= 0) {
+      s->eof = 1;
+      return(-1);
+    }
+    s->pos = s->buf;
+    s->end = s->buf + len;
+  }
+  result = *(s->pos);
+  s->pos += 1;
+  if (result == 0) {
+    s->eof = 1;
+    result = -1;
   }
   return(result);
 }
 
 /* reads a single RLE chunk from file fd, fills bytebuff with the actual data byte and returns the amount of times it should be repeated. returns -1 on error (like end of file). */
-static int readRLEbyte(unsigned char **memptr, int *bytebuff) {
+static int readRLEbyte(struct levstream *s, int *bytebuff) {
   int rleprefix = -1;
   for (;;) { /* RLE support */
-      *bytebuff = readbytefrommem(memptr);
+      *bytebuff = readbytefromstream(s);
       if (*bytebuff < 0) return(-1);
       if ((*bytebuff >= '0') && (*bytebuff <= '9')) {
         if (rleprefix > 0) {
@@ -153,79 +239,390 @@ static int readRLEbyte(unsigned char **memptr, int *bytebuff) {
   return(rleprefix);
 }
 
-/* floodfill algorithm to fill areas of a playfield that are not contained in walls */
-static void floodFillField(struct sokgame *game, int x, int y) {
-  if ((x >= 0) && (x < 64) && (y >= 0) && (y < 64) && (game->field[x][y] == field_floor)) {
-    game->field[x][y] = 0; /* set the 'pixel' before starting recursion */
-    floodFillField(game, x + 1, y);
-    floodFillField(game, x - 1, y);
-    floodFillField(game, x, y + 1);
-    floodFillField(game, x, y - 1);
+/* room scanlinefill() needs on its stack for a grid of w x h cells: a cell
+ * is pushed at most once by a span of the row above and once by a span of
+ * the row below, so 2 slots per cell always suffice */
+#define SCANLINEFILL_STACK(w, h) ((size_t)(w) * (h) * 2 + 1)
+
+/* fills the 4-connected area around (x,y) of a grid of w x h cells, without
+ * recursion. canfill() tells whether a cell belongs to the area and is not
+ * filled yet, fill() marks it as filled. stack must have room for
+ * SCANLINEFILL_STACK(w, h) entries. returns the number of cells filled. */
+static int scanlinefill(int x, int y, int w, int h, int (*canfill)(void *ctx, int x, int y), void (*fill)(void *ctx, int x, int y), void *ctx, unsigned int *stack) {
+  int sp = 0, count = 0, left, right, i, above, below;
+
+  stack[sp++] = (unsigned int)(y * w + x);
+  while (sp > 0) {
+    sp--;
+    x = (int)(stack[sp] % (unsigned int)w);
+    y = (int)(stack[sp] / (unsigned int)w);
+    if (canfill(ctx, x, y) == 0) continue;
+    /* find the whole span of the row, then fill it while looking for spans
+     * to continue with on the rows above and below */
+    for (left = x; (left > 0) && canfill(ctx, left - 1, y); left--);
+    for (right = x; (right < w - 1) && canfill(ctx, right + 1, y); right++);
+    above = 0;
+    below = 0;
+    for (i = left; i <= right; i++) {
+      fill(ctx, i, y);
+      count++;
+      if (y > 0) {
+        if (canfill(ctx, i, y - 1) == 0) {
+          above = 0;
+        } else if (above == 0) {
+          stack[sp++] = (unsigned int)((y - 1) * w + i);
+          above = 1;
+        }
+      }
+      if (y < h - 1) {
+        if (canfill(ctx, i, y + 1) == 0) {
+          below = 0;
+        } else if (below == 0) {
+          stack[sp++] = (unsigned int)((y + 1) * w + i);
+          below = 1;
+        }
+      }
+    }
   }
+  return(count);
 }
 
+static int outside_canfill(void *ctx, int x, int y) {
+  struct levstream *s = ctx;
+  return(s->grid[y * LEVGRID_SIZE + x] == field_floor);
+}
+
+static void outside_fill(void *ctx, int x, int y) {
+  struct levstream *s = ctx;
+  s->grid[y * LEVGRID_SIZE + x] = 0;
+}
 
-/* loads the next level from open file fd. returns 0 on success, 1 on success with end of file reached, or -1 on error. */
-static int loadlevelfromfile(struct sokgame *game, unsigned char **memptr, char *precomment, size_t precommentsz, char *postcomment, size_t postcommentsz) {
+/* removes floors from areas of the w x h top-left part of the grid of s
+ * that are not contained in walls. the stack of seeds is allocated once and
+ * reused by all levels of the stream, growing for larger ones only. returns
+ * 0 on success. */
+static int floodFillField(struct levstream *s, int x, int y, int w, int h) {
+  if (s->fillstacklen < SCANLINEFILL_STACK(w, h)) {
+    free(s->fillstack);
+    s->fillstacklen = SCANLINEFILL_STACK(w, h);
+    s->fillstack = malloc(sizeof(unsigned int) * s->fillstacklen);
+    if (s->fillstack == NULL) {
+      s->fillstacklen = 0;
+      return(-1);
+    }
+  }
+  scanlinefill(x, y, w, h, outside_canfill, outside_fill, s, s->fillstack);
+  return(0);
+}
+
+/* breadth-first search of the player's walks from (x,y): from[] (laid out as
+ * the field) is set to the direction (enum SOKMOVE) used to step into every
+ * reached cell, the start cell being marked with sokmoveNONE + 5 and
+ * unreached cells with 0. queue must have room for SOK_CELLS() entries. */
+static void walkbfs(const struct sokgame *game, int x, int y, unsigned char *from, unsigned int *queue) {
+  int head = 0, tail = 0, d, c, n;
+  int delta[5];
+  delta[sokmoveNONE] = 0;
+  delta[sokmoveUP] = -SOK_STRIDE(game);
+  delta[sokmoveLEFT] = -1;
+  delta[sokmoveDOWN] = SOK_STRIDE(game);
+  delta[sokmoveRIGHT] = 1;
+  memset(from, 0, SOK_CELLS(game));
+  c = SOK_INDEX(game, x, y);
+  from[c] = sokmoveNONE + 5;
+  queue[tail++] = (unsigned int)c;
+  while (head < tail) {
+    c = (int)queue[head++];
+    for (d = sokmoveUP; d <= sokmoveRIGHT; d++) {
+      n = c + delta[d];
+      /* the border is no floor, so the walk never gets past it */
+      if (from[n] != 0) continue;
+      if ((game->field[n] & field_floor) == 0) continue;
+      if (game->field[n] & (field_wall | field_atom)) continue;
+      from[n] = (unsigned char)d;
+      queue[tail++] = (unsigned int)n;
+    }
+  }
+}
+
+/* writes the walk leading to (x,y) as found by walkbfs() at the end of buf,
+ * and returns its length. buf must have room for as many moves as the field
+ * has cells. */
+static size_t walkmoves(const struct sokgame *game, const unsigned char *from, int x, int y, char *buf) {
+  static const char dirchar[5] = {' ', 'u', 'l', 'd', 'r'};
+  size_t len = 0, i;
+  int d;
+  /* collect moves backwards, then reverse them */
+  while ((d = from[SOK_INDEX(game, x, y)]) != sokmoveNONE + 5) {
+    buf[len++] = dirchar[d];
+    if (d == sokmoveUP) y++;
+    if (d == sokmoveLEFT) x++;
+    if (d == sokmoveDOWN) y--;
+    if (d == sokmoveRIGHT) x--;
+  }
+  for (i = 0; i < len / 2; i++) {
+    char c = buf[i];
+    buf[i] = buf[len - 1 - i];
+    buf[len - 1 - i] = c;
+  }
+  return(len);
+}
+
+char *sok_walkpath(const struct sokgame *game, int x, int y) {
+  unsigned char *from;
+  unsigned int *queue;
+  char *res = NULL;
+  if ((x < 0) || (y < 0) || (x >= game->field_width) || (y >= game->field_height)) return(NULL);
+  from = malloc(SOK_CELLS(game));
+  queue = malloc(sizeof(unsigned int) * SOK_CELLS(game));
+  if ((from != NULL) && (queue != NULL)) {
+    walkbfs(game, game->positionx, game->positiony, from, queue);
+    if (from[SOK_INDEX(game, x, y)] != 0) res = malloc((size_t)game->field_width * game->field_height + 1);
+    if (res != NULL) res[walkmoves(game, from, x, y, res)] = 0;
+  }
+  free(from);
+  free(queue);
+  return(res);
+}
+
+/* a push state is an atom position (its cell index) plus the direction of
+ * the push that brought it there, the player standing right behind the atom */
+#define PUSHSTATE(c, d) ((unsigned int)(c) * 4 + (d) - 1)
+#define PUSHCELLX(game, s) ((int)((s) / 4 % SOK_STRIDE(game)) - 1)
+#define PUSHCELLY(game, s) ((int)((s) / 4 / SOK_STRIDE(game)) - 1)
+#define PUSHNONE 0xffffffffu
+
+char *sok_pushpath(const struct sokgame *game, int atomx, int atomy, int x, int y) {
+  static const int vecx[5] = {0, 0, -1, 0, 1};
+  static const int vecy[5] = {0, -1, 0, 1, 0};
+  struct sokgame *scratch;
+  unsigned int *parent, *queue, *chain, *walkqueue;
+  unsigned int pushroot, found = PUSHNONE, i;
+  unsigned char *from;
+  size_t head = 0, tail = 0, chainlen = 0, pushstates = SOK_CELLS(game) * 4;
+  int goalsleft;
+  char *res = NULL;
+  size_t reslen = 0;
+
+  if ((atomx < 0) || (atomy < 0) || (atomx >= game->field_width) || (atomy >= game->field_height)) return(NULL);
+  if ((x < 0) || (y < 0) || (x >= game->field_width) || (y >= game->field_height)) return(NULL);
+  if ((SOK_FIELD(game, atomx, atomy) & field_atom) == 0) return(NULL);
+
+  /* the moved atom is tracked apart, the scratch field holds the others */
+  scratch = sok_copygame(game);
+  parent = malloc(sizeof(unsigned int) * (pushstates * 3 + 1 + SOK_CELLS(game)));
+  from = malloc(SOK_CELLS(game));
+  if ((scratch == NULL) || (parent == NULL) || (from == NULL)) goto DONE;
+  queue = parent + pushstates;
+  chain = queue + pushstates + 1;
+  walkqueue = chain + pushstates;
+  pushroot = (unsigned int)pushstates;
+  SOK_FIELD(scratch, atomx, atomy) &= ~field_atom;
+  memset(parent, 0xff, sizeof(unsigned int) * pushstates);
+
+  /* breadth-first search over pushes: the first state reaching (x,y) is the
+   * one with the fewest pushes. parent[] holds the previous state, or
+   * PUSHNONE for states not visited yet */
+  if ((atomx == x) && (atomy == y)) found = pushroot;
+  queue[tail++] = pushroot;
+  while ((head < tail) && (found == PUSHNONE)) {
+    unsigned int s = queue[head++], ns;
+    int bx, by, px, py, d;
+    if (s == pushroot) {
+      bx = atomx;
+      by = atomy;
+      px = game->positionx;
+      py = game->positiony;
+    } else {
+      bx = PUSHCELLX(game, s);
+      by = PUSHCELLY(game, s);
+      px = bx - vecx[s % 4 + 1];
+      py = by - vecy[s % 4 + 1];
+    }
+    SOK_FIELD(scratch, bx, by) |= field_atom;
+    walkbfs(scratch, px, py, from, walkqueue);
+    SOK_FIELD(scratch, bx, by) &= ~field_atom;
+    for (d = sokmoveUP; d <= sokmoveRIGHT; d++) {
+      int nx = bx + vecx[d], ny = by + vecy[d];
+      /* the atom is never on the border, so neither its neighbours are out
+       * of the field */
+      if (from[SOK_INDEX(game, bx - vecx[d], by - vecy[d])] == 0) continue;
+      if ((SOK_FIELD(scratch, nx, ny) & field_floor) == 0) continue;
+      if (SOK_FIELD(scratch, nx, ny) & (field_wall | field_atom)) continue;
+      ns = PUSHSTATE(SOK_INDEX(game, nx, ny), d);
+      if (parent[ns] != PUSHNONE) continue;
+      parent[ns] = s;
+      if ((nx == x) && (ny == y)) {
+        found = ns;
+        break;
+      }
+      queue[tail++] = ns;
+    }
+  }
+  if (found == PUSHNONE) goto DONE;
+
+  /* unroll the chain of states, then replay it to emit the moves */
+  for (i = found; i != pushroot; i = parent[i]) chain[chainlen++] = i;
+  res = malloc((chainlen + 1) * ((size_t)game->field_width * game->field_height + 1));
+  if (res == NULL) goto DONE;
+  x = game->positionx;
+  y = game->positiony;
+  goalsleft = game->goalsleft;
+  while (chainlen > 0) {
+    unsigned int s = chain[--chainlen];
+    int d = (int)(s % 4) + 1, bx, by;
+    bx = PUSHCELLX(game, s) - vecx[d];
+    by = PUSHCELLY(game, s) - vecy[d];
+    SOK_FIELD(scratch, bx, by) |= field_atom;
+    walkbfs(scratch, x, y, from, walkqueue);
+    SOK_FIELD(scratch, bx, by) &= ~field_atom;
+    reslen += walkmoves(game, from, bx - vecx[d], by - vecy[d], res + reslen);
+    res[reslen++] = "ULDR"[d - 1];
+    x = bx;
+    y = by;
+    /* do not push any further once the level is solved */
+    if (SOK_FIELD(game, bx, by) & field_goal) goalsleft++;
+    if (SOK_FIELD(game, bx + vecx[d], by + vecy[d]) & field_goal) goalsleft--;
+    if (goalsleft == 0) break;
+  }
+  res[reslen] = 0;
+
+  DONE:
+  free(scratch);
+  free(parent);
+  free(from);
+  return(res);
+}
+
+
+/* fills the wallmask of every cell of the level. thanks to the border of
+ * outside cells, neighbours are looked at without any bound check. */
+static void computewallmask(struct sokgame *game) {
+  int x, y, stride = SOK_STRIDE(game);
+  const unsigned char *f;
+  unsigned char res;
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      f = &SOK_FIELD(game, x, y);
+      res = 0;
+      if (f[-stride - 1] & field_wall) res |= wallmask_topleft;
+      if (f[-stride] & field_wall) res |= wallmask_top;
+      if (f[-stride + 1] & field_wall) res |= wallmask_topright;
+      if (f[-1] & field_wall) res |= wallmask_left;
+      if (f[1] & field_wall) res |= wallmask_right;
+      if (f[stride - 1] & field_wall) res |= wallmask_bottomleft;
+      if (f[stride] & field_wall) res |= wallmask_bottom;
+      if (f[stride + 1] & field_wall) res |= wallmask_bottomright;
+      SOK_WALLMASK(game, x, y) = res;
+    }
+  }
+}
+
+
+/* computes both CRCs of a freshly loaded level */
+static void computecrcs(struct sokgame *game) {
+  static const unsigned char zeros[SOK_MAXSIZE];
+  unsigned char pos[2];
+  unsigned short y, n;
+
+  /* compute the CRC32 of the field as it was done in v1.0.6 and earlier. This
+   * is buggy since it only looks at a part of the field due to the inversion
+   * of x and y axis. Also, it does not take into account the initial position
+   * of the player. This buggy CRC32 is only used as a fallback to look for
+   * solutions written by earlier versions of the game. It reads field_width
+   * rows of field_height cells, cells out of the level counting as 0. */
+  game->crc32_106 = crc32_init();
+  for (y = 0; y < game->field_width; y++) {
+    n = 0;
+    if (y < game->field_height) {
+      n = (game->field_width < game->field_height) ? game->field_width : game->field_height;
+      crc32_feed(&(game->crc32_106), &SOK_FIELD(game, 0, y), n);
+    }
+    crc32_feed(&(game->crc32_106), zeros, game->field_height - n);
+  }
+  crc32_finish(&(game->crc32_106));
+
+  /* compute the CRC64 of the playfield, row by row. do not forget to include
+   * the player's initial position in the CRC */
+  pos[0] = (unsigned char)(game->positionx);
+  pos[1] = (unsigned char)(game->positiony);
+  game->crc64 = crc64(0, pos, 2);
+  for (y = 0; y < game->field_height; y++) {
+    game->crc64 = crc64(game->crc64, &SOK_FIELD(game, 0, y), game->field_width);
+  }
+}
+
+
+/* initializes rows of the grid of s up to row n (excluded) to floor */
+static void levstream_initrows(struct levstream *s, int n) {
+  while (s->gridrows < n) {
+    memset(s->grid + s->gridrows * LEVGRID_SIZE, field_floor, LEVGRID_SIZE);
+    s->gridrows++;
+  }
+}
+
+/* loads the next level from level stream s into a newly allocated *game.
+ * returns 0 on success, 1 on success with end of file reached, or -1 on
+ * error (*game being left NULL). */
+static int loadlevelfromfile(struct sokgame **game, struct levstream *s, char *precomment, size_t precommentsz) {
   int leveldatastarted = 0, endoffile = 0;
-  unsigned short x, y;
+  unsigned short x, y, width = 0, height = 0;
+  int positionx = -1, positiony = -1;
   int bytebuff;
+  struct sokgame *g;
   char commentbuf[128];
+  char postcomment[128];
   size_t commentbuflen = 0;
-  game->positionx = -1;
-  game->positiony = -1;
-  game->field_width = 0;
-  game->field_height = 0;
-  game->solution = NULL;
+  *game = NULL;
+  postcomment[0] = 0;
   if ((precomment != NULL) && (precommentsz > 0)) *precomment = 0;
-  if ((postcomment != NULL) && (postcommentsz > 0)) *postcomment = 0;
 
-  /* Fill the area with floor */
-  for (y = 0; y < 64; y++) {
-    for (x = 0; x < 64; x++) {
-      game->field[x][y] = field_floor;
-    }
-  }
+  /* the grid is filled with floor as rows get used, the level starting at
+   * (1,1) so a margin of floor surrounds it */
+  s->gridrows = 0;
 
   x = 0;
   y = 0;
 
   for (;;) {
     int rleprefix;
-    rleprefix = readRLEbyte(memptr, &bytebuff);
+    unsigned char *cell;
+    rleprefix = readRLEbyte(s, &bytebuff);
     if (rleprefix < 0) endoffile = 1;
     if (endoffile != 0) break;
     for (; rleprefix > 0; rleprefix--) {
+      levstream_initrows(s, y + 2);
+      cell = s->grid + (y + 1) * LEVGRID_SIZE + x + 1;
       switch (bytebuff) {
         case ' ': /* empty space */
         case '-': /* dash (-) and underscore (_) are sometimes used to denote empty spaces */
         case '_':
-          game->field[x + 1][y + 1] |= field_floor;
+          *cell |= field_floor;
           x += 1;
           break;
         case '#': /* wall */
-          game->field[x + 1][y + 1] |= field_wall;
+          *cell |= field_wall;
           x += 1;
           break;
         case '@': /* player */
-          game->field[x + 1][y + 1] |= field_floor;
-          game->positionx = x;
-          game->positiony = y;
+          *cell |= field_floor;
+          positionx = x;
+          positiony = y;
           x += 1;
           break;
         case '*': /* atom on goal */
-          game->field[x + 1][y + 1] |= field_goal;
+          *cell |= field_goal;
           /* FALLTHRU */
         case '$': /* atom */
-          game->field[x + 1][y + 1] |= field_atom;
+          *cell |= field_atom;
           x += 1;
           break;
         case '+': /* player on goal */
-          game->positionx = x;
-          game->positiony = y;
+          positionx = x;
+          positiony = y;
           /* FALLTHRU */
         case '.': /* goal */
-          game->field[x + 1][y + 1] |= field_goal;
+          *cell |= field_goal;
           x += 1;
           break;
         case '\n': /* next row */
@@ -239,7 +636,7 @@ static int loadlevelfromfile(struct sokgame *game, unsigned char **memptr, char
           /* read the comment into buf */
           commentbuflen = 0;
           for (;;) {
-            bytebuff = readbytefrommem(memptr);
+            bytebuff = readbytefromstream(s);
             if (bytebuff == '\r') continue;
             if (bytebuff == '\n') break;
             if (bytebuff < 0) {
@@ -257,8 +654,8 @@ static int loadlevelfromfile(struct sokgame *game, unsigned char **memptr, char
           /* copy the comment to pre or post comment */
           if (leveldatastarted) {
             leveldatastarted = -1;
-            if ((postcomment) && (postcomment[0] == 0)) {
-              snprintf(postcomment, postcommentsz, "%s", commentbuf);
+            if (postcomment[0] == 0) {
+              snprintf(postcomment, sizeof(postcomment), "%s", commentbuf);
             }
           } else {
             if ((precomment) && (precomment[0] == 0)) {
@@ -269,56 +666,53 @@ static int loadlevelfromfile(struct sokgame *game, unsigned char **memptr, char
       }
       if ((leveldatastarted < 0) || (endoffile != 0)) break;
       if (x > 0) leveldatastarted = 1;
-      if (x >= 62) return(ERR_LEVEL_TOO_LARGE);
-      if (y >= 62) return(ERR_LEVEL_TOO_HIGH);
-      if (x > game->field_width) game->field_width = x;
-      if ((y >= game->field_height) && (x > 0)) game->field_height = y + 1;
+      if (x > SOK_MAXSIZE) return(ERR_LEVEL_TOO_LARGE);
+      if (y > SOK_MAXSIZE) return(ERR_LEVEL_TOO_HIGH);
+      if (x > width) width = x;
+      if ((y >= height) && (x > 0)) height = y + 1;
     }
     if ((leveldatastarted < 0) || (endoffile != 0)) break;
   }
 
   /* check if the loaded game looks sane */
-  if (game->positionx < 0) return(ERR_PLAYER_POS_UNDEFINED);
-  if (game->field_height < 1) return(ERR_LEVEL_TOO_SMALL);
-  if (game->field_width < 1) return(ERR_LEVEL_TOO_SMALL);
+  if (positionx < 0) return(ERR_PLAYER_POS_UNDEFINED);
+  if (height < 1) return(ERR_LEVEL_TOO_SMALL);
+  if (width < 1) return(ERR_LEVEL_TOO_SMALL);
   if (leveldatastarted == 0) return(ERR_NO_LEVEL_DATA_FOUND);
 
-  /* remove floors around the level */
-  floodFillField(game, 63, 63);
+  /* remove floors around the level: the fill is confined to the level's
+   * bounding box and its margin, which is all that is kept of the grid */
+  levstream_initrows(s, height + 2);
+  if (floodFillField(s, width + 1, height + 1, width + 2, height + 2) != 0) return(ERR_MEM_ALLOC_FAILED);
 
-  /* move the field by -1 vertically and horizontally to remove the additional row and column added for the fill function to be able to get around the field. */
-  for (y = 0; y < 63; y++) {
-    for (x = 0; x < 63; x++) {
-      game->field[x][y] = game->field[x + 1][y + 1];
-    }
+  g = sok_allocgame(width, height);
+  if (g == NULL) return(ERR_MEM_ALLOC_FAILED);
+  /* the margin of the grid becomes the border of the field */
+  for (y = 0; y < height + 2; y++) {
+    memcpy(g->field + (size_t)y * SOK_STRIDE(g), s->grid + y * LEVGRID_SIZE, width + 2);
   }
-  /* compute the CRC32 of the field as it was done in v1.0.6 and earlier. This
-   * is buggy since it only looks at a part of the field due to the inversion
-   * of x and y axis. Also, it does not take into account the initial position
-   * of the player. This buggy CRC32 is only used as a fallback to look for
-   * solutions written by earlier versions of the game. */
-  game->crc32_106 = crc32_init();
-  for (y = 0; y < game->field_width; y++) {
-    for (x = 0; x < game->field_height; x++) {
-      crc32_feed(&(game->crc32_106), &(game->field[x][y]), 1);
+  g->positionx = positionx;
+  g->positiony = positiony;
+  snprintf(g->comment, sizeof(g->comment), "%s", postcomment);
+
+  /* count goals that still need to be filled, so solved state is known in O(1) */
+  g->goalsleft = 0;
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      if ((SOK_FIELD(g, x, y) & (field_goal | field_atom)) == field_goal) g->goalsleft += 1;
     }
   }
-  crc32_finish(&(game->crc32_106));
 
-  /* compute the CRC64 of the playfield */
-  game->crc64 = 0;
-  { /* do not forget to include the player's initial position in the CRC */
-    unsigned char playerpos[2];
-    playerpos[0] = (unsigned char)(game->positionx);
-    playerpos[1] = (unsigned char)(game->positiony);
-    game->crc64 = crc64(game->crc64, playerpos, 2);
-  }
+  /* walls never move, so their neighbourhood is computed once for all */
+  computewallmask(g);
+
+  computecrcs(g);
 
-  if (debugmode) puts("---");
-  for (y = 0; y < game->field_height; y++) {
-    for (x = 0; x < game->field_width; x++) {
 #if debugmode != 0
-      switch (game->field[x][y]) {
+  puts("---");
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x++) {
+      switch (SOK_FIELD(g, x, y)) {
         case 0:
           printf(" ");
           break;
@@ -330,85 +724,62 @@ static int loadlevelfromfile(struct sokgame *game, unsigned char **memptr, char
           printf("X");
           break;
         default:
-          printf("%c", '0' + game->field[x][y]);
+          printf("%c", '0' + SOK_FIELD(g, x, y));
       }
-#endif
-      game->crc64 = crc64(game->crc64, &(game->field[x][y]), 1);
     }
-    if (debugmode) puts("");
+    puts("");
   }
-  if (debugmode) printf("CRC64 = %016" PRIx64 " (buggy pre-1.0.7 CRC32 = %08lX)\n", game->crc64, game->crc32_106);
+#endif
+  if (debugmode) printf("CRC64 = %016" PRIx64 " (buggy pre-1.0.7 CRC32 = %08lX)\n", g->crc64, g->crc32_106);
 
+  *game = g;
   if (endoffile != 0) return(1);
   return(0);
 }
 
-/* loads a file to memory. returns the file size on success, 0 otherwise. */
-static size_t loadfile2mem(char *file, unsigned char **memptr) {
-  size_t filesize;
-  long ftelloff;
-  FILE *fd = NULL;
-  *memptr = NULL;
-  fd = fopen(file, "rb");
-  if (fd == NULL) goto ERR;
-  /* get file size */
-  fseek(fd, 0, SEEK_END);
-  ftelloff = ftell(fd);
-  if (ftelloff <= 0) goto ERR;
-  filesize = (size_t)ftelloff;
-  if (filesize > 1024 * 1024 * 1024) goto ERR; /* don't even try loading huge files */
-  rewind(fd);
-  /* allocate mem */
-  *memptr = calloc(1, filesize + 1); /* +1 because I always want to have a NULL terminator at the end */
-  if (*memptr == NULL) goto ERR;
-  /* load file to mem */
-  if (fread(*memptr, 1, filesize, fd) != filesize) goto ERR;
-  fclose(fd);
-  return(filesize);
-
-  ERR:
-  if (fd != NULL) fclose(fd);
-  if (*memptr != NULL) {
-    free(*memptr);
-    *memptr = NULL;
+/* records the dimensions and number of boxes of game in the level index */
+static void sok_indexlevel(const struct sokgame *game) {
+  size_t i, cells = SOK_CELLS(game);
+  unsigned short boxes = 0;
+  for (i = 0; i < cells; i++) {
+    if (game->field[i] & field_atom) boxes++;
   }
-  return(0);
+  levindex_addlevel(game->crc64, game->field_width, game->field_height, boxes);
 }
 
 /* load levels from a file, and put them into an array of up to maxlevels levels */
 int sok_loadfile(struct sokgame **gamelist, int maxlevels, char *gamelevel, unsigned char *memptr, size_t filelen, char *comment, int maxcommentlen) {
   int errflag = 0;
   unsigned short level;
-  unsigned char *allocptr = NULL;
+  FILE *fd = NULL;
+  struct gzreader *gz;
+  struct levstream *stream;
   struct sokgame *game = NULL;
   if (gamelevel != NULL) {
-    filelen = loadfile2mem(gamelevel, &allocptr);
-    memptr = allocptr;
+    fd = fopen(gamelevel, "rb");
+    if (fd == NULL) return(ERR_UNABLE_TO_OPEN_FILE);
+  } else if ((filelen == 0) || (memptr == NULL)) {
+    return(ERR_UNABLE_TO_OPEN_FILE);
   }
-  if ((filelen == 0) || (memptr == NULL)) return(ERR_UNABLE_TO_OPEN_FILE);
 
-  /* if the level is gziped, uncompress it now */
-  if (isGz(memptr, filelen)) {
-    char unsigned *ungzptr;
-    size_t uncompressedlen;
-    ungzptr = ungz(memptr, filelen, &uncompressedlen);
-    filelen = uncompressedlen;
-    if (allocptr != NULL) free(allocptr);
-    allocptr = ungzptr;
-    memptr = ungzptr;
-    if (ungzptr == NULL) return(ERR_UNABLE_TO_OPEN_FILE);
+  /* levels are parsed on the fly, gzipped data being inflated as it goes */
+  gz = gzr_open(memptr, filelen, fd);
+  if (gz == NULL) {
+    if (fd != NULL) fclose(fd);
+    return(ERR_UNABLE_TO_OPEN_FILE);
+  }
+  stream = levstream_new(gz, NULL, NULL);
+  if (stream == NULL) {
+    gzr_close(gz);
+    if (fd != NULL) fclose(fd);
+    return(ERR_MEM_ALLOC_FAILED);
   }
 
   for (level = 0; !errflag; level++) { /* iterate to load games sequentially from the file */
     if (debugmode) puts("loading level..");
-    game = sok_allocgame();
-    if(!game) {
-      errflag = ERR_MEM_ALLOC_FAILED;
-      break;
-    }
 
     /* call loadlevelfromfile */
-    errflag = loadlevelfromfile(game, &memptr, (level == 0) ? comment : NULL, maxcommentlen, game->comment, sizeof(game->comment));
+    errflag = loadlevelfromfile(&game, stream, (level == 0) ? comment : NULL, maxcommentlen);
     if (errflag < 0) {
       if (level) errflag = 0;
       break;
@@ -418,28 +789,482 @@ int sok_loadfile(struct sokgame **gamelist, int maxlevels, char *gamelevel, unsi
       break;
     }
 
+    /* bitsets for the solver. not vital, so an allocation failure is ignored */
+    game->bitboard = bb_new(game);
+
     /* write the level num and load the solution (if any) */
     game->level = level + 1;
     game->solution = solution_load(game->crc64, "sol");
+    if (gamelevel != NULL) sok_indexlevel(game);
     gamelist[level] = game;
     game = NULL;
   }
 
   sok_freegame(game);
-  if (allocptr != NULL) free(allocptr);
+  /* a read error means corrupted data (like a truncated gzip file) */
+  if ((stream->err != 0) && (errflag >= 0)) errflag = ERR_UNABLE_TO_OPEN_FILE;
+  gzr_close(stream->gz);
+  levstream_free(stream);
+  if (fd != NULL) fclose(fd);
 
   if (errflag < 0) {
     sok_freefile(gamelist, level);
     return(errflag);
   }
 
+  /* sets loaded from memory are indexed by the caller, that knows their
+   * name */
+  if (gamelevel != NULL) {
+    uint64_t *crcs = malloc((size_t)level * sizeof(uint64_t) + 1);
+    char *name = levindex_pathname(gamelevel);
+    if ((crcs != NULL) && (name != NULL)) {
+      int x;
+      for (x = 0; x < level; x++) crcs[x] = gamelist[x]->crc64;
+      levindex_addset(name, level, crcs);
+    }
+    free(crcs);
+    free(name);
+  }
+
   return(level);
 }
 
+/* maps (or loads to memory) the raw content of file fname. returns 0 on
+ * success. */
+static int sok_mapfile(const char *fname, unsigned char **data, size_t *len, int *mapped) {
+  FILE *fd;
+  long fsize;
+  *data = NULL;
+  *mapped = 0;
+  fd = fopen(fname, "rb");
+  if (fd == NULL) return(-1);
+  if ((fseek(fd, 0, SEEK_END) != 0) || ((fsize = ftell(fd)) <= 0) || (fseek(fd, 0, SEEK_SET) != 0)) {
+    fclose(fd);
+    return(-1);
+  }
+  *len = (size_t)fsize;
+#ifdef SOK_MMAP
+  {
+    void *map = mmap(NULL, *len, PROT_READ, MAP_PRIVATE, fileno(fd), 0);
+    if (map != MAP_FAILED) {
+      fclose(fd);
+      *data = map;
+      *mapped = 1;
+      return(0);
+    }
+  }
+#endif
+  /* no mmap() available: load the file to memory */
+  *data = malloc(*len);
+  if ((*data != NULL) && (fread(*data, 1, *len, fd) != *len)) {
+    free(*data);
+    *data = NULL;
+  }
+  fclose(fd);
+  if (*data == NULL) return(-1);
+  return(0);
+}
+
+
+static void sok_unmapfile(unsigned char *data, size_t len, int mapped) {
+#ifdef SOK_MMAP
+  if (mapped) {
+    munmap(data, len);
+    return;
+  }
+#else
+  (void)len;
+  (void)mapped;
+#endif
+  free(data);
+}
+
+
+/*** level cache *************************************************************
+ *
+ * parsing a level set (inflating it, flood filling and computing CRCs of
+ * every level) is the bulk of the time it takes to open it. so the levels of
+ * each set are kept parsed in a level cache entry, keyed by the CRC64 of the
+ * set's file, and made of (all integers being little endian):
+ *
+ *   LEVCACHE_MAGIC (8 bytes)
+ *   key (8 bytes), length of the set's file (8 bytes)
+ *   count (4 bytes)
+ *   count level records:
+ *     crc64 (8 bytes), crc32_106 (4 bytes)
+ *     width, height, positionx, positiony (1 byte each)
+ *     goalsleft (2 bytes)
+ *     comment length (1 byte) and comment of the level
+ *     field, 2 cells per byte (first cell in the low nibble), row by row
+ *   comment length (1 byte) and comment of the set
+ *   CRC64 of all the above (8 bytes) */
+
+#define LEVCACHE_MAGIC "SOKLVC1\n"
+#define LEVCACHE_HDRLEN 28 /* magic + key + length + count */
+#define LEVCACHE_RECHDRLEN 19 /* record up to its comment */
+
+struct levcachebuf {
+  unsigned char *buf;
+  size_t len;
+  size_t alloc;
+  int err;   /* set on out of memory */
+};
+
+
+static void put_le(unsigned char *p, uint64_t v, int bytes) {
+  int i;
+  for (i = 0; i < bytes; i++) {
+    p[i] = (unsigned char)(v & 0xff);
+    v >>= 8;
+  }
+}
+
+
+static uint64_t get_le(const unsigned char *p, int bytes) {
+  uint64_t v = 0;
+  while (bytes-- > 0) v = (v << 8) | p[bytes];
+  return(v);
+}
+
+
+/* returns room for len more bytes at the end of cb, or NULL */
+static unsigned char *levcache_grow(struct levcachebuf *cb, size_t len) {
+  unsigned char *res;
+  if (cb->err != 0) return(NULL);
+  if (cb->len + len > cb->alloc) {
+    size_t newalloc = (cb->alloc == 0) ? 65536 : cb->alloc;
+    while (newalloc < cb->len + len) newalloc *= 2;
+    res = realloc(cb->buf, newalloc);
+    if (res == NULL) {
+      cb->err = 1;
+      return(NULL);
+    }
+    cb->buf = res;
+    cb->alloc = newalloc;
+  }
+  res = cb->buf + cb->len;
+  cb->len += len;
+  return(res);
+}
+
+
+/* appends the record of a parsed level to cb */
+static void levcache_addlevel(struct levcachebuf *cb, const struct sokgame *game) {
+  unsigned char *p;
+  size_t commentlen = strlen(game->comment);
+  int x, y, i = 0;
+  p = levcache_grow(cb, LEVCACHE_RECHDRLEN + commentlen + ((size_t)game->field_width * game->field_height + 1) / 2);
+  if (p == NULL) return;
+  put_le(p, game->crc64, 8);
+  put_le(p + 8, game->crc32_106, 4);
+  p[12] = (unsigned char)game->field_width;
+  p[13] = (unsigned char)game->field_height;
+  p[14] = (unsigned char)game->positionx;
+  p[15] = (unsigned char)game->positiony;
+  put_le(p + 16, game->goalsleft, 2);
+  p[18] = (unsigned char)commentlen;
+  memcpy(p + LEVCACHE_RECHDRLEN, game->comment, commentlen);
+  p += LEVCACHE_RECHDRLEN + commentlen;
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++, i++) {
+      if (i & 1) {
+        p[i >> 1] |= (unsigned char)(SOK_FIELD(game, x, y) << 4);
+      } else {
+        p[i >> 1] = SOK_FIELD(game, x, y);
+      }
+    }
+  }
+}
+
+
+/* builds a game out of its level cache record. returns NULL on out of
+ * memory. */
+static struct sokgame *levcache_getlevel(const unsigned char *rec) {
+  int x, y, i = 0;
+  const unsigned char *field;
+  struct sokgame *game = sok_allocgame(rec[12], rec[13]);
+  if (game == NULL) return(NULL);
+  game->crc64 = get_le(rec, 8);
+  game->crc32_106 = (unsigned long)get_le(rec + 8, 4);
+  game->positionx = rec[14];
+  game->positiony = rec[15];
+  game->goalsleft = (unsigned short)get_le(rec + 16, 2);
+  memcpy(game->comment, rec + LEVCACHE_RECHDRLEN, rec[18]);
+  field = rec + LEVCACHE_RECHDRLEN + rec[18];
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++, i++) {
+      SOK_FIELD(game, x, y) = (field[i >> 1] >> ((i & 1) * 4)) & 15;
+    }
+  }
+  computewallmask(game);
+  return(game);
+}
+
+
+/* indexes the levels of set out of its level cache entry (loaded in
+ * set->data). returns 0 on success, or -1 if the entry is not valid. */
+static int levcache_index(struct soklevelset *set, uint64_t key, size_t srclen, char *comment, int maxcommentlen) {
+  const unsigned char *data = set->data;
+  size_t pos, len, count, i;
+  if ((set->datalen < LEVCACHE_HDRLEN + 1 + 8) || (memcmp(data, LEVCACHE_MAGIC, 8) != 0)) return(-1);
+  if ((get_le(data + 8, 8) != key) || (get_le(data + 16, 8) != (uint64_t)srclen)) return(-1);
+  if (get_le(data + set->datalen - 8, 8) != crc64(0, data, (unsigned int)(set->datalen - 8))) return(-1);
+  count = (size_t)get_le(data + 24, 4);
+  if ((count == 0) || (count > MAXLEVELS)) return(-1);
+  /* the entry holds no more than what has been checked so far */
+  pos = LEVCACHE_HDRLEN;
+  for (i = 0; i < count; i++) {
+    const unsigned char *rec = data + pos;
+    if (set->datalen - 9 - pos < LEVCACHE_RECHDRLEN) return(-1);
+    /* levels are at most SOK_MAXSIZE x SOK_MAXSIZE, comments at most 127
+     * characters long */
+    if ((rec[12] < 1) || (rec[12] > SOK_MAXSIZE) || (rec[13] < 1) || (rec[13] > SOK_MAXSIZE) || (rec[14] >= rec[12]) || (rec[15] >= rec[13]) || (rec[18] > 127)) return(-1);
+    len = LEVCACHE_RECHDRLEN + rec[18] + ((size_t)rec[12] * rec[13] + 1) / 2;
+    if (set->datalen - 9 - pos < len) return(-1);
+    set->info[i].offset = pos;
+    set->info[i].len = len;
+    set->info[i].crc64 = get_le(rec, 8);
+    set->info[i].crc32_106 = (unsigned long)get_le(rec + 8, 4);
+    set->info[i].solution = NULL;
+    pos += len;
+  }
+  if (pos + 1 + data[pos] + 8 != set->datalen) return(-1);
+  set->count = (int)count;
+  if ((comment != NULL) && (maxcommentlen > 0)) {
+    len = data[pos];
+    if (len > (size_t)maxcommentlen - 1) len = (size_t)maxcommentlen - 1;
+    memcpy(comment, data + pos + 1, len);
+    comment[len] = 0;
+  }
+  return(0);
+}
+
+
+struct soklevelset *sok_openset(char *gamelevel, const unsigned char *memptr, size_t filelen, char *comment, int maxcommentlen, int *err) {
+  struct soklevelset *set;
+  struct sokgame *game;
+  struct levstream *stream = NULL;
+  struct levcachebuf cb;
+  unsigned char *filedata = NULL;
+  const unsigned char *src;
+  size_t offset = 0, srclen;
+  int res = 0, filemapped = 0;
+  uint64_t key;
+
+  memset(&cb, 0, sizeof(cb));
+  *err = ERR_MEM_ALLOC_FAILED;
+  set = calloc(1, sizeof(struct soklevelset));
+  if (set == NULL) goto ERR;
+  set->info = malloc(sizeof(struct soklevelinfo) * MAXLEVELS);
+  if (set->info == NULL) goto ERR;
+
+  /* the raw (possibly gzipped) content of the set */
+  if (gamelevel != NULL) {
+    if (sok_mapfile(gamelevel, &filedata, &srclen, &filemapped) != 0) {
+      *err = ERR_UNABLE_TO_OPEN_FILE;
+      goto ERR;
+    }
+    src = filedata;
+  } else if ((memptr != NULL) && (filelen > 0)) {
+    src = memptr;
+    srclen = filelen;
+  } else {
+    *err = ERR_UNABLE_TO_OPEN_FILE;
+    goto ERR;
+  }
+
+  /* levels parsed already? */
+  key = crc64(0, src, (unsigned int)srclen);
+  set->data = levelcache_load(key, &(set->datalen));
+  if (set->data != NULL) {
+    if (levcache_index(set, key, srclen, comment, maxcommentlen) == 0) {
+      set->cached = 1;
+      goto DONE;
+    }
+    free(set->data);
+    set->data = NULL;
+  }
+
+  /* plain files are used straight from their mapping. anything else is
+   * parsed as it gets inflated (or read), the set being then made of its
+   * level cache entry: the text of the set is never held in memory */
+  levcache_grow(&cb, LEVCACHE_HDRLEN);
+  if (filemapped && (isGz(src, srclen) == 0)) {
+    set->data = filedata;
+    set->datalen = srclen;
+    set->mapped = 1;
+    filedata = NULL;
+    stream = levstream_new(NULL, set->data, set->data + set->datalen);
+    if (stream == NULL) goto ERR;
+  } else {
+    struct gzreader *gz = gzr_open(src, srclen, NULL);
+    if (gz == NULL) {
+      *err = ERR_UNABLE_TO_OPEN_FILE;
+      goto ERR;
+    }
+    stream = levstream_new(gz, NULL, NULL);
+    if (stream == NULL) {
+      gzr_close(gz);
+      goto ERR;
+    }
+  }
+
+  /* first pass: parse every level, keeping only its CRCs (and location, in
+   * a mapped file), and filling the level cache entry on the way */
+  while (res == 0) {
+    if (set->mapped) offset = (size_t)(stream->pos - set->data);
+    res = loadlevelfromfile(&game, stream, (set->count == 0) ? comment : NULL, (size_t)maxcommentlen);
+    if (res < 0) break;
+    if (set->count >= MAXLEVELS) {
+      free(game);
+      *err = ERR_TOO_MANY_LEVELS_IN_SET;
+      goto ERR;
+    }
+    if (set->mapped) {
+      set->info[set->count].offset = offset;
+      set->info[set->count].len = (size_t)(stream->pos - set->data) - offset;
+    }
+    set->info[set->count].crc64 = game->crc64;
+    set->info[set->count].crc32_106 = game->crc32_106;
+    set->info[set->count].solution = NULL;
+    set->count++;
+    levcache_addlevel(&cb, game);
+    free(game);
+  }
+  /* a read error means corrupted data (like a truncated gzip file) */
+  if (stream->err != 0) {
+    *err = ERR_UNABLE_TO_OPEN_FILE;
+    goto ERR;
+  }
+  if (set->count == 0) { /* error of the first level */
+    *err = res;
+    goto ERR;
+  }
+
+  /* complete the level cache entry and store it */
+  {
+    size_t commentlen = 0;
+    unsigned char *p;
+    if ((comment != NULL) && (maxcommentlen > 0)) commentlen = strlen(comment);
+    if (commentlen > 255) commentlen = 255;
+    p = levcache_grow(&cb, 1 + commentlen + 8);
+    if (p != NULL) {
+      p[0] = (unsigned char)commentlen;
+      if (commentlen > 0) memcpy(p + 1, comment, commentlen);
+      memcpy(cb.buf, LEVCACHE_MAGIC, 8);
+      put_le(cb.buf + 8, key, 8);
+      put_le(cb.buf + 16, srclen, 8);
+      put_le(cb.buf + 24, (uint64_t)set->count, 4);
+      put_le(cb.buf + cb.len - 8, crc64(0, cb.buf, (unsigned int)(cb.len - 8)), 8);
+      levelcache_save(key, cb.buf, cb.len);
+    }
+  }
+
+  /* a set that is not mapped is served from its level cache entry */
+  if (set->mapped == 0) {
+    if (cb.err != 0) goto ERR;
+    set->data = cb.buf;
+    set->datalen = cb.len;
+    cb.buf = NULL;
+    if (levcache_index(set, key, srclen, NULL, 0) != 0) goto ERR;
+    set->cached = 1;
+  }
+
+  DONE:
+  set->games = calloc((size_t)set->count, sizeof(struct sokgame *));
+  if (set->games == NULL) goto ERR;
+
+  if (filedata != NULL) sok_unmapfile(filedata, srclen, filemapped);
+  free(cb.buf);
+  if ((stream != NULL) && (stream->gz != NULL)) gzr_close(stream->gz);
+  levstream_free(stream);
+  *err = 0;
+  return(set);
+
+  ERR:
+  if (filedata != NULL) sok_unmapfile(filedata, srclen, filemapped);
+  free(cb.buf);
+  if ((stream != NULL) && (stream->gz != NULL)) gzr_close(stream->gz);
+  levstream_free(stream);
+  sok_closeset(set);
+  return(NULL);
+}
+
+
+struct sokgame *sok_getlevel(struct soklevelset *set, int id) {
+  struct sokgame *game = NULL;
+  struct levstream *stream;
+  if (set->games[id] != NULL) return(set->games[id]);
+
+  if (set->cached) {
+    game = levcache_getlevel(set->data + set->info[id].offset);
+  } else {
+    stream = levstream_new(NULL, set->data + set->info[id].offset, set->data + set->info[id].offset + set->info[id].len);
+    /* the level has been parsed once already, so it can only fail on out
+     * of memory now */
+    if (stream != NULL) loadlevelfromfile(&game, stream, NULL, 0);
+    levstream_free(stream);
+  }
+  if (game == NULL) return(NULL);
+  game->bitboard = bb_new(game);
+  game->level = (unsigned short)(id + 1);
+  game->solution = set->info[id].solution;
+  set->games[id] = game;
+  sok_indexlevel(game);
+  return(game);
+}
+
+
+void sok_indexset(const struct soklevelset *set, const char *name) {
+  uint64_t *crcs;
+  int x;
+  crcs = malloc((size_t)set->count * sizeof(uint64_t) + 1);
+  if (crcs == NULL) return;
+  for (x = 0; x < set->count; x++) crcs[x] = set->info[x].crc64;
+  levindex_addset(name, set->count, crcs);
+  free(crcs);
+}
+
+
+void sok_loadsetsolutions(struct soklevelset *set) {
+  struct soklevelinfo *info;
+  unsigned long gen = solution_generation();
+  int x;
+  if (set->solgen == gen) return; /* nothing changed since last time */
+  set->solgen = gen;
+  for (x = 0; x < set->count; x++) {
+    info = &(set->info[x]);
+    ml_free(info->solution);
+    info->solution = solution_load(info->crc64, "sol");
+    /* no solution found: look for a solution under the pre-1.0.7 CRC32 */
+    if (info->solution == NULL) info->solution = solution_load(info->crc32_106, "dat");
+    if (set->games[x] != NULL) set->games[x]->solution = info->solution;
+  }
+}
+
+
+void sok_closeset(struct soklevelset *set) {
+  int x;
+  if (set == NULL) return;
+  for (x = 0; x < set->count; x++) {
+    if (set->games != NULL) {
+      if (set->games[x] != NULL) set->games[x]->solution = NULL; /* owned by info */
+      sok_freegame(set->games[x]);
+    }
+    ml_free(set->info[x].solution);
+  }
+  free(set->games);
+  free(set->info);
+  if (set->data != NULL) sok_unmapfile(set->data, set->datalen, set->mapped);
+  free(set);
+}
+
+
 /* reloads solutions for all levels in a list */
 void sok_loadsolutions(struct sokgame **gamelist, int levelscount) {
   int x = 0;
   for (x = 0; x < levelscount; x++) {
+    ml_free(gamelist[x]->solution);
     gamelist[x]->solution = solution_load(gamelist[x]->crc64, "sol");
     /* no solution found: look for a solution under the pre-1.0.7 CRC32 */
     if (gamelist[x]->solution == NULL) {
@@ -448,51 +1273,136 @@ void sok_loadsolutions(struct sokgame **gamelist, int levelscount) {
   }
 }
 
+/* returns non-zero if all goals are filled and at least 1 push was made */
+static int sok_issolved(const struct sokgame *game, const struct sokgamestates *states) {
+  if (game->goalsleft != 0) return(0);
+
+  /* no non-filled goal left = level completed! (but only if at least 1 push was made) */
+  if (states == NULL) return(0);
+  if (ml_pushcount(states->history) == 0) return(0);
+  return(1);
+}
+
 /* checks if level is solved yet. returns 0 if not, non-zero otherwise. */
 int sok_checksolution(struct sokgame *game, struct sokgamestates *states) {
-  unsigned short x, y;
   size_t bestscorelen, bestscorepushes, myscorelen, myscorepushes, betterflag = 0;
-  for (y = 0; y < game->field_height; y++) {
-    for (x = 0; x < game->field_width; x++) {
-      if (((game->field[x][y] & field_goal) != 0) && ((game->field[x][y] & field_atom) == 0)) return(0);
-    }
+  uint64_t perfstart = perf_begin();
+  if (sok_issolved(game, states) == 0) {
+    perf_end(perf_checksolution, perfstart);
+    return(0);
   }
 
-  /* no non-filled goal found = level completed! (but only if at least 1 push was made) */
-  if (states == NULL) return(0);
-  if (sok_history_getpushes(states->history) == 0) return(0);
-
   /* Check if the solution is better than the one we had so far */
-  bestscorelen = sok_history_getlen(game->solution);
-  bestscorepushes = sok_history_getpushes(game->solution);
-  myscorelen = sok_history_getlen(states->history);
-  myscorepushes = sok_history_getpushes(states->history);
+  bestscorelen = ml_count(game->solution);
+  bestscorepushes = ml_pushcount(game->solution);
+  myscorelen = ml_count(states->history);
+  myscorepushes = ml_pushcount(states->history);
   if (bestscorelen < 1) betterflag = 1;
   if (bestscorelen > myscorelen) betterflag = 1;
   if ((bestscorelen == myscorelen) && (bestscorepushes > myscorepushes)) betterflag = 1;
   /* if our solution is better, save it */
   if (betterflag != 0) solution_save(game->crc64, states->history, "sol");
+  perf_end(perf_checksolution, perfstart);
   return(1);
 }
 
 
-int sok_move(struct sokgame *game, enum SOKMOVE dir, int validitycheck, struct sokgamestates *states) {
-  int res = 0;
-  int x, y, vectorx = 0, vectory = 0, alreadysolved;
-  char historychar = ' ';
-  size_t movescount;
-  movescount = sok_history_getlen(states->history);
-  /* first of all let's check if we have enough place in history for a potential move - if not, realloc some place */
-  if (movescount + 3 >= states->historyallocsize) {
-    states->historyallocsize *= 2;
-    states->history = realloc(states->history, states->historyallocsize);
-    if (states->history == NULL) {
-      printf("failed to allocate %lu bytes for history buffer!\n", (unsigned long)(states->historyallocsize));
-      return(ERR_MEM_ALLOC_FAILED);
+/* every KEYFRAME_INTERVAL moves the position is recorded, so any point of
+ * the history is reached by replaying (or undoing) at most that many moves */
+#define KEYFRAME_INTERVAL 64
+
+struct sokkeyframes {
+  size_t count;        /* keyframe i is the position after i * KEYFRAME_INTERVAL moves */
+  size_t alloc;        /* bytes allocated for data */
+  size_t atoms;        /* number of atoms of the level */
+  unsigned char *data; /* x,y of the player then x,y of every atom, for each keyframe */
+};
+
+#define KEYFRAME_LEN(kf) (2 + (kf)->atoms * 2)
+
+static size_t keyframe_count(const struct sokgamestates *states) {
+  if (states->keyframes == NULL) return(0);
+  return(states->keyframes->count);
+}
+
+/* records the current position as the next keyframe. a keyframe that cannot
+ * be recorded is not fatal, seeking only gets slower. */
+static void keyframe_record(const struct sokgame *game, struct sokgamestates *states) {
+  struct sokkeyframes *kf = states->keyframes;
+  unsigned char *rec;
+  size_t atoms = 0;
+  int x, y;
+
+  if (kf == NULL) {
+    kf = calloc(1, sizeof(struct sokkeyframes));
+    if (kf == NULL) return;
+    states->keyframes = kf;
+  }
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      if (SOK_FIELD(game, x, y) & field_atom) atoms++;
     }
   }
-  /* now let's do our real stuff */
-  alreadysolved = sok_checksolution(game, NULL);
+  if (kf->count == 0) {
+    kf->atoms = atoms;
+  } else if (atoms != kf->atoms) {
+    return;
+  }
+  if ((kf->count + 1) * KEYFRAME_LEN(kf) > kf->alloc) {
+    size_t newalloc = (kf->count + 16) * KEYFRAME_LEN(kf) * 2;
+    unsigned char *newdata = realloc(kf->data, newalloc);
+    if (newdata == NULL) return;
+    kf->data = newdata;
+    kf->alloc = newalloc;
+  }
+
+  rec = kf->data + kf->count * KEYFRAME_LEN(kf);
+  *(rec++) = (unsigned char)game->positionx;
+  *(rec++) = (unsigned char)game->positiony;
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      if ((SOK_FIELD(game, x, y) & field_atom) == 0) continue;
+      *(rec++) = (unsigned char)x;
+      *(rec++) = (unsigned char)y;
+    }
+  }
+  kf->count++;
+}
+
+/* puts the player and atoms where keyframe id tells */
+static void keyframe_restore(struct sokgame *game, const struct sokgamestates *states, size_t id) {
+  const struct sokkeyframes *kf = states->keyframes;
+  const unsigned char *rec = kf->data + id * KEYFRAME_LEN(kf);
+  size_t i;
+  int x, y;
+
+  game->positionx = rec[0];
+  game->positiony = rec[1];
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) SOK_FIELD(game, x, y) &= ~field_atom;
+  }
+  for (i = 0; i < kf->atoms; i++) SOK_FIELD(game, rec[2 + i * 2], rec[3 + i * 2]) |= field_atom;
+  game->goalsleft = 0;
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      if ((SOK_FIELD(game, x, y) & (field_goal | field_atom)) == field_goal) game->goalsleft++;
+    }
+  }
+}
+
+/* forgets keyframes of positions beyond the first moves of the history */
+static void keyframe_truncate(struct sokgamestates *states, size_t moves) {
+  if (keyframe_count(states) > moves / KEYFRAME_INTERVAL + 1) states->keyframes->count = moves / KEYFRAME_INTERVAL + 1;
+}
+
+/* performs a move (or only checks its validity), without looking whether the
+ * level got solved. returns a negative value if move has been denied, or a
+ * sokmove bitfield otherwise. alreadysolved tells whether the level was
+ * solved before the move. */
+static int sok_domove(struct sokgame *game, enum SOKMOVE dir, int validitycheck, struct sokgamestates *states, int alreadysolved) {
+  int res = 0;
+  int x, y, vectorx = 0, vectory = 0;
+  int move = mlmove_up;
   x = game->positionx;
   y = game->positiony;
   switch (dir) {
@@ -500,56 +1410,97 @@ int sok_move(struct sokgame *game, enum SOKMOVE dir, int validitycheck, struct s
     case sokmoveUP:
       vectory = -1;
       states->angle = 0;
-      historychar = 'u';
+      move = mlmove_up;
       break;
     case sokmoveRIGHT:
       vectorx = 1;
       states->angle = 90;
-      historychar = 'r';
+      move = mlmove_right;
       break;
     case sokmoveDOWN:
       vectory = 1;
       states->angle = 180;
-      historychar = 'd';
+      move = mlmove_down;
       break;
     case sokmoveLEFT:
       vectorx = -1;
       states->angle = 270;
-      historychar = 'l';
+      move = mlmove_left;
       break;
   }
 
-  if (y < 1) return(-1);
-  if (game->field[x + vectorx][y + vectory] & field_wall) return(-1);
+  /* never leave the level's bounding box */
+  if (SOK_OUTSIDE(game, x + vectorx, y + vectory)) return(-1);
+  if (SOK_FIELD(game, x + vectorx, y + vectory) & field_wall) return(-1);
   /* is there an atom on our way? */
-  if (game->field[x + vectorx][y + vectory] & field_atom) {
+  if (SOK_FIELD(game, x + vectorx, y + vectory) & field_atom) {
     if (alreadysolved != 0) return(-1);
-    if ((y + vectory < 1) || (y + vectory > 62) || (x + vectorx < 1) || (x + vectorx > 62)) return(-1);
-    if (game->field[x + vectorx * 2][y + vectory * 2] & (field_wall | field_atom)) return(-1);
+    if (SOK_OUTSIDE(game, x + vectorx * 2, y + vectory * 2)) return(-1);
+    if (SOK_FIELD(game, x + vectorx * 2, y + vectory * 2) & (field_wall | field_atom)) return(-1);
     res |= sokmove_pushed;
-    if (game->field[x + vectorx * 2][y + vectory * 2] & field_goal) res |= sokmove_ongoal;
-    if (validitycheck == 0) {
-      historychar -= 32; /* change historical move to uppercase to mark a push action */
-      game->field[x + vectorx][y + vectory] &= ~field_atom;
-      game->field[x + vectorx * 2][y + vectory * 2] |= field_atom;
-    }
+    if (SOK_FIELD(game, x + vectorx * 2, y + vectory * 2) & field_goal) res |= sokmove_ongoal;
+    move |= mlmove_push;
   }
   if (validitycheck == 0) {
-    states->history[movescount] = historychar;
-    states->history[movescount + 1] = 0; /* makes it a null-terminated string in case anyone would want to print it as-is */
+    if (keyframe_count(states) * KEYFRAME_INTERVAL == ml_count(states->history)) keyframe_record(game, states);
+    /* record the move first, so nothing changes if memory runs out */
+    if (ml_append(states->history, move) != 0) {
+      puts("failed to allocate memory for history buffer!");
+      return(ERR_MEM_ALLOC_FAILED);
+    }
+    /* playing the next move to redo keeps the other ones, any other move
+     * starts a new history */
+    if (ml_count(states->redo) > 0) {
+      if (ml_get(states->redo, ml_count(states->redo) - 1) == move) {
+        ml_undo(states->redo);
+      } else {
+        ml_clear(states->redo);
+        keyframe_truncate(states, ml_count(states->history) - 1);
+      }
+    }
+    if (res & sokmove_pushed) {
+      SOK_FIELD(game, x + vectorx, y + vectory) &= ~field_atom;
+      SOK_FIELD(game, x + vectorx * 2, y + vectory * 2) |= field_atom;
+      if (SOK_FIELD(game, x + vectorx, y + vectory) & field_goal) game->goalsleft += 1;
+      if (res & sokmove_ongoal) game->goalsleft -= 1;
+    }
     game->positiony += vectory;
     game->positionx += vectorx;
   }
-  if ((alreadysolved == 0) && (sok_checksolution(game, states) != 0)) res |= sokmove_solved;
+  return(res);
+}
+
+
+int sok_move(struct sokgame *game, enum SOKMOVE dir, int validitycheck, struct sokgamestates *states) {
+  int res, alreadysolved;
+  uint64_t perfstart = perf_begin();
+  alreadysolved = sok_checksolution(game, NULL);
+  res = sok_domove(game, dir, validitycheck, states, alreadysolved);
+  if ((res >= 0) && (alreadysolved == 0) && (sok_checksolution(game, states) != 0)) res |= sokmove_solved;
+  perf_end(perf_move, perfstart);
   return(res);
 }
 
 void sok_resetstates(struct sokgamestates *states) {
-  if (states->history != NULL) free(states->history);
+  struct sokmovelist *history = states->history;
+  struct sokmovelist *redo = states->redo;
+  struct sokkeyframes *keyframes = states->keyframes;
   memset(states, 0, sizeof(struct sokgamestates));
-  states->historyallocsize = 64;
-  states->history = malloc(states->historyallocsize);
-  if (states->history != NULL) memset(states->history, 0, states->historyallocsize);
+  /* buffers are kept for the next game */
+  if (history != NULL) {
+    ml_clear(history);
+  } else {
+    history = ml_new();
+  }
+  if (redo != NULL) {
+    ml_clear(redo);
+  } else {
+    redo = ml_new();
+  }
+  if (keyframes != NULL) keyframes->count = 0;
+  states->history = history;
+  states->redo = redo;
+  states->keyframes = keyframes;
 }
 
 struct sokgamestates *sok_newstates(void) {
@@ -558,79 +1509,165 @@ struct sokgamestates *sok_newstates(void) {
   if (result == NULL) return(NULL);
   memset(result, 0, sizeof(struct sokgamestates));
   sok_resetstates(result);
+  if ((result->history == NULL) || (result->redo == NULL)) {
+    sok_freestates(result);
+    return(NULL);
+  }
   return(result);
 }
 
 void sok_freestates(struct sokgamestates *states) {
   if (states == NULL) return;
-  if (states->history != NULL) free(states->history);
+  ml_free(states->history);
+  ml_free(states->redo);
+  if (states->keyframes != NULL) free(states->keyframes->data);
+  free(states->keyframes);
   free(states);
 }
 
 void sok_undo(struct sokgame *game, struct sokgamestates *states) {
-  int movex = 0, movey = 0;
-  size_t movescount;
-  movescount = sok_history_getlen(states->history);
+  int movex = 0, movey = 0, move;
+  size_t movescount = ml_count(states->history);
   if (movescount < 1) return;
-  movescount -= 1;
-  switch (states->history[movescount]) {
-    case 'u':
-    case 'U':
+  move = ml_get(states->history, movescount - 1);
+  switch (move & 3) {
+    case mlmove_up:
       movey = 1;
       states->angle = 0;
       break;
-    case 'r':
-    case 'R':
+    case mlmove_right:
       movex = -1;
       states->angle = 90;
       break;
-    case 'd':
-    case 'D':
+    case mlmove_down:
       movey = -1;
       states->angle = 180;
       break;
-    case 'l':
-    case 'L':
+    case mlmove_left:
       movex = 1;
       states->angle = 270;
       break;
   }
   /* if it was a PUSH action, then move the atom back */
-  if ((states->history[movescount] >= 'A') && ((states->history[movescount] <= 'Z'))) {
-    game->field[game->positionx - movex][game->positiony - movey] &= ~field_atom;
-    game->field[game->positionx][game->positiony] |= field_atom;
+  if (move & mlmove_push) {
+    SOK_FIELD(game, game->positionx - movex, game->positiony - movey) &= ~field_atom;
+    SOK_FIELD(game, game->positionx, game->positiony) |= field_atom;
+    if (SOK_FIELD(game, game->positionx - movex, game->positiony - movey) & field_goal) game->goalsleft += 1;
+    if (SOK_FIELD(game, game->positionx, game->positiony) & field_goal) game->goalsleft -= 1;
   }
   game->positionx += movex;
   game->positiony += movey;
-  states->history[movescount] = 0;
+  ml_undo(states->history);
+  /* keep the move for redo, or forget all of them if memory runs out */
+  if (ml_append(states->redo, move) != 0) {
+    ml_clear(states->redo);
+    keyframe_truncate(states, movescount - 1);
+  }
 }
 
-void sok_play(struct sokgame *game, struct sokgamestates *states, char *playfile) {
-  if (playfile == NULL) return;
-  while (*playfile != 0) {
-    enum SOKMOVE playmove;
-    switch (*playfile) {
-      case 'u':
-      case 'U':
-        playmove = sokmoveUP;
-        break;
-      case 'r':
-      case 'R':
-        playmove = sokmoveRIGHT;
-        break;
-      case 'd':
-      case 'D':
-        playmove = sokmoveDOWN;
-        break;
-      case 'l':
-      case 'L':
-        playmove = sokmoveLEFT;
-        break;
-      default:
-        playmove = sokmoveLEFT;
-        break;
+/* moves the last n moves of list from to the end of list to, last one
+ * first. returns 0 on success, or -1 (lists being left untouched) if memory
+ * runs out. */
+static int ml_transfer(struct sokmovelist *to, struct sokmovelist *from, size_t n) {
+  size_t i;
+  for (i = 0; i < n; i++) {
+    if (ml_append(to, ml_get(from, ml_count(from) - 1)) != 0) break;
+    ml_undo(from);
+  }
+  if (i == n) return(0);
+  /* put back what was moved already */
+  while (i-- > 0) {
+    ml_append(from, ml_get(to, ml_count(to) - 1));
+    ml_undo(to);
+  }
+  return(-1);
+}
+
+size_t sok_seek(struct sokgame *game, struct sokgamestates *states, size_t pos) {
+  size_t cur = ml_count(states->history);
+  size_t base, direct;
+  size_t kf = pos / KEYFRAME_INTERVAL;
+
+  if (pos > cur + ml_count(states->redo)) pos = cur + ml_count(states->redo);
+  if (kf >= keyframe_count(states)) kf = keyframe_count(states) - 1;
+
+  /* jump to the closest keyframe first, if that saves moves */
+  direct = (pos > cur) ? pos - cur : cur - pos;
+  base = kf * KEYFRAME_INTERVAL;
+  if ((keyframe_count(states) > 0) && (base != cur) && (pos - base < direct)) {
+    int res;
+    if (base < cur) {
+      res = ml_transfer(states->redo, states->history, cur - base);
+    } else {
+      res = ml_transfer(states->history, states->redo, base - cur);
+    }
+    if (res == 0) {
+      static const int angles[4] = {0, 270, 180, 90}; /* of mlmove_xxx directions */
+      keyframe_restore(game, states, kf);
+      if (base > 0) states->angle = angles[ml_get(states->history, base - 1) & 3];
+      cur = base;
+    }
+  }
+
+  while (cur > pos) {
+    sok_undo(game, states);
+    cur--;
+  }
+  while (cur < pos) {
+    int move = ml_get(states->redo, ml_count(states->redo) - 1);
+    if (sok_domove(game, sok_ml2move(move), 0, states, 0) < 0) break;
+    cur++;
+  }
+  return(cur);
+}
+
+enum SOKMOVE sok_char2move(char c) {
+  switch (c) {
+    case 'u':
+    case 'U':
+      return(sokmoveUP);
+    case 'r':
+    case 'R':
+      return(sokmoveRIGHT);
+    case 'd':
+    case 'D':
+      return(sokmoveDOWN);
+    case 'l':
+    case 'L':
+      return(sokmoveLEFT);
+    default:
+      return(sokmoveLEFT);
+  }
+}
+
+enum SOKMOVE sok_ml2move(int move) {
+  /* move list directions are those of enum SOKMOVE, minus 1 */
+  return((enum SOKMOVE)((move & 3) + 1));
+}
+
+void sok_play(struct sokgame *game, struct sokgamestates *states, const struct sokmovelist *moves) {
+  size_t i;
+  for (i = 0; i < ml_count(moves); i++) {
+    sok_move(game, sok_ml2move(ml_get(moves, i)), 0, states);
+  }
+}
+
+int sok_replay(struct sokgame *game, struct sokgamestates *states, const struct sokmovelist *moves, size_t *failpos) {
+  size_t i;
+  if (failpos != NULL) *failpos = 0;
+  if (moves == NULL) return(0);
+  for (i = 0; i < ml_count(moves); i++) {
+    int move = ml_get(moves, i);
+    int res = sok_domove(game, sok_ml2move(move), 0, states, 0);
+    if (res < 0) {
+      if (failpos != NULL) *failpos = i;
+      return(-1);
+    }
+    /* the move must be recorded as what it does: a push or a walk */
+    if (((move & mlmove_push) != 0) != ((res & sokmove_pushed) != 0)) {
+      if (failpos != NULL) *failpos = i;
+      return(-2);
     }
-    sok_move(game, playmove, 0, states);
-    playfile += 1;
   }
+  return(sok_issolved(game, states));
 }
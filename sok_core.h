@@ -27,30 +27,73 @@
 #ifndef sok_core_h_sentinel
 #define sok_core_h_sentinel
 
+  #include <stddef.h> /* size_t */
   #include <stdint.h>
 
+  /* maximum number of levels in a level set */
+  #define MAXLEVELS 4096
+
+  /* maximum width and height of a level, so coordinates always fit a byte */
+  #define SOK_MAXSIZE 254
+
   #define field_floor 1
   #define field_atom 2
   #define field_goal 4
   #define field_wall 8
 
+  /* bits of wallmask[x][y], each telling that the corresponding neighbour of
+   * the (x,y) cell is a wall:
+   *
+   * 128 064 032
+   * 016     008
+   * 004 002 001 */
+  #define wallmask_topleft 128
+  #define wallmask_top 64
+  #define wallmask_topright 32
+  #define wallmask_left 16
+  #define wallmask_right 8
+  #define wallmask_bottomleft 4
+  #define wallmask_bottom 2
+  #define wallmask_bottomright 1
+
+  struct sokbitboard; /* see bitboard.h */
+  struct sokmovelist; /* see movelist.h */
+
+  /* the field is stored row by row, surrounded by a border of one cell of
+   * outside (0) on every side: cell (x,y) exists for x in -1..field_width and
+   * y in -1..field_height, so neighbours of any cell of the level can be
+   * looked at without bound checks */
+  #define SOK_STRIDE(game) ((game)->field_width + 2)
+  #define SOK_CELLS(game) ((size_t)SOK_STRIDE(game) * ((game)->field_height + 2))
+  #define SOK_INDEX(game, x, y) (((y) + 1) * SOK_STRIDE(game) + (x) + 1)
+  #define SOK_FIELD(game, x, y) ((game)->field[SOK_INDEX(game, x, y)])
+  #define SOK_WALLMASK(game, x, y) ((game)->wallmask[SOK_INDEX(game, x, y)])
+  /* non-zero if (x,y) lies out of the level's bounding box */
+  #define SOK_OUTSIDE(game, x, y) (((x) < 0) || ((y) < 0) || ((x) >= (game)->field_width) || ((y) >= (game)->field_height))
+
   struct sokgame {
     unsigned short field_width;
     unsigned short field_height;
-    unsigned char field[64][64];
+    unsigned char *field;    /* SOK_CELLS() cells, see SOK_FIELD() */
+    unsigned char *wallmask; /* walls around each cell, see below */
     char comment[128];
     int positionx;
     int positiony;
+    unsigned short goalsleft; /* number of goals that have no atom on them */
     unsigned short level;
     uint64_t crc64;
     unsigned long crc32_106; /* CRC32 as it was (badly) computed by v1.0.6 and earlier */
-    char *solution;
+    struct sokmovelist *solution;
+    struct sokbitboard *bitboard; /* bitsets of the initial position, may be NULL */
   };
 
+  struct sokkeyframes; /* position snapshots, private to sok_core.c */
+
   struct sokgamestates {
     int angle;
-    char *history;
-    size_t historyallocsize;
+    struct sokmovelist *history; /* moves played so far */
+    struct sokmovelist *redo;    /* moves undone, the next one to redo last */
+    struct sokkeyframes *keyframes; /* positions recorded along the history, may be NULL */
   };
 
   enum SOKMOVE {
@@ -70,20 +113,77 @@
 
   void sok_freefile(struct sokgame **gamelist, int gamescount);
 
+  /* returns a copy of game to play on, or NULL on out of memory. the copy
+   * shares the solution and bitboard of game, so it must not outlive it. it
+   * is freed with free(). */
+  struct sokgame *sok_copygame(const struct sokgame *game);
+
+  /* what is known about a level of a set without parsing it */
+  struct soklevelinfo {
+    size_t offset;           /* position of the level in the set's data */
+    size_t len;              /* length of the level's data */
+    uint64_t crc64;
+    unsigned long crc32_106;
+    struct sokmovelist *solution; /* loaded by sok_loadsetsolutions(), or NULL */
+  };
+
+  /* a level set whose levels are parsed only when needed */
+  struct soklevelset {
+    int count;                  /* number of levels in the set */
+    struct soklevelinfo *info;  /* count entries */
+    struct sokgame **games;     /* count entries, NULL until parsed */
+    unsigned char *data;        /* uncompressed content of the set */
+    size_t datalen;
+    int mapped;                 /* non-zero if data is a mapped file */
+    int cached;                 /* non-zero if data is a level cache entry */
+    unsigned long solgen;       /* solution_generation() of loaded solutions, 0 if none loaded */
+  };
+
+  /* opens a level set from file gamelevel, or from memory if gamelevel is
+   * NULL. the set's content is memory-mapped (or held in memory if it is
+   * gzipped) and merely indexed: levels are parsed later by sok_getlevel().
+   * parsed levels are kept in a cache, so sets opened before are loaded
+   * without being parsed at all.
+   * returns NULL on error, *err being set to a non-positive error code. */
+  struct soklevelset *sok_openset(char *gamelevel, const unsigned char *memptr, size_t filelen, char *comment, int maxcommentlen, int *err);
+
+  /* returns level id (0-based) of set, parsing it on first call. returns NULL
+   * on out of memory. the level's solution is owned by the set. */
+  struct sokgame *sok_getlevel(struct soklevelset *set, int id);
+
+  /* records the levels of set in the level index under name (see save.h).
+   * levels get their dimensions indexed as sok_getlevel() parses them. */
+  void sok_indexset(const struct soklevelset *set, const char *name);
+
+  /* (re)loads solutions for all levels of a set, unless no solution has been
+   * saved since they were last loaded */
+  void sok_loadsetsolutions(struct soklevelset *set);
+
+  void sok_closeset(struct soklevelset *set);
+
   /* checks if the game is solved. returns 0 if the game is not solved, non-zero otherwise. */
   int sok_checksolution(struct sokgame *game, struct sokgamestates *states);
 
   /* try to move the player in a direction. returns a negative value if move has been denied, or a sokmove bitfield otherwise. */
   int sok_move(struct sokgame *game, enum SOKMOVE dir, int validitycheck, struct sokgamestates *states);
 
-  /* undo last move */
+  /* undo last move. undone moves are kept to be redone, until a move other
+   * than the next one to redo is played. */
   void sok_undo(struct sokgame *game, struct sokgamestates *states);
 
-  /* returns the number of moves in a history string */
-  size_t sok_history_getlen(const char *history);
+  /* goes back or forth in the history (redoing undone moves) to the
+   * position after pos moves, at the cost of a few dozens of moves at most,
+   * however far pos is. returns the number of moves played after seeking. */
+  size_t sok_seek(struct sokgame *game, struct sokgamestates *states, size_t pos);
+
+  /* returns the number of moves played so far */
+  size_t sok_states_getmoves(const struct sokgamestates *states);
+
+  /* returns the number of pushes played so far */
+  size_t sok_states_getpushes(const struct sokgamestates *states);
 
-  /* returns the number of pushes in a history string */
-  size_t sok_history_getpushes(const char *history);
+  /* returns the number of undone moves that can be redone */
+  size_t sok_states_getredo(const struct sokgamestates *states);
 
   /* reset game's states */
   void sok_resetstates(struct sokgamestates *states);
@@ -100,7 +200,31 @@
   /* returns a human string for error code */
   char *sok_strerr(int errid);
 
-  /* plays a string of moves */
-  void sok_play(struct sokgame *game, struct sokgamestates *states, char *playfile);
+  /* computes the shortest walk of the player to (x,y), atoms being obstacles.
+   * returns a malloc'ed string of moves (empty if the player stands on (x,y)
+   * already), or NULL if (x,y) cannot be reached. */
+  char *sok_walkpath(const struct sokgame *game, int x, int y);
+
+  /* computes the moves pushing the atom at (atomx,atomy) to (x,y) with the
+   * fewest pushes, all other atoms staying in place. the moves stop as soon
+   * as the level gets solved on the way. returns a malloc'ed string of moves,
+   * or NULL if the atom cannot be pushed there. */
+  char *sok_pushpath(const struct sokgame *game, int atomx, int atomy, int x, int y);
+
+  /* translates a history character into a move direction */
+  enum SOKMOVE sok_char2move(char c);
+
+  /* translates a move list entry into a move direction */
+  enum SOKMOVE sok_ml2move(int move);
+
+  /* plays a list of moves */
+  void sok_play(struct sokgame *game, struct sokgamestates *states, const struct sokmovelist *moves);
+
+  /* replays a list of moves without any side effect (unlike sok_play(), no
+   * solution is ever saved). returns 1 if the level is solved once all moves
+   * are played, 0 if it is not, -1 if a move was illegal, or -2 if a move
+   * pushes an atom while not recorded as a push (or the other way round). in
+   * the latter cases *failpos is set to the offset of the offending move. */
+  int sok_replay(struct sokgame *game, struct sokgamestates *states, const struct sokmovelist *moves, size_t *failpos);
 
 #endif
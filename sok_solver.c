@@ -0,0 +1,876 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>   /* malloc(), realloc(), free() */
+#include <string.h>   /* memset(), memcpy(), memcmp() */
+#include <time.h>     /* time() */
+
+#include "bitboard.h"
+#include "compat-sdl.h" /* mutexes and atomics */
+#include "pool.h"
+#include "sok_core.h"
+
+#include "sok_solver.h" /* include self for control */
+
+/*
+ * The solver performs an A* search over push-states: a state is the set of
+ * box positions plus the area the player can reach, so all the walking
+ * between two pushes is collapsed into a single edge. The cost of a state is
+ * the number of pushes, the heuristic is the sum of the push distances of
+ * every box to its nearest goal. Visited states are kept in a transposition
+ * table keyed by a Zobrist hash. Pushes that lead to a dead cell (from which
+ * a box can never reach any goal) or to a 2x2 block of boxes and walls with
+ * a box off goal are pruned. Once a solution is found, the player's walks
+ * are rebuilt by a BFS between pushes.
+ *
+ * Move generation works on bitboards (see bitboard.h): the player's area is
+ * a word-wide flood fill and the pushable boxes of each direction come out
+ * of a few AND and shift operations per row.
+ *
+ * The search may run on several threads. Each worker owns an open list that
+ * it pops best states from and pushes the states it generates to; a worker
+ * that runs dry steals the best state of another worker. The transposition
+ * table is shared, split in shards that have a lock each. With a single
+ * worker this is plain A* and solutions are push-optimal, with more workers
+ * the first solution found wins, which may take a few more pushes.
+ */
+
+#define UNREACHABLE 0xFFFF
+#define SHARDBITS 6
+#define SHARDS (1 << SHARDBITS)
+#define CHUNKNODES 4096
+
+static const char dirchars[4] = {'u', 'r', 'd', 'l'};
+
+/* a push-state. it is followed in memory by its sorted box positions */
+struct solvnode {
+  uint64_t hash;
+  struct solvnode *parent;
+  unsigned short player;   /* normalized player position (top-left-most reachable cell) */
+  unsigned short pushfrom; /* position of the box before the push that led to this state */
+  unsigned short g;        /* pushes performed since the initial state */
+  unsigned short h;        /* lower bound of pushes left */
+  unsigned char pushdir;
+};
+
+#define NODEBOXES(n) ((unsigned short *)((unsigned char *)(n) + sizeof(struct solvnode)))
+
+struct heapentry {
+  struct solvnode *node;
+  unsigned short f;
+  unsigned short h;
+};
+
+/* a slice of the transposition table */
+struct ttshard {
+  CSDL_Mutex *lock;
+  struct solvnode **slots;
+  uint32_t size;            /* always a power of 2 */
+  uint32_t count;
+};
+
+struct solver;
+
+struct solvworker {
+  struct solver *s;
+  int id;
+  CSDL_Mutex *lock;         /* protects the open list, other workers steal from it */
+  struct heapentry *heap;   /* open list, as a binary heap ordered by f then h */
+  uint32_t heapcount;
+  uint32_t heapalloc;
+  unsigned char *chunk;     /* where the next node of this worker goes */
+  size_t chunkfree;         /* nodes left in chunk */
+  /* scratch buffers */
+  unsigned char *box;       /* box occupancy of the state being worked on */
+  uint64_t bbox[BB_MAXROWS];   /* same as bitsets */
+  uint64_t reach[BB_MAXROWS];  /* player's area of the state being expanded */
+  uint64_t creach[BB_MAXROWS]; /* player's area of the child being generated */
+  uint64_t push[BB_MAXROWS];   /* boxes that can be pushed in a direction */
+  unsigned int *visited;    /* marks of the BFS that rebuilds walks */
+  unsigned int stamp;
+  unsigned short *queue;
+  unsigned short *pbox;     /* boxes of the state being expanded */
+  unsigned short *cbox;     /* boxes of the child being generated */
+  unsigned long expanded;
+};
+
+struct solver {
+  /* the board, read-only once the search started */
+  int width;                /* width of the board, including a 1-cell wall border */
+  int cells;
+  int delta[4];             /* cell offsets of the u, r, d, l directions */
+  int boxcount;
+  int goalcount;
+  int strict;               /* as many boxes as goals: every box must end on a goal */
+  unsigned char *wall;      /* non-zero if the cell can never be entered */
+  unsigned char *goal;
+  unsigned short *mindist;  /* pushes needed to bring a box to the nearest goal */
+  uint64_t *zbox;
+  uint64_t *zplayer;
+  const struct sokbitboard *bb;
+  struct sokbitboard *ownbb;  /* bitboard built by the solver, if the game had none */
+  uint64_t live[BB_MAXROWS];  /* cells a box may be pushed to */
+  size_t nodesize;          /* struct solvnode plus its boxes, 8-bytes aligned */
+  /* search state */
+  struct ttshard shards[SHARDS];
+  struct solvworker *workers;
+  int workercount;
+  CSDL_AtomicInt pending;   /* open list entries not processed yet, over all workers */
+  CSDL_AtomicInt stop;      /* set once the search must end */
+  int (*cancel)(void *ctx);
+  void *cancelctx;
+  unsigned long maxtime;
+  time_t starttime;
+  CSDL_Mutex *lock;         /* protects all fields below */
+  int result;
+  struct solvnode *solved;
+  void *chunks;             /* all node chunks, linked by their first pointer */
+  size_t memused;
+  size_t maxmemory;
+};
+
+
+/* (re)allocates a block, keeping track of total memory use. returns NULL if
+ * the memory limit would be exceeded or if allocation fails */
+static void *solver_realloc(struct solver *s, void *ptr, size_t oldsz, size_t newsz) {
+  void *res = NULL;
+  SDL_LockMutex(s->lock);
+  if ((s->maxmemory == 0) || (s->memused - oldsz + newsz <= s->maxmemory)) {
+    res = realloc(ptr, newsz);
+    if (res != NULL) {
+      s->memused -= oldsz;
+      s->memused += newsz;
+    }
+  }
+  SDL_UnlockMutex(s->lock);
+  return(res);
+}
+
+/* frees a block allocated with solver_realloc() */
+static void solver_release(struct solver *s, void *ptr, size_t sz) {
+  SDL_LockMutex(s->lock);
+  s->memused -= sz;
+  SDL_UnlockMutex(s->lock);
+  free(ptr);
+}
+
+static void *solver_alloc(struct solver *s, size_t sz) {
+  void *res = solver_realloc(s, NULL, 0, sz);
+  if (res != NULL) memset(res, 0, sz);
+  return(res);
+}
+
+/* ends the search with result res, unless it has ended already */
+static void solver_stop(struct solver *s, int res, struct solvnode *solved) {
+  SDL_LockMutex(s->lock);
+  if (CSDL_AtomicGet(&(s->stop)) == 0) {
+    s->result = res;
+    s->solved = solved;
+    CSDL_AtomicSet(&(s->stop), 1);
+  }
+  SDL_UnlockMutex(s->lock);
+}
+
+/* splitmix64, feeds the Zobrist tables with reproducible values */
+static uint64_t solver_rand(uint64_t *seed) {
+  uint64_t z;
+  *seed += 0x9E3779B97F4A7C15llu;
+  z = *seed;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9llu;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBllu;
+  return(z ^ (z >> 31));
+}
+
+static unsigned int worker_newstamp(struct solvworker *w) {
+  w->stamp += 1;
+  if (w->stamp == 0) { /* wrapped around: old marks must go */
+    memset(w->visited, 0, sizeof(unsigned int) * (size_t)w->s->cells);
+    w->stamp = 1;
+  }
+  return(w->stamp);
+}
+
+/* BFS over all cells the player can walk to from start, leaving back-pointers
+ * in prevdir */
+static void worker_walkbfs(struct solvworker *w, unsigned short start, unsigned char *prevdir) {
+  const struct solver *s = w->s;
+  unsigned int stamp = worker_newstamp(w);
+  int head = 0, tail = 0, d;
+  unsigned short c, n;
+  w->visited[start] = stamp;
+  w->queue[tail++] = start;
+  while (head < tail) {
+    c = w->queue[head++];
+    for (d = 0; d < 4; d++) {
+      n = (unsigned short)(c + s->delta[d]);
+      if ((w->visited[n] == stamp) || s->wall[n] || w->box[n]) continue;
+      w->visited[n] = stamp;
+      prevdir[n] = (unsigned char)d;
+      w->queue[tail++] = n;
+    }
+  }
+}
+
+/* cell index of a bitboard position, and the other way round */
+#define CELL(s, x, y) ((unsigned short)(((y) + 1) * (s)->width + (x) + 1))
+#define CELLX(s, c) ((c) % (s)->width - 1)
+#define CELLY(s, c) ((c) / (s)->width - 1)
+
+/* returns the normalized position of the player standing on cell c, given
+ * the boxes of w->bbox. the area is left in reach. */
+static unsigned short worker_reach(struct solvworker *w, unsigned short c, uint64_t *reach) {
+  const struct solver *s = w->s;
+  int nx, ny;
+  bb_reach(s->bb, w->bbox, CELLX(s, c), CELLY(s, c), reach, &nx, &ny);
+  return(CELL(s, nx, ny));
+}
+
+/* computes the push distance of every cell to the closest goal by pulling
+ * boxes away from all goals at once. cells left UNREACHABLE are dead. */
+static void solver_computedist(struct solver *s, unsigned short *queue) {
+  int head = 0, tail = 0, c, d, n;
+  for (c = 0; c < s->cells; c++) {
+    s->mindist[c] = UNREACHABLE;
+    if (s->goal[c]) {
+      s->mindist[c] = 0;
+      queue[tail++] = (unsigned short)c;
+    }
+  }
+  while (head < tail) {
+    c = queue[head++];
+    for (d = 0; d < 4; d++) {
+      /* pull the box from c to n, the player ending one step further */
+      n = c + s->delta[d];
+      if (s->wall[n] || s->wall[n + s->delta[d]]) continue;
+      if (s->mindist[n] != UNREACHABLE) continue;
+      s->mindist[n] = (unsigned short)(s->mindist[c] + 1);
+      queue[tail++] = (unsigned short)n;
+    }
+  }
+}
+
+/* returns non-zero if the box just pushed to t is part of a 2x2 block of walls
+ * and boxes that contains a box off goal: such a block can never move again */
+static int worker_isfrozen(const struct solvworker *w, int t) {
+  const struct solver *s = w->s;
+  int i, j, c, offgoal;
+  static const int corner[4][2] = {{-1, -1}, {0, -1}, {-1, 0}, {0, 0}};
+  for (i = 0; i < 4; i++) {
+    int square[4];
+    square[0] = t + corner[i][0] + corner[i][1] * s->width;
+    square[1] = square[0] + 1;
+    square[2] = square[0] + s->width;
+    square[3] = square[2] + 1;
+    offgoal = 0;
+    for (j = 0; j < 4; j++) {
+      c = square[j];
+      if ((s->wall[c] == 0) && (w->box[c] == 0)) break;
+      if (w->box[c] && (s->goal[c] == 0)) offgoal = 1;
+    }
+    if ((j == 4) && offgoal) return(1);
+  }
+  return(0);
+}
+
+static int heap_less(const struct heapentry *a, const struct heapentry *b) {
+  if (a->f != b->f) return(a->f < b->f);
+  return(a->h < b->h);
+}
+
+/* adds a state to the open list of worker w */
+static int heap_push(struct solvworker *w, struct solvnode *node, unsigned short g, unsigned short h) {
+  struct heapentry e;
+  uint32_t i, parent;
+  int res = 0;
+  e.node = node;
+  e.h = h;
+  e.f = (unsigned short)(g + h);
+  CSDL_AtomicAdd(&(w->s->pending), 1);
+  SDL_LockMutex(w->lock);
+  if (w->heapcount == w->heapalloc) {
+    uint32_t newalloc = (w->heapalloc == 0) ? 1024 : w->heapalloc * 2;
+    struct heapentry *newheap;
+    newheap = solver_realloc(w->s, w->heap, sizeof(struct heapentry) * w->heapalloc, sizeof(struct heapentry) * newalloc);
+    if (newheap == NULL) {
+      res = -1;
+      goto DONE;
+    }
+    w->heap = newheap;
+    w->heapalloc = newalloc;
+  }
+  /* sift up */
+  i = w->heapcount++;
+  while (i > 0) {
+    parent = (i - 1) / 2;
+    if (heap_less(&e, &(w->heap[parent])) == 0) break;
+    w->heap[i] = w->heap[parent];
+    i = parent;
+  }
+  w->heap[i] = e;
+  DONE:
+  SDL_UnlockMutex(w->lock);
+  if (res != 0) CSDL_AtomicAdd(&(w->s->pending), -1);
+  return(res);
+}
+
+/* pops the best entry of worker w's open list. returns 0 if it is empty */
+static int heap_pop(struct solvworker *w, struct heapentry *res) {
+  struct heapentry last;
+  uint32_t i = 0, child;
+  SDL_LockMutex(w->lock);
+  if (w->heapcount == 0) {
+    SDL_UnlockMutex(w->lock);
+    return(0);
+  }
+  *res = w->heap[0];
+  last = w->heap[--w->heapcount];
+  /* sift down */
+  for (;;) {
+    child = i * 2 + 1;
+    if (child >= w->heapcount) break;
+    if ((child + 1 < w->heapcount) && heap_less(&(w->heap[child + 1]), &(w->heap[child]))) child++;
+    if (heap_less(&(w->heap[child]), &last) == 0) break;
+    w->heap[i] = w->heap[child];
+    i = child;
+  }
+  w->heap[i] = last;
+  SDL_UnlockMutex(w->lock);
+  return(1);
+}
+
+/* fetches the next state to expand, from w's own open list or else by
+ * stealing from another worker. returns 0 if no work is available. */
+static int worker_getwork(struct solvworker *w, struct heapentry *e) {
+  int i;
+  if (heap_pop(w, e) != 0) return(1);
+  for (i = 1; i < w->s->workercount; i++) {
+    if (heap_pop(&(w->s->workers[(w->id + i) % w->s->workercount]), e) != 0) return(1);
+  }
+  return(0);
+}
+
+static struct ttshard *solver_shard(struct solver *s, uint64_t hash) {
+  return(&(s->shards[hash >> (64 - SHARDBITS)]));
+}
+
+/* doubles a shard and rehashes its nodes. shard must be locked. */
+static int shard_grow(struct solver *s, struct ttshard *shard) {
+  uint32_t newsize = shard->size * 2, i, slot;
+  struct solvnode **newslots;
+  newslots = solver_alloc(s, sizeof(struct solvnode *) * newsize);
+  if (newslots == NULL) return(-1);
+  for (i = 0; i < shard->size; i++) {
+    if (shard->slots[i] == NULL) continue;
+    slot = (uint32_t)(shard->slots[i]->hash & (newsize - 1));
+    while (newslots[slot] != NULL) slot = (slot + 1) & (newsize - 1);
+    newslots[slot] = shard->slots[i];
+  }
+  solver_release(s, shard->slots, sizeof(struct solvnode *) * shard->size);
+  shard->slots = newslots;
+  shard->size = newsize;
+  return(0);
+}
+
+/* returns room for a new node from w's current chunk */
+static struct solvnode *worker_newnode(struct solvworker *w) {
+  struct solver *s = w->s;
+  struct solvnode *res;
+  if (w->chunkfree == 0) {
+    unsigned char *chunk;
+    /* the first slot of a chunk links it to the previous one */
+    chunk = solver_realloc(s, NULL, 0, s->nodesize * (CHUNKNODES + 1));
+    if (chunk == NULL) return(NULL);
+    SDL_LockMutex(s->lock);
+    *((void **)chunk) = s->chunks;
+    s->chunks = chunk;
+    SDL_UnlockMutex(s->lock);
+    w->chunk = chunk + s->nodesize;
+    w->chunkfree = CHUNKNODES;
+  }
+  res = (struct solvnode *)w->chunk;
+  w->chunk += s->nodesize;
+  w->chunkfree--;
+  return(res);
+}
+
+/* adds a push-state to the search, unless it is already known with a lower
+ * or equal cost. returns 0 on success, -1 on out of memory. */
+static int worker_addnode(struct solvworker *w, uint64_t hash, const unsigned short *boxes, unsigned short player, struct solvnode *parent, unsigned short pushfrom, int pushdir, unsigned short g, unsigned short h) {
+  struct solver *s = w->s;
+  struct ttshard *shard = solver_shard(s, hash);
+  size_t boxsz = sizeof(unsigned short) * (size_t)s->boxcount;
+  struct solvnode *node;
+  uint32_t slot;
+
+  SDL_LockMutex(shard->lock);
+  /* look for the state in the transposition table */
+  slot = (uint32_t)(hash & (shard->size - 1));
+  while ((node = shard->slots[slot]) != NULL) {
+    if ((node->hash == hash) && (node->player == player) && (memcmp(NODEBOXES(node), boxes, boxsz) == 0)) {
+      if (g >= node->g) {
+        SDL_UnlockMutex(shard->lock);
+        return(0);
+      }
+      /* found a cheaper path to a known state */
+      node->parent = parent;
+      node->pushfrom = pushfrom;
+      node->pushdir = (unsigned char)pushdir;
+      node->g = g;
+      SDL_UnlockMutex(shard->lock);
+      return(heap_push(w, node, g, h));
+    }
+    slot = (slot + 1) & (shard->size - 1);
+  }
+
+  /* new state */
+  if ((shard->count + 1) * 2 > shard->size) {
+    if (shard_grow(s, shard) != 0) goto NOMEM;
+    slot = (uint32_t)(hash & (shard->size - 1));
+    while (shard->slots[slot] != NULL) slot = (slot + 1) & (shard->size - 1);
+  }
+  node = worker_newnode(w);
+  if (node == NULL) goto NOMEM;
+  node->hash = hash;
+  node->parent = parent;
+  node->player = player;
+  node->pushfrom = pushfrom;
+  node->pushdir = (unsigned char)pushdir;
+  node->g = g;
+  node->h = h;
+  memcpy(NODEBOXES(node), boxes, boxsz);
+  shard->slots[slot] = node;
+  shard->count++;
+  SDL_UnlockMutex(shard->lock);
+  return(heap_push(w, node, g, h));
+
+  NOMEM:
+  SDL_UnlockMutex(shard->lock);
+  return(-1);
+}
+
+/* generates all children of node n, whose current cost is g. returns 0 on
+ * success, -1 on out of memory */
+static int worker_expand(struct solvworker *w, struct solvnode *n, unsigned short g) {
+  static const enum SOKMOVE bbdir[4] = {sokmoveUP, sokmoveRIGHT, sokmoveDOWN, sokmoveLEFT};
+  const struct solver *s = w->s;
+  int i, j, d, r, b, t, lo, hi, res = 0;
+  unsigned short norm, h;
+  uint64_t hash, bits;
+
+  memcpy(w->pbox, NODEBOXES(n), sizeof(unsigned short) * (size_t)s->boxcount);
+  for (i = 0; i < s->boxcount; i++) {
+    w->box[w->pbox[i]] = 1;
+    BB_SET(w->bbox, CELLX(s, w->pbox[i]), CELLY(s, w->pbox[i]));
+  }
+  worker_reach(w, n->player, w->reach);
+
+  for (d = 0; (d < 4) && (res == 0); d++) {
+    bb_pushable(s->bb, w->bbox, w->reach, s->live, bbdir[d], w->push);
+    for (r = 1; (r <= s->bb->height) && (res == 0); r++) {
+      for (bits = w->push[r]; bits != 0; bits &= bits - 1) {
+        b = CELL(s, bb_firstbit(bits), r - 1);
+        t = b + s->delta[d];
+        /* find the box in the sorted list */
+        lo = 0;
+        hi = s->boxcount - 1;
+        while (lo < hi) {
+          i = (lo + hi) / 2;
+          if (w->pbox[i] < b) {
+            lo = i + 1;
+          } else {
+            hi = i;
+          }
+        }
+        i = lo;
+        w->box[b] = 0;
+        w->box[t] = 1;
+        if ((s->strict == 0) || (worker_isfrozen(w, t) == 0)) {
+          BB_CLR(w->bbox, CELLX(s, b), CELLY(s, b));
+          BB_SET(w->bbox, CELLX(s, t), CELLY(s, t));
+          norm = worker_reach(w, (unsigned short)b, w->creach);
+          BB_CLR(w->bbox, CELLX(s, t), CELLY(s, t));
+          BB_SET(w->bbox, CELLX(s, b), CELLY(s, b));
+          /* the child's box list, kept sorted */
+          memcpy(w->cbox, w->pbox, sizeof(unsigned short) * (size_t)s->boxcount);
+          w->cbox[i] = (unsigned short)t;
+          for (j = i; (j > 0) && (w->cbox[j - 1] > w->cbox[j]); j--) {
+            w->cbox[j] = w->cbox[j - 1];
+            w->cbox[j - 1] = (unsigned short)t;
+          }
+          for (; (j + 1 < s->boxcount) && (w->cbox[j + 1] < w->cbox[j]); j++) {
+            w->cbox[j] = w->cbox[j + 1];
+            w->cbox[j + 1] = (unsigned short)t;
+          }
+          hash = n->hash ^ s->zbox[b] ^ s->zbox[t] ^ s->zplayer[n->player] ^ s->zplayer[norm];
+          h = 0;
+          if (s->strict) h = (unsigned short)(n->h - s->mindist[b] + s->mindist[t]);
+          res = worker_addnode(w, hash, w->cbox, norm, n, (unsigned short)b, d, (unsigned short)(g + 1), h);
+        }
+        w->box[t] = 0;
+        w->box[b] = 1;
+        if (res != 0) break;
+      }
+    }
+  }
+
+  for (i = 0; i < s->boxcount; i++) {
+    w->box[w->pbox[i]] = 0;
+    BB_CLR(w->bbox, CELLX(s, w->pbox[i]), CELLY(s, w->pbox[i]));
+  }
+  return(res);
+}
+
+static int solver_issolved(struct solvworker *w, const struct solvnode *n) {
+  const struct solver *s = w->s;
+  const unsigned short *boxes = NODEBOXES(n);
+  int i, res;
+  if (s->strict) return(n->h == 0);
+  for (i = 0; i < s->boxcount; i++) BB_SET(w->bbox, CELLX(s, boxes[i]), CELLY(s, boxes[i]));
+  res = bb_issolved(s->bb, w->bbox);
+  for (i = 0; i < s->boxcount; i++) BB_CLR(w->bbox, CELLX(s, boxes[i]), CELLY(s, boxes[i]));
+  return(res);
+}
+
+/* search loop of a single worker thread */
+static void worker_run(void *ctx, int id) {
+  struct solver *s = ctx;
+  struct solvworker *w = &(s->workers[id]);
+  struct heapentry e;
+  struct ttshard *shard;
+  unsigned short g;
+  int idle = 0;
+
+  while (CSDL_AtomicGet(&(s->stop)) == 0) {
+    if (worker_getwork(w, &e) == 0) {
+      /* nothing queued anywhere and nothing being expanded: search is over */
+      if (CSDL_AtomicGet(&(s->pending)) == 0) break;
+      SDL_Delay((idle++ < 16) ? 0 : 1);
+      continue;
+    }
+    idle = 0;
+    /* read the node's current cost, other workers may lower it any time */
+    shard = solver_shard(s, e.node->hash);
+    SDL_LockMutex(shard->lock);
+    g = e.node->g;
+    SDL_UnlockMutex(shard->lock);
+    /* skip entries of states that have been reached by a cheaper path since */
+    if (e.f == g + e.node->h) {
+      /* the game does not consider a level solved before the first push */
+      if ((g > 0) && solver_issolved(w, e.node)) {
+        solver_stop(s, soksolver_solved, e.node);
+      } else if (worker_expand(w, e.node, g) != 0) {
+        solver_stop(s, soksolver_outofmem, NULL);
+      }
+      w->expanded++;
+      if ((w->expanded & 1023) == 0) {
+        if ((s->maxtime != 0) && ((unsigned long)(time(NULL) - s->starttime) >= s->maxtime)) solver_stop(s, soksolver_timeout, NULL);
+        if ((s->cancel != NULL) && (s->cancel(s->cancelctx) != 0)) solver_stop(s, soksolver_cancelled, NULL);
+      }
+    }
+    CSDL_AtomicAdd(&(s->pending), -1);
+  }
+}
+
+/* appends the player's walk from *player to dst to the solution string */
+static int solver_appendwalk(struct solvworker *w, unsigned char *prevdir, unsigned short *player, unsigned short dst, char **sol, size_t *sollen, size_t *solalloc, size_t extra) {
+  const struct solver *s = w->s;
+  size_t len = 0, i;
+  unsigned short c;
+  worker_walkbfs(w, *player, prevdir);
+  for (c = dst; c != *player; c = (unsigned short)(c - s->delta[prevdir[c]])) len++;
+  if (*sollen + len + extra + 1 > *solalloc) {
+    char *newsol;
+    while (*sollen + len + extra + 1 > *solalloc) *solalloc *= 2;
+    newsol = realloc(*sol, *solalloc);
+    if (newsol == NULL) return(-1);
+    *sol = newsol;
+  }
+  /* walk back from dst, writing moves in reverse */
+  i = *sollen + len;
+  for (c = dst; c != *player; c = (unsigned short)(c - s->delta[prevdir[c]])) {
+    (*sol)[--i] = dirchars[prevdir[c]];
+  }
+  *sollen += len;
+  *player = dst;
+  return(0);
+}
+
+/* turns the chain of push-states ending at node n into a moves string. player
+ * is the initial player position. must be called once all workers are done. */
+static char *solver_buildsolution(struct solver *s, struct solvnode *n, unsigned short player) {
+  struct solvworker *w = &(s->workers[0]);
+  struct solvnode **path, *k;
+  unsigned char *prevdir;
+  size_t pushes = 0, i, sollen = 0, solalloc = 64;
+  char *sol;
+
+  /* path counted from the links, cheaper paths may have shortened it */
+  for (k = n; k->parent != NULL; k = k->parent) pushes++;
+  path = malloc(sizeof(struct solvnode *) * (pushes + 1));
+  prevdir = malloc((size_t)s->cells);
+  sol = malloc(solalloc);
+  if ((path == NULL) || (prevdir == NULL) || (sol == NULL)) goto FAIL;
+  i = pushes;
+  for (k = n; k != NULL; k = k->parent) path[i--] = k;
+
+  /* replay pushes from the initial state */
+  for (i = 0; i < (size_t)s->boxcount; i++) w->box[NODEBOXES(path[0])[i]] = 1;
+  for (i = 1; i <= pushes; i++) {
+    const struct solvnode *node = path[i];
+    int d = node->pushdir;
+    if (solver_appendwalk(w, prevdir, &player, (unsigned short)(node->pushfrom - s->delta[d]), &sol, &sollen, &solalloc, 1) != 0) goto FAIL;
+    sol[sollen++] = (char)(dirchars[d] - 32); /* uppercase = push */
+    w->box[node->pushfrom] = 0;
+    w->box[node->pushfrom + s->delta[d]] = 1;
+    player = node->pushfrom;
+  }
+  sol[sollen] = 0;
+  free(path);
+  free(prevdir);
+  return(sol);
+
+  FAIL:
+  free(path);
+  free(prevdir);
+  free(sol);
+  return(NULL);
+}
+
+static void solver_free(struct solver *s) {
+  int i;
+  void *chunk;
+  free(s->wall);
+  free(s->goal);
+  free(s->mindist);
+  free(s->zbox);
+  free(s->zplayer);
+  bb_free(s->ownbb);
+  for (i = 0; i < SHARDS; i++) {
+    free(s->shards[i].slots);
+    if (s->shards[i].lock != NULL) SDL_DestroyMutex(s->shards[i].lock);
+  }
+  for (i = 0; (s->workers != NULL) && (i < s->workercount); i++) {
+    struct solvworker *w = &(s->workers[i]);
+    if (w->lock != NULL) SDL_DestroyMutex(w->lock);
+    free(w->heap);
+    free(w->box);
+    free(w->visited);
+    free(w->queue);
+    free(w->pbox);
+    free(w->cbox);
+  }
+  free(s->workers);
+  while (s->chunks != NULL) {
+    chunk = s->chunks;
+    s->chunks = *((void **)chunk);
+    free(chunk);
+  }
+  if (s->lock != NULL) SDL_DestroyMutex(s->lock);
+}
+
+static int solver_initworker(struct solver *s, struct solvworker *w, int id) {
+  size_t cells = (size_t)s->cells;
+  w->s = s;
+  w->id = id;
+  w->lock = SDL_CreateMutex();
+  w->box = solver_alloc(s, cells);
+  w->visited = solver_alloc(s, sizeof(unsigned int) * cells);
+  w->queue = solver_alloc(s, sizeof(unsigned short) * cells);
+  w->pbox = solver_alloc(s, sizeof(unsigned short) * ((size_t)s->boxcount + 1));
+  w->cbox = solver_alloc(s, sizeof(unsigned short) * ((size_t)s->boxcount + 1));
+  if ((w->lock == NULL) || (w->box == NULL) || (w->visited == NULL) || (w->queue == NULL) || (w->pbox == NULL) || (w->cbox == NULL)) return(-1);
+  return(0);
+}
+
+/* sets up the board, the workers and the initial push-state. returns 0 on
+ * success */
+static int solver_init(struct solver *s, const struct sokgame *game, unsigned short *player) {
+  int x, y, c, i;
+  uint64_t seed = 0;
+  size_t cells;
+
+  s->lock = SDL_CreateMutex();
+  if (s->lock == NULL) return(-1);
+  s->width = game->field_width + 2;
+  s->cells = s->width * (game->field_height + 2);
+  s->delta[0] = -s->width;
+  s->delta[1] = 1;
+  s->delta[2] = s->width;
+  s->delta[3] = -1;
+  cells = (size_t)s->cells;
+
+  s->wall = solver_alloc(s, cells);
+  s->goal = solver_alloc(s, cells);
+  s->mindist = solver_alloc(s, sizeof(unsigned short) * cells);
+  s->zbox = solver_alloc(s, sizeof(uint64_t) * cells);
+  s->zplayer = solver_alloc(s, sizeof(uint64_t) * cells);
+  if ((s->wall == NULL) || (s->goal == NULL) || (s->mindist == NULL) || (s->zbox == NULL) || (s->zplayer == NULL)) return(-1);
+
+  /* the border around the level is made of walls */
+  memset(s->wall, 1, cells);
+  for (y = 0; y < game->field_height; y++) {
+    for (x = 0; x < game->field_width; x++) {
+      c = (y + 1) * s->width + x + 1;
+      if ((SOK_FIELD(game, x, y) & field_floor) && ((SOK_FIELD(game, x, y) & field_wall) == 0)) s->wall[c] = 0;
+      if (SOK_FIELD(game, x, y) & field_goal) s->goalcount++;
+      if (SOK_FIELD(game, x, y) & field_goal) s->goal[c] = 1;
+      if (SOK_FIELD(game, x, y) & field_atom) s->boxcount++;
+    }
+  }
+  for (c = 0; c < s->cells; c++) {
+    s->zbox[c] = solver_rand(&seed);
+    s->zplayer[c] = solver_rand(&seed);
+  }
+  s->strict = (s->boxcount == s->goalcount);
+
+  /* walls and goals do not move, so the level's bitboard works whatever the
+   * current position of game is */
+  s->bb = game->bitboard;
+  if (s->bb == NULL) {
+    s->ownbb = bb_new(game);
+    if (s->ownbb == NULL) return(-1);
+    s->bb = s->ownbb;
+  }
+  s->nodesize = (sizeof(struct solvnode) + sizeof(unsigned short) * (size_t)s->boxcount + 7) & ~(size_t)7;
+
+  for (i = 0; i < SHARDS; i++) {
+    s->shards[i].lock = SDL_CreateMutex();
+    s->shards[i].size = 256;
+    s->shards[i].slots = solver_alloc(s, sizeof(struct solvnode *) * s->shards[i].size);
+    if ((s->shards[i].lock == NULL) || (s->shards[i].slots == NULL)) return(-1);
+  }
+
+  s->workers = solver_alloc(s, sizeof(struct solvworker) * (size_t)s->workercount);
+  if (s->workers == NULL) return(-1);
+  for (i = 0; i < s->workercount; i++) {
+    if (solver_initworker(s, &(s->workers[i]), i) != 0) return(-1);
+  }
+  solver_computedist(s, s->workers[0].queue);
+  for (i = 0; i < s->bb->rows; i++) s->live[i] = ~(uint64_t)0;
+  if (s->strict) {
+    for (y = 0; y < game->field_height; y++) {
+      for (x = 0; x < game->field_width; x++) {
+        if (s->mindist[CELL(s, x, y)] == UNREACHABLE) BB_CLR(s->live, x, y);
+      }
+    }
+  }
+
+  /* boxes of the root state, in ascending order */
+  i = 0;
+  for (c = 0; c < s->cells; c++) {
+    x = c % s->width - 1;
+    y = c / s->width - 1;
+    if ((x < 0) || (y < 0) || (x >= game->field_width) || (y >= game->field_height)) continue;
+    if (SOK_FIELD(game, x, y) & field_atom) s->workers[0].pbox[i++] = (unsigned short)c;
+  }
+  *player = (unsigned short)((game->positiony + 1) * s->width + game->positionx + 1);
+  return(0);
+}
+
+
+int sok_solve(const struct sokgame *game, const struct soksolver_params *params, char **solution, struct soksolver_stats *stats) {
+  struct solver s;
+  struct solvworker *w;
+  unsigned short player, norm, h = 0;
+  uint64_t hash;
+  int i, res = soksolver_nosolution;
+
+  *solution = NULL;
+  memset(&s, 0, sizeof(s));
+  if (stats != NULL) memset(stats, 0, sizeof(*stats));
+  /* bitboards hold a row of the level in a single word */
+  if ((game->field_width > BB_MAXSIZE) || (game->field_height > BB_MAXSIZE)) return(soksolver_toolarge);
+  s.workercount = 1;
+  if (params != NULL) {
+    s.maxmemory = params->maxmemory;
+    s.maxtime = params->maxtime;
+    s.workercount = params->threads;
+    s.cancel = params->cancel;
+    s.cancelctx = params->cancelctx;
+  }
+  if (s.workercount < 1) s.workercount = CSDL_GetCPUCount();
+  if (s.workercount < 1) s.workercount = 1;
+  s.starttime = time(NULL);
+  if (solver_init(&s, game, &player) != 0) {
+    solver_free(&s);
+    return(soksolver_outofmem);
+  }
+  w = &(s.workers[0]);
+
+  /* not enough boxes to fill all goals */
+  if (s.boxcount < s.goalcount) goto DONE;
+
+  /* root state */
+  hash = 0;
+  for (i = 0; i < s.boxcount; i++) {
+    hash ^= s.zbox[w->pbox[i]];
+    BB_SET(w->bbox, CELLX(&s, w->pbox[i]), CELLY(&s, w->pbox[i]));
+    if (s.strict) {
+      if (s.mindist[w->pbox[i]] == UNREACHABLE) goto DONE; /* a box is stuck from the start */
+      h = (unsigned short)(h + s.mindist[w->pbox[i]]);
+    }
+  }
+  norm = worker_reach(w, player, w->reach);
+  for (i = 0; i < s.boxcount; i++) BB_CLR(w->bbox, CELLX(&s, w->pbox[i]), CELLY(&s, w->pbox[i]));
+  hash ^= s.zplayer[norm];
+  if (worker_addnode(w, hash, w->pbox, norm, NULL, 0, 0, 0, h) != 0) {
+    res = soksolver_outofmem;
+    goto DONE;
+  }
+
+  /* workers that could not be spawned are played down by the calling thread
+   * one after another, so the search completes either way */
+  i = pool_run(s.workercount, s.workercount, worker_run, &s);
+  if (stats != NULL) stats->threads = i;
+
+  res = soksolver_nosolution;
+  if (CSDL_AtomicGet(&(s.stop)) != 0) res = s.result;
+  if (res == soksolver_solved) {
+    *solution = solver_buildsolution(&s, s.solved, player);
+    if (*solution == NULL) res = soksolver_outofmem;
+  }
+
+  DONE:
+  if (stats != NULL) {
+    for (i = 0; i < s.workercount; i++) stats->nodes += s.workers[i].expanded;
+  }
+  solver_free(&s);
+  return(res);
+}
+
+
+const char *sok_solver_strerr(int res) {
+  switch ((enum SOKSOLVER) res) {
+    case soksolver_solved: return("solved");
+    case soksolver_nosolution: return("no solution exists");
+    case soksolver_timeout: return("time limit reached");
+    case soksolver_outofmem: return("memory limit reached");
+    case soksolver_toolarge: return("level too large for the solver");
+    case soksolver_cancelled: return("cancelled");
+  }
+  return("unknown error");
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the 'Simple Sokoban' project.
+ *
+ * MIT LICENSE
+ *
+ * Copyright (C) 2014-2025 Mateusz Viste
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef sok_solver_h_sentinel
+#define sok_solver_h_sentinel
+
+  #include "sok_core.h"
+
+  enum SOKSOLVER {
+    soksolver_solved = 0,
+    soksolver_nosolution = -1,
+    soksolver_timeout = -2,
+    soksolver_outofmem = -3,
+    soksolver_toolarge = -4, /* level wider or higher than BB_MAXSIZE */
+    soksolver_cancelled = -5
+  };
+
+  struct soksolver_params {
+    size_t maxmemory;       /* memory the solver is allowed to use, in bytes (0 = no limit) */
+    unsigned long maxtime;  /* time the solver is allowed to spend, in seconds (0 = no limit) */
+    int threads;            /* worker threads to search with (0 = one per CPU core) */
+    /* polled by the worker threads while searching (may be NULL): the
+     * search is abandoned as soon as it returns non-zero */
+    int (*cancel)(void *ctx);
+    void *cancelctx;
+  };
+
+  struct soksolver_stats {
+    unsigned long nodes;    /* number of push-states expanded */
+    int threads;            /* number of threads that took part in the search */
+  };
+
+  /* computes a solution for game (starting from its current position). on
+   * success returns soksolver_solved and sets *solution to a malloc()'ed
+   * string of moves in the same format as states->history. otherwise returns
+   * one of the other SOKSOLVER values. stats may be NULL. solutions found by
+   * a single thread are push-optimal, with more threads they may not be. */
+  int sok_solve(const struct sokgame *game, const struct soksolver_params *params, char **solution, struct soksolver_stats *stats);
+
+  /* returns a human string for a solver result */
+  const char *sok_solver_strerr(int res);
+
+#endif